@@ -1,23 +1,41 @@
 ## Note that this file is not auto generated, it is what generates the
 ## callouts-gen.hpp file
+<%
+    seeds, slots = perfect_hash.build(sorted(calloutsMap))
+%>\
 // This file was autogenerated.  Do not edit!
 // See callouts-gen.py for more details
 #pragma once
 
-#include <string>
-#include <tuple>
+#include <perfect_hash.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
 
 namespace phosphor
 {
 namespace logging
 {
 
-constexpr auto callouts =
+namespace callout_tables
 {
-% for key, value in sorted(calloutsMap.items()):
-    std::make_tuple("${key}", "${value}"),
+
+inline constexpr std::array<int32_t, ${len(seeds)}> seeds{${", ".join(str(s) for s in seeds)}};
+
+inline constexpr std::array<PerfectHashMap<std::string_view>::Entry, ${len(slots)}>
+    entries{{
+% for key in slots:
+    {"${key}", "${calloutsMap[key]}"},
 % endfor
-};
+}};
+
+} // namespace callout_tables
+
+/** @brief The inventory path, under the inventory root, of each sysfs
+ *         device path */
+inline constexpr PerfectHashMap<std::string_view> callouts{
+    callout_tables::seeds, callout_tables::entries};
 
 } // namespace logging
 } // namespace phosphor
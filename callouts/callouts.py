@@ -2,6 +2,7 @@
 
 import argparse
 import os
+import sys
 
 from mako.template import Template
 
@@ -31,11 +32,17 @@ def main():
     with open(args.callouts_yaml, "r") as fd:
         calloutsMap = yaml.safe_load(fd)
 
+        # The tables are built with the same code as the elog-gen ones.
+        sys.path.insert(0, os.path.join(script_dir, "..", "tools"))
+        import perfect_hash
+
         # Render the mako template
         template = os.path.join(script_dir, "callouts-gen.mako.hpp")
         t = Template(filename=template)
         with open(args.output, "w") as fd:
-            fd.write(t.render(calloutsMap=calloutsMap))
+            fd.write(
+                t.render(calloutsMap=calloutsMap, perfect_hash=perfect_hash)
+            )
 
 
 if __name__ == "__main__":
@@ -1,3 +1,5 @@
+#include "config.h"
+
 #include "elog_entry.hpp"
 
 #include "elog_serialize.hpp"
@@ -6,11 +8,14 @@
 #include "paths.hpp"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/File/error.hpp>
 
+#include <sstream>
+
 namespace phosphor
 {
 namespace logging
@@ -66,7 +71,7 @@ bool Entry::resolved(bool value)
                           .count();
         updateTimestamp(ms);
 
-        serialize(*this);
+        parent.persistUpdate(*this);
     }
 
     return current;
@@ -81,7 +86,7 @@ std::string Entry::eventId(std::string value)
         current =
             sdbusplus::server::xyz::openbmc_project::logging::Entry::eventId(
                 value);
-        serialize(*this);
+        parent.persistUpdate(*this);
     }
 
     return current;
@@ -96,7 +101,7 @@ std::string Entry::resolution(std::string value)
         current =
             sdbusplus::server::xyz::openbmc_project::logging::Entry::resolution(
                 value);
-        serialize(*this);
+        parent.persistUpdate(*this);
     }
 
     return current;
@@ -104,7 +109,18 @@ std::string Entry::resolution(std::string value)
 
 sdbusplus::message::unix_fd Entry::getEntry()
 {
-    int fd = open(path().c_str(), O_RDONLY | O_NONBLOCK);
+    int fd = -1;
+    if constexpr (ENTRY_STORE_JOURNAL)
+    {
+        // There is no file per entry, so provide the same data
+        // from an in-memory file.
+        fd = serializeToMemfd();
+    }
+    else
+    {
+        fd = open(path().c_str(), O_RDONLY | O_NONBLOCK);
+    }
+
     if (fd == -1)
     {
         auto e = errno;
@@ -123,6 +139,40 @@ sdbusplus::message::unix_fd Entry::getEntry()
     return fd;
 }
 
+int Entry::serializeToMemfd() const
+{
+    std::ostringstream os;
+    serialize(*this, os);
+    auto data = os.str();
+
+    int fd = memfd_create("entry", MFD_CLOEXEC);
+    if (fd == -1)
+    {
+        return fd;
+    }
+
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        auto rc = write(fd, data.data() + offset, data.size() - offset);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            auto e = errno;
+            close(fd);
+            errno = e;
+            return -1;
+        }
+        offset += rc;
+    }
+
+    lseek(fd, 0, SEEK_SET);
+    return fd;
+}
+
 void Entry::closeFD(int fd, sdeventplus::source::EventBase& /*source*/)
 {
     close(fd);
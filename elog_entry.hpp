@@ -170,6 +170,14 @@ class Entry : public EntryIfaces
      * @param[in] source - The event source object used
      */
     void closeFD(int fd, sdeventplus::source::EventBase& source);
+
+    /**
+     * @brief Writes the serialized entry to a memfd, for when entries
+     *        are stored in the entry journal instead of one file each.
+     * @return int - The file descriptor, positioned at the start, or -1
+     *               on failure with errno set.
+     */
+    int serializeToMemfd() const;
 };
 
 } // namespace logging
@@ -0,0 +1,638 @@
+#include "config.h"
+
+#include "elog_journal.hpp"
+
+#include "elog_serialize.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/tuple.hpp>
+#include <cereal/types/vector.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace phosphor
+{
+namespace logging
+{
+
+namespace
+{
+
+constexpr uint32_t recordMagic = 0x454A524E; // 'EJRN'
+constexpr auto segmentPrefix = "segment.";
+constexpr auto compactTempName = ".compact";
+
+/**
+ * @brief Compaction is done once there are this many more records
+ *        than the two needed for each live entry.
+ */
+constexpr size_t compactSlack = 128;
+
+/** @brief The header in front of every record */
+struct RecordHeader
+{
+    uint32_t magic;
+    uint8_t type;
+    uint8_t reserved[3];
+    uint32_t id;
+    uint32_t size;
+    uint32_t checksum;
+};
+
+/**
+ * @brief FNV-1a over the record type, ID, and payload, so that a torn
+ *        or corrupted record is detected.
+ */
+uint32_t checksum(uint8_t type, uint32_t id, const char* data, size_t size)
+{
+    uint32_t hash = 2166136261U;
+    auto add = [&hash](uint8_t byte) {
+        hash ^= byte;
+        hash *= 16777619U;
+    };
+
+    add(type);
+    for (size_t i = 0; i < sizeof(id); i++)
+    {
+        add(static_cast<uint8_t>(id >> (i * 8)));
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        add(static_cast<uint8_t>(data[i]));
+    }
+    return hash;
+}
+
+/**
+ * @brief Builds a record, header and payload, so it can be written
+ *        with a single write().
+ */
+std::string makeRecord(EntryJournal::RecordType type, uint32_t id,
+                       const std::string& payload)
+{
+    RecordHeader header{};
+    header.magic = recordMagic;
+    header.type = static_cast<uint8_t>(type);
+    header.id = id;
+    header.size = payload.size();
+    header.checksum =
+        checksum(header.type, id, payload.data(), payload.size());
+
+    std::string record(sizeof(header) + payload.size(), '\0');
+    std::memcpy(record.data(), &header, sizeof(header));
+    std::memcpy(record.data() + sizeof(header), payload.data(),
+                payload.size());
+    return record;
+}
+
+/** @brief Writes the whole buffer, throwing on failure */
+void writeAll(int fd, const std::string& data)
+{
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        auto rc = ::write(fd, data.data() + offset, data.size() - offset);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed writing entry journal");
+        }
+        offset += rc;
+    }
+}
+
+/** @brief Serializes the properties that can change after creation */
+std::string serializeDelta(const Entry& e)
+{
+    std::ostringstream os;
+    {
+        cereal::BinaryOutputArchive oarchive(os);
+        oarchive(e.severity(), e.resolved(), e.associations(),
+                 e.updateTimestamp(), e.eventId(), e.resolution());
+    }
+    return os.str();
+}
+
+/** @brief Applies a delta record to an entry */
+void deserializeDelta(const std::string& data, Entry& e)
+{
+    Entry::Level severity{};
+    bool resolved{};
+    AssociationList associations{};
+    uint64_t updateTimestamp{};
+    std::string eventId{};
+    std::string resolution{};
+
+    std::istringstream is(data);
+    cereal::BinaryInputArchive iarchive(is);
+    iarchive(severity, resolved, associations, updateTimestamp, eventId,
+             resolution);
+
+    e.severity(severity, true);
+    e.sdbusplus::server::xyz::openbmc_project::logging::Entry::resolved(
+        resolved, true);
+    e.associations(associations, true);
+    e.updateTimestamp(updateTimestamp, true);
+    e.eventId(eventId, true);
+    e.resolution(resolution, true);
+}
+
+/** @brief fsyncs a directory so renames and removals are durable */
+void syncDirectory(const fs::path& dir)
+{
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+} // namespace
+
+EntryJournal::EntryJournal(const fs::path& dir, size_t segmentSize) :
+    _dir(dir), _segmentSize(segmentSize)
+{}
+
+EntryJournal::~EntryJournal()
+{
+    closeSegment();
+}
+
+fs::path EntryJournal::segmentPath(uint32_t seq) const
+{
+    return _dir / std::format("{}{:08X}", segmentPrefix, seq);
+}
+
+void EntryJournal::load()
+{
+    _loaded = true;
+    fs::create_directories(_dir);
+    fs::remove(_dir / compactTempName);
+
+    for (const auto& dirEntry : fs::directory_iterator(_dir))
+    {
+        auto name = dirEntry.path().filename().string();
+        if (!name.starts_with(segmentPrefix))
+        {
+            continue;
+        }
+
+        try
+        {
+            _segments.push_back(
+                std::stoul(name.substr(std::strlen(segmentPrefix)), nullptr,
+                           16));
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Ignoring unexpected entry journal file {FILE}", "FILE",
+                       dirEntry.path());
+        }
+    }
+    std::ranges::sort(_segments);
+
+    size_t checkpoint = 0;
+    for (size_t i = 0; i < _segments.size(); i++)
+    {
+        auto path = segmentPath(_segments[i]);
+        auto fileSize = fs::file_size(path);
+        auto goodSize = replay(path, checkpoint, i);
+
+        if (goodSize != fileSize)
+        {
+            lg2::error("Entry journal segment {FILE} has a bad record at "
+                       "offset {OFFSET}",
+                       "FILE", path, "OFFSET", goodSize);
+
+            // Drop the partial record so appends start on a boundary
+            if (i == _segments.size() - 1)
+            {
+                fs::resize_file(path, goodSize);
+            }
+        }
+    }
+
+    // Segments before the latest checkpoint were left behind by an
+    // interrupted compaction.
+    for (size_t i = 0; i < checkpoint; i++)
+    {
+        fs::remove(segmentPath(_segments[i]));
+    }
+    _segments.erase(_segments.begin(), _segments.begin() + checkpoint);
+
+    if (_recordCount > (2 * _records.size()) + compactSlack)
+    {
+        compact();
+    }
+}
+
+size_t EntryJournal::replay(const fs::path& path, size_t& checkpoint,
+                            size_t index)
+{
+    std::ifstream file{path, std::ios::binary};
+    auto fileSize = fs::file_size(path);
+    std::string payload;
+    size_t offset = 0;
+
+    while (true)
+    {
+        RecordHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            break;
+        }
+
+        if ((header.magic != recordMagic) ||
+            (header.size > fileSize - offset - sizeof(header)))
+        {
+            break;
+        }
+
+        payload.resize(header.size);
+        if (!file.read(payload.data(), header.size))
+        {
+            break;
+        }
+
+        if (header.checksum !=
+            checksum(header.type, header.id, payload.data(), payload.size()))
+        {
+            break;
+        }
+
+        switch (static_cast<RecordType>(header.type))
+        {
+            case RecordType::entry:
+                _records[header.id] = Records{std::move(payload), {}};
+                break;
+            case RecordType::delta:
+            {
+                auto it = _records.find(header.id);
+                if (it != _records.end())
+                {
+                    it->second.delta = std::move(payload);
+                }
+                break;
+            }
+            case RecordType::remove:
+                _records.erase(header.id);
+                break;
+            case RecordType::checkpoint:
+                _records.clear();
+                _recordCount = 0;
+                checkpoint = index;
+                break;
+            default:
+                lg2::error("Unknown entry journal record type {TYPE}", "TYPE",
+                           header.type);
+                break;
+        }
+
+        payload.clear();
+        _recordCount++;
+        offset += sizeof(header) + header.size;
+    }
+
+    return offset;
+}
+
+std::map<uint32_t, std::unique_ptr<Entry>>
+    EntryJournal::restore(const EntryFactory& makeEntry)
+{
+    if (!_loaded)
+    {
+        load();
+    }
+
+    std::map<uint32_t, std::unique_ptr<Entry>> entries;
+
+    for (auto it = _records.begin(); it != _records.end();)
+    {
+        auto id = it->first;
+        auto e = makeEntry(id);
+
+        try
+        {
+            std::istringstream is(it->second.entry);
+            deserialize(is, *e);
+
+            if (!it->second.delta.empty())
+            {
+                deserializeDelta(it->second.delta, *e);
+            }
+
+            if (e->id() != id)
+            {
+                throw std::runtime_error(
+                    std::format("Entry ID mismatch {}/{}", id, e->id()));
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            lg2::error("Failed restoring entry {ID} from the entry journal: "
+                       "{EXCEPTION}",
+                       "ID", id, "EXCEPTION", ex);
+            it = _records.erase(it);
+            continue;
+        }
+
+        entries.emplace(id, std::move(e));
+        ++it;
+    }
+
+    return entries;
+}
+
+size_t EntryJournal::migrate(
+    const fs::path& fileDir, const EntryFactory& makeEntry,
+    std::map<uint32_t, std::unique_ptr<Entry>>& entries)
+{
+    if (!fs::exists(fileDir))
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+
+    for (const auto& file : fs::directory_iterator(fileDir))
+    {
+        uint32_t id = 0;
+        try
+        {
+            id = std::stoul(file.path().filename().string());
+        }
+        catch (const std::exception& e)
+        {
+            continue;
+        }
+
+        if (!entries.contains(id))
+        {
+            auto e = makeEntry(id);
+            if (!deserialize(file.path(), *e))
+            {
+                continue;
+            }
+
+            if (e->id() != id)
+            {
+                lg2::error("Failed in sanity check while migrating error "
+                           "entry. Ignoring error entry {ID_NUM}/{ENTRY_ID}.",
+                           "ID_NUM", id, "ENTRY_ID", e->id());
+                continue;
+            }
+
+            add(*e);
+            entries.emplace(id, std::move(e));
+            count++;
+        }
+
+        fs::remove(file.path());
+    }
+
+    if (count)
+    {
+        lg2::info("Migrated {COUNT} error entries into the entry journal",
+                  "COUNT", count);
+    }
+
+    return count;
+}
+
+void EntryJournal::add(const Entry& e)
+{
+    std::ostringstream os;
+    serialize(e, os);
+    auto& records = _records[e.id()];
+    records = Records{os.str(), {}};
+
+    append(RecordType::entry, e.id(), records.entry);
+}
+
+void EntryJournal::add(std::span<const std::unique_ptr<Entry>> entries)
+{
+    std::string data;
+
+    for (const auto& e : entries)
+    {
+        std::ostringstream os;
+        serialize(*e, os);
+        auto& records = _records[e->id()];
+        records = Records{os.str(), {}};
+
+        data += makeRecord(RecordType::entry, e->id(), records.entry);
+    }
+
+    if (!entries.empty())
+    {
+        appendRecords(data, entries.size());
+    }
+}
+
+void EntryJournal::update(const Entry& e)
+{
+    auto payload = serializeDelta(e);
+
+    auto it = _records.find(e.id());
+    if (it != _records.end())
+    {
+        it->second.delta = payload;
+    }
+
+    append(RecordType::delta, e.id(), payload);
+}
+
+void EntryJournal::remove(uint32_t id)
+{
+    _records.erase(id);
+    append(RecordType::remove, id, {});
+}
+
+void EntryJournal::remove(const std::set<uint32_t>& ids)
+{
+    std::string data;
+
+    for (auto id : ids)
+    {
+        _records.erase(id);
+        data += makeRecord(RecordType::remove, id, {});
+    }
+
+    if (!ids.empty())
+    {
+        appendRecords(data, ids.size());
+    }
+}
+
+void EntryJournal::append(RecordType type, uint32_t id,
+                          const std::string& payload)
+{
+    appendRecords(makeRecord(type, id, payload), 1);
+}
+
+void EntryJournal::appendRecords(const std::string& data, size_t count)
+{
+    if (!_loaded)
+    {
+        load();
+    }
+
+    if ((_fd >= 0) && (_segmentBytes >= _segmentSize))
+    {
+        closeSegment();
+        _segments.push_back(_segments.back() + 1);
+    }
+
+    if (_fd < 0)
+    {
+        openSegment();
+    }
+
+    try
+    {
+        writeAll(_fd, data);
+    }
+    catch (const std::system_error&)
+    {
+        // Cut off a partly written record, as restore() would drop
+        // every record after it in the segment.  If that fails too,
+        // later records go into a new segment instead.
+        if (ftruncate(_fd, _segmentBytes) != 0)
+        {
+            closeSegment();
+            _segments.push_back(_segments.back() + 1);
+        }
+        throw;
+    }
+
+    _segmentBytes += data.size();
+    _recordCount += count;
+
+    // The in memory records are already up to date, so a compaction
+    // here includes this change.
+    if (_recordCount > (2 * _records.size()) + compactSlack)
+    {
+        compact();
+    }
+}
+
+void EntryJournal::openSegment()
+{
+    if (_segments.empty())
+    {
+        _segments.push_back(1);
+    }
+
+    auto path = segmentPath(_segments.back());
+    _fd = open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (_fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed opening " + path.string());
+    }
+
+    struct stat st{};
+    _segmentBytes = (fstat(_fd, &st) == 0) ? st.st_size : 0;
+}
+
+void EntryJournal::closeSegment()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+        _segmentBytes = 0;
+    }
+}
+
+void EntryJournal::compact()
+{
+    if (!_loaded)
+    {
+        load();
+    }
+
+    closeSegment();
+
+    auto newSeq = _segments.empty() ? 1 : _segments.back() + 1;
+    auto tempPath = _dir / compactTempName;
+
+    int fd = open(tempPath.c_str(),
+                  O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed opening " + tempPath.string());
+    }
+
+    std::string data = makeRecord(RecordType::checkpoint, 0, {});
+    size_t count = 1;
+
+    for (const auto& [id, records] : _records)
+    {
+        data += makeRecord(RecordType::entry, id, records.entry);
+        count++;
+
+        if (!records.delta.empty())
+        {
+            data += makeRecord(RecordType::delta, id, records.delta);
+            count++;
+        }
+    }
+
+    try
+    {
+        writeAll(fd, data);
+        if (fsync(fd) != 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed syncing entry journal");
+        }
+    }
+    catch (...)
+    {
+        close(fd);
+        fs::remove(tempPath);
+        throw;
+    }
+    close(fd);
+
+    fs::rename(tempPath, segmentPath(newSeq));
+    syncDirectory(_dir);
+
+    // With the checkpoint durable the old segments are no longer needed.
+    for (auto seq : _segments)
+    {
+        fs::remove(segmentPath(seq));
+    }
+
+    _segments.assign(1, newSeq);
+    _recordCount = count;
+    _compactions++;
+}
+
+EntryJournal::Stats EntryJournal::getStats() const
+{
+    return Stats{_segments.size(), _records.size(), _recordCount,
+                 _compactions};
+}
+
+} // namespace logging
+} // namespace phosphor
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "elog_entry.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace phosphor
+{
+namespace logging
+{
+
+namespace fs = std::filesystem;
+
+/** @class EntryJournal
+ *  @brief A segmented, append-only store for error entries.
+ *  @details Instead of rewriting a file per entry on every change, each
+ *           create, property update, and delete appends one record to
+ *           the active segment file.  A new segment is started once the
+ *           active one reaches the segment size.  When the number of
+ *           superseded records grows past the number of live entries,
+ *           the live entries are written to a new checkpoint segment and
+ *           the older segments are removed.
+ *
+ *           On restore the segments are replayed in order.  A record
+ *           that fails its checksum, for example one torn by a power
+ *           loss, ends the replay of its segment.
+ */
+class EntryJournal
+{
+  public:
+    /** @brief Creates the Entry object for an entry ID being restored */
+    using EntryFactory = std::function<std::unique_ptr<Entry>(uint32_t)>;
+
+    /** @brief The record types */
+    enum class RecordType : uint8_t
+    {
+        /** All properties of an entry */
+        entry = 1,
+        /** The properties of an entry that can change after creation */
+        delta = 2,
+        /** The entry was deleted */
+        remove = 3,
+        /** Discard everything in earlier segments */
+        checkpoint = 4
+    };
+
+    /** @brief Statistics on the journal contents */
+    struct Stats
+    {
+        size_t segments = 0;
+        size_t liveEntries = 0;
+        size_t records = 0;
+        size_t compactions = 0;
+    };
+
+    EntryJournal() = delete;
+    EntryJournal(const EntryJournal&) = delete;
+    EntryJournal& operator=(const EntryJournal&) = delete;
+    EntryJournal(EntryJournal&&) = delete;
+    EntryJournal& operator=(EntryJournal&&) = delete;
+    ~EntryJournal();
+
+    /** @brief Constructor
+     *
+     *  No file I/O is done until the journal is restored or written to.
+     *
+     *  @param[in] dir - The directory to store the segment files in
+     *  @param[in] segmentSize - The size a segment can grow to before
+     *                           a new one is started
+     */
+    explicit EntryJournal(const fs::path& dir,
+                          size_t segmentSize = defaultSegmentSize);
+
+    /** @brief Appends a record containing every property of an entry.
+     *         Used when an entry is created.
+     *
+     *  @param[in] e - The entry
+     */
+    void add(const Entry& e);
+
+    /** @brief Appends a record for each of the entries, with a single
+     *         write.  Used when a batch of entries is created.
+     *
+     *  @param[in] entries - The entries
+     */
+    void add(std::span<const std::unique_ptr<Entry>> entries);
+
+    /** @brief Appends a record containing the properties of an entry
+     *         that can change after it was created.
+     *
+     *  @param[in] e - The entry
+     */
+    void update(const Entry& e);
+
+    /** @brief Appends a record noting an entry was deleted
+     *
+     *  @param[in] id - The entry ID
+     */
+    void remove(uint32_t id);
+
+    /** @brief Appends a record for each of the entries deleted, with a
+     *         single write.  Used when all entries are deleted.
+     *
+     *  @param[in] ids - The entry IDs
+     */
+    void remove(const std::set<uint32_t>& ids);
+
+    /** @brief Replays the journal and creates the live entries.
+     *
+     *  @param[in] makeEntry - Creates the Entry object for an ID, which
+     *                         is then filled in from the journal.
+     *
+     *  @return The restored entries, keyed by entry ID
+     */
+    std::map<uint32_t, std::unique_ptr<Entry>>
+        restore(const EntryFactory& makeEntry);
+
+    /** @brief Moves entries stored one file per entry into the journal.
+     *
+     *  Every file named with an entry ID that isn't already in the
+     *  journal is deserialized, added to the journal, and then deleted.
+     *
+     *  @param[in] fileDir - The directory of per entry files
+     *  @param[in] makeEntry - Creates the Entry object for an ID
+     *  @param[in,out] entries - The restored entries to add to
+     *
+     *  @return The number of entries migrated
+     */
+    size_t migrate(const fs::path& fileDir, const EntryFactory& makeEntry,
+                   std::map<uint32_t, std::unique_ptr<Entry>>& entries);
+
+    /** @brief Rewrites the live entries into a new checkpoint segment
+     *         and removes all previous segments.
+     */
+    void compact();
+
+    /** @brief Returns statistics on the journal contents
+     */
+    Stats getStats() const;
+
+    /** @brief The default segment size */
+    static constexpr size_t defaultSegmentSize = 256 * 1024;
+
+  private:
+    /** @brief The latest records for a live entry */
+    struct Records
+    {
+        std::string entry;
+        std::string delta;
+    };
+
+    /** @brief Returns the path of a segment file
+     *
+     *  @param[in] seq - The segment sequence number
+     */
+    fs::path segmentPath(uint32_t seq) const;
+
+    /** @brief Reads the segment files into _records, dropping any
+     *         segments made obsolete by a checkpoint.
+     */
+    void load();
+
+    /** @brief Replays one segment file into _records
+     *
+     *  @param[in] path - The segment path
+     *  @param[out] checkpoint - Set to index if the segment contains a
+     *                           checkpoint record
+     *  @param[in] index - The segment's index in _segments
+     *
+     *  @return The offset just past the last good record
+     */
+    size_t replay(const fs::path& path, size_t& checkpoint, size_t index);
+
+    /** @brief Appends a record to the active segment, starting a new
+     *         segment first if needed, and then compacts if there are
+     *         enough superseded records.
+     *
+     *  @param[in] type - The record type
+     *  @param[in] id - The entry ID
+     *  @param[in] payload - The record data
+     */
+    void append(RecordType type, uint32_t id, const std::string& payload);
+
+    /** @brief Appends records to the active segment with one write, the
+     *         same as append() does for one record.
+     *
+     *  @param[in] data - The records
+     *  @param[in] count - The number of records
+     */
+    void appendRecords(const std::string& data, size_t count);
+
+    /** @brief Opens the active segment for appending */
+    void openSegment();
+
+    /** @brief Closes the active segment */
+    void closeSegment();
+
+    /** @brief Directory holding the segment files */
+    const fs::path _dir;
+
+    /** @brief Max size of a segment before starting another */
+    const size_t _segmentSize;
+
+    /** @brief The latest records of each live entry */
+    std::map<uint32_t, Records> _records;
+
+    /** @brief Sequence numbers of the segments on disk */
+    std::vector<uint32_t> _segments;
+
+    /** @brief The descriptor of the active segment, or -1 */
+    int _fd = -1;
+
+    /** @brief The current size of the active segment */
+    size_t _segmentBytes = 0;
+
+    /** @brief The number of records in all segments */
+    size_t _recordCount = 0;
+
+    /** @brief The number of compactions done */
+    size_t _compactions = 0;
+
+    /** @brief If the segment files have been read */
+    bool _loaded = false;
+};
+
+} // namespace logging
+} // namespace phosphor
@@ -24,17 +24,11 @@ void build<xyz::openbmc_project::common::callout::Device::CALLOUT_DEVICE_PATH>(
     auto iter = metadata.find(match);
     if (metadata.end() != iter)
     {
-        auto comp = [](const auto& first, const auto& second) {
-            return (std::strcmp(std::get<0>(first), second) < 0);
-        };
-        auto callout = std::lower_bound(callouts.begin(), callouts.end(),
-                                        (iter->second).c_str(), comp);
-        if ((callouts.end() != callout) &&
-            !std::strcmp((iter->second).c_str(), std::get<0>(*callout)))
+        if (const auto* callout = callouts.find(iter->second))
         {
             list.emplace_back(std::make_tuple(
                 CALLOUT_FWD_ASSOCIATION, CALLOUT_REV_ASSOCIATION,
-                std::string(INVENTORY_ROOT) + std::get<1>(*callout)));
+                std::string(INVENTORY_ROOT).append(*callout)));
         }
     }
 }
@@ -8,8 +8,6 @@
 
 #include <phosphor-logging/elog-errors.hpp>
 
-#include <algorithm>
-#include <cstring>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -59,18 +57,12 @@ inline void build<example::xyz::openbmc_project::example::device::Callout::
     auto iter = metadata.find(match);
     if (metadata.end() != iter)
     {
-        auto comp = [](const auto& first, const auto& second) {
-            return (std::strcmp(std::get<0>(first), second) < 0);
-        };
-        auto callout = std::lower_bound(callouts.begin(), callouts.end(),
-                                        (iter->second).c_str(), comp);
-        if ((callouts.end() != callout) &&
-            !std::strcmp((iter->second).c_str(), std::get<0>(*callout)))
+        if (const auto* callout = callouts.find(iter->second))
         {
             constexpr auto ROOT = "/xyz/openbmc_project/inventory";
 
-            list.push_back(std::make_tuple(
-                "callout", "fault", std::string(ROOT) + std::get<1>(*callout)));
+            list.push_back(std::make_tuple("callout", "fault",
+                                           std::string(ROOT).append(*callout)));
         }
     }
 }
@@ -145,6 +145,12 @@ fs::path serialize(const Entry& e, const fs::path& dir)
     return path;
 }
 
+void serialize(const Entry& e, std::ostream& os)
+{
+    cereal::BinaryOutputArchive oarchive(os);
+    oarchive(e);
+}
+
 bool deserialize(const fs::path& path, Entry& e)
 {
     try
@@ -169,5 +175,11 @@ bool deserialize(const fs::path& path, Entry& e)
     }
 }
 
+void deserialize(std::istream& is, Entry& e)
+{
+    cereal::BinaryInputArchive iarchive(is);
+    iarchive(e);
+}
+
 } // namespace logging
 } // namespace phosphor
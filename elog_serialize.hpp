@@ -6,6 +6,7 @@
 #include "paths.hpp"
 
 #include <filesystem>
+#include <iostream>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,12 @@ namespace fs = std::filesystem;
 fs::path serialize(const Entry& e,
                    const fs::path& dir = fs::path(paths::error()));
 
+/** @brief Serialize an error d-bus object into a stream
+ *  @param[in] e - const reference to error entry.
+ *  @param[in] os - the stream to write to.
+ */
+void serialize(const Entry& e, std::ostream& os);
+
 /** @brief Deserialze a persisted error into a d-bus object
  *  @param[in] path - pathname of persisted error file
  *  @param[in] e - reference to error object which is the target of
@@ -33,6 +40,14 @@ fs::path serialize(const Entry& e,
  */
 bool deserialize(const fs::path& path, Entry& e);
 
+/** @brief Deserialze an error from a stream into a d-bus object
+ *  @param[in] is - the stream to read from.
+ *  @param[in] e - reference to error object which is the target of
+ *             deserialization.
+ *  @throws cereal::Exception if the data is invalid.
+ */
+void deserialize(std::istream& is, Entry& e);
+
 /** @brief Return the path to serialize a log entry to
  *  @param[in] id - log entry ID
  *  @param[in] dir - pathname of directory where the serialized error will
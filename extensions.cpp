@@ -23,6 +23,12 @@ DeleteFunctions& Extensions::getDeleteFunctions()
     return deleteFunctions;
 }
 
+DeleteAllFunctions& Extensions::getDeleteAllFunctions()
+{
+    static DeleteAllFunctions deleteAllFunctions{};
+    return deleteAllFunctions;
+}
+
 DeleteProhibitedFunctions& Extensions::getDeleteProhibitedFunctions()
 {
     static DeleteProhibitedFunctions deleteProhibitedFunctions{};
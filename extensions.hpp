@@ -4,6 +4,7 @@
 #include "log_manager.hpp"
 
 #include <functional>
+#include <set>
 #include <vector>
 
 namespace phosphor
@@ -42,6 +43,26 @@ using CreateFunction = std::function<void(
  */
 using DeleteFunction = std::function<void(uint32_t)>;
 
+/**
+ * @brief The function type that will be called after event logs are
+ *        deleted together, such as by DeleteAll.
+ * @param[in] const std::set<uint32_t>& - The IDs of the event logs deleted
+ */
+using DeleteAllFunction = std::function<void(const std::set<uint32_t>&)>;
+
+/**
+ * @brief The delete functions of an extension that handles event logs
+ *        deleted together itself.  When several logs are deleted at once,
+ *        the DeleteAllFunction is called once with all of the IDs instead of
+ *        calling the DeleteFunction for each log.  This only affects the
+ *        extension that registered them.
+ */
+struct DeleteFunctionPair
+{
+    DeleteFunction remove;
+    DeleteAllFunction removeAll;
+};
+
 /**
  * @brief The function type that will to check if an event log is prohibited
  *        from being deleted.
@@ -67,6 +88,7 @@ using LogIDsWithHwIsolationFunctions =
 using StartupFunctions = std::vector<StartupFunction>;
 using CreateFunctions = std::vector<CreateFunction>;
 using DeleteFunctions = std::vector<DeleteFunction>;
+using DeleteAllFunctions = std::vector<DeleteFunctionPair>;
 using DeleteProhibitedFunctions = std::vector<DeleteProhibitedFunction>;
 
 /**
@@ -81,6 +103,19 @@ using DeleteProhibitedFunctions = std::vector<DeleteProhibitedFunction>;
         Extensions e{func};                                                    \
     }
 
+/**
+ * @brief Register an extension's delete and delete all functions together
+ *
+ * Call this macro at global scope instead of REGISTER_EXTENSION_FUNCTION
+ * for the delete function of an extension that also handles event logs
+ * deleted together.
+ */
+#define REGISTER_EXTENSION_DELETE_FUNCTIONS(func, allFunc)                     \
+    namespace func##_ns                                                        \
+    {                                                                          \
+        Extensions e{func, allFunc};                                           \
+    }
+
 /**
  * @brief Disable default error log capping
  *
@@ -158,6 +193,22 @@ class Extensions
         getDeleteFunctions().push_back(func);
     }
 
+    /**
+     * @brief Constructor to register a delete and a delete all function
+     *
+     * The delete all function will be called once after
+     * phosphor-log-manager deletes several event logs together, and the
+     * delete function after it deletes one.
+     *
+     * @param[in] func - The delete function to register
+     * @param[in] allFunc - The delete all function to register
+     */
+    Extensions(DeleteFunction func, DeleteAllFunction allFunc)
+    {
+        getDeleteAllFunctions().emplace_back(std::move(func),
+                                             std::move(allFunc));
+    }
+
     /**
      * @brief Constructor to register a delete prohibition function
      *
@@ -217,6 +268,12 @@ class Extensions
      */
     static DeleteFunctions& getDeleteFunctions();
 
+    /**
+     * @brief Returns the delete and DeleteAll functions registered together
+     * @return DeleteAllFunctions - the delete and DeleteAll functions
+     */
+    static DeleteAllFunctions& getDeleteAllFunctions();
+
     /**
      * @brief Returns the DeleteProhibited functions
      * @return DeleteProhibitedFunctions - the DeleteProhibited functions
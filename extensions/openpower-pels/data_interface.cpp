@@ -86,6 +86,8 @@ constexpr auto chassisState = "xyz.openbmc_project.State.Chassis";
 constexpr auto hostState = "xyz.openbmc_project.State.Host";
 constexpr auto viniRecordVPD = "com.ibm.ipzvpd.VINI";
 constexpr auto vsbpRecordVPD = "com.ibm.ipzvpd.VSBP";
+constexpr auto vcenRecordVPD = "com.ibm.ipzvpd.VCEN";
+constexpr auto vsysRecordVPD = "com.ibm.ipzvpd.VSYS";
 constexpr auto locCode = "xyz.openbmc_project.Inventory.Decorator.LocationCode";
 constexpr auto compatible =
     "xyz.openbmc_project.Inventory.Decorator.Compatible";
@@ -230,6 +232,9 @@ DataInterface::DataInterface(sdbusplus::bus_t& bus) :
             }
         }));
 
+    watchInventoryCache();
+    watchHwIsolation();
+
     if (isPHALDevTreeExist())
     {
 #ifdef PEL_ENABLE_PHAL
@@ -289,6 +294,23 @@ DBusPathList DataInterface::getPaths(const DBusInterfaceList& interfaces) const
     return paths;
 }
 
+DBusSubTree DataInterface::getSubTree(const std::string& root,
+                                      const DBusInterfaceList& interfaces) const
+{
+    auto method = _bus.new_method_call(service_name::objectMapper,
+                                       object_path::objectMapper,
+                                       interface::objectMapper, "GetSubTree");
+
+    method.append(root, 0, interfaces);
+
+    auto reply = _bus.call(method, dbusTimeout);
+
+    DBusSubTree subtree;
+    reply.read(subtree);
+
+    return subtree;
+}
+
 DBusService DataInterface::getService(const std::string& objectPath,
                                       const std::string& interface) const
 {
@@ -450,31 +472,42 @@ void DataInterface::getHWCalloutFields(
     // will provide this info.  Any missing interfaces will result
     // in exceptions being thrown.
 
-    auto service = getService(inventoryPath, interface::viniRecordVPD);
+    auto fields = _inventoryCache.getHWCalloutFields(inventoryPath, [&]() {
+        auto service = getService(inventoryPath, interface::viniRecordVPD);
+
+        auto properties =
+            getAllProperties(service, inventoryPath, interface::viniRecordVPD);
 
-    auto properties =
-        getAllProperties(service, inventoryPath, interface::viniRecordVPD);
+        InventoryCache::HWCalloutFields f;
+        auto value = std::get<std::vector<uint8_t>>(properties["FN"]);
+        f.fruPartNumber = std::string{value.begin(), value.end()};
 
-    auto value = std::get<std::vector<uint8_t>>(properties["FN"]);
-    fruPartNumber = std::string{value.begin(), value.end()};
+        value = std::get<std::vector<uint8_t>>(properties["CC"]);
+        f.ccin = std::string{value.begin(), value.end()};
 
-    value = std::get<std::vector<uint8_t>>(properties["CC"]);
-    ccin = std::string{value.begin(), value.end()};
+        value = std::get<std::vector<uint8_t>>(properties["SN"]);
+        f.serialNumber = std::string{value.begin(), value.end()};
 
-    value = std::get<std::vector<uint8_t>>(properties["SN"]);
-    serialNumber = std::string{value.begin(), value.end()};
+        return f;
+    });
+
+    fruPartNumber = std::move(fields.fruPartNumber);
+    ccin = std::move(fields.ccin);
+    serialNumber = std::move(fields.serialNumber);
 }
 
 std::string DataInterface::getLocationCode(
     const std::string& inventoryPath) const
 {
-    auto service = getService(inventoryPath, interface::locCode);
+    return _inventoryCache.getLocationCode(inventoryPath, [&]() {
+        auto service = getService(inventoryPath, interface::locCode);
 
-    DBusValue locCode;
-    getProperty(service, inventoryPath, interface::locCode, "LocationCode",
-                locCode);
+        DBusValue locCode;
+        getProperty(service, inventoryPath, interface::locCode, "LocationCode",
+                    locCode);
 
-    return std::get<std::string>(locCode);
+        return std::get<std::string>(locCode);
+    });
 }
 
 std::string DataInterface::addLocationCodePrefix(
@@ -495,68 +528,79 @@ std::string DataInterface::addLocationCodePrefix(
 std::string DataInterface::expandLocationCode(const std::string& locationCode,
                                               uint16_t /*node*/) const
 {
-    // Location codes for connectors are the location code of the FRU they are
-    // on, plus a '-Tx' segment.  Remove this last segment before expanding it
-    // and then add it back in afterwards.  This way, the connector doesn't have
-    // to be in the model just so that it can be expanded.
-    auto [baseLoc, connectorLoc] = extractConnectorFromLocCode(locationCode);
+    return _inventoryCache.getExpandedLocationCode(locationCode, [&]() {
+        // Location codes for connectors are the location code of the FRU
+        // they are on, plus a '-Tx' segment.  Remove this last segment
+        // before expanding it and then add it back in afterwards.  This
+        // way, the connector doesn't have to be in the model just so that
+        // it can be expanded.
+        auto [baseLoc, connectorLoc] =
+            extractConnectorFromLocCode(locationCode);
 
-    auto method =
-        _bus.new_method_call(service_name::vpdManager, object_path::vpdManager,
-                             interface::vpdManager, "GetExpandedLocationCode");
+        auto method = _bus.new_method_call(
+            service_name::vpdManager, object_path::vpdManager,
+            interface::vpdManager, "GetExpandedLocationCode");
 
-    method.append(addLocationCodePrefix(baseLoc), static_cast<uint16_t>(0));
+        method.append(addLocationCodePrefix(baseLoc),
+                      static_cast<uint16_t>(0));
 
-    auto reply = _bus.call(method, dbusTimeout);
+        auto reply = _bus.call(method, dbusTimeout);
 
-    std::string expandedLocationCode;
-    reply.read(expandedLocationCode);
+        std::string expandedLocationCode;
+        reply.read(expandedLocationCode);
 
-    if (!connectorLoc.empty())
-    {
-        expandedLocationCode += connectorLoc;
-    }
+        if (!connectorLoc.empty())
+        {
+            expandedLocationCode += connectorLoc;
+        }
 
-    return expandedLocationCode;
+        return expandedLocationCode;
+    });
 }
 
 std::vector<std::string> DataInterface::getInventoryFromLocCode(
     const std::string& locationCode, uint16_t node, bool expanded) const
 {
-    std::string methodName = expanded ? "GetFRUsByExpandedLocationCode"
-                                      : "GetFRUsByUnexpandedLocationCode";
-
-    // Remove the connector segment, if present, so that this method call
-    // returns an inventory path that getHWCalloutFields() can be used with.
-    // (The serial number, etc, aren't stored on the connector in the
-    // inventory, and may not even be modeled.)
-    auto [baseLoc, connectorLoc] = extractConnectorFromLocCode(locationCode);
-
-    auto method =
-        _bus.new_method_call(service_name::vpdManager, object_path::vpdManager,
-                             interface::vpdManager, methodName.c_str());
-
-    if (expanded)
-    {
-        method.append(baseLoc);
-    }
-    else
-    {
-        method.append(addLocationCodePrefix(baseLoc), node);
-    }
+    return _inventoryCache.getInventoryFromLocCode(
+        locationCode, node, expanded, [&]() {
+            std::string methodName = expanded
+                                         ? "GetFRUsByExpandedLocationCode"
+                                         : "GetFRUsByUnexpandedLocationCode";
+
+            // Remove the connector segment, if present, so that this method
+            // call returns an inventory path that getHWCalloutFields() can
+            // be used with.  (The serial number, etc, aren't stored on the
+            // connector in the inventory, and may not even be modeled.)
+            auto [baseLoc, connectorLoc] =
+                extractConnectorFromLocCode(locationCode);
+
+            auto method = _bus.new_method_call(
+                service_name::vpdManager, object_path::vpdManager,
+                interface::vpdManager, methodName.c_str());
+
+            if (expanded)
+            {
+                method.append(baseLoc);
+            }
+            else
+            {
+                method.append(addLocationCodePrefix(baseLoc), node);
+            }
 
-    auto reply = _bus.call(method, dbusTimeout);
+            auto reply = _bus.call(method, dbusTimeout);
 
-    std::vector<sdbusplus::message::object_path> entries;
-    reply.read(entries);
+            std::vector<sdbusplus::message::object_path> entries;
+            reply.read(entries);
 
-    std::vector<std::string> paths;
+            std::vector<std::string> paths;
 
-    // Note: The D-Bus method will fail if nothing found.
-    std::for_each(entries.begin(), entries.end(),
-                  [&paths](const auto& path) { paths.push_back(path); });
+            // Note: The D-Bus method will fail if nothing found.
+            std::for_each(
+                entries.begin(), entries.end(),
+                [&paths](const auto& path) { paths.push_back(path); });
 
-    return paths;
+            return paths;
+        });
 }
 
 void DataInterface::assertLEDGroup(const std::string& ledGroup,
@@ -717,18 +761,47 @@ void DataInterface::createProgressSRC(
     _bus.call(method, dbusTimeout);
 }
 
-std::vector<uint32_t> DataInterface::getLogIDWithHwIsolation() const
+std::vector<uint32_t> DataInterface::readLogIDsWithHwIsolation() const
 {
-    std::vector<std::string> association = {"xyz.openbmc_project.Association"};
     std::string hwErrorLog = "/isolated_hw_errorlog";
     std::string errorLog = "/error_log";
-    DBusPathList paths;
     std::vector<uint32_t> ids;
 
-    // Get all latest mapper associations
-    paths = getPaths(association);
-    for (auto& path : paths)
+    // Get all latest mapper associations, and all isolation entries,
+    // along with their services so they don't have to be looked up
+    // one path at a time.  The entries are searched for from "/" too,
+    // since the mapper fails a GetSubTree on a root path that doesn't
+    // exist, as the hardware isolation tree doesn't on some systems.
+    auto associations = getSubTree("/", {interface::association});
+    auto entries = getSubTree("/", {interface::hwIsolationEntry});
+
+    auto addLogID = [this, &ids](const std::string& path,
+                                 const std::string& service) {
+        DBusValue endpoints;
+
+        // Read Endpoints property
+        getProperty(service, path, interface::association, "endpoints",
+                    endpoints);
+
+        auto logPath = std::get<std::vector<std::string>>(endpoints);
+        if (!logPath.empty())
+        {
+            // Get OpenBMC event log Id
+            uint32_t id =
+                stoi(logPath[0].substr(logPath[0].find_last_of('/') + 1));
+            ids.push_back(id);
+        }
+    };
+
+    for (const auto& [path, services] : associations)
     {
+        if (services.empty())
+        {
+            continue;
+        }
+
+        const auto& assocService = services.begin()->first;
+
         // Look for object path with hardware isolation entry if any
         size_t pos = path.find(hwErrorLog);
         if (pos != std::string::npos)
@@ -736,77 +809,105 @@ std::vector<uint32_t> DataInterface::getLogIDWithHwIsolation() const
             // Get the object path
             std::string ph = path;
             ph.erase(pos, hwErrorLog.length());
-            auto service = getService(ph, interface::hwIsolationEntry);
-            if (!service.empty())
+
+            auto entry = entries.find(ph);
+            if ((entry != entries.end()) && !entry->second.empty())
             {
-                bool status;
                 DBusValue value;
 
                 // Read the Resolved property from object path
-                getProperty(service, ph, interface::hwIsolationEntry,
-                            "Resolved", value);
-
-                status = std::get<bool>(value);
+                getProperty(entry->second.begin()->first, ph,
+                            interface::hwIsolationEntry, "Resolved", value);
 
                 // If the entry isn't resolved
-                if (!status)
+                if (!std::get<bool>(value))
                 {
-                    auto assocService =
-                        getService(path, interface::association);
-                    if (!assocService.empty())
-                    {
-                        DBusValue endpoints;
-
-                        // Read Endpoints property
-                        getProperty(assocService, path, interface::association,
-                                    "endpoints", endpoints);
-
-                        auto logPath =
-                            std::get<std::vector<std::string>>(endpoints);
-                        if (!logPath.empty())
-                        {
-                            // Get OpenBMC event log Id
-                            uint32_t id = stoi(logPath[0].substr(
-                                logPath[0].find_last_of('/') + 1));
-                            ids.push_back(id);
-                        }
-                    }
+                    addLogID(path, assocService);
                 }
             }
         }
 
         // Look for object path with error_log entry if any
-        pos = path.find(errorLog);
-        if (pos != std::string::npos)
+        if (path.find(errorLog) != std::string::npos)
         {
-            auto service = getService(path, interface::association);
-            if (!service.empty())
-            {
-                DBusValue value;
+            addLogID(path, assocService);
+        }
+    }
 
-                // Read Endpoints property
-                getProperty(service, path, interface::association, "endpoints",
-                            value);
+    // remove duplicates to have only unique ids
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
 
-                auto logPath = std::get<std::vector<std::string>>(value);
-                if (!logPath.empty())
-                {
-                    // Get OpenBMC event log Id
-                    uint32_t id = stoi(
-                        logPath[0].substr(logPath[0].find_last_of('/') + 1));
-                    ids.push_back(id);
-                }
-            }
+    return ids;
+}
+
+bool DataInterface::affectsHwIsolation(const std::string& path)
+{
+    return path.starts_with(object_path::hwIsolation) ||
+           (path.find("/isolated_hw_errorlog") != std::string::npos) ||
+           (path.find("/error_log") != std::string::npos);
+}
+
+void DataInterface::watchHwIsolation()
+{
+    // The object path is the first thing in InterfacesAdded and
+    // InterfacesRemoved.
+    auto ifacesChanged = [this](auto& msg) {
+        sdbusplus::message::object_path path;
+        msg.read(path);
+
+        if (affectsHwIsolation(path.str))
+        {
+            hwIsolationChanged();
         }
+    };
+
+    // Isolation entries coming and going, which are always under the
+    // hardware isolation tree.
+    std::string isolationTree = std::string{object_path::hwIsolation} + '/';
+
+    for (const auto& rule :
+         {match_rules::interfacesAdded(), match_rules::interfacesRemoved()})
+    {
+        _hwIsolationMatches.emplace_back(
+            _bus,
+            rule + match_rules::sender(service_name::hwIsolation) +
+                match_rules::argNpath(0, isolationTree),
+            [this](auto&) { hwIsolationChanged(); });
     }
 
-    if (ids.size() > 1)
+    // The mapper's association objects coming and going.  Those are
+    // where the object they belong to is, which for error_log can be
+    // outside of the isolation tree, so only the sender can be matched.
+    for (const auto& rule :
+         {match_rules::interfacesAdded(), match_rules::interfacesRemoved()})
     {
-        // remove duplicates to have only unique ids
-        std::sort(ids.begin(), ids.end());
-        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        _hwIsolationMatches.emplace_back(
+            _bus, rule + match_rules::sender(service_name::objectMapper),
+            ifacesChanged);
     }
-    return ids;
+
+    // An entry being resolved or unresolved
+    _hwIsolationMatches.emplace_back(
+        _bus,
+        match_rules::propertiesChangedNamespace(object_path::hwIsolation,
+                                                interface::hwIsolationEntry) +
+            match_rules::sender(service_name::hwIsolation),
+        [this](auto&) { hwIsolationChanged(); });
+
+    // The endpoints of an association changing
+    _hwIsolationMatches.emplace_back(
+        _bus,
+        match_rules::type::signal() + match_rules::member("PropertiesChanged") +
+            match_rules::interface(interface::dbusProperty) +
+            match_rules::argN(0, interface::association) +
+            match_rules::sender(service_name::objectMapper),
+        [this](auto& msg) {
+            if (affectsHwIsolation(msg.get_path()))
+            {
+                hwIsolationChanged();
+            }
+        });
 }
 
 std::vector<uint8_t> DataInterface::getRawProgressSRC(void) const
@@ -973,6 +1074,54 @@ void DataInterface::addHotplugWatch(const std::string& path)
     }
 }
 
+void DataInterface::watchInventoryCache()
+{
+    auto ifacesChanged = std::bind(&DataInterface::inventoryCacheIfacesChanged,
+                                   this, std::placeholders::_1);
+
+    _inventoryCacheMatches.emplace_back(
+        _bus, match_rules::interfacesAdded(object_path::baseInv),
+        ifacesChanged);
+
+    _inventoryCacheMatches.emplace_back(
+        _bus, match_rules::interfacesRemoved(object_path::baseInv),
+        ifacesChanged);
+
+    _inventoryCacheMatches.emplace_back(
+        _bus,
+        match_rules::propertiesChangedNamespace(object_path::baseInv,
+                                                interface::viniRecordVPD),
+        [this](auto& msg) { _inventoryCache.invalidateVPD(msg.get_path()); });
+
+    _inventoryCacheMatches.emplace_back(
+        _bus,
+        match_rules::propertiesChangedNamespace(object_path::baseInv,
+                                                interface::locCode),
+        [this](auto& msg) {
+            _inventoryCache.invalidateLocationCode(msg.get_path());
+        });
+
+    // Location codes are expanded using the system VPD.
+    for (const auto& iface :
+         {interface::vcenRecordVPD, interface::vsysRecordVPD})
+    {
+        _inventoryCacheMatches.emplace_back(
+            _bus,
+            match_rules::propertiesChangedNamespace(object_path::baseInv,
+                                                    iface),
+            [this](auto&) { _inventoryCache.invalidateSystemVPD(); });
+    }
+}
+
+void DataInterface::inventoryCacheIfacesChanged(sdbusplus::message_t& msg)
+{
+    // Only the path is needed, and it comes first in both signals.
+    sdbusplus::message::object_path path;
+    msg.read(path);
+
+    _inventoryCache.invalidate(path.str);
+}
+
 void DataInterface::inventoryIfaceAdded(sdbusplus::message_t& msg)
 {
     sdbusplus::message::object_path path;
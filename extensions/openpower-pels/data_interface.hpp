@@ -2,6 +2,7 @@
 
 #include "dbus_types.hpp"
 #include "dbus_watcher.hpp"
+#include "inventory_cache.hpp"
 
 #ifdef PEL_ENABLE_PHAL
 #include <libguard/guard_interface.hpp>
@@ -15,6 +16,7 @@
 #include <expected>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <unordered_map>
 
 #ifdef PEL_ENABLE_PHAL
@@ -480,9 +482,20 @@ class DataInterfaceBase
      * @brief Get the list of unresolved OpenBMC event log ids that have an
      * associated hardware isolation entry.
      *
+     * The list is only read again, with readLogIDsWithHwIsolation(), after
+     * hwIsolationChanged() is called.
+     *
      * @return std::vector<uint32_t> - The list of log ids
      */
-    virtual std::vector<uint32_t> getLogIDWithHwIsolation() const = 0;
+    std::vector<uint32_t> getLogIDWithHwIsolation() const
+    {
+        if (!_hwIsolationLogIDs)
+        {
+            _hwIsolationLogIDs = readLogIDsWithHwIsolation();
+        }
+
+        return *_hwIsolationLogIDs;
+    }
 
     /**
      * @brief Returns the latest raw progress SRC from the State.Boot.Raw
@@ -558,6 +571,23 @@ class DataInterfaceBase
         const DBusInterfaceList& interfaces) const = 0;
 
   protected:
+    /**
+     * @brief Reads the unresolved OpenBMC event log ids that have an
+     *        associated hardware isolation entry.
+     *
+     * @return std::vector<uint32_t> - The sorted list of log ids
+     */
+    virtual std::vector<uint32_t> readLogIDsWithHwIsolation() const = 0;
+
+    /**
+     * @brief Clears the log ids saved by getLogIDWithHwIsolation(),
+     *        when an isolation entry or its associations changed.
+     */
+    void hwIsolationChanged()
+    {
+        _hwIsolationLogIDs.reset();
+    }
+
     /**
      * @brief Sets the host on/off state and runs any
      *        callback functions (if there was a change).
@@ -625,6 +655,12 @@ class DataInterfaceBase
      */
     std::map<std::string, FRUPresentFunc> _fruPresentCallbacks;
 
+    /**
+     * @brief The log ids returned by getLogIDWithHwIsolation(), or empty
+     *        if they need to be read again.
+     */
+    mutable std::optional<std::vector<uint32_t>> _hwIsolationLogIDs;
+
     /**
      * @brief The BMC firmware version string
      */
@@ -835,6 +871,18 @@ class DataInterface : public DataInterfaceBase
         const std::string& locationCode, uint16_t node,
         bool expanded) const override;
 
+    /**
+     * @brief Returns the hit and miss counts of the cache used by
+     *        getLocationCode(), getHWCalloutFields(), expandLocationCode()
+     *        and getInventoryFromLocCode().
+     *
+     * @return const InventoryCache::Stats& - The counts
+     */
+    const InventoryCache::Stats& getInventoryCacheStats() const
+    {
+        return _inventoryCache.getStats();
+    }
+
     /**
      * @brief Sets the Asserted property on the LED group passed in.
      *
@@ -891,12 +939,16 @@ class DataInterface : public DataInterfaceBase
         const std::vector<uint8_t>& srcStruct) const override;
 
     /**
-     * @brief Get the list of unresolved OpenBMC event log ids that have an
-     * associated hardware isolation entry.
+     * @brief Says if a change to the object at the path can change the
+     *        log ids returned by getLogIDWithHwIsolation().
      *
-     * @return std::vector<uint32_t> - The list of log ids
+     * These are the hardware isolation entries and the isolated_hw_errorlog
+     * and error_log association objects.
+     *
+     * @param[in] path - The D-Bus object path
+     * @return bool - If it can change the log ids
      */
-    std::vector<uint32_t> getLogIDWithHwIsolation() const override;
+    static bool affectsHwIsolation(const std::string& path);
 
     /**
      * @brief Returns the latest raw progress SRC from the State.Boot.Raw
@@ -964,6 +1016,19 @@ class DataInterface : public DataInterfaceBase
      */
     DBusPathList getPaths(const DBusInterfaceList& interfaces) const;
 
+    /**
+     * @brief Finds all D-Bus paths under the root path that contain any
+     *        of the interfaces passed in, along with their services, by
+     *        using GetSubTree.
+     *
+     * @param[in] root - The path to search under
+     * @param[in] interfaces - The desired interfaces
+     *
+     * @return DBusSubTree - The paths, services, and interfaces
+     */
+    DBusSubTree getSubTree(const std::string& root,
+                           const DBusInterfaceList& interfaces) const;
+
     /**
      * @brief The interfacesAdded callback used on the inventory to
      *        find the D-Bus object that has the motherboard interface.
@@ -1045,6 +1110,33 @@ class DataInterface : public DataInterfaceBase
     void initPHAL();
 #endif // PEL_ENABLE_PHAL
 
+    /**
+     * @brief Adds the matches that keep _inventoryCache up to date.
+     */
+    void watchInventoryCache();
+
+    /**
+     * @brief Called when interfaces are added to or removed from an
+     *        inventory object, to remove it from _inventoryCache.
+     *
+     * @param[in] msg - The InterfacesAdded or InterfacesRemoved signal
+     */
+    void inventoryCacheIfacesChanged(sdbusplus::message_t& msg);
+
+    /**
+     * @brief Reads the unresolved OpenBMC event log ids that have an
+     *        associated hardware isolation entry from D-Bus.
+     *
+     * @return std::vector<uint32_t> - The sorted list of log ids
+     */
+    std::vector<uint32_t> readLogIDsWithHwIsolation() const override;
+
+    /**
+     * @brief Adds the matches that call hwIsolationChanged() when the
+     *        hardware isolation entries or their associations change.
+     */
+    void watchHwIsolation();
+
     /**
      * @brief A helper API to subscribe to systemd signals
      *
@@ -1081,6 +1173,22 @@ class DataInterface : public DataInterfaceBase
      */
     sdbusplus::bus_t& _bus;
 
+    /**
+     * @brief The inventory data used in hardware callouts, so it
+     *        doesn't have to be read from D-Bus every time.
+     */
+    mutable InventoryCache _inventoryCache;
+
+    /**
+     * @brief The matches that invalidate _inventoryCache entries.
+     */
+    std::vector<sdbusplus::bus::match_t> _inventoryCacheMatches;
+
+    /**
+     * @brief The matches that call hwIsolationChanged().
+     */
+    std::vector<sdbusplus::bus::match_t> _hwIsolationMatches;
+
     /**
      * @brief Watcher to check "openpower-update-bios-attr-table" service
      *        is "done" to init PHAL libraires
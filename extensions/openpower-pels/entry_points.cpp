@@ -78,7 +78,12 @@ void pelDelete(uint32_t id)
     return manager->erase(id);
 }
 
-REGISTER_EXTENSION_FUNCTION(pelDelete)
+void pelDeleteAll(const std::set<uint32_t>& ids)
+{
+    manager->erase(ids);
+}
+
+REGISTER_EXTENSION_DELETE_FUNCTIONS(pelDelete, pelDeleteAll)
 
 void pelDeleteProhibited(uint32_t id, bool& prohibited)
 {
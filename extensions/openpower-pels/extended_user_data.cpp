@@ -16,9 +16,7 @@
 #include "extended_user_data.hpp"
 
 #include "pel_types.hpp"
-#ifdef PELTOOL
 #include "user_data_json.hpp"
-#endif
 #include <phosphor-logging/lg2.hpp>
 
 #include <format>
@@ -96,15 +94,11 @@ void ExtendedUserData::validate()
 }
 
 std::optional<std::string> ExtendedUserData::getJSON(
-    uint8_t /*creatorID*/,
-    const std::vector<std::string>& plugins [[maybe_unused]]) const
+    uint8_t /*creatorID*/, const std::vector<std::string>& plugins) const
 {
     // Use the creator ID value from the section.
-#ifdef PELTOOL
     return user_data::getJSON(_header.componentID, _header.subType,
                               _header.version, _data, _creatorID, plugins);
-#endif
-    return std::nullopt;
 }
 
 bool ExtendedUserData::shrink(size_t newSize)
@@ -23,6 +23,39 @@ namespace openpower::pels
 const auto subscriptionName = "PELHostNotifier";
 const size_t maxRetryAttempts = 15;
 
+namespace
+{
+
+/**
+ * @brief Returns the send priority of a PEL severity, where 0 is sent
+ *        first.
+ *
+ * @param[in] severity - The PEL severity
+ *
+ * @return uint8_t - The priority
+ */
+uint8_t getPriority(uint8_t severity)
+{
+    switch (static_cast<SeverityType>(severity & 0xF0))
+    {
+        case SeverityType::critical:
+            return 0;
+        case SeverityType::unrecoverable:
+            return 1;
+        case SeverityType::predictive:
+            return 2;
+        case SeverityType::diagnostic:
+            return 3;
+        case SeverityType::recovered:
+        case SeverityType::symptom:
+            return 4;
+        default:
+            return 5;
+    }
+}
+
+} // namespace
+
 HostNotifier::HostNotifier(Repository& repo, DataInterfaceBase& dataIface,
                            std::unique_ptr<HostInterface> hostIface) :
     _repo(repo), _dataIface(dataIface), _hostIface(std::move(hostIface)),
@@ -84,7 +117,7 @@ bool HostNotifier::addPELToQueue(const PEL& pel)
 {
     if (enqueueRequired(pel.id()))
     {
-        _pelQueue.push_back(pel.id());
+        enqueue(pel.id());
     }
 
     // Return false so that Repo::for_each keeps going.
@@ -177,7 +210,7 @@ void HostNotifier::newLogCallback(const PEL& pel)
     lg2::debug("New PEL added to queue, PEL ID = {ID}", "ID", lg2::hex,
                pel.id());
 
-    _pelQueue.push_back(pel.id());
+    enqueue(pel.id());
 
     // Notify shouldn't happen if host is down, not up long enough, or full
     if (!_dataIface.isHostUp() || _hostFull || _hostUpTimer.isEnabled())
@@ -205,18 +238,14 @@ void HostNotifier::newLogCallback(const PEL& pel)
 
 void HostNotifier::deleteLogCallback(uint32_t id)
 {
-    auto queueIt = std::find(_pelQueue.begin(), _pelQueue.end(), id);
-    if (queueIt != _pelQueue.end())
+    if (dequeue(id))
     {
         lg2::debug("Host notifier removing deleted log from queue");
-        _pelQueue.erase(queueIt);
     }
 
-    auto sentIt = std::find(_sentPELs.begin(), _sentPELs.end(), id);
-    if (sentIt != _sentPELs.end())
+    if (_sentPELs.erase(id))
     {
         lg2::debug("Host notifier removing deleted log from sent list");
-        _sentPELs.erase(sentIt);
     }
 
     // Nothing we can do about this...
@@ -261,7 +290,8 @@ void HostNotifier::doNewLogNotify()
             // trying again when the next new log comes in.
             lg2::error(
                 "PEL Host notifier hit max retry attempts. Giving up for now. PEL ID = {ID}",
-                "ID", lg2::hex, _pelQueue.front());
+                "ID", lg2::hex,
+                _pelQueue.empty() ? 0 : _pelQueue.begin()->id);
 
             // Tell the host interface object to clean itself up, especially to
             // release the PLDM instance ID it's been using.
@@ -276,8 +306,7 @@ void HostNotifier::doNewLogNotify()
     // Find the PEL to send
     while (!doNotify && !_pelQueue.empty())
     {
-        id = _pelQueue.front();
-        _pelQueue.pop_front();
+        id = popFront();
 
         if (notifyRequired(id))
         {
@@ -302,13 +331,19 @@ void HostNotifier::doNewLogNotify()
             if (rc == CmdStatus::success)
             {
                 _inProgressPEL = id;
+
+                if (!_drainStart)
+                {
+                    _drainStart = std::chrono::steady_clock::now();
+                    _drainSent = 0;
+                }
             }
             else
             {
                 // It failed.  Retry
                 lg2::error("PLDM send failed, PEL ID = {ID}", "ID", lg2::hex,
                            id);
-                _pelQueue.push_front(id);
+                enqueue(id);
                 _inProgressPEL = 0;
                 _retryTimer.restartOnce(_hostIface->getSendRetryDelay());
             }
@@ -342,8 +377,8 @@ void HostNotifier::hostStateChange(bool hostUp)
         // to new so they'll get sent again.
         for (auto id : _sentPELs)
         {
-            _pelQueue.push_back(id);
             _repo.setPELHostTransState(id, TransmissionState::newPEL);
+            enqueue(id);
         }
 
         _sentPELs.clear();
@@ -371,10 +406,12 @@ void HostNotifier::commandResponse(ResponseStatus status)
                    lg2::hex, id);
         _retryCount = 0;
 
-        _sentPELs.push_back(id);
+        _sentPELs.insert(id);
 
         _repo.setPELHostTransState(id, TransmissionState::sent);
 
+        updateDrainStats();
+
         // If the host is full, don't send off the next PEL
         if (!_hostFull && !_pelQueue.empty())
         {
@@ -386,7 +423,7 @@ void HostNotifier::commandResponse(ResponseStatus status)
         lg2::error("PLDM command response failure, PEL ID = {ID}", "ID",
                    lg2::hex, id);
         // Retry
-        _pelQueue.push_front(id);
+        enqueue(id);
         _retryTimer.restartOnce(_hostIface->getReceiveRetryDelay());
     }
 }
@@ -396,7 +433,7 @@ void HostNotifier::retryTimerExpired()
     if (_dataIface.isHostUp())
     {
         lg2::info("Attempting command retry, PEL ID = {ID}", "ID", lg2::hex,
-                  _pelQueue.front());
+                  _pelQueue.empty() ? 0 : _pelQueue.begin()->id);
         _retryCount++;
         doNewLogNotify();
     }
@@ -414,9 +451,10 @@ void HostNotifier::stopCommand()
 
     if (_inProgressPEL != 0)
     {
-        _pelQueue.push_front(_inProgressPEL);
+        enqueue(_inProgressPEL);
         _inProgressPEL = 0;
     }
+    _drainStart.reset();
 
     if (_retryTimer.isEnabled())
     {
@@ -432,11 +470,7 @@ void HostNotifier::ackPEL(uint32_t id)
     _repo.setPELHostTransState(id, TransmissionState::acked);
 
     // No longer just 'sent', so remove it from the sent list.
-    auto sent = std::find(_sentPELs.begin(), _sentPELs.end(), id);
-    if (sent != _sentPELs.end())
-    {
-        _sentPELs.erase(sent);
-    }
+    _sentPELs.erase(id);
 
     // An ack means the host is no longer full
     if (_hostFullTimer.isEnabled())
@@ -466,17 +500,10 @@ void HostNotifier::setHostFull(uint32_t id)
     _hostFull = true;
 
     // This PEL needs to get re-sent
-    auto sent = std::find(_sentPELs.begin(), _sentPELs.end(), id);
-    if (sent != _sentPELs.end())
+    if (_sentPELs.erase(id))
     {
-        _sentPELs.erase(sent);
         _repo.setPELHostTransState(id, TransmissionState::newPEL);
-
-        if (std::find(_pelQueue.begin(), _pelQueue.end(), id) ==
-            _pelQueue.end())
-        {
-            _pelQueue.push_front(id);
-        }
+        enqueue(id);
     }
 
     // The only PELs that will be sent when the
@@ -492,13 +519,70 @@ void HostNotifier::setBadPEL(uint32_t id)
 {
     lg2::error("PEL rejected by the host, PEL ID = {ID}", "ID", lg2::hex, id);
 
-    auto sent = std::find(_sentPELs.begin(), _sentPELs.end(), id);
-    if (sent != _sentPELs.end())
+    _sentPELs.erase(id);
+
+    _repo.setPELHostTransState(id, TransmissionState::badPEL);
+}
+
+void HostNotifier::enqueue(uint32_t id)
+{
+    if (_queuedPELs.contains(id))
     {
-        _sentPELs.erase(sent);
+        return;
     }
 
-    _repo.setPELHostTransState(id, TransmissionState::badPEL);
+    QueueEntry entry{getPriority(0), 0, id};
+
+    Repository::LogID i{Repository::LogID::Pel{id}};
+    if (auto attributes = _repo.getPELAttributes(i); attributes)
+    {
+        const auto& a = attributes.value().get();
+        entry.priority = getPriority(a.severity);
+        entry.creationTime = a.creationTime;
+    }
+
+    _queuedPELs.emplace(id, _pelQueue.insert(entry).first);
+}
+
+bool HostNotifier::dequeue(uint32_t id)
+{
+    auto it = _queuedPELs.find(id);
+    if (it == _queuedPELs.end())
+    {
+        return false;
+    }
+
+    _pelQueue.erase(it->second);
+    _queuedPELs.erase(it);
+    return true;
+}
+
+uint32_t HostNotifier::popFront()
+{
+    auto id = _pelQueue.begin()->id;
+    _queuedPELs.erase(id);
+    _pelQueue.erase(_pelQueue.begin());
+    return id;
+}
+
+void HostNotifier::updateDrainStats()
+{
+    _drainSent++;
+
+    if (_drainStart && _pelQueue.empty())
+    {
+        if (_drainSent > 1)
+        {
+            auto duration =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - *_drainStart);
+
+            lg2::info("Sent {NUM} PELs to the host in {DURATION}ms", "NUM",
+                      _drainSent, "DURATION", duration.count());
+        }
+
+        _drainStart.reset();
+    }
 }
 
 } // namespace openpower::pels
@@ -8,7 +8,11 @@
 #include <sdeventplus/source/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
-#include <deque>
+#include <chrono>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace openpower::pels
 {
@@ -45,6 +49,9 @@ namespace openpower::pels
  * which will invoke HostNotifier::setHostFull(). This will stop new
  * PELs from being sent, and the first PEL that hits this will have
  * a timer set to retry again later.
+ *
+ * The queued PELs are sent in order of severity, most severe first,
+ * and then oldest first.
  */
 class HostNotifier
 {
@@ -272,6 +279,48 @@ class HostNotifier
      */
     void stopCommand();
 
+    /**
+     * @brief Adds a PEL to the queue, if it isn't already in it.
+     *
+     * @param[in] id - The PEL ID
+     */
+    void enqueue(uint32_t id);
+
+    /**
+     * @brief Removes a PEL from the queue.
+     *
+     * @param[in] id - The PEL ID
+     *
+     * @return bool - If it was in the queue
+     */
+    bool dequeue(uint32_t id);
+
+    /**
+     * @brief Removes and returns the next PEL to send from the queue.
+     *
+     * @return uint32_t - The PEL ID
+     */
+    uint32_t popFront();
+
+    /**
+     * @brief Counts a successful response, and traces how long it
+     *        took to send the queue when it has emptied.
+     */
+    void updateDrainStats();
+
+    /**
+     * @brief An entry in the PEL queue, sorted by severity and then
+     *        creation time.
+     */
+    struct QueueEntry
+    {
+        uint8_t priority;
+        uint64_t creationTime;
+        uint32_t id;
+
+        auto operator<=>(const QueueEntry&) const = default;
+    };
+
     /**
      * @brief The PEL repository object
      */
@@ -288,16 +337,21 @@ class HostNotifier
     std::unique_ptr<HostInterface> _hostIface;
 
     /**
-     * @brief The list of PEL IDs that need to be sent.
+     * @brief The PELs that need to be sent, in the order to send them.
+     */
+    std::set<QueueEntry> _pelQueue;
+
+    /**
+     * @brief The entries in _pelQueue, by PEL ID.
      */
-    std::deque<uint32_t> _pelQueue;
+    std::unordered_map<uint32_t, std::set<QueueEntry>::iterator> _queuedPELs;
 
     /**
      * @brief The list of IDs that were sent, but not acked yet.
      *
      * These move back to _pelQueue on a power off.
      */
-    std::vector<uint32_t> _sentPELs;
+    std::unordered_set<uint32_t> _sentPELs;
 
     /**
      * @brief The ID the PEL where the notification has
@@ -306,6 +360,16 @@ class HostNotifier
      */
     uint32_t _inProgressPEL = 0;
 
+    /**
+     * @brief When the first PEL was sent since the queue was last empty.
+     */
+    std::optional<std::chrono::steady_clock::time_point> _drainStart;
+
+    /**
+     * @brief The number of PELs sent since _drainStart.
+     */
+    size_t _drainSent = 0;
+
     /**
      * @brief The command retry count
      */
@@ -0,0 +1,141 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "inventory_cache.hpp"
+
+#include <format>
+
+namespace openpower::pels
+{
+
+template <typename Value>
+bool InventoryCache::Table<Value>::erase(const std::string& key)
+{
+    if (auto it = index.find(key); it != index.end())
+    {
+        entries.erase(it->second);
+        index.erase(it);
+        return true;
+    }
+    return false;
+}
+
+template <typename Value>
+void InventoryCache::Table<Value>::clear()
+{
+    entries.clear();
+    index.clear();
+}
+
+template <typename Value>
+Value InventoryCache::get(Table<Value>& table, const std::string& key,
+                          const std::function<Value()>& fetch)
+{
+    if (auto it = table.index.find(key); it != table.index.end())
+    {
+        _stats.hits++;
+
+        // Move it to the front, as it is now the most recently used.
+        table.entries.splice(table.entries.begin(), table.entries,
+                             it->second);
+        return it->second->second;
+    }
+
+    _stats.misses++;
+
+    // If this throws, there's nothing to save.
+    auto value = fetch();
+
+    if (table.index.size() >= maxEntries)
+    {
+        table.index.erase(table.entries.back().first);
+        table.entries.pop_back();
+    }
+
+    table.entries.emplace_front(key, value);
+    table.index.emplace(key, table.entries.begin());
+
+    return value;
+}
+
+std::string InventoryCache::getLocationCode(
+    const std::string& inventoryPath, const std::function<std::string()>& fetch)
+{
+    return get(_locationCodes, inventoryPath, fetch);
+}
+
+InventoryCache::HWCalloutFields InventoryCache::getHWCalloutFields(
+    const std::string& inventoryPath,
+    const std::function<HWCalloutFields()>& fetch)
+{
+    return get(_hwCalloutFields, inventoryPath, fetch);
+}
+
+std::string InventoryCache::getExpandedLocationCode(
+    const std::string& locationCode, const std::function<std::string()>& fetch)
+{
+    return get(_expandedLocationCodes, locationCode, fetch);
+}
+
+std::vector<std::string> InventoryCache::getInventoryFromLocCode(
+    const std::string& locationCode, uint16_t node, bool expanded,
+    const std::function<std::vector<std::string>()>& fetch)
+{
+    auto key = std::format("{}:{}:{}", expanded ? 'E' : 'U', node,
+                           locationCode);
+    return get(_inventoryPaths, key, fetch);
+}
+
+void InventoryCache::invalidateVPD(const std::string& inventoryPath)
+{
+    if (_hwCalloutFields.erase(inventoryPath))
+    {
+        _stats.invalidations++;
+    }
+}
+
+void InventoryCache::invalidateLocationCode(const std::string& inventoryPath)
+{
+    _locationCodes.erase(inventoryPath);
+
+    // Any location code could now map to a different FRU.
+    _expandedLocationCodes.clear();
+    _inventoryPaths.clear();
+    _stats.invalidations++;
+}
+
+void InventoryCache::invalidateSystemVPD()
+{
+    _expandedLocationCodes.clear();
+    _inventoryPaths.clear();
+    _stats.invalidations++;
+}
+
+void InventoryCache::invalidate(const std::string& inventoryPath)
+{
+    _hwCalloutFields.erase(inventoryPath);
+    invalidateLocationCode(inventoryPath);
+}
+
+void InventoryCache::clear()
+{
+    _locationCodes.clear();
+    _hwCalloutFields.clear();
+    _expandedLocationCodes.clear();
+    _inventoryPaths.clear();
+    _stats.invalidations++;
+}
+
+} // namespace openpower::pels
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace openpower::pels
+{
+
+/**
+ * @class InventoryCache
+ *
+ * Holds the inventory data that is looked up on D-Bus when creating
+ * hardware callouts, so that the same FRUs don't have to be looked up
+ * over and over again when many PELs are created.
+ *
+ * The data is:
+ *  - The location code of an inventory path
+ *  - The VINI FN, CC, and SN keywords of an inventory path
+ *  - The expanded version of an unexpanded location code
+ *  - The inventory paths of a location code
+ *
+ * On a cache miss, the function passed in does the D-Bus lookup and its
+ * result is saved, replacing the least recently used entry of that table
+ * when it is full.  If it throws, nothing is saved.  The owner of the
+ * cache is responsible for watching D-Bus and calling the invalidate
+ * functions when the inventory changes.
+ */
+class InventoryCache
+{
+  public:
+    /**
+     * @brief The VINI keywords used in hardware callouts.
+     */
+    struct HWCalloutFields
+    {
+        std::string fruPartNumber;
+        std::string ccin;
+        std::string serialNumber;
+    };
+
+    /**
+     * @brief The cache hit and miss counts.
+     */
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t invalidations = 0;
+    };
+
+    InventoryCache() = default;
+    ~InventoryCache() = default;
+    InventoryCache(const InventoryCache&) = delete;
+    InventoryCache& operator=(const InventoryCache&) = delete;
+    InventoryCache(InventoryCache&&) = default;
+    InventoryCache& operator=(InventoryCache&&) = default;
+
+    /**
+     * @brief Returns the location code of an inventory path.
+     *
+     * @param[in] inventoryPath - The inventory path
+     * @param[in] fetch - Looks up the location code on a miss
+     *
+     * @return std::string - The location code
+     */
+    std::string getLocationCode(const std::string& inventoryPath,
+                                const std::function<std::string()>& fetch);
+
+    /**
+     * @brief Returns the VINI FN, CC, and SN keywords of an inventory path.
+     *
+     * @param[in] inventoryPath - The inventory path
+     * @param[in] fetch - Looks up the keywords on a miss
+     *
+     * @return HWCalloutFields - The keywords
+     */
+    HWCalloutFields getHWCalloutFields(
+        const std::string& inventoryPath,
+        const std::function<HWCalloutFields()>& fetch);
+
+    /**
+     * @brief Returns the expanded version of a location code.
+     *
+     * @param[in] locationCode - The unexpanded location code
+     * @param[in] fetch - Looks up the expanded location code on a miss
+     *
+     * @return std::string - The expanded location code
+     */
+    std::string getExpandedLocationCode(
+        const std::string& locationCode,
+        const std::function<std::string()>& fetch);
+
+    /**
+     * @brief Returns the inventory paths of a location code.
+     *
+     * @param[in] locationCode - The location code
+     * @param[in] node - The node number the location is on
+     * @param[in] expanded - If the location code is expanded
+     * @param[in] fetch - Looks up the paths on a miss
+     *
+     * @return std::vector<std::string> - The inventory paths
+     */
+    std::vector<std::string> getInventoryFromLocCode(
+        const std::string& locationCode, uint16_t node, bool expanded,
+        const std::function<std::vector<std::string>()>& fetch);
+
+    /**
+     * @brief Removes the VPD keywords of an inventory path.
+     *
+     * @param[in] inventoryPath - The inventory path
+     */
+    void invalidateVPD(const std::string& inventoryPath);
+
+    /**
+     * @brief Removes the location code of an inventory path, along with
+     *        all location code to inventory path mappings since they
+     *        may have depended on it.
+     *
+     * @param[in] inventoryPath - The inventory path
+     */
+    void invalidateLocationCode(const std::string& inventoryPath);
+
+    /**
+     * @brief Removes the expanded location codes, and the location code
+     *        to inventory path mappings, for when the system VPD that
+     *        the expansion is made from changes.
+     */
+    void invalidateSystemVPD();
+
+    /**
+     * @brief Removes everything about an inventory path, for when it is
+     *        added or removed.
+     *
+     * @param[in] inventoryPath - The inventory path
+     */
+    void invalidate(const std::string& inventoryPath);
+
+    /**
+     * @brief Removes everything.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the hit and miss counts.
+     *
+     * @return const Stats& - The counts
+     */
+    const Stats& getStats() const
+    {
+        return _stats;
+    }
+
+    /**
+     * @brief The most entries each table will hold.  When a table is
+     *        full, its least recently used entry is replaced.
+     */
+    static constexpr size_t maxEntries = 1024;
+
+  private:
+    /**
+     * @brief A table of values by key, most recently used first.
+     */
+    template <typename Value>
+    struct Table
+    {
+        using Entries = std::list<std::pair<std::string, Value>>;
+
+        /**
+         * @brief Removes the value of a key.
+         *
+         * @param[in] key - The key
+         *
+         * @return bool - If the key was in the table
+         */
+        bool erase(const std::string& key);
+
+        /**
+         * @brief Removes everything.
+         */
+        void clear();
+
+        /**
+         * @brief The values, most recently used first.
+         */
+        Entries entries;
+
+        /**
+         * @brief The position of each key in entries.
+         */
+        std::unordered_map<std::string, typename Entries::iterator> index;
+    };
+
+    /**
+     * @brief Returns the value of the key from the table, using the
+     *        fetch function to get and save it on a miss.
+     *
+     * @param[in] table - The table to use
+     * @param[in] key - The key to find
+     * @param[in] fetch - Gets the value on a miss
+     *
+     * @return Value - The value
+     */
+    template <typename Value>
+    Value get(Table<Value>& table, const std::string& key,
+              const std::function<Value()>& fetch);
+
+    /**
+     * @brief Location codes, by inventory path.
+     */
+    Table<std::string> _locationCodes;
+
+    /**
+     * @brief VINI keywords, by inventory path.
+     */
+    Table<HWCalloutFields> _hwCalloutFields;
+
+    /**
+     * @brief Expanded location codes, by unexpanded location code.
+     */
+    Table<std::string> _expandedLocationCodes;
+
+    /**
+     * @brief Inventory paths, by location code, node, and if the
+     *        location code is expanded.
+     */
+    Table<std::vector<std::string>> _inventoryPaths;
+
+    /**
+     * @brief The hit and miss counts.
+     */
+    Stats _stats;
+};
+
+} // namespace openpower::pels
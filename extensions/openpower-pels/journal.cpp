@@ -19,7 +19,10 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <format>
+#include <ranges>
+#include <unordered_map>
 
 namespace openpower::pels
 {
@@ -68,32 +71,133 @@ void Journal::sync() const
     }
 }
 
+std::vector<std::vector<std::string>> JournalBase::getMessagesByID(
+    const std::vector<std::pair<std::string, size_t>>& captures) const
+{
+    std::vector<std::vector<std::string>> messages;
+    messages.reserve(captures.size());
+
+    for (const auto& [syslogID, maxMessages] : captures)
+    {
+        try
+        {
+            messages.push_back(getMessages(syslogID, maxMessages));
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed during journal collection: {ERROR}", "ERROR",
+                       e);
+            messages.emplace_back();
+        }
+    }
+
+    return messages;
+}
+
 std::vector<std::string> Journal::getMessages(const std::string& syslogID,
                                               size_t maxMessages) const
 {
-    // The message registry JSON schema will also fail if a zero is in the JSON
-    if (0 == maxMessages)
+    return std::move(collect({{syslogID, maxMessages}}).front());
+}
+
+std::vector<std::vector<std::string>> Journal::getMessagesByID(
+    const std::vector<std::pair<std::string, size_t>>& captures) const
+{
+    // An empty ID matches every entry, so it needs its own pass.
+    if ((captures.size() > 1) &&
+        std::ranges::any_of(captures,
+                            [](const auto& c) { return c.first.empty(); }))
+    {
+        return JournalBase::getMessagesByID(captures);
+    }
+
+    try
+    {
+        return collect(captures);
+    }
+    catch (const std::exception& e)
     {
-        lg2::error(
-            "maxMessages value of zero passed into Journal::getMessages");
-        return std::vector<std::string>{};
+        // Get each ID on its own instead, so only the ones that fail
+        // again are left empty.
+        lg2::error("Failed during journal collection: {ERROR}", "ERROR", e);
+        return JournalBase::getMessagesByID(captures);
     }
+}
 
+sd_journal* Journal::open() const
+{
     sd_journal* journal;
-    int rc = sd_journal_open(&journal, SD_JOURNAL_LOCAL_ONLY);
+    int rc = 0;
+
+    if (_files.empty())
+    {
+        rc = sd_journal_open(&journal, SD_JOURNAL_LOCAL_ONLY);
+    }
+    else
+    {
+        std::vector<const char*> paths;
+        for (const auto& file : _files)
+        {
+            paths.push_back(file.c_str());
+        }
+        paths.push_back(nullptr);
+
+        rc = sd_journal_open_files(&journal, paths.data(), 0);
+    }
+
     if (rc < 0)
     {
         throw std::runtime_error{
             std::string{"Failed to open journal: "} + strerror(-rc)};
     }
 
+    return journal;
+}
+
+std::vector<std::vector<std::string>> Journal::collect(
+    const std::vector<std::pair<std::string, size_t>>& captures) const
+{
+    std::vector<std::vector<std::string>> messages(captures.size());
+
+    // The captures still needing messages, by syslog ID
+    std::unordered_map<std::string, std::vector<size_t>> pending;
+
+    for (size_t i = 0; i < captures.size(); i++)
+    {
+        const auto& [syslogID, maxMessages] = captures[i];
+
+        // The message registry JSON schema will also fail if a zero is in
+        // the JSON
+        if (0 == maxMessages)
+        {
+            lg2::error(
+                "maxMessages value of zero passed into Journal::getMessages");
+            continue;
+        }
+
+        messages[i].reserve(maxMessages);
+        pending[syslogID].push_back(i);
+    }
+
+    if (pending.empty())
+    {
+        return messages;
+    }
+
+    sd_journal* journal = open();
     JournalCloser closer{journal};
 
-    if (!syslogID.empty())
+    // Matches on the same field are ORed together.
+    for (const auto& syslogID : pending | std::views::keys)
     {
+        if (syslogID.empty())
+        {
+            continue;
+        }
+
         std::string match{"SYSLOG_IDENTIFIER=" + syslogID};
 
-        rc = sd_journal_add_match(journal, match.c_str(), 0);
+        int rc = sd_journal_add_match(journal, match.c_str(), 0);
         if (rc < 0)
         {
             throw std::runtime_error{
@@ -101,44 +205,84 @@ std::vector<std::string> Journal::getMessages(const std::string& syslogID,
         }
     }
 
-    // Loop through matching entries from newest to oldest
-    std::vector<std::string> messages;
-    messages.reserve(maxMessages);
-    std::string sID, pid, message, timeStamp, line;
+    // With a single ID, the match already did the filtering.
+    bool singleID = pending.size() == 1;
+    auto* targets = &pending.begin()->second;
+    TimeStampCache timeStampCache;
+    std::string sID, line;
 
+    // Loop through matching entries from newest to oldest, saving them
+    // in that order and reversing them at the end.
     SD_JOURNAL_FOREACH_BACKWARDS(journal)
     {
-        timeStamp = getTimeStamp(journal);
-        sID = getFieldValue(journal, "SYSLOG_IDENTIFIER");
-        pid = getFieldValue(journal, "_PID");
-        message = getFieldValue(journal, "MESSAGE");
+        sID.clear();
+        appendFieldValue(journal, "SYSLOG_IDENTIFIER", sID);
+
+        if (!singleID)
+        {
+            auto it = pending.find(sID);
+            if (it == pending.end())
+            {
+                continue;
+            }
+            targets = &it->second;
+        }
+
+        line.clear();
+        appendTimeStamp(journal, timeStampCache, line);
+        line += ' ';
+        line += sID;
+        line += '[';
+        appendFieldValue(journal, "_PID", line);
+        line += "]: ";
+        appendFieldValue(journal, "MESSAGE", line);
+
+        for (auto i : *targets)
+        {
+            messages[i].push_back(line);
+        }
 
-        line = timeStamp + " " + sID + "[" + pid + "]: " + message;
-        messages.emplace(messages.begin(), line);
+        // All captures with the same ID fill up at the same rate, except
+        // the ones that wanted fewer messages.
+        std::erase_if(*targets, [&](auto i) {
+            return messages[i].size() >= captures[i].second;
+        });
 
-        if (messages.size() >= maxMessages)
+        if (targets->empty())
         {
-            break;
+            if (singleID)
+            {
+                break;
+            }
+
+            pending.erase(sID);
+            if (pending.empty())
+            {
+                break;
+            }
         }
     }
 
+    for (auto& m : messages)
+    {
+        std::ranges::reverse(m);
+    }
+
     return messages;
 }
 
-std::string Journal::getFieldValue(sd_journal* journal,
-                                   const std::string& field) const
+void Journal::appendFieldValue(sd_journal* journal, const char* field,
+                               std::string& out)
 {
-    std::string value{};
-
     const void* data{nullptr};
     size_t length{0};
-    int rc = sd_journal_get_data(journal, field.c_str(), &data, &length);
+    int rc = sd_journal_get_data(journal, field, &data, &length);
     if (rc < 0)
     {
         if (-rc == ENOENT)
         {
-            // Current entry does not include this field; return empty value
-            return value;
+            // Current entry does not include this field; add nothing
+            return;
         }
         else
         {
@@ -149,18 +293,17 @@ std::string Journal::getFieldValue(sd_journal* journal,
     }
 
     // Get value from field data.  Field data in format "FIELD=value".
-    std::string dataString{static_cast<const char*>(data), length};
-    std::string::size_type pos = dataString.find('=');
-    if ((pos != std::string::npos) && ((pos + 1) < dataString.size()))
+    std::string_view dataString{static_cast<const char*>(data), length};
+    std::string_view::size_type pos = dataString.find('=');
+    if (pos != std::string_view::npos)
     {
         // Value is substring after the '='
-        value = dataString.substr(pos + 1);
+        out += dataString.substr(pos + 1);
     }
-
-    return value;
 }
 
-std::string Journal::getTimeStamp(sd_journal* journal) const
+void Journal::appendTimeStamp(sd_journal* journal, TimeStampCache& cache,
+                              std::string& out)
 {
     // Get realtime (wallclock) timestamp of current journal entry.  The
     // timestamp is in microseconds since the epoch.
@@ -176,19 +319,27 @@ std::string Journal::getTimeStamp(sd_journal* journal) const
     // Convert to number of seconds since the epoch
     time_t secs = usec / 1000000;
 
-    // Convert seconds to tm struct required by strftime()
-    struct tm* timeStruct = gmtime(&secs);
-    if (timeStruct == nullptr)
+    if (secs != cache.secs)
     {
-        throw std::runtime_error{
-            std::string{"Invalid journal entry timestamp: "} + strerror(errno)};
-    }
+        // Convert seconds to tm struct required by strftime()
+        struct tm timeStruct;
+        if (gmtime_r(&secs, &timeStruct) == nullptr)
+        {
+            throw std::runtime_error{
+                std::string{"Invalid journal entry timestamp: "} +
+                strerror(errno)};
+        }
 
-    // Convert tm struct into a date/time string
-    char timeStamp[80];
-    strftime(timeStamp, sizeof(timeStamp), "%b %d %H:%M:%S", timeStruct);
+        // Convert tm struct into a date/time string
+        char timeStamp[80];
+        auto size = strftime(timeStamp, sizeof(timeStamp), "%b %d %H:%M:%S",
+                             &timeStruct);
+
+        cache.secs = secs;
+        cache.text.assign(timeStamp, size);
+    }
 
-    return timeStamp;
+    out += cache.text;
 }
 
 } // namespace openpower::pels
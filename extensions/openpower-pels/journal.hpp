@@ -3,6 +3,7 @@
 #include <systemd/sd-journal.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace openpower::pels
@@ -33,6 +34,20 @@ class JournalBase
     virtual std::vector<std::string> getMessages(const std::string& syslogID,
                                                  size_t maxMessages) const = 0;
 
+    /**
+     * @brief Get messages from the journal for several syslog IDs
+     *
+     * A failure getting the messages of one ID is logged and leaves its
+     * messages empty.
+     *
+     * @param captures - The SYSLOG_IDENTIFIER field values along with the
+     *                   max number of messages to get for each
+     *
+     * @return The messages of each ID, in the same order as captures
+     */
+    virtual std::vector<std::vector<std::string>> getMessagesByID(
+        const std::vector<std::pair<std::string, size_t>>& captures) const;
+
     /**
      * @brief Call journalctl --sync to write unwritten journal data to disk
      */
@@ -48,6 +63,16 @@ class Journal : public JournalBase
 {
   public:
     Journal() = default;
+
+    /**
+     * @brief Constructor to read from the journal files passed in
+     *        instead of the local journal.
+     *
+     * @param files - The journal files
+     */
+    explicit Journal(std::vector<std::string> files) : _files{std::move(files)}
+    {}
+
     ~Journal() = default;
     Journal(const Journal&) = default;
     Journal& operator=(const Journal&) = default;
@@ -65,6 +90,23 @@ class Journal : public JournalBase
     std::vector<std::string> getMessages(const std::string& syslogID,
                                          size_t maxMessages) const override;
 
+    /**
+     * @brief Get messages from the journal for several syslog IDs, with
+     *        a single pass through the journal.
+     *
+     * If that pass fails, such as when a match can't be added, the IDs
+     * are read one at a time instead, so a failure for one ID only
+     * leaves that ID empty.
+     *
+     * @param captures - The SYSLOG_IDENTIFIER field values along with the
+     *                   max number of messages to get for each
+     *
+     * @return The messages of each ID, in the same order as captures
+     */
+    std::vector<std::vector<std::string>> getMessagesByID(
+        const std::vector<std::pair<std::string, size_t>>& captures)
+        const override;
+
     /**
      * @brief Call journalctl --sync to write unwritten journal data to disk
      */
@@ -72,23 +114,60 @@ class Journal : public JournalBase
 
   private:
     /**
-     * @brief Gets a field from the current journal entry
+     * @brief The last timestamp formatted, since many journal entries
+     *        are from the same second.
+     */
+    struct TimeStampCache
+    {
+        time_t secs = -1;
+        std::string text;
+    };
+
+    /**
+     * @brief Walks the journal from newest to oldest and collects the
+     *        messages for each capture.  An empty syslog ID matches
+     *        every entry, so it can only be used on its own.
      *
-     * @param journal - pointer to current journal entry
-     * @param field - The field name whose value to get
+     * @param captures - The SYSLOG_IDENTIFIER field values along with the
+     *                   max number of messages to get for each
+     *
+     * @return The messages of each ID, in the same order as captures
+     */
+    std::vector<std::vector<std::string>> collect(
+        const std::vector<std::pair<std::string, size_t>>& captures) const;
+
+    /**
+     * @brief Opens the journal files, or the local journal if there
+     *        aren't any.
      *
-     * @return std::string - The field value
+     * @return sd_journal* - The journal, which the caller must close
      */
-    std::string getFieldValue(sd_journal* journal,
-                              const std::string& field) const;
+    sd_journal* open() const;
 
     /**
-     * @brief Gets a readable timestamp from the journal entry
+     * @brief Appends a field from the current journal entry to a string
      *
      * @param journal - pointer to current journal entry
+     * @param field - The field name whose value to get
+     * @param out - The string to append the value to
+     */
+    static void appendFieldValue(sd_journal* journal, const char* field,
+                                 std::string& out);
+
+    /**
+     * @brief Appends a readable timestamp from the journal entry to
+     *        a string
      *
-     * @return std::string - A timestamp string
+     * @param journal - pointer to current journal entry
+     * @param cache - The last timestamp formatted
+     * @param out - The string to append the timestamp to
+     */
+    static void appendTimeStamp(sd_journal* journal, TimeStampCache& cache,
+                                std::string& out);
+
+    /**
+     * @brief The journal files to read, if not the local journal.
      */
-    std::string getTimeStamp(sd_journal* journal) const;
+    std::vector<std::string> _files;
 };
 } // namespace openpower::pels
@@ -23,6 +23,7 @@
 
 #include <cstring>
 #include <filesystem>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -82,7 +83,23 @@ std::unique_ptr<char[]> dumpHex(const void* data, size_t size,
     {
         jsonIndent.append("\"");
     }
-    std::unique_ptr<char[]> buffer{new char[std::max(70, 10 * (int)size)]()};
+
+    // Each line of 16 bytes has the indent, the offset when not JSON, the
+    // hex values, and up to 32 characters of escaped ASCII, which is less
+    // than 100 characters past the indent.
+    size_t lines = (size + 15) / 16;
+    size_t lineSize = jsonIndent.size() + 100;
+    std::unique_ptr<char[]> buffer{new char[lines * lineSize + 1]()};
+
+    // Track the end instead of using strcat, which would have to find it
+    // again each time.  The buffer is zeroed so it stays terminated.
+    char* end = buffer.get();
+    auto append = [&end](const char* str) {
+        auto length = strlen(str);
+        memcpy(end, str, length);
+        end += length;
+    };
+
     char* symbol = (char*)calloc(symbolSize, sizeof(char));
     char* byteCount = (char*)calloc(11, sizeof(char));
     char ascii[17];
@@ -95,13 +112,14 @@ std::unique_ptr<char[]> dumpHex(const void* data, size_t size,
             if (!toJson)
             {
                 snprintf(byteCount, 11, "%08X  ", static_cast<uint32_t>(i));
-                strcat(buffer.get(), byteCount);
+                append(byteCount);
             }
-            strcat(buffer.get(), jsonIndent.c_str());
+            append(jsonIndent.c_str());
         }
-        snprintf(symbol, symbolSize, "%02X ", ((unsigned char*)data)[i]);
-        strcat(buffer.get(), symbol);
-        memset(symbol, 0, strlen(symbol));
+        constexpr auto hexDigits = "0123456789ABCDEF";
+        auto byte = ((unsigned char*)data)[i];
+        char hex[] = {hexDigits[byte >> 4], hexDigits[byte & 0xF], ' ', '\0'};
+        append(hex);
         if (((unsigned char*)data)[i] >= ' ' &&
             ((unsigned char*)data)[i] <= '~')
         {
@@ -118,7 +136,7 @@ std::unique_ptr<char[]> dumpHex(const void* data, size_t size,
             {
                 asciiString = escapeJSON(asciiString);
             }
-            strcat(buffer.get(), " ");
+            append(" ");
             if ((i + 1) % 16 == 0)
             {
                 if (i + 1 != size && toJson)
@@ -136,7 +154,7 @@ std::unique_ptr<char[]> dumpHex(const void* data, size_t size,
                     snprintf(symbol, symbolSize, "|  %s\n",
                              asciiString.c_str());
                 }
-                strcat(buffer.get(), symbol);
+                append(symbol);
                 memset(symbol, 0, strlen(symbol));
             }
             else if (i + 1 == size)
@@ -144,11 +162,11 @@ std::unique_ptr<char[]> dumpHex(const void* data, size_t size,
                 ascii[(i + 1) % 16] = '\0';
                 if ((i + 1) % 16 <= 8)
                 {
-                    strcat(buffer.get(), " ");
+                    append(" ");
                 }
                 for (j = (i + 1) % 16; j < 16; ++j)
                 {
-                    strcat(buffer.get(), "   ");
+                    append("   ");
                 }
                 std::string asciiString2(ascii);
                 if (toJson)
@@ -163,7 +181,7 @@ std::unique_ptr<char[]> dumpHex(const void* data, size_t size,
                              asciiString2.c_str());
                 }
 
-                strcat(buffer.get(), symbol);
+                append(symbol);
                 memset(symbol, 0, strlen(symbol));
             }
         }
@@ -246,7 +264,8 @@ std::string trimEnd(std::string s)
  *
  * Keeps a cache of the JSON it reads to live throughout
  * the peltool call as the JSON can be reused across
- * PEL sections or even across PELs.
+ * PEL sections or even across PELs.  peltool can render
+ * PELs on several threads, so the cache has a lock.
  *
  * @param[in] compID - The component ID
  * @param[in] creatorID - The creator ID for the PEL
@@ -256,44 +275,41 @@ static std::optional<std::string> lookupComponentName(uint16_t compID,
                                                       char creatorID)
 {
     static std::map<char, nlohmann::json> jsonCache;
-    nlohmann::json jsonData;
-    nlohmann::json* jsonPtr = &jsonData;
-    std::filesystem::path filename{
-        std::string{creatorID} + "_component_ids.json"};
-    filename = getPELReadOnlyDataPath() / filename;
+    static std::mutex jsonCacheMutex;
+    std::lock_guard lock{jsonCacheMutex};
 
     auto jsonIt = jsonCache.find(creatorID);
-    if (jsonIt != jsonCache.end())
-    {
-        jsonPtr = &(jsonIt->second);
-    }
-    else
+    if (jsonIt == jsonCache.end())
     {
-        std::error_code ec;
-        if (!std::filesystem::exists(filename, ec))
-        {
-            return std::nullopt;
-        }
+        // A missing or bad file is cached as null so that it
+        // isn't looked for again for every PEL.
+        nlohmann::json jsonData;
+        std::filesystem::path filename{
+            std::string{creatorID} + "_component_ids.json"};
+        filename = getPELReadOnlyDataPath() / filename;
 
         std::ifstream file{filename};
-        if (!file)
+        if (file)
         {
-            return std::nullopt;
+            jsonData = nlohmann::json::parse(file, nullptr, false);
+            if (jsonData.is_discarded())
+            {
+                jsonData = nullptr;
+            }
         }
 
-        jsonData = nlohmann::json::parse(file, nullptr, false);
-        if (jsonData.is_discarded())
-        {
-            return std::nullopt;
-        }
+        jsonIt = jsonCache.emplace(creatorID, std::move(jsonData)).first;
+    }
 
-        jsonCache.emplace(creatorID, jsonData);
+    if (!jsonIt->second.is_object())
+    {
+        return std::nullopt;
     }
 
     auto id = getNumberString("%04X", compID);
 
-    auto it = jsonPtr->find(id);
-    if (it == jsonPtr->end())
+    auto it = jsonIt->second.find(id);
+    if (it == jsonIt->second.end())
     {
         return std::nullopt;
     }
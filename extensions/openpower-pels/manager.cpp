@@ -16,7 +16,7 @@
 #include "manager.hpp"
 
 #include "additional_data.hpp"
-#include "elog_serialize.hpp"
+#include "extended_user_data.hpp"
 #include "json_utils.hpp"
 #include "pel.hpp"
 #include "pel_entry.hpp"
@@ -30,6 +30,7 @@
 #include <xyz/openbmc_project/Common/error.hpp>
 #include <xyz/openbmc_project/Logging/Create/server.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -301,6 +302,21 @@ void Manager::erase(uint32_t obmcLogID)
     _repo.remove(id);
 }
 
+void Manager::erase(const std::set<uint32_t>& obmcLogIDs)
+{
+    std::vector<Repository::LogID> ids;
+    ids.reserve(obmcLogIDs.size());
+
+    for (auto obmcLogID : obmcLogIDs)
+    {
+        auto path = std::string(OBJ_ENTRY) + '/' + std::to_string(obmcLogID);
+        _pelEntries.erase(path);
+        ids.emplace_back(Repository::LogID::Obmc(obmcLogID));
+    }
+
+    _repo.remove(ids);
+}
+
 void Manager::getLogIDWithHwIsolation(std::vector<uint32_t>& idsWithHwIsoEntry)
 {
     idsWithHwIsoEntry = _dataIface->getLogIDWithHwIsolation();
@@ -559,7 +575,21 @@ void Manager::scheduleRepoPrune()
 
 void Manager::pruneRepo(sdeventplus::source::EventBase& /*source*/)
 {
-    auto idsWithHwIsoEntry = _dataIface->getLogIDWithHwIsolation();
+    std::vector<uint32_t> idsWithHwIsoEntry;
+    try
+    {
+        idsWithHwIsoEntry = _dataIface->getLogIDWithHwIsolation();
+    }
+    catch (const std::exception& e)
+    {
+        // Without knowing which PELs are guarded, don't prune any.  The
+        // next PEL added will try again.
+        lg2::error("Failed reading the hardware isolated log IDs, not "
+                   "pruning: {ERROR}",
+                   "ERROR", e);
+        _repoPrunerEventSource.reset();
+        return;
+    }
 
     auto idsToDelete = _repo.prune(idsWithHwIsoEntry);
 
@@ -604,56 +634,70 @@ void Manager::pelFileDeleted(sdeventplus::source::IO& /*io*/, int /*fd*/,
         return;
     }
 
-    // An event for 1 PEL uses 48B. When all PELs are deleted at once,
-    // as many events as there is room for can be handled in one callback.
-    // A size of 2000 will allow 41 to be processed, with additional
-    // callbacks being needed to process the remaining ones.
-    std::array<uint8_t, 2000> data{};
-    auto bytesRead = read(_pelFileDeleteFD, data.data(), data.size());
-    if (bytesRead < 0)
-    {
-        auto e = errno;
-        lg2::error("Failed reading data from inotify event, errno = {ERRNO}",
-                   "ERRNO", e);
-        abort();
-    }
+    // An event for 1 PEL uses 48B, so this fits about 85 of them.  Keep
+    // reading until the queue is empty so that when all PELs are deleted
+    // at once they are handled together instead of a few per callback.
+    std::array<uint8_t, 4096> data{};
+    std::vector<Repository::LogID> ids;
 
-    auto offset = 0;
-    while (offset < bytesRead)
+    while (true)
     {
-        auto event = reinterpret_cast<inotify_event*>(&data[offset]);
-        if (event->mask & IN_DELETE)
+        auto bytesRead = read(_pelFileDeleteFD, data.data(), data.size());
+        if (bytesRead < 0)
         {
-            std::string filename{event->name};
+            auto e = errno;
+            if (e == EAGAIN)
+            {
+                break;
+            }
+
+            lg2::error(
+                "Failed reading data from inotify event, errno = {ERRNO}",
+                "ERRNO", e);
+            abort();
+        }
 
-            // Get the PEL ID from the filename and tell the
-            // repo it's been removed, and then delete the BMC
-            // event log if it's there.
-            auto pos = filename.find_first_of('_');
-            if (pos != std::string::npos)
+        auto offset = 0;
+        while (offset < bytesRead)
+        {
+            auto event = reinterpret_cast<inotify_event*>(&data[offset]);
+            if (event->mask & IN_DELETE)
             {
-                try
+                std::string filename{event->name};
+
+                // Get the PEL ID from the filename
+                auto pos = filename.find_first_of('_');
+                if (pos != std::string::npos)
                 {
-                    auto idString = filename.substr(pos + 1);
-                    auto pelID = std::stoul(idString, nullptr, 16);
+                    try
+                    {
+                        auto idString = filename.substr(pos + 1);
+                        auto pelID = std::stoul(idString, nullptr, 16);
 
-                    Repository::LogID id{Repository::LogID::Pel(pelID)};
-                    auto removedLogID = _repo.remove(id);
-                    if (removedLogID)
+                        ids.emplace_back(Repository::LogID::Pel(pelID));
+                    }
+                    catch (const std::exception& e)
                     {
-                        _logManager.erase(removedLogID->obmcID.id);
+                        lg2::info(
+                            "Could not find PEL ID from its filename {NAME}",
+                            "NAME", filename);
                     }
                 }
-                catch (const std::exception& e)
-                {
-                    lg2::info("Could not find PEL ID from its filename {NAME}",
-                              "NAME", filename);
-                }
             }
+
+            offset += offsetof(inotify_event, name) + event->len;
         }
+    }
 
-        offset += offsetof(inotify_event, name) + event->len;
+    // Tell the repo they've been removed, and then delete the
+    // BMC event logs that are there.
+    std::set<uint32_t> obmcLogIDs;
+    for (const auto& removedLogID : _repo.remove(ids))
+    {
+        obmcLogIDs.insert(removedLogID.obmcID.id);
     }
+
+    _logManager.erase(obmcLogIDs);
 }
 
 std::tuple<uint32_t, uint32_t> Manager::createPELWithFFDCFiles(
@@ -674,6 +718,49 @@ std::string Manager::getPELJSON(uint32_t obmcLogID)
     // Throws InvalidArgument if not found
     auto pelID = getPELIdFromBMCLogId(obmcLogID);
 
+    return _pelJSONCache.get(pelID,
+                             [this, pelID]() { return renderPELJSON(pelID); });
+}
+
+std::string Manager::renderPELJSON(uint32_t pelID)
+{
+    Repository::LogID id{Repository::LogID::Pel(pelID)};
+    std::optional<std::vector<uint8_t>> data;
+
+    try
+    {
+        data = _repo.getPELData(id);
+    }
+    catch (const std::exception& e)
+    {
+        throw common_error::InternalFailure();
+    }
+
+    if (!data)
+    {
+        throw common_error::InvalidArgument();
+    }
+
+    openpower::pels::PEL pel{*data};
+    if (!pel.valid())
+    {
+        lg2::error("Cannot render invalid PEL {ID} in JSON", "ID", lg2::hex,
+                   pelID);
+        throw common_error::InternalFailure();
+    }
+
+    // The Python parser plugins can only be run by peltool.
+    if (needsParserPlugins(pel, getParserPlugins()))
+    {
+        return runPeltool(pelID);
+    }
+
+    // Same as what peltool prints
+    return pel.toJSON(_registry, {}) + '\n';
+}
+
+std::string Manager::runPeltool(uint32_t pelID)
+{
     auto cmd = std::format("/usr/bin/peltool -i {:#x}", pelID);
 
     FILE* pipe = popen(cmd.c_str(), "r");
@@ -700,6 +787,79 @@ std::string Manager::getPELJSON(uint32_t obmcLogID)
     return output;
 }
 
+const std::vector<std::string>& Manager::getParserPlugins()
+{
+    if (!_parserPlugins)
+    {
+        _parserPlugins.emplace();
+
+        for (const auto& parserDir : {"udparsers", "srcparsers"})
+        {
+            std::error_code ec;
+            auto dir = getPELParserSitePath() / parserDir;
+
+            for (const auto& entry : fs::directory_iterator(dir, ec))
+            {
+                // A plugin is a package with a module of the same name.
+                auto name = entry.path().filename().string();
+                if (entry.is_directory(ec) &&
+                    fs::exists(entry.path() / (name + ".py"), ec))
+                {
+                    _parserPlugins->push_back(name);
+                }
+            }
+        }
+    }
+
+    return *_parserPlugins;
+}
+
+bool Manager::needsParserPlugins(const openpower::pels::PEL& pel,
+                                 const std::vector<std::string>& plugins)
+{
+    auto hasPlugin = [&plugins](uint8_t creatorID, const std::string& name) {
+        if (creatorID != static_cast<uint8_t>(CreatorID::openBMC))
+        {
+            return true;
+        }
+
+        auto plugin = getNumberString("%c", tolower(creatorID)) + name;
+        return std::ranges::find(plugins, plugin) != plugins.end();
+    };
+
+    // The same plugin names that SRC::getJSON() and
+    // user_data::getJSON() look for.
+    for (const auto& section : pel.optionalSections())
+    {
+        auto sectionID = static_cast<SectionID>(section->header().id);
+        auto compID = getNumberString("%04x", section->header().componentID);
+
+        if (((sectionID == SectionID::primarySRC) ||
+             (sectionID == SectionID::secondarySRC)) &&
+            hasPlugin(pel.privateHeader().creatorID(), "src"))
+        {
+            return true;
+        }
+
+        if ((sectionID == SectionID::userData) &&
+            hasPlugin(pel.privateHeader().creatorID(), compID))
+        {
+            return true;
+        }
+
+        if (sectionID == SectionID::extUserData)
+        {
+            const auto& ed = static_cast<const ExtendedUserData&>(*section);
+            if (hasPlugin(ed.creatorID(), compID))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 void Manager::checkPelAndQuiesce(std::unique_ptr<openpower::pels::PEL>& pel)
 {
     if ((pel->userHeader().severity() ==
@@ -868,7 +1028,7 @@ void Manager::serializeLogEntry(uint32_t obmcLogID)
     auto entryN = _logManager.entries.find(obmcLogID);
     if (entryN != _logManager.entries.end())
     {
-        serialize(*entryN->second);
+        _logManager.persistUpdate(*entryN->second);
     }
 }
 
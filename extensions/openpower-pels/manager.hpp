@@ -9,6 +9,7 @@
 #include "log_manager.hpp"
 #include "paths.hpp"
 #include "pel.hpp"
+#include "pel_json_cache.hpp"
 #include "registry.hpp"
 #include "repository.hpp"
 
@@ -67,6 +68,13 @@ class Manager : public PELInterface
 
         setupPELDeleteWatch();
 
+        // The rendered JSON is stale once a PEL is changed or deleted.
+        auto invalidateJSON = [this](uint32_t pelID) {
+            _pelJSONCache.invalidate(pelID);
+        };
+        _repo.subscribeToUpdates("Manager", invalidateJSON);
+        _repo.subscribeToDeletes("Manager", invalidateJSON);
+
         _dataIface->subscribeToFruPresent(
             "Manager",
             std::bind(&Manager::hardwarePresent, this, std::placeholders::_1));
@@ -125,6 +133,14 @@ class Manager : public PELInterface
      */
     void erase(uint32_t obmcLogID);
 
+    /**
+     * @brief Erase the PELs of OpenBMC event logs that were deleted
+     *        together, such as by DeleteAll.
+     *
+     * @param[in] obmcLogIDs - the corresponding OpenBMC event log ids
+     */
+    void erase(const std::set<uint32_t>& obmcLogIDs);
+
     /**
      * @brief Get the list of event log ids that have an associated
      *        hardware isolation entry.
@@ -219,6 +235,10 @@ class Manager : public PELInterface
     /**
      * @brief D-Bus method to return the PEL in JSON format
      *
+     * The JSON is rendered in the daemon the same way peltool -i does,
+     * and is cached until the PEL changes.  Only PELs with sections that
+     * a Python parser plugin decodes still run peltool.
+     *
      * @param[in] obmcLogID - The OpenBMC entry log ID
      *
      * @return std::string - The fully parsed PEL in JSON
@@ -239,6 +259,24 @@ class Manager : public PELInterface
      */
     static std::vector<uint8_t> eselToRawData(const std::string& esel);
 
+    /**
+     * @brief Says if any of the sections of a PEL may be decoded by a
+     *        Python parser plugin, so only peltool can render it.
+     *
+     * The plugins for the SRC and UserData sections of other creators
+     * than the BMC can be in any directory on the python3 path, which
+     * peltool searches but the daemon can't, so those always need
+     * peltool.  The BMC's sections only need it if a plugin for them is
+     * in the list.
+     *
+     * @param[in] pel - The PEL
+     * @param[in] plugins - The plugins installed in the site directory
+     *
+     * @return bool - If a plugin may be needed
+     */
+    static bool needsParserPlugins(const openpower::pels::PEL& pel,
+                                   const std::vector<std::string>& plugins);
+
     /**
      * @brief Generate resolution string from the PEL
      *
@@ -398,8 +436,10 @@ class Manager : public PELInterface
      * @brief Called when the inotify watch put on the repository directory
      *        detects a PEL file was deleted.
      *
-     * Will tell the Repository class about the deleted PEL, and then tell
-     * the log manager class to delete the corresponding OpenBMC event log.
+     * Will tell the Repository class about the deleted PELs, and then tell
+     * the log manager class to delete the corresponding OpenBMC event logs.
+     * All of the events already queued are handled together, so deleting
+     * many files at once removes them with one call to each.
      */
     void pelFileDeleted(sdeventplus::source::IO& io, int fd, uint32_t revents);
 
@@ -505,6 +545,33 @@ class Manager : public PELInterface
     static bool clearPowerThermalDeconfigFlag(const std::string& locationCode,
                                               openpower::pels::PEL& pel);
 
+    /**
+     * @brief Renders a PEL in JSON for getPELJSON().
+     *
+     * @param[in] pelID - The PEL ID
+     *
+     * @return std::string - The JSON
+     */
+    std::string renderPELJSON(uint32_t pelID);
+
+    /**
+     * @brief Renders a PEL in JSON by running peltool, for PELs that
+     *        need the Python parser plugins.
+     *
+     * @param[in] pelID - The PEL ID
+     *
+     * @return std::string - The JSON
+     */
+    static std::string runPeltool(uint32_t pelID);
+
+    /**
+     * @brief Returns the names of the Python parser plugins installed,
+     *        which are found the first time this is called.
+     *
+     * @return const std::vector<std::string>& - The plugin names
+     */
+    const std::vector<std::string>& getParserPlugins();
+
     /**
      * @brief Called by DataInterface when the presence of hotpluggable
      *        hardware is detected.
@@ -552,6 +619,16 @@ class Manager : public PELInterface
      */
     std::unique_ptr<JournalBase> _journal;
 
+    /**
+     * @brief The JSON returned by getPELJSON(), by PEL ID.
+     */
+    PELJSONCache _pelJSONCache;
+
+    /**
+     * @brief The Python parser plugins installed, once they're found.
+     */
+    std::optional<std::vector<std::string>> _parserPlugins;
+
     /**
      * @brief The map used to keep track of PEL entry pointer associated with
      *        event log.
@@ -0,0 +1,313 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "parse_cache.hpp"
+
+#include "read_file.hpp"
+#include "stream.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <vector>
+
+namespace openpower::pels::user_data
+{
+
+namespace fs = std::filesystem;
+
+constexpr uint32_t cacheMagic = 0x50554443; // PUDC
+constexpr uint8_t cacheVersion = 2;
+
+namespace
+{
+
+/**
+ * @brief FNV-1a over the section data.  It is saved to the cache
+ *        file, so it can't use std::hash, which isn't guaranteed to
+ *        be the same from one build to the next.
+ */
+uint64_t hashData(std::span<const uint8_t> data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto byte : data)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+ParseCache::Key ParseCache::makeKey(uint8_t creatorID, uint16_t componentID,
+                                    uint8_t subType, uint8_t version,
+                                    std::span<const uint8_t> data)
+{
+    return Key{creatorID,
+               componentID,
+               subType,
+               version,
+               static_cast<uint32_t>(data.size()),
+               hashData(data)};
+}
+
+bool ParseCache::find(const Key& key, std::span<const uint8_t> data,
+                      std::optional<std::string>& json)
+{
+    std::lock_guard lock{_mutex};
+
+    auto entry = _entries.find(key);
+    if ((entry == _entries.end()) ||
+        !std::ranges::equal(entry->second.data, data))
+    {
+        _stats.misses++;
+        return false;
+    }
+
+    _stats.hits++;
+    json = entry->second.json;
+    return true;
+}
+
+void ParseCache::insert(const Key& key, std::span<const uint8_t> data,
+                        const std::optional<std::string>& json)
+{
+    std::lock_guard lock{_mutex};
+
+    if (add(key, Entry{{data.begin(), data.end()}, json}))
+    {
+        _modified = true;
+    }
+}
+
+bool ParseCache::add(const Key& key, Entry&& entry)
+{
+    auto size = entry.data.size() + (entry.json ? entry.json->size() : 0);
+    if (_cachedSize + size > _maxSize)
+    {
+        return false;
+    }
+
+    // A section with the same hash but different data keeps the
+    // entry already there.
+    if (!_entries.emplace(key, std::move(entry)).second)
+    {
+        return false;
+    }
+
+    _cachedSize += size;
+    return true;
+}
+
+bool ParseCache::load(const fs::path& file, uint64_t stamp)
+{
+    std::lock_guard lock{_mutex};
+
+    _entries.clear();
+    _cachedSize = 0;
+    _modified = false;
+
+    std::vector<uint8_t> data;
+    try
+    {
+        data = util::readFile(file);
+    }
+    catch (const std::system_error&)
+    {
+        return false;
+    }
+
+    try
+    {
+        Stream stream{data};
+        uint32_t magic = 0;
+        uint8_t version = 0;
+        uint64_t fileStamp = 0;
+        uint32_t count = 0;
+
+        stream >> magic >> version >> fileStamp >> count;
+        if ((magic != cacheMagic) || (version != cacheVersion) ||
+            (fileStamp != stamp))
+        {
+            return false;
+        }
+
+        // The sizes are checked before anything is allocated, as the
+        // file could be damaged.
+        auto checkSize = [&stream](uint32_t size) {
+            if (size > stream.remaining())
+            {
+                throw std::out_of_range{"Entry is larger than the file"};
+            }
+        };
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint8_t creatorID = 0;
+            uint16_t componentID = 0;
+            uint8_t subType = 0;
+            uint8_t version = 0;
+            uint32_t dataSize = 0;
+
+            stream >> creatorID >> componentID >> subType >> version >>
+                dataSize;
+            checkSize(dataSize);
+
+            Entry entry;
+            entry.data.resize(dataSize);
+            stream >> entry.data;
+
+            uint8_t hasJSON = 0;
+            uint32_t jsonSize = 0;
+            stream >> hasJSON >> jsonSize;
+            checkSize(jsonSize);
+
+            if (_cachedSize + dataSize + jsonSize > _maxSize)
+            {
+                break;
+            }
+
+            if (hasJSON)
+            {
+                std::vector<char> text(jsonSize);
+                stream >> text;
+                entry.json.emplace(text.begin(), text.end());
+            }
+
+            // The hash is made again from the data rather than
+            // trusting the file.
+            auto key = makeKey(creatorID, componentID, subType, version,
+                               entry.data);
+            add(key, std::move(entry));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Could not read PEL parser cache {FILE}: {ERROR}", "FILE",
+                   file, "ERROR", e);
+        _entries.clear();
+        _cachedSize = 0;
+        return false;
+    }
+
+    return true;
+}
+
+void ParseCache::save(const fs::path& file, uint64_t stamp)
+{
+    std::lock_guard lock{_mutex};
+
+    if (!_modified)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> data;
+    Stream stream{data};
+
+    stream << cacheMagic << cacheVersion << stamp
+           << static_cast<uint32_t>(_entries.size());
+
+    for (const auto& [key, entry] : _entries)
+    {
+        const auto& json = entry.json;
+        stream << key.creatorID << key.componentID << key.subType
+               << key.version << static_cast<uint32_t>(entry.data.size())
+               << entry.data << static_cast<uint8_t>(json.has_value())
+               << static_cast<uint32_t>(json ? json->size() : 0);
+        if (json)
+        {
+            stream << std::vector<char>(json->begin(), json->end());
+        }
+    }
+
+    // Write a temporary file and rename it, so that another
+    // peltool can't read a partially written cache.  It has a
+    // unique name so two peltools saving at once don't write the
+    // same one.
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+
+    std::string tempPath = file.string() + ".XXXXXX";
+    int fd = mkstemp(tempPath.data());
+    if (fd == -1)
+    {
+        return;
+    }
+
+    // mkstemp() makes it only readable by its owner.
+    bool written = (fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0);
+
+    size_t offset = 0;
+    while (written && (offset < data.size()))
+    {
+        auto rc = write(fd, data.data() + offset, data.size() - offset);
+        if (rc > 0)
+        {
+            offset += rc;
+        }
+        else if ((rc == -1) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            written = false;
+        }
+    }
+
+    if ((close(fd) != 0) || !written)
+    {
+        fs::remove(tempPath, ec);
+        return;
+    }
+
+    fs::rename(tempPath, file, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        return;
+    }
+
+    _modified = false;
+}
+
+size_t ParseCache::size() const
+{
+    std::lock_guard lock{_mutex};
+    return _entries.size();
+}
+
+ParseCache::Stats ParseCache::getStats() const
+{
+    std::lock_guard lock{_mutex};
+    return _stats;
+}
+
+ParseCache& getParseCache()
+{
+    static ParseCache cache;
+    return cache;
+}
+
+} // namespace openpower::pels::user_data
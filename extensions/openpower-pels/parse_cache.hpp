@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace openpower::pels::user_data
+{
+
+/**
+ * @class ParseCache
+ *
+ * Holds the JSON that the Python parser plugins returned for UserData
+ * sections, so the same data isn't passed to a plugin again.  Sections
+ * are keyed by their creator, component ID, subtype, version, and a
+ * hash of their data.  The data itself is kept too, and a section is
+ * only found if its data is the same, so two sections with the same
+ * hash can't get each other's JSON.  A plugin returning nothing is
+ * cached too.
+ *
+ * The cache can be saved to a file and loaded in a later peltool run.
+ * The file has a stamp of the installed plugins, and is ignored if
+ * the stamp passed to load() doesn't match it.
+ *
+ * Once the data and JSON in the cache add up to the maximum size, no
+ * more is added.  The cache can be used from several threads.
+ */
+class ParseCache
+{
+  public:
+    /**
+     * @brief Identifies a UserData section.
+     */
+    struct Key
+    {
+        uint8_t creatorID;
+        uint16_t componentID;
+        uint8_t subType;
+        uint8_t version;
+        uint32_t size;
+        uint64_t hash;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+    /**
+     * @brief The cache hit and miss counts.
+     */
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    static constexpr size_t defaultMaxSize = 4 * 1024 * 1024;
+
+    ~ParseCache() = default;
+    ParseCache(const ParseCache&) = delete;
+    ParseCache& operator=(const ParseCache&) = delete;
+    ParseCache(ParseCache&&) = delete;
+    ParseCache& operator=(ParseCache&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] maxSize - The most data and JSON, in bytes, to hold
+     */
+    explicit ParseCache(size_t maxSize = defaultMaxSize) : _maxSize(maxSize) {}
+
+    /**
+     * @brief Makes the key of a UserData section.
+     *
+     * @param[in] creatorID - The creator ID from the Private Header
+     * @param[in] componentID - The comp ID from the section header
+     * @param[in] subType - The subtype from the section header
+     * @param[in] version - The version from the section header
+     * @param[in] data - The section data
+     *
+     * @return Key - The key
+     */
+    static Key makeKey(uint8_t creatorID, uint16_t componentID,
+                       uint8_t subType, uint8_t version,
+                       std::span<const uint8_t> data);
+
+    /**
+     * @brief Looks up the JSON of a section.
+     *
+     * @param[in] key - The section's key
+     * @param[in] data - The section data
+     * @param[out] json - The JSON, or std::nullopt if the plugin
+     *                    didn't return any
+     *
+     * @return bool - If the section was in the cache
+     */
+    bool find(const Key& key, std::span<const uint8_t> data,
+              std::optional<std::string>& json);
+
+    /**
+     * @brief Adds the JSON of a section.
+     *
+     * @param[in] key - The section's key
+     * @param[in] data - The section data
+     * @param[in] json - The JSON, or std::nullopt if the plugin
+     *                   didn't return any
+     */
+    void insert(const Key& key, std::span<const uint8_t> data,
+                const std::optional<std::string>& json);
+
+    /**
+     * @brief Loads the sections saved to a file, replacing the cache.
+     *
+     * @param[in] file - The file
+     * @param[in] stamp - The stamp of the installed plugins
+     *
+     * @return bool - If the file was loaded
+     */
+    bool load(const std::filesystem::path& file, uint64_t stamp);
+
+    /**
+     * @brief Saves the cache to a file, if anything was added to it
+     *        since it was loaded.
+     *
+     * @param[in] file - The file
+     * @param[in] stamp - The stamp of the installed plugins
+     */
+    void save(const std::filesystem::path& file, uint64_t stamp);
+
+    /**
+     * @brief Returns the number of sections in the cache.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns the hit and miss counts.
+     */
+    Stats getStats() const;
+
+  private:
+    /**
+     * @brief The data and JSON of a section.
+     */
+    struct Entry
+    {
+        std::vector<uint8_t> data;
+        std::optional<std::string> json;
+    };
+
+    /**
+     * @brief Adds a section if it fits in the maximum size.
+     *
+     * @param[in] key - The section's key
+     * @param[in] entry - The section's data and JSON
+     *
+     * @return bool - If it was added
+     */
+    bool add(const Key& key, Entry&& entry);
+
+    /**
+     * @brief Each section
+     */
+    std::map<Key, Entry> _entries;
+
+    /**
+     * @brief The size of the data and JSON in _entries
+     */
+    size_t _cachedSize = 0;
+
+    /**
+     * @brief The most data and JSON to hold
+     */
+    size_t _maxSize;
+
+    /**
+     * @brief If sections were added since the cache was loaded
+     */
+    bool _modified = false;
+
+    /**
+     * @brief The hit and miss counts
+     */
+    Stats _stats;
+
+    /**
+     * @brief Protects everything above
+     */
+    mutable std::mutex _mutex;
+};
+
+/**
+ * @brief Returns the cache that user_data::getJSON() uses for the
+ *        Python parser plugins.
+ */
+ParseCache& getParseCache();
+
+} // namespace openpower::pels::user_data
@@ -1,6 +1,7 @@
 #pragma once
 #include "../../paths.hpp"
 
+#include <chrono>
 #include <filesystem>
 
 namespace openpower
@@ -23,6 +24,18 @@ std::filesystem::path getPELRepoPath();
  */
 std::filesystem::path getPELReadOnlyDataPath();
 
+/**
+ * @brief Returns the Python site directory that the udparsers and
+ *        srcparsers PEL parser plugins are installed under
+ */
+std::filesystem::path getPELParserSitePath();
+
+/**
+ * @brief Returns the file that peltool saves the results of the
+ *        UserData parser plugins to, for its later runs
+ */
+std::filesystem::path getPELParserCacheFile();
+
 /**
  * @brief Returns the maximum size in bytes allocated to store PELs.
  *
@@ -43,5 +56,19 @@ size_t getPELRepoSize();
  */
 size_t getMaxNumPELs();
 
+/**
+ * @brief Returns the longest time that a PEL write can wait to be
+ *        flushed to storage, so that PELs written close together can
+ *        share a single flush.
+ *
+ * A value of zero means each PEL write is flushed by itself.
+ *
+ * This is still in paths.c/hpp even though it doesn't return a path
+ * because this file is easy to override when testing.
+ *
+ * @return std::chrono::milliseconds The maximum flush latency
+ */
+std::chrono::milliseconds getPELSyncLatency();
+
 } // namespace pels
 } // namespace openpower
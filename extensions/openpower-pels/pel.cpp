@@ -217,7 +217,13 @@ PEL::PEL(std::vector<uint8_t>& data, uint32_t obmcLogID)
     populateFromRawData(data, obmcLogID);
 }
 
-void PEL::populateFromRawData(std::vector<uint8_t>& data, uint32_t obmcLogID)
+PEL::PEL(std::span<const uint8_t> data, uint32_t obmcLogID)
+{
+    populateFromRawData(data, obmcLogID);
+}
+
+void PEL::populateFromRawData(std::span<const uint8_t> data,
+                              uint32_t obmcLogID)
 {
     Stream pelData{data};
     _ph = std::make_unique<PrivateHeader>(pelData);
@@ -449,8 +455,8 @@ std::map<uint16_t, size_t> PEL::getPluralSections() const
     return sections;
 }
 
-void PEL::toJSON(message::Registry& registry,
-                 const std::vector<std::string>& plugins) const
+std::string PEL::toJSON(message::Registry& registry,
+                        const std::vector<std::string>& plugins) const
 {
     auto sections = getPluralSections();
 
@@ -468,7 +474,7 @@ void PEL::toJSON(message::Registry& registry,
     std::size_t found = buf.rfind(",");
     if (found != std::string::npos)
         buf.replace(found, 1, "");
-    std::cout << buf << std::endl;
+    return buf;
 }
 
 bool PEL::addUserDataSection(std::unique_ptr<UserData> userData)
@@ -668,21 +674,25 @@ void PEL::addJournalSections(const message::Entry& regEntry,
     {
         // Get journal entries based on the syslog id field.
         const auto& sections = std::get<message::AppCaptureList>(jc);
+        std::vector<std::pair<std::string, size_t>> captures;
         for (const auto& [syslogID, numLines] : sections)
         {
-            try
+            captures.emplace_back(syslogID, numLines);
+        }
+
+        try
+        {
+            for (auto& messages : journal.getMessagesByID(captures))
             {
-                auto messages = journal.getMessages(syslogID, numLines);
                 if (!messages.empty())
                 {
                     allMessages.push_back(std::move(messages));
                 }
             }
-            catch (const std::exception& e)
-            {
-                lg2::error("Failed during journal collection: {ERROR}", "ERROR",
-                           e);
-            }
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed during journal collection: {ERROR}", "ERROR", e);
         }
     }
 
@@ -1053,6 +1063,13 @@ std::vector<uint8_t> flattenLines(const std::vector<std::string>& lines)
 {
     std::vector<uint8_t> out;
 
+    size_t size = 0;
+    for (const auto& line : lines)
+    {
+        size += line.size() + 1;
+    }
+    out.reserve(size);
+
     for (const auto& line : lines)
     {
         out.insert(out.end(), line.begin(), line.end());
@@ -75,10 +75,8 @@ class PEL
      *
      * Build a PEL from raw data.
      *
-     * Note: Neither this nor the following constructor can take a const vector&
-     * because the Stream class that is used to read from the vector cannot take
-     * a const.  The alternative is to make a copy of the data, but as PELs can
-     * be up to 16KB that is undesireable.
+     * Note: To build a PEL from const data without making a copy of it,
+     * use the std::span constructor below.
      *
      * @param[in] data - The PEL data
      */
@@ -94,6 +92,18 @@ class PEL
      */
     PEL(std::vector<uint8_t>& data, uint32_t obmcLogID);
 
+    /**
+     * @brief Constructor
+     *
+     * Build a PEL from read only raw data, such as a memory mapped PEL
+     * file, without first copying it into a vector.  The data isn't
+     * referenced after the constructor returns.
+     *
+     * @param[in] data - the PEL data
+     * @param[in] obmcLogID - the corresponding OpenBMC event log ID
+     */
+    explicit PEL(std::span<const uint8_t> data, uint32_t obmcLogID = 0);
+
     /**
      * @brief Constructor
      *
@@ -242,12 +252,13 @@ class PEL
     void assignID();
 
     /**
-     * @brief Output a PEL in JSON.
+     * @brief Returns a PEL in JSON.
      * @param[in] registry - Registry object reference
      * @param[in] plugins - Vector of strings of plugins found in filesystem
+     * @return std::string - The JSON
      */
-    void toJSON(message::Registry& registry,
-                const std::vector<std::string>& plugins) const;
+    std::string toJSON(message::Registry& registry,
+                       const std::vector<std::string>& plugins) const;
 
     /**
      * @brief Sets the host transmission state in the User Header
@@ -333,14 +344,12 @@ class PEL
     /**
      * @brief Builds the section objects from a PEL data buffer
      *
-     * Note: The data parameter cannot be const for the same reasons
-     * as listed in the constructor.
-     *
      * @param[in] data - The PEL data
      * @param[in] obmcLogID - The OpenBMC event log ID to use for that
      *                        field in the Private Header.
      */
-    void populateFromRawData(std::vector<uint8_t>& data, uint32_t obmcLogID);
+    void populateFromRawData(std::span<const uint8_t> data,
+                             uint32_t obmcLogID);
 
     /**
      * @brief Flattens the PEL objects into the buffer
@@ -0,0 +1,67 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pel_json_cache.hpp"
+
+namespace openpower::pels
+{
+
+std::string PELJSONCache::get(uint32_t pelID,
+                              const std::function<std::string()>& render)
+{
+    if (auto it = _index.find(pelID); it != _index.end())
+    {
+        _stats.hits++;
+
+        // Move it to the front, as it is now the most recently used.
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return it->second->second;
+    }
+
+    _stats.misses++;
+
+    // If this throws, there's nothing to save.
+    auto json = render();
+
+    if (_index.size() >= maxEntries)
+    {
+        _index.erase(_entries.back().first);
+        _entries.pop_back();
+    }
+
+    _entries.emplace_front(pelID, json);
+    _index.emplace(pelID, _entries.begin());
+
+    return json;
+}
+
+void PELJSONCache::invalidate(uint32_t pelID)
+{
+    if (auto it = _index.find(pelID); it != _index.end())
+    {
+        _entries.erase(it->second);
+        _index.erase(it);
+        _stats.invalidations++;
+    }
+}
+
+void PELJSONCache::clear()
+{
+    _entries.clear();
+    _index.clear();
+    _stats.invalidations++;
+}
+
+} // namespace openpower::pels
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace openpower::pels
+{
+
+/**
+ * @class PELJSONCache
+ *
+ * Holds the JSON rendered for the GetPELJSON D-Bus method, by PEL ID,
+ * since clients such as Redfish poll for the same PELs over and over.
+ *
+ * On a miss, the function passed in renders the JSON and it is saved,
+ * replacing the least recently used entry when the cache is full.  If it
+ * throws, nothing is saved.  The owner of the cache is responsible for
+ * calling invalidate() when a PEL is changed or deleted.
+ */
+class PELJSONCache
+{
+  public:
+    /**
+     * @brief The cache hit and miss counts.
+     */
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t invalidations = 0;
+    };
+
+    PELJSONCache() = default;
+    ~PELJSONCache() = default;
+    PELJSONCache(const PELJSONCache&) = delete;
+    PELJSONCache& operator=(const PELJSONCache&) = delete;
+    PELJSONCache(PELJSONCache&&) = default;
+    PELJSONCache& operator=(PELJSONCache&&) = default;
+
+    /**
+     * @brief Returns the JSON of a PEL.
+     *
+     * @param[in] pelID - The PEL ID
+     * @param[in] render - Renders the JSON on a miss
+     *
+     * @return std::string - The JSON
+     */
+    std::string get(uint32_t pelID, const std::function<std::string()>& render);
+
+    /**
+     * @brief Removes the JSON of a PEL, for when it is changed or deleted.
+     *
+     * @param[in] pelID - The PEL ID
+     */
+    void invalidate(uint32_t pelID);
+
+    /**
+     * @brief Removes everything.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of PELs in the cache.
+     *
+     * @return size_t - The number of PELs
+     */
+    size_t size() const
+    {
+        return _index.size();
+    }
+
+    /**
+     * @brief Returns the hit and miss counts.
+     *
+     * @return const Stats& - The counts
+     */
+    const Stats& getStats() const
+    {
+        return _stats;
+    }
+
+    /**
+     * @brief The most PELs the cache will hold.  The JSON of a PEL is
+     *        usually between 5KB and 50KB.
+     */
+    static constexpr size_t maxEntries = 64;
+
+  private:
+    using Entries = std::list<std::pair<uint32_t, std::string>>;
+
+    /**
+     * @brief The JSON of each PEL, most recently used first.
+     */
+    Entries _entries;
+
+    /**
+     * @brief The position of each PEL in _entries.
+     */
+    std::unordered_map<uint32_t, Entries::iterator> _index;
+
+    /**
+     * @brief The hit and miss counts.
+     */
+    Stats _stats;
+};
+
+} // namespace openpower::pels
@@ -0,0 +1,369 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pel_list.hpp"
+
+#include "json_utils.hpp"
+#include "pel_types.hpp"
+#include "pel_values.hpp"
+#include "section_header.hpp"
+#include "stream.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace openpower::pels::list
+{
+
+namespace fs = std::filesystem;
+namespace pv = openpower::pels::pel_values;
+
+constexpr uint8_t critSysTermSeverity = 0x51;
+
+/**
+ * @brief How many items each worker may render ahead of the writer.
+ */
+constexpr size_t resultsPerWorker = 4;
+
+bool Filter::includes(const UserHeader& uh, const SRC* src) const
+{
+    if (!includeInfo && uh.severity() == 0)
+    {
+        return false;
+    }
+
+    if (critSysTerm && uh.severity() != critSysTermSeverity)
+    {
+        return false;
+    }
+
+    std::bitset<16> actionFlags{uh.actionFlags()};
+    if (!hidden && actionFlags.test(hiddenFlagBit))
+    {
+        return false;
+    }
+
+    if (src && scrubRegex)
+    {
+        auto val = src->asciiString();
+        if (std::regex_search(trimEnd(val), *scrubRegex,
+                              std::regex_constants::match_not_null))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<fs::path> getFiles(const fs::path& dir, bool reverse)
+{
+    std::vector<fs::path> files;
+
+    for (const auto& entry : fs::directory_iterator(dir))
+    {
+        if (entry.is_regular_file())
+        {
+            files.push_back(entry.path());
+        }
+    }
+
+    if (reverse)
+    {
+        std::sort(files.begin(), files.end(), std::greater<>());
+    }
+    else
+    {
+        std::sort(files.begin(), files.end());
+    }
+
+    return files;
+}
+
+std::string summarize(const PrivateHeader& ph, const UserHeader& uh,
+                      const SRC* src, message::Registry& registry)
+{
+    std::string entry =
+        "    \"" + getNumberString("0x%X", ph.id()) + "\": {\n";
+
+    if (src)
+    {
+        auto val = src->asciiString();
+        jsonInsert(entry, "SRC", trimEnd(val), 2);
+
+        auto message =
+            src->getErrorDetails(registry, DetailLevel::message, true);
+        if (message)
+        {
+            jsonInsert(entry, "Message", *message, 2);
+        }
+    }
+    else
+    {
+        jsonInsert(entry, "SRC", "No SRC", 2);
+    }
+
+    jsonInsert(entry, "PLID", getNumberString("0x%X", ph.plid()), 2);
+
+    std::string creatorID = getNumberString("%c", ph.creatorID());
+    jsonInsert(entry, "CreatorID",
+               pv::creatorIDs.contains(creatorID) ? pv::creatorIDs.at(creatorID)
+                                                  : "Unknown Creator ID",
+               2);
+
+    jsonInsert(entry, "Subsystem",
+               pv::getValue(uh.subsystem(), pel_values::subsystemValues), 2);
+
+    const auto& time = ph.commitTimestamp();
+    char timeStr[50];
+    sprintf(timeStr, "%02X/%02X/%02X%02X %02X:%02X:%02X", time.month, time.day,
+            time.yearMSB, time.yearLSB, time.hour, time.minutes, time.seconds);
+    jsonInsert(entry, "Commit Time", timeStr, 2);
+
+    jsonInsert(entry, "Sev",
+               pv::getValue(uh.severity(), pel_values::severityValues), 2);
+
+    jsonInsert(entry, "CompID",
+               getComponentName(ph.header().componentID, ph.creatorID()), 2);
+
+    // Remove the comma after the last field
+    entry.erase(entry.rfind(','), 1);
+    entry += "    }";
+
+    return entry;
+}
+
+std::optional<std::string> summarize(std::span<const uint8_t> data,
+                                     const Filter& filter,
+                                     message::Registry& registry)
+{
+    Stream stream{data};
+    PrivateHeader ph{stream};
+    UserHeader uh{stream};
+
+    if (!ph.valid() || !uh.valid())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<SRC> src;
+    auto offset = stream.offset();
+
+    for (size_t i = 2; i < ph.sectionCount(); i++)
+    {
+        if (offset + SectionHeader::flattenedSize() > data.size())
+        {
+            return std::nullopt;
+        }
+
+        Stream sectionStream{data, offset};
+        SectionHeader header;
+        sectionStream >> header;
+
+        if ((header.size < SectionHeader::flattenedSize()) ||
+            (offset + header.size > data.size()))
+        {
+            return std::nullopt;
+        }
+
+        if (!src && (header.id == static_cast<uint16_t>(SectionID::primarySRC)))
+        {
+            sectionStream.offset(offset);
+            src.emplace(sectionStream);
+            if (!src->valid())
+            {
+                return std::nullopt;
+            }
+        }
+
+        offset += header.size;
+    }
+
+    const SRC* srcPtr = src ? &*src : nullptr;
+
+    if (!filter.includes(uh, srcPtr))
+    {
+        return std::nullopt;
+    }
+
+    return summarize(ph, uh, srcPtr, registry);
+}
+
+void renderInOrder(size_t count, size_t workers, const RenderFunc& render,
+                   const WriteFunc& write)
+{
+    if ((workers <= 1) || (count <= 1))
+    {
+        for (size_t index = 0; index < count; index++)
+        {
+            auto result = render(index, 0);
+            if (result)
+            {
+                write(*result);
+            }
+        }
+        return;
+    }
+
+    workers = std::min(workers, count);
+
+    struct Result
+    {
+        bool done = false;
+        std::optional<std::string> text;
+        std::exception_ptr error;
+    };
+
+    // The rendered items that haven't been written yet, at
+    // index % window.  Workers don't start on an item until
+    // the one window items before it has been written.
+    const size_t window = workers * resultsPerWorker;
+    std::vector<Result> results(window);
+
+    std::mutex mutex;
+    std::condition_variable renderedCV;
+    std::condition_variable writtenCV;
+    size_t next = 0;
+    size_t written = 0;
+    bool stop = false;
+
+    auto work = [&](size_t worker) {
+        std::unique_lock lock{mutex};
+
+        while (true)
+        {
+            writtenCV.wait(lock, [&]() {
+                return stop || (next == count) || (next < written + window);
+            });
+
+            if (stop || (next == count))
+            {
+                return;
+            }
+
+            auto index = next++;
+            lock.unlock();
+
+            Result result{true, std::nullopt, nullptr};
+            try
+            {
+                result.text = render(index, worker);
+            }
+            catch (...)
+            {
+                result.error = std::current_exception();
+            }
+
+            lock.lock();
+            results[index % window] = std::move(result);
+            renderedCV.notify_one();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t worker = 0; worker < workers; worker++)
+    {
+        threads.emplace_back(work, worker);
+    }
+
+    std::exception_ptr error;
+
+    try
+    {
+        for (size_t index = 0; index < count; index++)
+        {
+            std::unique_lock lock{mutex};
+            auto& slot = results[index % window];
+            renderedCV.wait(lock, [&slot]() { return slot.done; });
+
+            auto result = std::move(slot);
+            slot = Result{};
+            written++;
+            lock.unlock();
+            writtenCV.notify_all();
+
+            if (result.error)
+            {
+                std::rethrow_exception(result.error);
+            }
+
+            if (result.text)
+            {
+                write(*result.text);
+            }
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard lock{mutex};
+        stop = true;
+    }
+    writtenCV.notify_all();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void Writer::write(const std::string& pel)
+{
+    switch (_format)
+    {
+        case Format::object:
+            _out << (_count == 0 ? "{\n" : ",\n") << pel;
+            break;
+        case Format::array:
+            _out << (_count == 0 ? "[\n" : ",\n\n") << pel << '\n';
+            break;
+        case Format::plain:
+            _out << pel << '\n';
+            break;
+    }
+
+    _count++;
+}
+
+void Writer::finish()
+{
+    switch (_format)
+    {
+        case Format::object:
+            _out << (_count == 0 ? "{}\n" : "\n}\n");
+            break;
+        case Format::array:
+            _out << (_count == 0 ? "[]\n" : "]\n");
+            break;
+        case Format::plain:
+            break;
+    }
+
+    _out.flush();
+}
+
+} // namespace openpower::pels::list
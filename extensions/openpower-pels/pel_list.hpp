@@ -0,0 +1,195 @@
+#pragma once
+
+#include "private_header.hpp"
+#include "registry.hpp"
+#include "src.hpp"
+#include "user_header.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <regex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace openpower::pels::list
+{
+
+/**
+ * @brief Selects which PELs peltool lists.
+ */
+struct Filter
+{
+    /** @brief If hidden PELs are included */
+    bool hidden = false;
+
+    /** @brief If informational PELs are included */
+    bool includeInfo = false;
+
+    /** @brief If only critical system terminating PELs are included */
+    bool critSysTerm = false;
+
+    /** @brief PELs with a primary SRC matching this are left out */
+    std::optional<std::regex> scrubRegex;
+
+    /**
+     * @brief Says if a PEL passes the filter.
+     *
+     * @param[in] uh - The PEL's User Header
+     * @param[in] src - The PEL's primary SRC, or nullptr if it has none
+     *
+     * @return bool - If the PEL should be listed
+     */
+    bool includes(const UserHeader& uh, const SRC* src) const;
+};
+
+/**
+ * @brief Returns the PEL files in a directory, oldest first.
+ *
+ * PEL filenames start with the commit time as a fixed width BCD
+ * hex string, so sorting them by name sorts them by commit time.
+ *
+ * @param[in] dir - The directory
+ * @param[in] reverse - If the newest should be first instead
+ *
+ * @return std::vector<std::filesystem::path> - The files
+ */
+std::vector<std::filesystem::path> getFiles(const std::filesystem::path& dir,
+                                            bool reverse);
+
+/**
+ * @brief Returns the 'peltool -l' entry of a PEL, like:
+ *
+ *    "0x50000001": {
+ *        "SRC": "BD8D1001",
+ *        ...
+ *    }
+ *
+ * @param[in] ph - The Private Header
+ * @param[in] uh - The User Header
+ * @param[in] src - The primary SRC, or nullptr if there isn't one
+ * @param[in] registry - The message registry
+ *
+ * @return std::string - The entry
+ */
+std::string summarize(const PrivateHeader& ph, const UserHeader& uh,
+                      const SRC* src, message::Registry& registry);
+
+/**
+ * @brief Returns the 'peltool -l' entry of flattened PEL data.
+ *
+ * Only the Private Header, User Header, and primary SRC sections are
+ * parsed, as nothing else is in the entry.  The other sections only
+ * have their section headers checked.
+ *
+ * @param[in] data - The PEL data
+ * @param[in] filter - Which PELs to include
+ * @param[in] registry - The message registry
+ *
+ * @return std::optional<std::string> - The entry, or std::nullopt if the
+ *                                      PEL is invalid or filtered out
+ */
+std::optional<std::string> summarize(std::span<const uint8_t> data,
+                                     const Filter& filter,
+                                     message::Registry& registry);
+
+/**
+ * @brief Renders one item, on a worker thread.
+ *
+ * Passed the item index and the worker index, so that workers can
+ * have their own copies of anything that isn't thread safe.  Returns
+ * std::nullopt to skip the item.
+ */
+using RenderFunc =
+    std::function<std::optional<std::string>(size_t index, size_t worker)>;
+
+/**
+ * @brief Writes a rendered item, on the calling thread.
+ */
+using WriteFunc = std::function<void(const std::string&)>;
+
+/**
+ * @brief Renders items on a pool of threads, and writes them in order.
+ *
+ * Workers only get ahead of the writer by a few items each, so no
+ * more than that are held in memory at once no matter how many items
+ * there are.  If a render throws, the exception is rethrown from here
+ * after the workers are stopped.
+ *
+ * @param[in] count - The number of items
+ * @param[in] workers - The number of threads, with 1 rendering
+ *                      everything on the calling thread
+ * @param[in] render - Renders an item
+ * @param[in] write - Writes a rendered item
+ */
+void renderInOrder(size_t count, size_t workers, const RenderFunc& render,
+                   const WriteFunc& write);
+
+/**
+ * @class Writer
+ *
+ * Writes peltool's output one PEL at a time as it is rendered, instead
+ * of building it all up first.
+ */
+class Writer
+{
+  public:
+    /**
+     * @brief How the PELs are written.
+     */
+    enum class Format
+    {
+        object, // -l: A JSON object of PEL entries
+        array,  // -a: A JSON array of PELs
+        plain   // -x: One hexdump after another
+    };
+
+    Writer() = delete;
+    ~Writer() = default;
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+    Writer(Writer&&) = delete;
+    Writer& operator=(Writer&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] out - The stream to write to
+     * @param[in] format - How to write the PELs
+     */
+    Writer(std::ostream& out, Format format) : _out(out), _format(format) {}
+
+    /**
+     * @brief Writes a PEL.
+     *
+     * @param[in] pel - The rendered PEL
+     */
+    void write(const std::string& pel);
+
+    /**
+     * @brief Closes the object or array, or writes an empty one
+     *        if there weren't any PELs.
+     */
+    void finish();
+
+  private:
+    /**
+     * @brief The stream to write to
+     */
+    std::ostream& _out;
+
+    /**
+     * @brief How to write the PELs
+     */
+    Format _format;
+
+    /**
+     * @brief The number of PELs written
+     */
+    size_t _count = 0;
+};
+
+} // namespace openpower::pels::list
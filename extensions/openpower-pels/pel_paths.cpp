@@ -27,6 +27,7 @@ namespace pels
 namespace fs = std::filesystem;
 static constexpr size_t defaultRepoSize = 20 * 1024 * 1024;
 static constexpr size_t defaultMaxNumPELs = 3000;
+static constexpr std::chrono::milliseconds defaultSyncLatency{100};
 
 fs::path getPELIDFile()
 {
@@ -47,6 +48,17 @@ fs::path getPELReadOnlyDataPath()
     return std::filesystem::path{"/usr/share/phosphor-logging/pels"};
 }
 
+fs::path getPELParserSitePath()
+{
+    return std::filesystem::path{PEL_PARSER_SITE_PATH};
+}
+
+fs::path getPELParserCacheFile()
+{
+    // In /run so it is in RAM and doesn't outlive a code update.
+    return std::filesystem::path{"/run/phosphor-logging/pel_parser_cache"};
+}
+
 size_t getPELRepoSize()
 {
     // For now, always use 20MB, revisit in the future if different
@@ -61,5 +73,11 @@ size_t getMaxNumPELs()
     return defaultMaxNumPELs;
 }
 
+std::chrono::milliseconds getPELSyncLatency()
+{
+    // Hardcode using the same reasoning as the repo size field.
+    return defaultSyncLatency;
+}
+
 } // namespace pels
 } // namespace openpower
@@ -0,0 +1,96 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plugin_host.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <map>
+
+namespace openpower::pels::plugin_host
+{
+
+PyObject* getFunction(const std::string& module, const std::string& function)
+{
+    // The GIL protects these
+    static std::map<std::string, PyObject*> modules;
+    static std::map<std::string, PyObject*> functions;
+
+    auto name = module + '.' + function;
+    auto func = functions.find(name);
+    if (func != functions.end())
+    {
+        return func->second;
+    }
+
+    auto mod = modules.find(module);
+    if (mod == modules.end())
+    {
+        PyObject* pModule = PyImport_ImportModule(module.c_str());
+        if (pModule == nullptr)
+        {
+            lg2::debug("Could not import PEL parser module {MODULE}: {ERROR}",
+                       "MODULE", module, "ERROR", fetchError());
+        }
+        mod = modules.emplace(module, pModule).first;
+    }
+
+    PyObject* pFunc = nullptr;
+    if (mod->second != nullptr)
+    {
+        pFunc = PyObject_GetAttrString(mod->second, function.c_str());
+        if ((pFunc == nullptr) || !PyCallable_Check(pFunc))
+        {
+            PyErr_Clear();
+            Py_XDECREF(pFunc);
+            pFunc = nullptr;
+            lg2::error("Python module error.  Function missing: {FUNC}, "
+                       "module = {MODULE}",
+                       "FUNC", function, "MODULE", module);
+        }
+    }
+
+    functions.emplace(std::move(name), pFunc);
+    return pFunc;
+}
+
+std::string fetchError()
+{
+    std::string error = "No error string found";
+    PyObject *eType, *eValue, *eTraceback;
+
+    PyErr_Fetch(&eType, &eValue, &eTraceback);
+    Py_XDECREF(eType);
+    Py_XDECREF(eTraceback);
+
+    if (eValue)
+    {
+        PyObject* pStr = PyObject_Str(eValue);
+        Py_XDECREF(eValue);
+        if (pStr)
+        {
+            const char* str = PyUnicode_AsUTF8(pStr);
+            if (str)
+            {
+                error = str;
+            }
+            Py_XDECREF(pStr);
+        }
+    }
+
+    return error;
+}
+
+} // namespace openpower::pels::plugin_host
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Python.h>
+
+#include <string>
+
+namespace openpower::pels::plugin_host
+{
+
+/**
+ * @brief Returns a function from a parser plugin module.
+ *
+ * Each module is imported the first time one of its functions is
+ * asked for, and the function objects are kept for the rest of the
+ * process, so decoding many sections only imports each plugin once.
+ * A module that fails to import, or that doesn't have the function,
+ * is remembered as well and isn't tried again.
+ *
+ * The GIL must be held.
+ *
+ * @param[in] module - The module, like udparsers.o5000.o5000
+ * @param[in] function - The function, like parseUDToJson
+ *
+ * @return PyObject* - A borrowed reference to the function, or nullptr
+ *                     if it isn't available
+ */
+PyObject* getFunction(const std::string& module, const std::string& function);
+
+/**
+ * @brief Returns the string of the current Python exception, and
+ *        clears it.
+ *
+ * The GIL must be held.
+ *
+ * @return std::string - The exception string
+ */
+std::string fetchError();
+
+} // namespace openpower::pels::plugin_host
@@ -0,0 +1,85 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "read_file.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+namespace openpower
+{
+namespace pels
+{
+namespace util
+{
+
+std::vector<uint8_t> readFile(const std::filesystem::path& path)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throw std::system_error{errno, std::generic_category(),
+                                "Unable to open " + path.string()};
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) == -1)
+    {
+        auto e = errno;
+        close(fd);
+        throw std::system_error{e, std::generic_category(),
+                                "Unable to stat " + path.string()};
+    }
+
+    std::vector<uint8_t> data(st.st_size);
+    size_t offset = 0;
+
+    // Keep going in case the file is shorter than it was
+    while (offset < data.size())
+    {
+        auto rc = read(fd, data.data() + offset, data.size() - offset);
+        if (rc == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            auto e = errno;
+            close(fd);
+            throw std::system_error{e, std::generic_category(),
+                                    "Unable to read " + path.string()};
+        }
+
+        if (rc == 0)
+        {
+            data.resize(offset);
+            break;
+        }
+
+        offset += rc;
+    }
+
+    close(fd);
+    return data;
+}
+
+} // namespace util
+} // namespace pels
+} // namespace openpower
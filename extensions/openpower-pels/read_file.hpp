@@ -0,0 +1,48 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace openpower
+{
+namespace pels
+{
+namespace util
+{
+
+/**
+ * @brief Reads the full contents of a file.
+ *
+ * The file is sized with fstat() and then read straight into the
+ * vector, instead of copying it through an ifstream's buffer byte by
+ * byte.  It takes more than one read() if a read comes up short, and
+ * the contents stop at end of file if the file shrank after fstat().
+ *
+ * Throws a std::system_error if the file cannot be opened or read.
+ *
+ * @param[in] path - The path to the file
+ *
+ * @return std::vector<uint8_t> - The file contents
+ */
+std::vector<uint8_t> readFile(const std::filesystem::path& path);
+
+} // namespace util
+} // namespace pels
+} // namespace openpower
@@ -708,145 +708,203 @@ JournalCapture getJournalCapture(const nlohmann::json& json)
 std::optional<Entry> Registry::lookup(const std::string& name, LookupType type,
                                       bool toCache)
 {
-    std::optional<nlohmann::json> registryTmp;
-    auto& registryOpt = (_registry) ? _registry : registryTmp;
-    if (!registryOpt)
+    load(!toCache);
+
+    const auto& index = (type == LookupType::name) ? _nameIndex
+                                                   : _reasonCodeIndex;
+    auto it = index.find(name);
+    if ((it == index.end()) || !_entries[it->second])
     {
-        registryOpt = readRegistry(_registryFile);
-        if (!registryOpt)
-        {
-            return std::nullopt;
-        }
-        else if (toCache)
-        {
-            // Save message registry in memory for peltool
-            _registry = std::move(registryTmp);
-        }
+        return std::nullopt;
     }
-    auto& reg = (_registry) ? _registry : registryTmp;
-    const auto& registry = reg.value();
-    // Find an entry with this name in the PEL array.
-    auto e = std::find_if(
-        registry["PELs"].begin(), registry["PELs"].end(),
-        [&name, &type](const nlohmann::json& j) {
-            return ((name == j.at("Name").get<std::string>() &&
-                     type == LookupType::name) ||
-                    (name == j.at("SRC").at("ReasonCode").get<std::string>() &&
-                     type == LookupType::reasonCode));
-        });
 
-    if (e != registry["PELs"].end())
+    auto entry = *_entries[it->second];
+    const auto& callouts = _callouts[it->second];
+    if (!callouts.empty())
     {
-        // Fill in the Entry structure from the JSON.  Most, but not all, fields
-        // are optional.
+        entry.callouts = nlohmann::json::from_msgpack(callouts);
+    }
 
-        try
-        {
-            Entry entry;
-            entry.name = (*e)["Name"];
+    return entry;
+}
 
-            if (e->contains("Subsystem"))
-            {
-                entry.subsystem = helper::getSubsystem((*e)["Subsystem"]);
-            }
+Entry Registry::parseEntry(const nlohmann::json& e, const std::string& name)
+{
+    Entry entry;
+    entry.name = e["Name"];
 
-            if (e->contains("ActionFlags"))
-            {
-                entry.actionFlags = helper::getActionFlags((*e)["ActionFlags"]);
-            }
+    if (e.contains("Subsystem"))
+    {
+        entry.subsystem = helper::getSubsystem(e["Subsystem"]);
+    }
 
-            if (e->contains("MfgActionFlags"))
-            {
-                entry.mfgActionFlags =
-                    helper::getActionFlags((*e)["MfgActionFlags"]);
-            }
+    if (e.contains("ActionFlags"))
+    {
+        entry.actionFlags = helper::getActionFlags(e["ActionFlags"]);
+    }
 
-            if (e->contains("Severity"))
-            {
-                entry.severity = helper::getSeverities((*e)["Severity"]);
-            }
+    if (e.contains("MfgActionFlags"))
+    {
+        entry.mfgActionFlags = helper::getActionFlags(e["MfgActionFlags"]);
+    }
 
-            if (e->contains("MfgSeverity"))
-            {
-                entry.mfgSeverity = helper::getSeverities((*e)["MfgSeverity"]);
-            }
+    if (e.contains("Severity"))
+    {
+        entry.severity = helper::getSeverities(e["Severity"]);
+    }
 
-            if (e->contains("EventType"))
-            {
-                entry.eventType = helper::getEventType((*e)["EventType"]);
-            }
+    if (e.contains("MfgSeverity"))
+    {
+        entry.mfgSeverity = helper::getSeverities(e["MfgSeverity"]);
+    }
 
-            if (e->contains("EventScope"))
-            {
-                entry.eventScope = helper::getEventScope((*e)["EventScope"]);
-            }
+    if (e.contains("EventType"))
+    {
+        entry.eventType = helper::getEventType(e["EventType"]);
+    }
 
-            auto& src = (*e)["SRC"];
-            entry.src.reasonCode = helper::getSRCReasonCode(src, name);
+    if (e.contains("EventScope"))
+    {
+        entry.eventScope = helper::getEventScope(e["EventScope"]);
+    }
 
-            if (src.contains("Type"))
-            {
-                entry.src.type = helper::getSRCType(src, name);
-            }
-            else
-            {
-                entry.src.type = static_cast<uint8_t>(SRCType::bmcError);
-            }
+    auto& src = e["SRC"];
+    entry.src.reasonCode = helper::getSRCReasonCode(src, name);
 
-            // Now that we know the SRC type and reason code,
-            // we can get the component ID.
-            entry.componentID = helper::getComponentID(
-                entry.src.type, entry.src.reasonCode, *e, name);
+    if (src.contains("Type"))
+    {
+        entry.src.type = helper::getSRCType(src, name);
+    }
+    else
+    {
+        entry.src.type = static_cast<uint8_t>(SRCType::bmcError);
+    }
 
-            if (src.contains("Words6To9"))
-            {
-                entry.src.hexwordADFields =
-                    helper::getSRCHexwordFields(src, name);
-            }
+    // Now that we know the SRC type and reason code,
+    // we can get the component ID.
+    entry.componentID = helper::getComponentID(
+        entry.src.type, entry.src.reasonCode, e, name);
 
-            if (src.contains("SymptomIDFields"))
-            {
-                entry.src.symptomID = helper::getSRCSymptomIDFields(src, name);
-            }
+    if (src.contains("Words6To9"))
+    {
+        entry.src.hexwordADFields = helper::getSRCHexwordFields(src, name);
+    }
 
-            if (src.contains("DeconfigFlag"))
-            {
-                entry.src.deconfigFlag = helper::getSRCDeconfigFlag(src);
-            }
+    if (src.contains("SymptomIDFields"))
+    {
+        entry.src.symptomID = helper::getSRCSymptomIDFields(src, name);
+    }
 
-            if (src.contains("CheckstopFlag"))
-            {
-                entry.src.checkstopFlag = helper::getSRCCheckstopFlag(src);
-            }
+    if (src.contains("DeconfigFlag"))
+    {
+        entry.src.deconfigFlag = helper::getSRCDeconfigFlag(src);
+    }
 
-            auto& doc = (*e)["Documentation"];
-            entry.doc.message = doc["Message"];
-            entry.doc.description = doc["Description"];
-            if (doc.contains("MessageArgSources"))
-            {
-                entry.doc.messageArgSources = doc["MessageArgSources"];
-            }
+    if (src.contains("CheckstopFlag"))
+    {
+        entry.src.checkstopFlag = helper::getSRCCheckstopFlag(src);
+    }
+
+    auto& doc = e["Documentation"];
+    entry.doc.message = doc["Message"];
+    entry.doc.description = doc["Description"];
+    if (doc.contains("MessageArgSources"))
+    {
+        entry.doc.messageArgSources = doc["MessageArgSources"];
+    }
+
+    if (e.contains("JournalCapture"))
+    {
+        entry.journalCapture = helper::getJournalCapture(e["JournalCapture"]);
+    }
+
+    return entry;
+}
+
+std::optional<Registry::FileStamp> Registry::getFileStamp() const
+{
+    // Look in /etc first in case someone put a test file there
+    FileStamp stamp;
+    std::error_code ec;
+    fs::path debugFile{fs::path{debugFilePath} / registryFileName};
+
+    stamp.path = fs::exists(debugFile, ec) ? debugFile : _registryFile;
+    stamp.modified = fs::last_write_time(stamp.path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    stamp.size = fs::file_size(stamp.path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    return stamp;
+}
+
+void Registry::load(bool checkForChanges)
+{
+    if (_loadedStamp && !checkForChanges)
+    {
+        return;
+    }
+
+    auto stamp = getFileStamp();
+    if (stamp && (stamp == _loadedStamp))
+    {
+        return;
+    }
+
+    _entries.clear();
+    _callouts.clear();
+    _nameIndex.clear();
+    _reasonCodeIndex.clear();
+    _loadedStamp.reset();
+
+    auto registry = readRegistry(_registryFile);
+
+    // Even if the file is bad, don't parse it again until it changes.
+    _loadedStamp = stamp;
+
+    if (!registry || !registry->contains("PELs"))
+    {
+        return;
+    }
+
+    auto& pels = (*registry)["PELs"];
+    _entries.reserve(pels.size());
+    _callouts.reserve(pels.size());
+
+    for (auto& e : pels)
+    {
+        auto pos = _entries.size();
+        auto& entry = _entries.emplace_back();
+        auto& callouts = _callouts.emplace_back();
+
+        try
+        {
+            // The first entry wins if a name or reason code is repeated.
+            auto name = e.at("Name").get<std::string>();
+            _nameIndex.emplace(name, pos);
+            _reasonCodeIndex.emplace(
+                e.at("SRC").at("ReasonCode").get<std::string>(), pos);
+
+            entry = parseEntry(e, name);
 
             // If there are callouts defined, save the JSON for later
             if (_loadCallouts)
             {
-                if (e->contains("Callouts"))
+                if (e.contains("Callouts"))
                 {
-                    entry.callouts = (*e)["Callouts"];
+                    callouts = nlohmann::json::to_msgpack(e["Callouts"]);
                 }
-                else if (e->contains("CalloutsUsingAD"))
+                else if (e.contains("CalloutsUsingAD"))
                 {
-                    entry.callouts = (*e)["CalloutsUsingAD"];
+                    callouts = nlohmann::json::to_msgpack(e["CalloutsUsingAD"]);
                 }
             }
-
-            if (e->contains("JournalCapture"))
-            {
-                entry.journalCapture =
-                    helper::getJournalCapture((*e)["JournalCapture"]);
-            }
-
-            return entry;
         }
         catch (const std::exception& ex)
         {
@@ -854,8 +912,6 @@ std::optional<Entry> Registry::lookup(const std::string& name, LookupType type,
                        "ERROR", ex);
         }
     }
-
-    return std::nullopt;
 }
 
 std::optional<nlohmann::json> Registry::readRegistry(
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -278,8 +279,12 @@ class Registry
      * @param[in] name - The error name, like xyz.openbmc_project.Error.Foo
      *                 - OR
      *                 - The reason code, like 0x1001
+     * The registry is parsed into its entries on the first lookup, and
+     * is parsed again if the file changes.
+     *
      * @param[in] type - LookupType enum value
-     * @param[in] toCache - boolean to cache registry in memory
+     * @param[in] toCache - If true, once the registry is loaded it won't
+     *                      be checked for changes again
      * @return optional<Entry> A filled in message registry structure if
      *                         found, otherwise an empty optional object.
      */
@@ -316,15 +321,80 @@ class Registry
     std::optional<nlohmann::json> readRegistry(
         const std::filesystem::path& registryFile);
 
+    /**
+     * @brief Loads the registry entries if they haven't been yet, or if
+     *        the registry file has changed since they were.
+     *
+     * @param[in] checkForChanges - If an already loaded registry should
+     *                              be checked for changes.
+     */
+    void load(bool checkForChanges);
+
+    /**
+     * @brief Fills in an Entry structure from its registry JSON.  Most,
+     *        but not all, fields are optional.
+     *
+     * Throws exceptions on failures.
+     *
+     * @param[in] e - The JSON for the entry, an element of 'PELs'
+     * @param[in] name - The error name, to use in a trace if things go awry.
+     *
+     * @return Entry - The entry, without the callouts filled in
+     */
+    static Entry parseEntry(const nlohmann::json& e, const std::string& name);
+
+    /**
+     * @brief Identifies the version of the registry file that was loaded.
+     */
+    struct FileStamp
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type modified;
+        uintmax_t size = 0;
+
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    /**
+     * @brief Gets the stamp of the registry file that would be read now.
+     *
+     * @return optional<FileStamp> - The stamp, or an empty optional if
+     *                               the file can't be accessed.
+     */
+    std::optional<FileStamp> getFileStamp() const;
+
     /**
      * @brief The path to the registry JSON file.
      */
     std::filesystem::path _registryFile;
 
     /**
-     * @brief The full message registry object.
+     * @brief The stamp of the loaded registry file, if one was loaded.
+     */
+    std::optional<FileStamp> _loadedStamp;
+
+    /**
+     * @brief The registry entries, in file order.  An entry that failed
+     *        to parse is left empty.
+     */
+    std::vector<std::optional<Entry>> _entries;
+
+    /**
+     * @brief The callout JSON of each entry in MessagePack form, since
+     *        it's much smaller than the JSON object.  Empty if the entry
+     *        has no callouts or callouts aren't being loaded.
+     */
+    std::vector<std::vector<uint8_t>> _callouts;
+
+    /**
+     * @brief The index into _entries of each error name.
+     */
+    std::unordered_map<std::string, size_t> _nameIndex;
+
+    /**
+     * @brief The index into _entries of each reason code, like "0x1001".
      */
-    std::optional<nlohmann::json> _registry;
+    std::unordered_map<std::string, size_t> _reasonCodeIndex;
 
     /**
      * @brief If the callout JSON should be saved in the Entry on lookup.
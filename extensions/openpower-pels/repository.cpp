@@ -15,13 +15,21 @@
  */
 #include "repository.hpp"
 
+#include "read_file.hpp"
+
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/File/error.hpp>
 
+#include <atomic>
+#include <charconv>
 #include <fstream>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 
 namespace openpower
 {
@@ -32,6 +40,7 @@ namespace fs = std::filesystem;
 namespace file_error = sdbusplus::xyz::openbmc_project::Common::File::Error;
 
 constexpr size_t warningPercentage = 95;
+constexpr size_t statBlockSize = 512;
 
 /**
  * @brief Returns the amount of space the file uses on disk.
@@ -44,7 +53,6 @@ constexpr size_t warningPercentage = 95;
  */
 size_t getFileDiskSize(const std::filesystem::path& file)
 {
-    constexpr size_t statBlockSize = 512;
     struct stat statData;
     auto rc = stat(file.c_str(), &statData);
     if (rc != 0)
@@ -58,10 +66,415 @@ size_t getFileDiskSize(const std::filesystem::path& file)
     return statData.st_blocks * statBlockSize;
 }
 
+namespace
+{
+
+/**
+ * @brief The minimum number of PELs to parse per thread during restore(),
+ *        so a small repository doesn't pay for starting threads.
+ */
+constexpr size_t minPELsPerRestoreThread = 64;
+
+/**
+ * @brief The attributes index file identifier and format version.
+ */
+constexpr uint32_t indexMagic = 0x50454C49; // 'PELI'
+constexpr uint8_t indexVersion = 1;
+
+/**
+ * @brief The offset of hex word 5 in the primary SRC section, which holds
+ *        the error status flags.
+ *
+ * It follows the section header, the 8 bytes of SRC fields, and hex
+ * words 2 - 4.
+ */
+constexpr size_t srcWord5Offset =
+    SectionHeader::flattenedSize() + 8 + (3 * sizeof(uint32_t));
+
+/**
+ * @brief One record in the attributes index.
+ *
+ * Along with the PELAttributes contents, it has the file modification time
+ * and size used to tell if the record is still current.
+ */
+struct IndexRecord
+{
+    std::string filename;
+    uint64_t modifyTime = 0;
+    uint64_t fileSize = 0;
+    uint64_t sizeOnDisk = 0;
+    uint32_t pelID = 0;
+    uint32_t obmcID = 0;
+    uint32_t plid = 0;
+    uint8_t creator = 0;
+    uint8_t subsystem = 0;
+    uint8_t severity = 0;
+    uint16_t actionFlags = 0;
+    uint8_t hostState = 0;
+    uint8_t hmcState = 0;
+    uint8_t deconfig = 0;
+    uint8_t guard = 0;
+    uint64_t creationTime = 0;
+};
+
+/**
+ * @brief Stream extraction operator for an IndexRecord
+ *
+ * @param[in] s - the stream
+ * @param[out] r - the IndexRecord object
+ */
+Stream& operator>>(Stream& s, IndexRecord& r)
+{
+    uint16_t nameSize = 0;
+    s >> nameSize;
+    std::vector<char> name(nameSize);
+    s >> name;
+    r.filename.assign(name.begin(), name.end());
+
+    s >> r.modifyTime >> r.fileSize >> r.sizeOnDisk >> r.pelID >> r.obmcID >>
+        r.plid >> r.creator >> r.subsystem >> r.severity >> r.actionFlags >>
+        r.hostState >> r.hmcState >> r.deconfig >> r.guard >> r.creationTime;
+    return s;
+}
+
+/**
+ * @brief Stream insertion operator for an IndexRecord
+ *
+ * @param[out] s - the stream
+ * @param[in] r - the IndexRecord object
+ */
+Stream& operator<<(Stream& s, const IndexRecord& r)
+{
+    s << static_cast<uint16_t>(r.filename.size());
+    s << std::vector<char>(r.filename.begin(), r.filename.end());
+
+    s << r.modifyTime << r.fileSize << r.sizeOnDisk << r.pelID << r.obmcID
+      << r.plid << r.creator << r.subsystem << r.severity << r.actionFlags
+      << r.hostState << r.hmcState << r.deconfig << r.guard << r.creationTime;
+    return s;
+}
+
+/**
+ * @brief Returns the modification time of a file in nanoseconds.
+ *
+ * @param[in] statData - The stat() results for the file
+ *
+ * @return uint64_t - The modification time
+ */
+uint64_t getModifyTime(const struct stat& statData)
+{
+    return static_cast<uint64_t>(statData.st_mtim.tv_sec) * 1000000000 +
+           statData.st_mtim.tv_nsec;
+}
+
+/**
+ * @brief Says if an attributes index record still matches its PEL file,
+ *        based on the file's modification time and size.
+ *
+ * A file modified in the same clock tick as the index was written could
+ * be changed again in that tick without its modification time changing,
+ * on a filesystem with coarse timestamps.  So the record is only used
+ * if the file is older than the index.
+ *
+ * @param[in] record - The index record
+ * @param[in] path - The PEL file
+ * @param[in] indexTime - The modification time of the index
+ *
+ * @return bool - If the record can be used
+ */
+bool isCurrent(const IndexRecord& record, const fs::path& path,
+               uint64_t indexTime)
+{
+    struct stat statData;
+    if (stat(path.c_str(), &statData) != 0)
+    {
+        return false;
+    }
+
+    return (getModifyTime(statData) == record.modifyTime) &&
+           (record.modifyTime < indexTime) &&
+           (static_cast<uint64_t>(statData.st_size) == record.fileSize) &&
+           (static_cast<TransmissionState>(record.hostState) !=
+            TransmissionState::sent);
+}
+
+/**
+ * @brief Reads the attributes index file.
+ *
+ * If the file is missing or corrupt an empty map is returned, and every
+ * PEL will be read from its file.
+ *
+ * @param[in] indexPath - The index file
+ * @param[out] indexTime - The modification time of the index file
+ *
+ * @return The records, keyed by PEL filename
+ */
+std::unordered_map<std::string, IndexRecord> readIndex(
+    const fs::path& indexPath, uint64_t& indexTime)
+{
+    std::unordered_map<std::string, IndexRecord> records;
+
+    struct stat statData;
+    if (stat(indexPath.c_str(), &statData) != 0)
+    {
+        return records;
+    }
+    indexTime = getModifyTime(statData);
+
+    std::ifstream file{indexPath, std::ios::binary};
+    if (!file.good())
+    {
+        return records;
+    }
+
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+    file.close();
+
+    try
+    {
+        Stream stream{data};
+        uint32_t magic = 0;
+        uint8_t version = 0;
+        uint32_t count = 0;
+
+        stream >> magic >> version >> count;
+        if ((magic != indexMagic) || (version != indexVersion))
+        {
+            lg2::info("Ignoring PEL attributes index with version {VERSION}",
+                      "VERSION", version);
+            return records;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            IndexRecord record;
+            stream >> record;
+            records.emplace(record.filename, std::move(record));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Could not read PEL attributes index {FILE}: {ERROR}",
+                   "FILE", indexPath, "ERROR", e);
+        records.clear();
+    }
+
+    return records;
+}
+
+/**
+ * @brief Writes the attributes index file.
+ *
+ * The data is written to a temporary file first and then renamed
+ * so a partially written index can never be read.
+ *
+ * @param[in] indexPath - The index file
+ * @param[in] records - The records to write
+ */
+void writeIndex(const fs::path& indexPath,
+                const std::vector<IndexRecord>& records)
+{
+    std::vector<uint8_t> data;
+    Stream stream{data};
+
+    stream << indexMagic << indexVersion
+           << static_cast<uint32_t>(records.size());
+    for (const auto& record : records)
+    {
+        stream << record;
+    }
+
+    auto tempPath = indexPath;
+    tempPath += ".tmp";
+
+    std::ofstream file{tempPath, std::ios::binary};
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    file.close();
+
+    std::error_code ec;
+    if (file.fail())
+    {
+        lg2::error("Unable to write PEL attributes index {FILE}", "FILE",
+                   tempPath);
+        fs::remove(tempPath, ec);
+        return;
+    }
+
+    fs::rename(tempPath, indexPath, ec);
+    if (ec)
+    {
+        lg2::error("Unable to rename PEL attributes index {FILE}: {ERROR}",
+                   "FILE", tempPath, "ERROR", ec.message());
+        fs::remove(tempPath, ec);
+    }
+}
+
+/**
+ * @brief Writes all of the data to the file descriptor.
+ *
+ * @param[in] fd - The file descriptor
+ * @param[in] data - The data to write
+ *
+ * @return int - 0 if successful, else the errno value
+ */
+int writeFile(int fd, const std::vector<uint8_t>& data)
+{
+    size_t offset = 0;
+
+    while (offset < data.size())
+    {
+        auto rc = ::write(fd, data.data() + offset, data.size() - offset);
+        if (rc == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return errno;
+        }
+
+        offset += rc;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Flushes a directory to storage, so that renames
+ *        into it are durable.
+ *
+ * @param[in] dir - The directory
+ */
+void syncDirectory(const fs::path& dir)
+{
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        return;
+    }
+
+    if (fsync(fd) != 0)
+    {
+        auto e = errno;
+        lg2::error("Unable to flush directory {DIR}, errno = {ERRNO}", "DIR",
+                   dir, "ERRNO", e);
+    }
+
+    close(fd);
+}
+
+/**
+ * @brief Builds the attributes index record for a PEL file.
+ *
+ * Only the section headers, the Private and User Header sections, and
+ * the primary SRC hex words are decoded, which is all that is needed
+ * to fill in the PELAttributes structure.  Walking all of the section
+ * headers still catches truncated files.
+ *
+ * @param[in] path - The PEL file
+ *
+ * @return The record, or an empty optional if the PEL is invalid
+ */
+std::optional<IndexRecord> readHeaders(const fs::path& path)
+{
+    struct stat statData;
+    if (stat(path.c_str(), &statData) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "stat");
+    }
+
+    auto data = util::readFile(path);
+
+    if (data.empty())
+    {
+        return std::nullopt;
+    }
+
+    Stream stream{data};
+    PrivateHeader ph{stream};
+    UserHeader uh{stream};
+
+    if (!ph.valid() || !uh.valid())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<uint32_t> srcWord5;
+    auto offset = stream.offset();
+
+    for (size_t i = 2; i < ph.sectionCount(); i++)
+    {
+        if (offset + SectionHeader::flattenedSize() > data.size())
+        {
+            return std::nullopt;
+        }
+
+        Stream sectionStream{data, offset};
+        SectionHeader header;
+        sectionStream >> header;
+
+        if ((header.size < SectionHeader::flattenedSize()) ||
+            (offset + header.size > data.size()))
+        {
+            return std::nullopt;
+        }
+
+        if (!srcWord5 &&
+            (header.id == static_cast<uint16_t>(SectionID::primarySRC)) &&
+            (header.size >= srcWord5Offset + sizeof(uint32_t)))
+        {
+            uint32_t word = 0;
+            sectionStream.offset(offset + srcWord5Offset);
+            sectionStream >> word;
+            srcWord5 = word;
+        }
+
+        offset += header.size;
+    }
+
+    // The deconfig and guard flags are only defined in BMC
+    // and hostboot SRCs.
+    auto creator = static_cast<CreatorID>(ph.creatorID());
+    if ((creator != CreatorID::openBMC) && (creator != CreatorID::hostboot))
+    {
+        srcWord5.reset();
+    }
+
+    auto flagSet = [&srcWord5](SRC::ErrorStatusFlags flag) -> uint8_t {
+        return srcWord5 && (*srcWord5 & static_cast<uint32_t>(flag));
+    };
+
+    IndexRecord record;
+    record.filename = path.filename();
+    record.modifyTime = getModifyTime(statData);
+    record.fileSize = statData.st_size;
+    record.sizeOnDisk = statData.st_blocks * statBlockSize;
+    record.pelID = ph.id();
+    record.obmcID = ph.obmcLogID();
+    record.plid = ph.plid();
+    record.creator = ph.creatorID();
+    record.subsystem = uh.subsystem();
+    record.severity = uh.severity();
+    record.actionFlags = uh.actionFlags();
+    record.hostState = uh.hostTransmissionState();
+    record.hmcState = uh.hmcTransmissionState();
+    record.deconfig = flagSet(SRC::ErrorStatusFlags::deconfigured);
+    record.guard = flagSet(SRC::ErrorStatusFlags::guarded);
+    record.creationTime = getMillisecondsSinceEpoch(ph.createTimestamp());
+
+    return record;
+}
+
+} // namespace
+
 Repository::Repository(const std::filesystem::path& basePath, size_t repoSize,
-                       size_t maxNumPELs) :
+                       size_t maxNumPELs,
+                       std::chrono::milliseconds syncLatency) :
     _logPath(basePath / "logs"), _maxRepoSize(repoSize),
-    _maxNumPELs(maxNumPELs), _archivePath(basePath / "logs" / "archive")
+    _maxNumPELs(maxNumPELs), _archivePath(basePath / "logs" / "archive"),
+    _indexPath(basePath / "attributes_index"),
+    _tempPath(basePath / "logs" / ".tmp"), _syncLatency(syncLatency)
 {
     if (!fs::exists(_logPath))
     {
@@ -73,74 +486,52 @@ Repository::Repository(const std::filesystem::path& basePath, size_t repoSize,
         fs::create_directories(_archivePath);
     }
 
+    // Anything left in here is from a write that didn't finish
+    fs::remove_all(_tempPath);
+    fs::create_directories(_tempPath);
+
+    if (_syncLatency != std::chrono::milliseconds::zero())
+    {
+        _syncTimer = std::make_unique<
+            sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+            sdeventplus::Event::get_default(),
+            [this](auto& /*timer*/) { sync(); });
+    }
+
     restore();
 }
 
+Repository::~Repository()
+{
+    sync();
+}
+
 void Repository::restore()
 {
+    uint64_t indexTime = 0;
+    auto index = readIndex(_indexPath, indexTime);
+    auto indexSize = index.size();
+    std::vector<IndexRecord> records;
+    std::vector<fs::path> stalePaths;
+
     for (auto& dirEntry : fs::directory_iterator(_logPath))
     {
         try
         {
-            if (!fs::is_regular_file(dirEntry.path()))
+            if (!dirEntry.is_regular_file())
             {
                 continue;
             }
 
-            std::ifstream file{dirEntry.path()};
-            std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
-                                      std::istreambuf_iterator<char>()};
-            file.close();
-
-            PEL pel{data};
-            if (pel.valid())
+            auto record = index.find(dirEntry.path().filename());
+            if ((record != index.end()) &&
+                isCurrent(record->second, dirEntry.path(), indexTime))
             {
-                // If the host hasn't acked it, reset the host state so
-                // it will get sent up again.
-                if (pel.hostTransmissionState() == TransmissionState::sent)
-                {
-                    pel.setHostTransmissionState(TransmissionState::newPEL);
-                    try
-                    {
-                        write(pel, dirEntry.path());
-                    }
-                    catch (const std::exception& e)
-                    {
-                        lg2::error(
-                            "Failed to save PEL after updating host state, PEL ID = {ID}",
-                            "ID", lg2::hex, pel.id());
-                    }
-                }
-
-                PELAttributes attributes{
-                    dirEntry.path(),
-                    getFileDiskSize(dirEntry.path()),
-                    pel.privateHeader().creatorID(),
-                    pel.userHeader().subsystem(),
-                    pel.userHeader().severity(),
-                    pel.userHeader().actionFlags(),
-                    pel.hostTransmissionState(),
-                    pel.hmcTransmissionState(),
-                    pel.plid(),
-                    pel.getDeconfigFlag(),
-                    pel.getGuardFlag(),
-                    getMillisecondsSinceEpoch(
-                        pel.privateHeader().createTimestamp())};
-
-                using pelID = LogID::Pel;
-                using obmcID = LogID::Obmc;
-                _pelAttributes.emplace(
-                    LogID(pelID(pel.id()), obmcID(pel.obmcLogID())),
-                    attributes);
-
-                updateRepoStats(attributes, true);
+                records.push_back(std::move(record->second));
             }
             else
             {
-                lg2::error(
-                    "Found invalid PEL file {FILE} while restoring.  Removing.",
-                    "FILE", dirEntry.path());
-                fs::remove(dirEntry.path());
+                stalePaths.push_back(dirEntry.path());
             }
         }
         catch (const std::exception& e)
@@ -150,6 +541,117 @@ void Repository::restore()
         }
     }
 
+    std::vector<std::optional<IndexRecord>> parsed(stalePaths.size());
+    std::vector<uint8_t> failed(stalePaths.size(), 0);
+    std::atomic<size_t> next = 0;
+
+    auto worker = [&]() {
+        for (auto i = next++; i < stalePaths.size(); i = next++)
+        {
+            try
+            {
+                parsed[i] = readHeaders(stalePaths[i]);
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error(
+                    "Hit exception while restoring PEL file {FILE}: {ERROR}",
+                    "FILE", stalePaths[i], "ERROR", e);
+                failed[i] = 1;
+            }
+        }
+    };
+
+    {
+        // The calling thread is one of the workers.
+        auto numThreads = std::min<size_t>(
+            std::max(std::thread::hardware_concurrency(), 1U),
+            stalePaths.size() / minPELsPerRestoreThread);
+
+        std::vector<std::jthread> threads;
+        for (size_t i = 1; i < numThreads; i++)
+        {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+    }
+
+    for (size_t i = 0; i < stalePaths.size(); i++)
+    {
+        if (failed[i])
+        {
+            continue;
+        }
+
+        if (!parsed[i])
+        {
+            lg2::error(
+                "Found invalid PEL file {FILE} while restoring.  Removing.",
+                "FILE", stalePaths[i]);
+            fs::remove(stalePaths[i]);
+            continue;
+        }
+
+        // If the host hasn't acked it, reset the host state so
+        // it will get sent up again.
+        if (static_cast<TransmissionState>(parsed[i]->hostState) ==
+            TransmissionState::sent)
+        {
+            try
+            {
+                resetHostTransState(stalePaths[i]);
+                parsed[i] = readHeaders(stalePaths[i]);
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error(
+                    "Failed to save PEL after updating host state, PEL ID = {ID}",
+                    "ID", lg2::hex, parsed[i]->pelID);
+
+                // Don't let the index record be used on the next restore.
+                parsed[i]->hostState =
+                    static_cast<uint8_t>(TransmissionState::newPEL);
+                parsed[i]->modifyTime = 0;
+            }
+        }
+
+        if (parsed[i])
+        {
+            records.push_back(std::move(*parsed[i]));
+        }
+    }
+
+    for (const auto& record : records)
+    {
+        PELAttributes attributes{
+            _logPath / record.filename,
+            record.sizeOnDisk,
+            record.creator,
+            record.subsystem,
+            record.severity,
+            record.actionFlags,
+            static_cast<TransmissionState>(record.hostState),
+            static_cast<TransmissionState>(record.hmcState),
+            record.plid,
+            record.deconfig != 0,
+            record.guard != 0,
+            record.creationTime};
+
+        using pelID = LogID::Pel;
+        using obmcID = LogID::Obmc;
+        addAttributes(LogID(pelID(record.pelID), obmcID(record.obmcID)),
+                      attributes);
+
+        updateRepoStats(attributes, true);
+    }
+
+    // Only rewrite the index if it didn't exactly match the PEL files.
+    if (!stalePaths.empty() || (records.size() != indexSize))
+    {
+        writeIndex(_indexPath, records);
+    }
+
     // Get size of archive folder
     for (auto& dirEntry : fs::directory_iterator(_archivePath))
     {
@@ -157,6 +659,14 @@ void Repository::restore()
     }
 }
 
+void Repository::resetHostTransState(const fs::path& path)
+{
+    auto data = util::readFile(path);
+    PEL pel{data};
+    pel.setHostTransmissionState(TransmissionState::newPEL);
+    write(pel, path);
+}
+
 std::string Repository::getPELFilename(uint32_t pelID, const BCDTime& time)
 {
     char name[50];
@@ -191,46 +701,254 @@ void Repository::add(std::unique_ptr<PEL>& pel)
 
     using pelID = LogID::Pel;
     using obmcID = LogID::Obmc;
-    _pelAttributes.emplace(LogID(pelID(pel->id()), obmcID(pel->obmcLogID())),
-                           attributes);
+    addAttributes(LogID(pelID(pel->id()), obmcID(pel->obmcLogID())),
+                  attributes);
 
     _lastPelID = pel->id();
 
     updateRepoStats(attributes, true);
+    indexChanged();
 
     processAddCallbacks(*pel);
 }
 
+uint32_t Repository::getPELIDKey(const LogID& id) const
+{
+    if (id.pelID.id != 0)
+    {
+        return id.pelID.id;
+    }
+
+    if (id.obmcID.id != 0)
+    {
+        // OBMC IDs are unique, but if one were ever reused, find the
+        // earliest PEL with it like a search of the map would.
+        auto [begin, end] = _obmcIDIndex.equal_range(id.obmcID.id);
+        auto it =
+            std::min_element(begin, end, [](const auto& a, const auto& b) {
+                return a.second < b.second;
+            });
+        if (it != end)
+        {
+            return it->second;
+        }
+    }
+
+    return 0;
+}
+
+std::map<Repository::LogID, Repository::PELAttributes>::const_iterator
+    Repository::findPEL(const LogID& id) const
+{
+    auto pelID = getPELIDKey(id);
+    if (pelID == 0)
+    {
+        return _pelAttributes.end();
+    }
+
+    // The map is ordered on just the PEL ID.
+    return _pelAttributes.find(LogID{LogID::Pel{pelID}});
+}
+
+std::map<Repository::LogID, Repository::PELAttributes>::iterator
+    Repository::findPEL(const LogID& id)
+{
+    auto pelID = getPELIDKey(id);
+    if (pelID == 0)
+    {
+        return _pelAttributes.end();
+    }
+
+    return _pelAttributes.find(LogID{LogID::Pel{pelID}});
+}
+
+void Repository::addAttributes(const LogID& id,
+                               const PELAttributes& attributes)
+{
+    auto [it, inserted] = _pelAttributes.emplace(id, attributes);
+
+    if (inserted && (id.obmcID.id != 0))
+    {
+        _obmcIDIndex.emplace(id.obmcID.id, id.pelID.id);
+    }
+
+    if (inserted)
+    {
+        updatePruneQueues(id, attributes, true);
+    }
+}
+
+void Repository::eraseAttributes(
+    std::map<LogID, PELAttributes>::const_iterator it)
+{
+    auto [begin, end] = _obmcIDIndex.equal_range(it->first.obmcID.id);
+    auto index = std::find_if(begin, end, [&it](const auto& entry) {
+        return entry.second == it->first.pelID.id;
+    });
+    if (index != end)
+    {
+        _obmcIDIndex.erase(index);
+    }
+
+    updatePruneQueues(it->first, it->second, false);
+
+    _pelAttributes.erase(it);
+}
+
 void Repository::write(const PEL& pel, const fs::path& path)
 {
-    std::ofstream file{path, std::ios::binary};
+    auto tempPath = _tempPath / path.filename();
+    std::error_code ec;
 
-    if (!file.good())
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+    if (fd == -1)
     {
         // If this fails, the filesystem is probably full so it isn't like
         // we could successfully create yet another error log here.
         auto e = errno;
-        fs::remove(path);
         lg2::error(
             "Unable to open PEL file {FILE} for writing, errno = {ERRNO}",
-            "FILE", path, "ERRNO", e);
+            "FILE", tempPath, "ERRNO", e);
         throw file_error::Open();
     }
 
     auto data = pel.data();
-    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    auto e = writeFile(fd, data);
 
-    if (file.fail())
+    // Without a sync timer, flush it now.
+    if ((e == 0) && !_syncTimer && (fsync(fd) != 0))
+    {
+        e = errno;
+    }
+
+    close(fd);
+
+    if (e == 0)
+    {
+        fs::rename(tempPath, path, ec);
+        e = ec.value();
+    }
+
+    if (e != 0)
     {
         // Same note as above about not being able to create an error log
         // for this case even if we wanted.
-        auto e = errno;
-        file.close();
-        fs::remove(path);
+        fs::remove(tempPath, ec);
         lg2::error("Unable to write PEL file {FILE}, errno = {ERRNO}", "FILE",
                    path, "ERRNO", e);
         throw file_error::Write();
     }
+
+    _writeStats.files++;
+    _writeStats.bytes += data.size();
+
+    if (_syncTimer)
+    {
+        startSyncTimer();
+    }
+    else
+    {
+        // Also flush the rename
+        syncDirectory(path.parent_path());
+        _writeStats.flushes++;
+    }
+}
+
+void Repository::startSyncTimer()
+{
+    if (_syncTimer && !_syncPending)
+    {
+        _syncPending = true;
+        _syncTimer->restartOnce(_syncLatency);
+    }
+}
+
+void Repository::indexChanged()
+{
+    _indexDirty = true;
+    startSyncTimer();
+}
+
+void Repository::writeAttributesIndex() const
+{
+    std::vector<IndexRecord> records;
+    records.reserve(_pelAttributes.size());
+
+    for (const auto& [id, attributes] : _pelAttributes)
+    {
+        struct stat statData;
+        if (stat(attributes.path.c_str(), &statData) != 0)
+        {
+            continue;
+        }
+
+        IndexRecord record;
+        record.filename = attributes.path.filename();
+        record.modifyTime = getModifyTime(statData);
+        record.fileSize = statData.st_size;
+        record.sizeOnDisk = attributes.sizeOnDisk;
+        record.pelID = id.pelID.id;
+        record.obmcID = id.obmcID.id;
+        record.plid = attributes.plid;
+        record.creator = attributes.creator;
+        record.subsystem = attributes.subsystem;
+        record.severity = attributes.severity;
+        record.actionFlags =
+            static_cast<uint16_t>(attributes.actionFlags.to_ulong());
+        record.hostState = static_cast<uint8_t>(attributes.hostState);
+        record.hmcState = static_cast<uint8_t>(attributes.hmcState);
+        record.deconfig = attributes.deconfig;
+        record.guard = attributes.guard;
+        record.creationTime = attributes.creationTime;
+
+        records.push_back(std::move(record));
+    }
+
+    writeIndex(_indexPath, records);
+}
+
+void Repository::sync()
+{
+    // Written first so the flush below covers it too.
+    if (_indexDirty)
+    {
+        _indexDirty = false;
+        writeAttributesIndex();
+    }
+
+    if (!_syncPending)
+    {
+        return;
+    }
+
+    _syncPending = false;
+
+    if (_syncTimer)
+    {
+        _syncTimer->setEnabled(false);
+    }
+
+    // One syncfs() covers every PEL written, and renamed, since the
+    // last one, including any in the archive directory.
+    int fd = open(_logPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        auto e = errno;
+        lg2::error("Unable to open {DIR} to flush PELs, errno = {ERRNO}",
+                   "DIR", _logPath, "ERRNO", e);
+        return;
+    }
+
+    if (syncfs(fd) != 0)
+    {
+        auto e = errno;
+        lg2::error("Unable to flush PELs, errno = {ERRNO}", "ERRNO", e);
+    }
+
+    close(fd);
+
+    _writeStats.flushes++;
 }
 
 std::optional<Repository::LogID> Repository::remove(const LogID& id)
@@ -241,6 +959,57 @@ std::optional<Repository::LogID> Repository::remove(const LogID& id)
         return std::nullopt;
     }
 
+    // Check for existense of new archive folder
+    if (!fs::exists(_archivePath))
+    {
+        fs::create_directories(_archivePath);
+    }
+
+    auto actualID = removeEntry(pel);
+
+    processDeleteCallbacks(actualID.pelID.id);
+
+    return actualID;
+}
+
+std::vector<Repository::LogID> Repository::remove(
+    const std::vector<LogID>& ids)
+{
+    std::vector<LogID> removed;
+    removed.reserve(ids.size());
+
+    if (!fs::exists(_archivePath))
+    {
+        fs::create_directories(_archivePath);
+    }
+
+    for (const auto& id : ids)
+    {
+        auto pel = findPEL(id);
+        if (pel != _pelAttributes.end())
+        {
+            removed.push_back(removeEntry(pel));
+        }
+    }
+
+    // Only tell the subscribers once every PEL is out of the repository.
+    for (const auto& id : removed)
+    {
+        processDeleteCallbacks(id.pelID.id);
+    }
+
+    if (!removed.empty())
+    {
+        lg2::info("Removed {NUM_PELS} PELs from the repository", "NUM_PELS",
+                  removed.size());
+    }
+
+    return removed;
+}
+
+Repository::LogID Repository::removeEntry(
+    std::map<LogID, PELAttributes>::iterator pel)
+{
     LogID actualID = pel->first;
     updateRepoStats(pel->second, false);
 
@@ -248,25 +1017,24 @@ std::optional<Repository::LogID> Repository::remove(const LogID& id)
         "Removing PEL from repository, PEL ID = {PEL_ID}, BMC log ID = {BMC_ID}",
         "PEL_ID", lg2::hex, actualID.pelID.id, "BMC_ID", actualID.obmcID.id);
 
-    if (fs::exists(pel->second.path))
+    // Move log file to archive folder.  It is already gone if something
+    // else deleted it, like when this is called from the inotify watch.
+    auto fileName = _archivePath / pel->second.path.filename();
+    std::error_code ec;
+    fs::rename(pel->second.path, fileName, ec);
+    if (!ec)
     {
-        // Check for existense of new archive folder
-        if (!fs::exists(_archivePath))
-        {
-            fs::create_directories(_archivePath);
-        }
-
-        // Move log file to archive folder
-        auto fileName = _archivePath / pel->second.path.filename();
-        fs::rename(pel->second.path, fileName);
-
         // Update size of file
         _archiveSize += getFileDiskSize(fileName);
     }
+    else if (ec != std::errc::no_such_file_or_directory)
+    {
+        lg2::error("Could not archive PEL file {FILE}: {ERROR}", "FILE",
+                   pel->second.path, "ERROR", ec.message());
+    }
 
-    _pelAttributes.erase(pel);
-
-    processDeleteCallbacks(actualID.pelID.id);
+    eraseAttributes(pel);
+    indexChanged();
 
     return actualID;
 }
@@ -276,18 +1044,16 @@ std::optional<std::vector<uint8_t>> Repository::getPELData(const LogID& id)
     auto pel = findPEL(id);
     if (pel != _pelAttributes.end())
     {
-        std::ifstream file{pel->second.path.c_str()};
-        if (!file.good())
+        try
+        {
+            return util::readFile(pel->second.path);
+        }
+        catch (const std::system_error& e)
         {
-            auto e = errno;
             lg2::error("Unable to open PEL file {FILE}, errno = {ERRNO}",
-                       "FILE", pel->second.path, "ERRNO", e);
+                       "FILE", pel->second.path, "ERRNO", e.code().value());
             throw file_error::Open();
         }
-
-        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
-                                  std::istreambuf_iterator<char>()};
-        return data;
     }
 
     return std::nullopt;
@@ -318,21 +1084,19 @@ void Repository::for_each(ForEachFunc func) const
 {
     for (const auto& [id, attributes] : _pelAttributes)
     {
-        std::ifstream file{attributes.path};
-
-        if (!file.good())
+        std::vector<uint8_t> data;
+        try
+        {
+            data = util::readFile(attributes.path);
+        }
+        catch (const std::system_error& e)
         {
-            auto e = errno;
             lg2::error(
                 "Repository::for_each: Unable to open PEL file {FILE}, errno = {ERRNO}",
-                "FILE", attributes.path, "ERRNO", e);
+                "FILE", attributes.path, "ERRNO", e.code().value());
             continue;
         }
 
-        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
-                                  std::istreambuf_iterator<char>()};
-        file.close();
-
         PEL pel{data};
 
         try
@@ -384,6 +1148,23 @@ void Repository::processDeleteCallbacks(uint32_t id) const
     }
 }
 
+void Repository::processUpdateCallbacks(uint32_t id) const
+{
+    for (auto& [name, func] : _updateSubscriptions)
+    {
+        try
+        {
+            func(id);
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error(
+                "PEL Repository update callback exception. Name = {NAME}, Error = {ERROR}",
+                "NAME", name, "ERROR", e);
+        }
+    }
+}
+
 std::optional<std::reference_wrapper<const Repository::PELAttributes>>
     Repository::getPELAttributes(const LogID& id) const
 {
@@ -398,9 +1179,7 @@ std::optional<std::reference_wrapper<const Repository::PELAttributes>>
 
 void Repository::setPELHostTransState(uint32_t pelID, TransmissionState state)
 {
-    LogID id{LogID::Pel{pelID}};
-    auto attr = std::find_if(_pelAttributes.begin(), _pelAttributes.end(),
-                             [&id](const auto& a) { return a.first == id; });
+    auto attr = findPEL(LogID{LogID::Pel{pelID}});
 
     if ((attr != _pelAttributes.end()) && (attr->second.hostState != state))
     {
@@ -424,9 +1203,7 @@ void Repository::setPELHostTransState(uint32_t pelID, TransmissionState state)
 
 void Repository::setPELHMCTransState(uint32_t pelID, TransmissionState state)
 {
-    LogID id{LogID::Pel{pelID}};
-    auto attr = std::find_if(_pelAttributes.begin(), _pelAttributes.end(),
-                             [&id](const auto& a) { return a.first == id; });
+    auto attr = findPEL(LogID{LogID::Pel{pelID}});
 
     if ((attr != _pelAttributes.end()) && (attr->second.hmcState != state))
     {
@@ -450,11 +1227,7 @@ void Repository::setPELHMCTransState(uint32_t pelID, TransmissionState state)
 
 bool Repository::updatePEL(const fs::path& path, PELUpdateFunc updateFunc)
 {
-    std::ifstream file{path};
-    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
-                              std::istreambuf_iterator<char>()};
-    file.close();
-
+    auto data = util::readFile(path);
     PEL pel{data};
 
     if (pel.valid())
@@ -468,18 +1241,22 @@ bool Repository::updatePEL(const fs::path& path, PELUpdateFunc updateFunc)
             //  - deconfig flag - Can be cleared for PELs that call out
             //                    hotplugged FRUs.
             // Make sure they're up to date.
-            LogID id{LogID::Pel(pel.id())};
-            auto attr =
-                std::find_if(_pelAttributes.begin(), _pelAttributes.end(),
-                             [&id](const auto& a) { return a.first == id; });
+            auto attr = findPEL(LogID{LogID::Pel(pel.id())});
             if (attr != _pelAttributes.end())
             {
+                // The states decide which prune queues it's in
+                updatePruneQueues(attr->first, attr->second, false);
+
                 attr->second.hmcState = pel.hmcTransmissionState();
                 attr->second.hostState = pel.hostTransmissionState();
                 attr->second.deconfig = pel.getDeconfigFlag();
+
+                updatePruneQueues(attr->first, attr->second, true);
             }
 
             write(pel, path);
+            indexChanged();
+            processUpdateCallbacks(pel.id());
             return true;
         }
     }
@@ -587,26 +1364,69 @@ bool Repository::sizeWarning()
            (_pelAttributes.size() > _maxNumPELs);
 }
 
-std::vector<Repository::AttributesReference> Repository::getAllPELAttributes(
-    SortOrder order) const
+Repository::PruneCategory Repository::getPruneCategory(const PELAttributes& pel)
+{
+    auto isServiceable = Repository::isServiceableSev(pel);
+
+    if (CreatorID::openBMC == static_cast<CreatorID>(pel.creator))
+    {
+        return isServiceable ? bmcServiceable : bmcInfo;
+    }
+
+    return isServiceable ? nonBMCServiceable : nonBMCInfo;
+}
+
+Repository::PruneKey Repository::getPruneKey(const LogID& id,
+                                             const PELAttributes& pel)
 {
-    std::vector<Repository::AttributesReference> attributes;
+    // The filename starts with the 16 hex digit BCD commit time, so
+    // the number it makes sorts the same as the filename does.  If
+    // it isn't a normal PEL filename just prune it first.
+    uint64_t timestamp = 0;
+    auto filename = pel.path.filename().string();
 
-    std::for_each(_pelAttributes.begin(), _pelAttributes.end(),
-                  [&attributes](auto& pelEntry) {
-                      attributes.push_back(pelEntry);
-                  });
+    if (filename.size() > 16)
+    {
+        auto result = std::from_chars(filename.data(), filename.data() + 16,
+                                      timestamp, 16);
+        if ((result.ec != std::errc{}) ||
+            (result.ptr != filename.data() + 16))
+        {
+            timestamp = 0;
+        }
+    }
 
-    std::sort(attributes.begin(), attributes.end(),
-              [order](const auto& left, const auto& right) {
-                  if (order == SortOrder::ascending)
-                  {
-                      return left.get().second.path < right.get().second.path;
-                  }
-                  return left.get().second.path > right.get().second.path;
-              });
+    return {timestamp, id.pelID.id};
+}
+
+void Repository::updatePruneQueues(const LogID& id, const PELAttributes& pel,
+                                   bool pelAdded)
+{
+    auto& queues = _pruneQueues[getPruneCategory(pel)];
+    auto key = getPruneKey(id, pel);
+
+    std::array<bool, numPrunePasses> inPass{};
+    inPass[hmcAcked] = pel.hmcState == TransmissionState::acked;
+    inPass[hostAcked] = pel.hostState == TransmissionState::acked;
+    inPass[hostSent] = pel.hostState == TransmissionState::sent;
+    inPass[anyState] = true;
+
+    for (size_t pass = 0; pass < numPrunePasses; pass++)
+    {
+        if (!inPass[pass])
+        {
+            continue;
+        }
 
-    return attributes;
+        if (pelAdded)
+        {
+            queues[pass].insert(key);
+        }
+        else
+        {
+            queues[pass].erase(key);
+        }
+    }
 }
 
 std::vector<uint32_t> Repository::prune(
@@ -617,6 +1437,9 @@ std::vector<uint32_t> Repository::prune(
               "{NUM_PELS} PELs",
               "TOTAL", _sizes.total, "NUM_PELS", _pelAttributes.size());
 
+    std::unordered_set<uint32_t> hwIsoIDs{idsWithHwIsoEntry.begin(),
+                                          idsWithHwIsoEntry.end()};
+
     // Set up the 5 functions to check if the PEL category
     // is still over its limits.
 
@@ -645,51 +1468,22 @@ std::vector<uint32_t> Repository::prune(
         return _pelAttributes.size() > _maxNumPELs * 80 / 100;
     };
 
-    // Set up the functions to determine which category a PEL is in.
-    // TODO: Return false in these functions if a PEL caused a guard record.
-
-    // A BMC informational PEL
-    IsPELTypeFunc isBMCInfo = [](const PELAttributes& pel) {
-        return (CreatorID::openBMC == static_cast<CreatorID>(pel.creator)) &&
-               !Repository::isServiceableSev(pel);
-    };
-
-    // A BMC non informational PEL
-    IsPELTypeFunc isBMCNonInfo = [](const PELAttributes& pel) {
-        return (CreatorID::openBMC == static_cast<CreatorID>(pel.creator)) &&
-               Repository::isServiceableSev(pel);
-    };
-
-    // A non BMC informational PEL
-    IsPELTypeFunc isNonBMCInfo = [](const PELAttributes& pel) {
-        return (CreatorID::openBMC != static_cast<CreatorID>(pel.creator)) &&
-               !Repository::isServiceableSev(pel);
-    };
-
-    // A non BMC non informational PEL
-    IsPELTypeFunc isNonBMCNonInfo = [](const PELAttributes& pel) {
-        return (CreatorID::openBMC != static_cast<CreatorID>(pel.creator)) &&
-               Repository::isServiceableSev(pel);
-    };
-
-    // When counting PELs, count every PEL
-    IsPELTypeFunc isAnyPEL = [](const PELAttributes& /*pel*/) { return true; };
-
     // Check all 4 categories, which will result in at most 90%
     // usage (15 + 30 + 15 + 30).
-    removePELs(overBMCInfoLimit, isBMCInfo, idsWithHwIsoEntry, obmcLogIDs);
-    removePELs(overBMCNonInfoLimit, isBMCNonInfo, idsWithHwIsoEntry,
-               obmcLogIDs);
-    removePELs(overNonBMCInfoLimit, isNonBMCInfo, idsWithHwIsoEntry,
-               obmcLogIDs);
-    removePELs(overNonBMCNonInfoLimit, isNonBMCNonInfo, idsWithHwIsoEntry,
+    // TODO: Skip PELs in these categories if they caused a guard record.
+    removePELs(overBMCInfoLimit, {bmcInfo}, hwIsoIDs, obmcLogIDs);
+    removePELs(overBMCNonInfoLimit, {bmcServiceable}, hwIsoIDs, obmcLogIDs);
+    removePELs(overNonBMCInfoLimit, {nonBMCInfo}, hwIsoIDs, obmcLogIDs);
+    removePELs(overNonBMCNonInfoLimit, {nonBMCServiceable}, hwIsoIDs,
                obmcLogIDs);
 
     // After the above pruning check if there are still too many PELs,
     // which can happen depending on PEL sizes.
     if (_pelAttributes.size() > _maxNumPELs)
     {
-        removePELs(tooManyPELsLimit, isAnyPEL, idsWithHwIsoEntry, obmcLogIDs);
+        removePELs(tooManyPELsLimit,
+                   {bmcInfo, bmcServiceable, nonBMCInfo, nonBMCServiceable},
+                   hwIsoIDs, obmcLogIDs);
     }
 
     if (!obmcLogIDs.empty())
@@ -701,76 +1495,60 @@ std::vector<uint32_t> Repository::prune(
     return obmcLogIDs;
 }
 
-void Repository::removePELs(const IsOverLimitFunc& isOverLimit,
-                            const IsPELTypeFunc& isPELType,
-                            const std::vector<uint32_t>& idsWithHwIsoEntry,
-                            std::vector<uint32_t>& removedBMCLogIDs)
+void Repository::removePELs(
+    const IsOverLimitFunc& isOverLimit,
+    const std::vector<PruneCategory>& categories,
+    const std::unordered_set<uint32_t>& idsWithHwIsoEntry,
+    std::vector<uint32_t>& removedBMCLogIDs)
 {
-    if (!isOverLimit())
-    {
-        return;
-    }
-
-    auto attributes = getAllPELAttributes(SortOrder::ascending);
-
-    // Make 4 passes on the PELs, stopping as soon as isOverLimit
-    // returns false.
-    //   Pass 1: only delete HMC acked PELs
-    //   Pass 2: only delete OS acked PELs
-    //   Pass 3: only delete PHYP sent PELs
-    //   Pass 4: delete all PELs
-    static const std::vector<std::function<bool(const PELAttributes& pel)>>
-        stateChecks{[](const auto& pel) {
-                        return pel.hmcState == TransmissionState::acked;
-                    },
-
-                    [](const auto& pel) {
-                        return pel.hostState == TransmissionState::acked;
-                    },
+    using QueueIt = std::set<PruneKey>::const_iterator;
 
-                    [](const auto& pel) {
-                        return pel.hostState == TransmissionState::sent;
-                    },
-
-                    [](const auto& /*pel*/) { return true; }};
-
-    for (const auto& stateCheck : stateChecks)
+    for (size_t pass = 0; (pass < numPrunePasses) && isOverLimit(); pass++)
     {
-        for (auto it = attributes.begin(); it != attributes.end();)
+        // Walk the queues of all the categories together, always taking
+        // the oldest PEL next.  Removing a PEL only removes it from the
+        // queues of its own category, and the position in that one has
+        // already been moved past it.
+        std::vector<std::pair<QueueIt, QueueIt>> positions;
+        for (auto category : categories)
         {
-            const auto& pel = it->get();
-            if (isPELType(pel.second) && stateCheck(pel.second))
-            {
-                auto removedID = pel.first.obmcID.id;
+            const auto& queue = _pruneQueues[category][pass];
+            positions.emplace_back(queue.begin(), queue.end());
+        }
 
-                auto idFound = std::find(idsWithHwIsoEntry.begin(),
-                                         idsWithHwIsoEntry.end(), removedID);
-                if (idFound != idsWithHwIsoEntry.end())
+        while (isOverLimit())
+        {
+            auto oldest = positions.end();
+            for (auto it = positions.begin(); it != positions.end(); ++it)
+            {
+                if ((it->first != it->second) &&
+                    ((oldest == positions.end()) ||
+                     (*it->first < *oldest->first)))
                 {
-                    ++it;
-                    continue;
+                    oldest = it;
                 }
+            }
 
-                remove(pel.first);
+            if (oldest == positions.end())
+            {
+                break;
+            }
 
-                removedBMCLogIDs.push_back(removedID);
+            auto pelID = oldest->first->second;
+            ++oldest->first;
 
-                attributes.erase(it);
+            LogID id{LogID::Pel{pelID}};
+            auto pel = findPEL(id);
+            auto removedID = pel->first.obmcID.id;
 
-                if (!isOverLimit())
-                {
-                    break;
-                }
-            }
-            else
+            if (idsWithHwIsoEntry.contains(removedID))
             {
-                ++it;
+                continue;
             }
-        }
 
-        if (!isOverLimit())
-        {
-            break;
+            remove(id);
+
+            removedBMCLogIDs.push_back(removedID);
         }
     }
 }
@@ -3,10 +3,19 @@
 #include "paths.hpp"
 #include "pel.hpp"
 
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
 #include <algorithm>
+#include <array>
 #include <bitset>
+#include <chrono>
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace openpower
 {
@@ -132,12 +141,29 @@ class Repository
         {}
     };
 
+    /**
+     * @brief Counters for the writes of PEL files.
+     */
+    struct WriteStats
+    {
+        uint64_t files = 0;
+        uint64_t bytes = 0;
+        uint64_t flushes = 0;
+    };
+
     Repository() = delete;
-    ~Repository() = default;
-    Repository(const Repository&) = default;
-    Repository& operator=(const Repository&) = default;
-    Repository(Repository&&) = default;
-    Repository& operator=(Repository&&) = default;
+    Repository(const Repository&) = delete;
+    Repository& operator=(const Repository&) = delete;
+    Repository(Repository&&) = delete;
+    Repository& operator=(Repository&&) = delete;
+
+    /**
+     * @brief Destructor
+     *
+     * Flushes any PEL writes still waiting on the sync timer, and
+     * writes the attributes index if it changed.
+     */
+    ~Repository();
 
     /**
      * @brief Constructor
@@ -145,7 +171,8 @@ class Repository
      * @param[in] basePath - the base filesystem path for the repository
      */
     explicit Repository(const std::filesystem::path& basePath) :
-        Repository(basePath, getPELRepoSize(), getMaxNumPELs())
+        Repository(basePath, getPELRepoSize(), getMaxNumPELs(),
+                   getPELSyncLatency())
     {}
 
     /**
@@ -155,9 +182,14 @@ class Repository
      * @param[in] repoSize - The maximum amount of space to use for PELs,
      *                       in bytes
      * @param[in] maxNumPELs - The maximum number of PELs to allow
+     * @param[in] syncLatency - The longest a PEL write can wait to be
+     *                          flushed to storage.  If zero, every write
+     *                          is flushed before write() returns.
      */
     Repository(const std::filesystem::path& basePath, size_t repoSize,
-               size_t maxNumPELs);
+               size_t maxNumPELs,
+               std::chrono::milliseconds syncLatency =
+                   std::chrono::milliseconds::zero());
 
     /**
      * @brief Adds a PEL to the repository
@@ -181,6 +213,20 @@ class Repository
      */
     std::optional<LogID> remove(const LogID& id);
 
+    /**
+     * @brief Removes many PELs from the repository at once
+     *
+     * Like remove(), except the delete callbacks are only called once
+     * all of the PELs are removed.  IDs of PELs not in the repository
+     * are skipped.
+     *
+     * @param[in] ids - the IDs (either the pel ID, OBMC ID, or both)
+     *                  to remove
+     *
+     * @return std::vector<LogID> - The LogIDs of the removed PELs
+     */
+    std::vector<LogID> remove(const std::vector<LogID>& ids);
+
     /**
      * @brief Generates the filename to use for the PEL ID and BCDTime.
      *
@@ -300,6 +346,35 @@ class Repository
         _deleteSubscriptions.erase(name);
     }
 
+    using UpdateCallback = std::function<void(uint32_t)>;
+
+    /**
+     * @brief Subscribe to PELs being modified by updatePEL().
+     *
+     * Every time a PEL in the repository is rewritten with new
+     * contents, the provided function will be called with the PEL
+     * ID as the argument.
+     *
+     * The function must be of type void(const uint32_t).
+     *
+     * @param[in] name - The subscription name
+     * @param[in] func - The callback function
+     */
+    void subscribeToUpdates(const std::string& name, UpdateCallback func)
+    {
+        _updateSubscriptions.emplace(name, func);
+    }
+
+    /**
+     * @brief Unsubscribe from updated PELs.
+     *
+     * @param[in] name - The subscription name
+     */
+    void unsubscribeFromUpdates(const std::string& name)
+    {
+        _updateSubscriptions.erase(name);
+    }
+
     /**
      * @brief Get the PEL attributes for a PEL
      *
@@ -352,6 +427,30 @@ class Repository
         return _sizes;
     }
 
+    /**
+     * @brief Returns the PEL file write counters
+     *
+     * @return const WriteStats& - The stats structure
+     */
+    const WriteStats& getWriteStats() const
+    {
+        return _writeStats;
+    }
+
+    /**
+     * @brief Flushes the PEL files written since the last flush
+     *        to storage.
+     *
+     * With a nonzero sync latency, PEL writes are renamed into place
+     * right away but are flushed together by this function, which runs
+     * off of a timer started by the first write after a flush.  This way
+     * a burst of PELs only costs a single flush.
+     *
+     * The attributes index is rewritten here first if PELs were added,
+     * updated, or removed since it was last written.
+     */
+    void sync();
+
     /**
      * @brief Says if the PEL is considered serviceable (not just
      *        informational) as determined by its severity.
@@ -473,16 +572,58 @@ class Repository
     /**
      * @brief Finds an entry in the _pelAttributes map.
      *
+     * Has the same matching rules as LogID::operator==, so the PEL ID
+     * is used if it is nonzero, and otherwise the OBMC ID is.  OBMC IDs
+     * are looked up in _obmcIDIndex so neither case needs a scan.
+     *
      * @param[in] id - the ID (either the pel ID, OBMC ID, or both)
      *
      * @return an iterator to the entry
      */
     std::map<LogID, PELAttributes>::const_iterator findPEL(
-        const LogID& id) const
-    {
-        return std::find_if(_pelAttributes.begin(), _pelAttributes.end(),
-                            [&id](const auto& a) { return a.first == id; });
-    }
+        const LogID& id) const;
+
+    /**
+     * @copydoc findPEL(const LogID&) const
+     */
+    std::map<LogID, PELAttributes>::iterator findPEL(const LogID& id);
+
+    /**
+     * @brief Returns the PEL ID that the LogID passed in refers to.
+     *
+     * @param[in] id - the ID (either the pel ID, OBMC ID, or both)
+     *
+     * @return uint32_t - The PEL ID, or 0 if there isn't a PEL with
+     *                    that OBMC ID.
+     */
+    uint32_t getPELIDKey(const LogID& id) const;
+
+    /**
+     * @brief Adds an entry to the _pelAttributes map and the
+     *        OBMC ID index.
+     *
+     * @param[in] id - The full LogID of the PEL
+     * @param[in] attributes - The PEL's attributes
+     */
+    void addAttributes(const LogID& id, const PELAttributes& attributes);
+
+    /**
+     * @brief Removes an entry from the _pelAttributes map and the
+     *        OBMC ID index.
+     *
+     * @param[in] it - The iterator to the entry to remove
+     */
+    void eraseAttributes(std::map<LogID, PELAttributes>::const_iterator it);
+
+    /**
+     * @brief Moves a PEL's file to the archive folder and removes its
+     *        entry, without calling the delete callbacks.
+     *
+     * @param[in] pel - The iterator to the PEL's entry
+     *
+     * @return LogID - The LogID of the removed PEL
+     */
+    LogID removeEntry(std::map<LogID, PELAttributes>::iterator pel);
 
     /**
      * @brief Call any subscribed functions for new PELs
@@ -498,15 +639,63 @@ class Repository
      */
     void processDeleteCallbacks(uint32_t id) const;
 
+    /**
+     * @brief Call any subscribed functions for updated PELs
+     *
+     * @param[in] id - The ID of the updated PEL
+     */
+    void processUpdateCallbacks(uint32_t id) const;
+
     /**
      * @brief Restores the _pelAttributes map on startup based on the existing
      *        PEL data files.
+     *
+     * PELs whose file modification time and size still match their
+     * record in the attributes index are restored from that record
+     * without reading the file.  The rest are read in parallel, only
+     * decoding the section headers, the Private and User Header
+     * sections, and the primary SRC hex words.  The index is rewritten
+     * when done.
      */
     void restore();
 
+    /**
+     * @brief Writes the attributes index for the current PELs.
+     */
+    void writeAttributesIndex() const;
+
+    /**
+     * @brief Notes that a PEL was added, updated, or removed, so the
+     *        attributes index is rewritten by the next sync().
+     *
+     * With a sync timer that is when the timer expires, and without
+     * one it is when the repository is destroyed.
+     */
+    void indexChanged();
+
+    /**
+     * @brief Starts the sync timer, if there is one and it isn't
+     *        already running.
+     */
+    void startSyncTimer();
+
+    /**
+     * @brief Restores a PEL whose host transmission state is 'sent' by
+     *        resetting it to 'new' and rewriting the file, so it will get
+     *        sent up again.
+     *
+     * @param[in] path - The PEL file
+     */
+    void resetHostTransState(const std::filesystem::path& path);
+
     /**
      * @brief Stores a PEL object in the filesystem.
      *
+     * The PEL is written to a file in the temporary directory and then
+     * renamed to the path, so a power loss can't leave a partially
+     * written file there.  It is flushed to storage either before this
+     * returns or by the next sync(), depending on the sync latency.
+     *
      * @param[in] pel - The PEL to write
      * @param[in] path - The file to write to
      *
@@ -523,31 +712,83 @@ class Repository
      */
     void updateRepoStats(const PELAttributes& pel, bool pelAdded);
 
-    enum class SortOrder
+    /**
+     * @brief The categories of PELs that each have their own
+     *        limit on how much space they can take up.
+     */
+    enum PruneCategory : size_t
     {
-        ascending,
-        descending
+        bmcInfo,
+        bmcServiceable,
+        nonBMCInfo,
+        nonBMCServiceable,
+        numPruneCategories
     };
 
     /**
-     * @brief Returns a vector of all the _pelAttributes entries sorted
-     *        as specified
+     * @brief The passes made on the PELs in a category when pruning,
+     *        in the order they're made:
+     *
+     *   hmcAcked: only delete HMC acked PELs
+     *   hostAcked: only delete OS acked PELs
+     *   hostSent: only delete PHYP sent PELs
+     *   anyState: delete all PELs
+     */
+    enum PrunePass : size_t
+    {
+        hmcAcked,
+        hostAcked,
+        hostSent,
+        anyState,
+        numPrunePasses
+    };
+
+    /**
+     * @brief The key used to order PELs for pruning, which sorts the
+     *        same as their filenames do: by the commit timestamp and
+     *        then the PEL ID.
+     */
+    using PruneKey = std::pair<uint64_t, uint32_t>;
+
+    /**
+     * @brief Returns the category that a PEL is pruned in.
+     *
+     * @param[in] pel - The PELAttributes entry for the PEL
+     *
+     * @return PruneCategory - The category
+     */
+    static PruneCategory getPruneCategory(const PELAttributes& pel);
+
+    /**
+     * @brief Returns the key a PEL is ordered by in the prune queues.
+     *
+     * @param[in] id - The LogID of the PEL
+     * @param[in] pel - The PELAttributes entry for the PEL
+     *
+     * @return PruneKey - The key
+     */
+    static PruneKey getPruneKey(const LogID& id, const PELAttributes& pel);
+
+    /**
+     * @brief Adds a PEL to, or removes it from, the prune queues
+     *        of the passes that its transmission states qualify it for.
      *
-     * @param[in] order - If the PELs should be returned in ascending
-     *                    (oldest first) or descending order.
+     * Must be called to remove a PEL before its states are changed
+     * and to add it back afterwards.
      *
-     * @return std::vector<AttributesReference> - The sorted vector of
-     *         references to the pair<LogID, PELAttributes> entries of
-     *         _pelAttributes.
+     * @param[in] id - The LogID of the PEL
+     * @param[in] pel - The PELAttributes entry for the PEL
+     * @param[in] pelAdded - true if the PEL is being added, false if removed
      */
-    std::vector<AttributesReference> getAllPELAttributes(SortOrder order) const;
+    void updatePruneQueues(const LogID& id, const PELAttributes& pel,
+                           bool pelAdded);
 
     using IsOverLimitFunc = std::function<bool()>;
-    using IsPELTypeFunc = std::function<bool(const PELAttributes&)>;
 
     /**
-     * @brief Makes 4 passes on the PELs that meet the IsPELTypeFunc
-     *        criteria removing PELs until IsOverLimitFunc returns false.
+     * @brief Makes 4 passes on the PELs in the categories passed in,
+     *        oldest first, removing PELs until IsOverLimitFunc
+     *        returns false.
      *
      *   Pass 1: only delete HMC acked PELs
      *   Pass 2: only delete Os acked PELs
@@ -557,18 +798,18 @@ class Repository
      * @param[in] isOverLimit - The bool(void) function that should
      *                          return true if PELs still need to be
      *                           removed.
-     * @param[in] isPELType - The bool(const PELAttributes&) function
-     *                         used to select the PELs to operate on.
-     * @param[in] ids - The OpenBMC event log Ids with hardware isolation
-     *                   entry.
+     * @param[in] categories - The categories of PELs to operate on.
+     * @param[in] idsWithHwIsoEntry - The OpenBMC event log Ids with
+     *                                hardware isolation entry.
      *
      * @param[out] removedBMCLogIDs - The OpenBMC event log IDs of the
      *                                removed PELs.
      */
     void removePELs(const IsOverLimitFunc& isOverLimit,
-                    const IsPELTypeFunc& isPELType,
-                    const std::vector<uint32_t>& idsWithHwIsoEntry,
+                    const std::vector<PruneCategory>& categories,
+                    const std::unordered_set<uint32_t>& idsWithHwIsoEntry,
                     std::vector<uint32_t>& removedBMCLogIDs);
+
     /**
      * @brief The filesystem path to the PEL logs.
      */
@@ -579,6 +820,25 @@ class Repository
      */
     std::map<LogID, PELAttributes> _pelAttributes;
 
+    /**
+     * @brief A map of OBMC IDs to PEL IDs for the entries in
+     *        _pelAttributes, so finding a PEL by its OBMC ID
+     *        doesn't require searching through every entry.
+     *
+     * It holds every PEL with an OBMC ID, so if an OBMC ID were ever
+     * reused, the other PEL can still be found once one is removed.
+     */
+    std::unordered_multimap<uint32_t, uint32_t> _obmcIDIndex;
+
+    /**
+     * @brief The PELs in each prune category, in pruning order, for
+     *        each prune pass they qualify for.  This way pruning
+     *        doesn't need to sort or search through all of the PELs.
+     */
+    std::array<std::array<std::set<PruneKey>, numPrunePasses>,
+               numPruneCategories>
+        _pruneQueues;
+
     /**
      * @brief Subcriptions for new PELs.
      */
@@ -589,6 +849,11 @@ class Repository
      */
     std::map<std::string, DeleteCallback> _deleteSubscriptions;
 
+    /**
+     * @brief Subscriptions for updated PELs.
+     */
+    std::map<std::string, UpdateCallback> _updateSubscriptions;
+
     /**
      * @brief The maximum amount of space that the PELs in the
      *        repository can occupy.
@@ -620,6 +885,47 @@ class Repository
      * @brief The size of archive folder.
      */
     uint64_t _archiveSize = 0;
+
+    /**
+     * @brief The filesystem path to the PEL attributes index, which
+     *        is used to speed up restore().
+     */
+    const std::filesystem::path _indexPath;
+
+    /**
+     * @brief The directory PELs are written to before being renamed
+     *        into place.
+     */
+    const std::filesystem::path _tempPath;
+
+    /**
+     * @brief The longest a PEL write can wait before being flushed.
+     */
+    const std::chrono::milliseconds _syncLatency;
+
+    /**
+     * @brief The timer that calls sync() after a write, if there
+     *        is a sync latency.
+     */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        _syncTimer;
+
+    /**
+     * @brief If there have been writes since the last sync().
+     */
+    bool _syncPending = false;
+
+    /**
+     * @brief If PELs have changed since the attributes index was
+     *        written.
+     */
+    bool _indexDirty = false;
+
+    /**
+     * @brief The PEL file write counters.
+     */
+    WriteStats _writeStats;
 };
 
 } // namespace pels
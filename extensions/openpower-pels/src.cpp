@@ -20,6 +20,8 @@
 #include "paths.hpp"
 #include "pel_values.hpp"
 #ifdef PELTOOL
+#include "plugin_host.hpp"
+
 #include <Python.h>
 
 #include <nlohmann/json.hpp>
@@ -48,6 +50,11 @@ void pyDecRef(PyObject* pyObj)
     Py_XDECREF(pyObj);
 }
 
+void pyReleaseGIL(PyGILState_STATE* state)
+{
+    PyGILState_Release(*state);
+}
+
 /**
  * @brief Returns a JSON string to append to SRC section.
  *
@@ -126,136 +133,69 @@ std::string prettyJSON(const orderedJSON& json)
 std::optional<std::string> getPythonJSON(std::vector<std::string>& hexwords,
                                          uint8_t creatorID)
 {
-    PyObject *pName, *pModule, *eType, *eValue, *eTraceback;
-    std::string pErrStr;
+    // peltool can render PELs on several threads, so hold the GIL
+    // until the objects below have been released.
+    PyGILState_STATE gilState = PyGILState_Ensure();
+    std::unique_ptr<PyGILState_STATE, decltype(&pyReleaseGIL)> gilPtr(
+        &gilState, &pyReleaseGIL);
+
     std::string module = getNumberString("%c", tolower(creatorID)) + "src";
-    pName = PyUnicode_FromString(
-        std::string("srcparsers." + module + "." + module).c_str());
-    std::unique_ptr<PyObject, decltype(&pyDecRef)> modNamePtr(pName, &pyDecRef);
-    pModule = PyImport_Import(pName);
-    if (pModule == NULL)
+    PyObject* pFunc = plugin_host::getFunction(
+        "srcparsers." + module + "." + module, "parseSRCToJson");
+    if (pFunc == nullptr)
     {
-        pErrStr = "No error string found";
-        PyErr_Fetch(&eType, &eValue, &eTraceback);
-        if (eType)
-        {
-            Py_XDECREF(eType);
-        }
-        if (eTraceback)
-        {
-            Py_XDECREF(eTraceback);
-        }
-        if (eValue)
+        return std::nullopt;
+    }
+
+    PyObject* pArgs = PyTuple_New(9);
+    std::unique_ptr<PyObject, decltype(&pyDecRef)> argPtr(pArgs, &pyDecRef);
+    for (size_t i = 0; i < 9; i++)
+    {
+        std::string arg{"00000000"};
+        if (i < hexwords.size())
         {
-            PyObject* pStr = PyObject_Str(eValue);
-            Py_XDECREF(eValue);
-            if (pStr)
-            {
-                pErrStr = PyUnicode_AsUTF8(pStr);
-                Py_XDECREF(pStr);
-            }
+            arg = hexwords[i];
         }
+        PyTuple_SetItem(pArgs, i, Py_BuildValue("s", arg.c_str()));
     }
-    else
+    PyObject* pResult = PyObject_CallObject(pFunc, pArgs);
+    if (pResult == nullptr)
     {
-        std::unique_ptr<PyObject, decltype(&pyDecRef)> modPtr(
-            pModule, &pyDecRef);
-        std::string funcToCall = "parseSRCToJson";
-        PyObject* pKey = PyUnicode_FromString(funcToCall.c_str());
-        std::unique_ptr<PyObject, decltype(&pyDecRef)> keyPtr(pKey, &pyDecRef);
-        PyObject* pDict = PyModule_GetDict(pModule);
-        Py_INCREF(pDict);
-        if (!PyDict_Contains(pDict, pKey))
-        {
-            Py_DECREF(pDict);
-            lg2::error(
-                "Python module error.  Function missing: {FUNC}, SRC = {SRC}, module = {MODULE}",
-                "FUNC", funcToCall, "SRC", hexwords.front(), "MODULE", module);
-            return std::nullopt;
-        }
-        PyObject* pFunc = PyDict_GetItemString(pDict, funcToCall.c_str());
-        Py_DECREF(pDict);
-        Py_INCREF(pFunc);
-        if (PyCallable_Check(pFunc))
-        {
-            PyObject* pArgs = PyTuple_New(9);
-            std::unique_ptr<PyObject, decltype(&pyDecRef)> argPtr(
-                pArgs, &pyDecRef);
-            for (size_t i = 0; i < 9; i++)
-            {
-                std::string arg{"00000000"};
-                if (i < hexwords.size())
-                {
-                    arg = hexwords[i];
-                }
-                PyTuple_SetItem(pArgs, i, Py_BuildValue("s", arg.c_str()));
-            }
-            PyObject* pResult = PyObject_CallObject(pFunc, pArgs);
-            Py_DECREF(pFunc);
-            if (pResult)
-            {
-                std::unique_ptr<PyObject, decltype(&pyDecRef)> resPtr(
-                    pResult, &pyDecRef);
+        lg2::debug("Python exception thrown by parser. Error = {ERROR}, "
+                   "SRC = {SRC}, module = {MODULE}",
+                   "ERROR", plugin_host::fetchError(), "SRC", hexwords.front(),
+                   "MODULE", module);
+        return std::nullopt;
+    }
 
-                if (pResult == Py_None)
-                {
-                    return std::nullopt;
-                }
+    std::unique_ptr<PyObject, decltype(&pyDecRef)> resPtr(pResult, &pyDecRef);
 
-                PyObject* pBytes =
-                    PyUnicode_AsEncodedString(pResult, "utf-8", "~E~");
-                std::unique_ptr<PyObject, decltype(&pyDecRef)> pyBytePtr(
-                    pBytes, &pyDecRef);
-                const char* output = PyBytes_AS_STRING(pBytes);
-                try
-                {
-                    orderedJSON json = orderedJSON::parse(output);
-                    if ((json.is_object() && !json.empty()) ||
-                        (json.is_array() && json.size() > 0) ||
-                        (json.is_string() && json != ""))
-                    {
-                        return prettyJSON(json);
-                    }
-                }
-                catch (const std::exception& e)
-                {
-                    lg2::error(
-                        "Bad JSON from parser. Error = {ERROR}, SRC = {SRC}, module = {MODULE}",
-                        "ERROR", e, "SRC", hexwords.front(), "MODULE", module);
-                    return std::nullopt;
-                }
-            }
-            else
-            {
-                pErrStr = "No error string found";
-                PyErr_Fetch(&eType, &eValue, &eTraceback);
-                if (eType)
-                {
-                    Py_XDECREF(eType);
-                }
-                if (eTraceback)
-                {
-                    Py_XDECREF(eTraceback);
-                }
-                if (eValue)
-                {
-                    PyObject* pStr = PyObject_Str(eValue);
-                    Py_XDECREF(eValue);
-                    if (pStr)
-                    {
-                        pErrStr = PyUnicode_AsUTF8(pStr);
-                        Py_XDECREF(pStr);
-                    }
-                }
-            }
+    if (pResult == Py_None)
+    {
+        return std::nullopt;
+    }
+
+    PyObject* pBytes = PyUnicode_AsEncodedString(pResult, "utf-8", "~E~");
+    std::unique_ptr<PyObject, decltype(&pyDecRef)> pyBytePtr(pBytes,
+                                                             &pyDecRef);
+    const char* output = PyBytes_AS_STRING(pBytes);
+    try
+    {
+        orderedJSON json = orderedJSON::parse(output);
+        if ((json.is_object() && !json.empty()) ||
+            (json.is_array() && json.size() > 0) ||
+            (json.is_string() && json != ""))
+        {
+            return prettyJSON(json);
         }
     }
-    if (!pErrStr.empty())
+    catch (const std::exception& e)
     {
-        lg2::debug("Python exception thrown by parser. Error = {ERROR}, "
-                   "SRC = {SRC}, module = {MODULE}",
-                   "ERROR", pErrStr, "SRC", hexwords.front(), "MODULE", module);
+        lg2::error(
+            "Bad JSON from parser. Error = {ERROR}, SRC = {SRC}, module = {MODULE}",
+            "ERROR", e, "SRC", hexwords.front(), "MODULE", module);
     }
+
     return std::nullopt;
 }
 #endif
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -45,6 +46,9 @@ inline uint64_t ntohll(uint64_t value)
  *
  * This class is used for getting data types into and out of a vector<uint8_t>
  * that contains data in network byte (big endian) ordering.
+ *
+ * It can also be constructed over a read only span of data, such as a memory
+ * mapped file, in which case it can only be read from.
  */
 class Stream
 {
@@ -61,7 +65,7 @@ class Stream
      *
      * @param[in] data - the vector of data
      */
-    explicit Stream(std::vector<uint8_t>& data) : _data(data), _offset(0) {}
+    explicit Stream(std::vector<uint8_t>& data) : _vector(&data), _offset(0) {}
 
     /**
      * @brief Constructor
@@ -70,9 +74,35 @@ class Stream
      * @param[in] offset - the starting offset
      */
     Stream(std::vector<uint8_t>& data, std::size_t offset) :
-        _data(data), _offset(offset)
+        _vector(&data), _offset(offset)
+    {
+        if (_offset >= size())
+        {
+            throw std::out_of_range("Offset out of range");
+        }
+    }
+
+    /**
+     * @brief Constructor for a read only stream
+     *
+     * The data must outlive the stream, and nothing can be
+     * written to it.
+     *
+     * @param[in] data - the span of data
+     */
+    explicit Stream(std::span<const uint8_t> data) : _view(data), _offset(0)
+    {}
+
+    /**
+     * @brief Constructor for a read only stream
+     *
+     * @param[in] data - the span of data
+     * @param[in] offset - the starting offset
+     */
+    Stream(std::span<const uint8_t> data, std::size_t offset) :
+        _view(data), _offset(offset)
     {
-        if (_offset >= _data.size())
+        if (_offset >= size())
         {
             throw std::out_of_range("Offset out of range");
         }
@@ -279,7 +309,7 @@ class Stream
      */
     void offset(std::size_t newOffset)
     {
-        if (newOffset >= _data.size())
+        if (newOffset >= size())
         {
             throw std::out_of_range("new offset out of range");
         }
@@ -305,8 +335,8 @@ class Stream
      */
     std::size_t remaining() const
     {
-        assert(_data.size() >= _offset);
-        return _data.size() - _offset;
+        assert(size() >= _offset);
+        return size() - _offset;
     }
 
     /**
@@ -318,7 +348,7 @@ class Stream
     void read(void* out, std::size_t size)
     {
         rangeCheck(size);
-        memcpy(out, &_data[_offset], size);
+        memcpy(out, data() + _offset, size);
         _offset += size;
     }
 
@@ -330,12 +360,17 @@ class Stream
      */
     void write(const void* in, std::size_t size)
     {
+        if (_vector == nullptr)
+        {
+            throw std::logic_error("Attempted write to a read only stream");
+        }
+
         size_t newSize = _offset + size;
-        if (newSize > _data.size())
+        if (newSize > _vector->size())
         {
-            _data.resize(newSize, 0);
+            _vector->resize(newSize, 0);
         }
-        memcpy(&_data[_offset], in, size);
+        memcpy(_vector->data() + _offset, in, size);
         _offset += size;
     }
 
@@ -347,20 +382,48 @@ class Stream
      */
     void rangeCheck(std::size_t size)
     {
-        if (_offset + size > _data.size())
+        if (_offset + size > this->size())
         {
             std::string msg{"Attempted stream overflow: offset "};
             msg += std::to_string(_offset) + " buffer size " +
-                   std::to_string(_data.size()) + " op size " +
+                   std::to_string(this->size()) + " op size " +
                    std::to_string(size);
             throw std::out_of_range(msg.c_str());
         }
     }
 
     /**
-     * @brief The data that the stream accesses.
+     * @brief Returns a pointer to the start of the data.
+     *
+     * The vector is always checked as writes can reallocate it.
+     *
+     * @return const uint8_t* - The data
+     */
+    const uint8_t* data() const
+    {
+        return (_vector != nullptr) ? _vector->data() : _view.data();
+    }
+
+    /**
+     * @brief Returns the size of the data.
+     *
+     * @return size_t - The size
+     */
+    std::size_t size() const
+    {
+        return (_vector != nullptr) ? _vector->size() : _view.size();
+    }
+
+    /**
+     * @brief The vector that the stream accesses, if it isn't read only.
+     */
+    std::vector<uint8_t>* _vector = nullptr;
+
+    /**
+     * @brief The read only data that the stream accesses, if there is
+     *        no vector.
      */
-    std::vector<uint8_t>& _data;
+    std::span<const uint8_t> _view;
 
     /**
      * @brief The current offset of the stream.
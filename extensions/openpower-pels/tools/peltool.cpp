@@ -19,21 +19,27 @@
 
 #include "../bcd_time.hpp"
 #include "../json_utils.hpp"
+#include "../parse_cache.hpp"
 #include "../paths.hpp"
 #include "../pel.hpp"
+#include "../pel_list.hpp"
 #include "../pel_types.hpp"
 #include "../pel_values.hpp"
+#include "../read_file.hpp"
 
 #include <Python.h>
+#include <sys/stat.h>
 
 #include <CLI/CLI.hpp>
 #include <phosphor-logging/log.hpp>
+#include <sdbusplus/bus.hpp>
 
-#include <bitset>
 #include <fstream>
 #include <iostream>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <thread>
 
 namespace fs = std::filesystem;
 using namespace phosphor::logging;
@@ -41,8 +47,6 @@ using namespace openpower::pels;
 namespace message = openpower::pels::message;
 namespace pv = openpower::pels::pel_values;
 
-const uint8_t critSysTermSeverity = 0x51;
-
 using PELFunc = std::function<void(const PEL&, bool hexDump)>;
 message::Registry registry(getPELReadOnlyDataPath() / message::registryFileName,
                            false);
@@ -68,121 +72,6 @@ std::string pelLogDir()
     return std::string(phosphor::logging::paths::extension()) + "/pels/logs";
 }
 
-/**
- * @brief helper function to get PEL commit timestamp from file name
- * @retrun uint64_t - PEL commit timestamp
- * @param[in] std::string - file name
- */
-uint64_t fileNameToTimestamp(const std::string& fileName)
-{
-    std::string token = fileName.substr(0, fileName.find("_"));
-    uint64_t bcdTime = 0;
-    if (token.length() >= 14)
-    {
-        int i = 0;
-
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= (static_cast<uint64_t>(tmp) << 56);
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-        i += 2;
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= (static_cast<uint64_t>(tmp) << 48);
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-        i += 2;
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= (static_cast<uint64_t>(tmp) << 40);
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-        i += 2;
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= (static_cast<uint64_t>(tmp) << 32);
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-        i += 2;
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= (tmp << 24);
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-        i += 2;
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= (tmp << 16);
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-        i += 2;
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= (tmp << 8);
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-        i += 2;
-        try
-        {
-            auto tmp = std::stoul(token.substr(i, 2), 0, 16);
-            bcdTime |= tmp;
-        }
-        catch (const std::exception& err)
-        {
-            std::cout << "Conversion failure: " << err.what() << std::endl;
-        }
-    }
-    return bcdTime;
-}
-
-/**
- * @brief helper function to get PEL id from file name
- * @retrun uint32_t - PEL id
- * @param[in] std::string - file name
- */
-uint32_t fileNameToPELId(const std::string& fileName)
-{
-    uint32_t num = 0;
-    try
-    {
-        num = std::stoul(fileName.substr(fileName.find("_") + 1), 0, 16);
-    }
-    catch (const std::exception& err)
-    {
-        std::cout << "Conversion failure: " << err.what() << std::endl;
-    }
-    return num;
-}
-
 /**
  * @brief Check if the string ends with the PEL ID string passed in
  * @param[in] str - string to check for PEL ID
@@ -217,25 +106,54 @@ bool endsWithPelID(const std::string& str, const std::string& pelID)
  */
 std::vector<uint8_t> getFileData(const std::string& name)
 {
-    std::ifstream file(name, std::ifstream::in);
-    if (file.good())
+    try
     {
-        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
-                                  std::istreambuf_iterator<char>()};
-        return data;
+        return openpower::pels::util::readFile(name);
     }
-    else
+    catch (const std::system_error&)
     {
         return {};
     }
 }
 
+/**
+ * @brief Returns the modification time of a file in nanoseconds.
+ *
+ * @param[in] path - The file
+ *
+ * @return uint64_t - The modification time, or 0 if it isn't available
+ */
+uint64_t getModifyTime(const fs::path& path)
+{
+    struct stat statData;
+    if (stat(path.c_str(), &statData) != 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(statData.st_mtim.tv_sec) * 1000000000 +
+           statData.st_mtim.tv_nsec;
+}
+
+/**
+ * @brief If the UserData parse cache is loaded from and saved to a file
+ */
+bool useParseCacheFile = true;
+
+/**
+ * @brief The stamp of the installed plugins that the parse cache file
+ *        was loaded with, if it was.
+ */
+std::optional<uint64_t> pluginStamp;
+
 /**
  * @brief Initialize Python interpreter and gather all UD parser modules under
  *        the paths found in Python sys.path and the current user directory.
  *        This is to prevent calling a non-existant module which causes Python
  *        to print an import error message and breaking JSON output.
  *
+ *        Also loads the UserData parse cache saved by an earlier run, if it
+ *        was made by this peltool with the same plugins.
+ *
  * @return std::vector<std::string> Vector of plugins found in filesystem
  */
 std::vector<std::string> getPlugins()
@@ -244,6 +162,7 @@ std::vector<std::string> getPlugins()
     std::vector<std::string> plugins;
     std::vector<std::string> siteDirs;
     std::array<std::string, 2> parserDirs = {"udparsers", "srcparsers"};
+    std::string stampData;
     PyObject* pName = PyUnicode_FromString("sys");
     PyObject* pModule = PyImport_Import(pName);
     Py_XDECREF(pName);
@@ -272,279 +191,134 @@ std::vector<std::string> getPlugins()
                 for (const auto& entry :
                      fs::directory_iterator(dir + "/" + parserDir))
                 {
-                    if (entry.is_directory() and
-                        fs::exists(entry.path().string() + "/" +
-                                   entry.path().stem().string() + ".py"))
+                    fs::path module = entry.path().string() + "/" +
+                                      entry.path().stem().string() + ".py";
+                    if (entry.is_directory() and fs::exists(module))
                     {
                         plugins.push_back(entry.path().stem());
+
+                        stampData += module.string() + ':' +
+                                     std::to_string(getModifyTime(module)) +
+                                     '\n';
                     }
                 }
             }
         }
     }
+
+    if (useParseCacheFile)
+    {
+        // Cached results are stale if peltool or a plugin is updated
+        stampData += std::to_string(getModifyTime("/proc/self/exe"));
+        pluginStamp = std::hash<std::string>{}(stampData);
+        user_data::getParseCache().load(getPELParserCacheFile(), *pluginStamp);
+    }
+
     return plugins;
 }
 
 /**
- * @brief Creates JSON string of a PEL entry if fullPEL is false or prints to
- *        stdout the full PEL in JSON if fullPEL is true
- * @param[in] itr - std::map iterator of <uint32_t, BCDTime>
- * @param[in] hidden - Boolean to include hidden PELs
- * @param[in] includeInfo - Boolean to include informational PELs
- * @param[in] critSysTerm - Boolean to include critical error and system
- * termination PELs
- * @param[in] fullPEL - Boolean to print full JSON representation of PEL
- * @param[in] foundPEL - Boolean to check if any PEL is present
- * @param[in] scrubRegex - SRC regex object
- * @param[in] plugins - Vector of strings of plugins found in filesystem
+ * @brief Print a list of PELs or a JSON array of PELs
+ *
+ * The PELs are rendered on a thread per CPU and written out in order
+ * as they are done.
+ *
+ * @param[in] order - Boolean to print in reverse orser
+ * @param[in] filter - Which PELs to print
+ * @param[in] fullPEL - Boolean to print full PEL into a JSON array
  * @param[in] hexDump - Boolean to print hexdump of PEL instead of JSON
- * @return std::string - JSON string of PEL entry (empty if fullPEL is true)
+ * @param[in] archive - Boolean to print the archived PELs
  */
-template <typename T>
-std::string genPELJSON(
-    T itr, bool hidden, bool includeInfo, bool critSysTerm, bool fullPEL,
-    bool& foundPEL, const std::optional<std::regex>& scrubRegex,
-    const std::vector<std::string>& plugins, bool hexDump, bool archive)
+void printPELs(bool order, const list::Filter& filter, bool fullPEL,
+               bool hexDump, bool archive = false)
 {
-    std::string val;
-    std::string listStr;
-    char name[51];
-    sprintf(name, "/%.2X%.2X%.2X%.2X%.2X%.2X%.2X%.2X_%.8X",
-            static_cast<uint8_t>((itr.second >> 56) & 0xFF),
-            static_cast<uint8_t>((itr.second >> 48) & 0xFF),
-            static_cast<uint8_t>((itr.second >> 40) & 0xFF),
-            static_cast<uint8_t>((itr.second >> 32) & 0xFF),
-            static_cast<uint8_t>((itr.second >> 24) & 0xFF),
-            static_cast<uint8_t>((itr.second >> 16) & 0xFF),
-            static_cast<uint8_t>((itr.second >> 8) & 0xFF),
-            static_cast<uint8_t>(itr.second & 0xFF), itr.first);
-
-    auto fileName = (archive ? pelLogDir() + "/archive" : pelLogDir()) + name;
-    try
+    auto files =
+        list::getFiles(archive ? pelLogDir() + "/archive" : pelLogDir(), order);
+
+    std::vector<std::string> plugins;
+    PyThreadState* pyState = nullptr;
+    if (fullPEL && !hexDump)
     {
-        std::vector<uint8_t> data = getFileData(fileName);
-        if (data.empty())
-        {
-            log<level::ERR>("Empty PEL file",
-                            entry("FILENAME=%s", fileName.c_str()));
-            return listStr;
-        }
-        PEL pel{data};
-        if (!pel.valid())
-        {
-            return listStr;
-        }
-        if (!includeInfo && pel.userHeader().severity() == 0)
-        {
-            return listStr;
-        }
-        if (critSysTerm && pel.userHeader().severity() != critSysTermSeverity)
-        {
-            return listStr;
-        }
-        std::bitset<16> actionFlags{pel.userHeader().actionFlags()};
-        if (!hidden && actionFlags.test(hiddenFlagBit))
-        {
-            return listStr;
-        }
-        if (pel.primarySRC() && scrubRegex)
-        {
-            val = pel.primarySRC().value()->asciiString();
-            if (std::regex_search(trimEnd(val), scrubRegex.value(),
-                                  std::regex_constants::match_not_null))
-            {
-                return listStr;
-            }
-        }
-        if (hexDump)
-        {
-            std::cout
-                << dumpHex(std::data(pel.data()), pel.size(), 0, false).get()
-                << std::endl;
-        }
-        else if (fullPEL)
+        plugins = getPlugins();
+
+        // Release the GIL so the workers can take it to run the parsers
+        pyState = PyEval_SaveThread();
+    }
+
+    // The registry isn't thread safe, so each worker gets its own.
+    size_t workers = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<std::unique_ptr<message::Registry>> registries;
+    for (size_t i = 0; i < workers; i++)
+    {
+        registries.push_back(std::make_unique<message::Registry>(
+            getPELReadOnlyDataPath() / message::registryFileName, false));
+    }
+
+    auto render = [&files, &filter, &plugins, &registries, fullPEL,
+                   hexDump](size_t index,
+                            size_t worker) -> std::optional<std::string> {
+        const auto& fileName = files[index];
+        try
         {
-            if (!foundPEL)
+            std::vector<uint8_t> data = getFileData(fileName);
+            if (data.empty())
             {
-                std::cout << "[\n";
-                foundPEL = true;
+                log<level::ERR>("Empty PEL file",
+                                entry("FILENAME=%s", fileName.c_str()));
+                return std::nullopt;
             }
-            else
+
+            // The list only needs the headers and primary SRC
+            if (!fullPEL && !hexDump)
             {
-                std::cout << ",\n\n";
+                return list::summarize(data, filter, *registries[worker]);
             }
-            pel.toJSON(registry, plugins);
-        }
-        else
-        {
-            // id
-            listStr += "    \"" +
-                       getNumberString("0x%X", pel.privateHeader().id()) +
-                       "\": {\n";
-            // ASCII
-            if (pel.primarySRC())
-            {
-                val = pel.primarySRC().value()->asciiString();
-                jsonInsert(listStr, "SRC", trimEnd(val), 2);
 
-                // Registry message
-                auto regVal = pel.primarySRC().value()->getErrorDetails(
-                    registry, DetailLevel::message, true);
-                if (regVal)
-                {
-                    val = regVal.value();
-                    jsonInsert(listStr, "Message", val, 2);
-                }
-            }
-            else
+            PEL pel{data};
+            if (!pel.valid() ||
+                !filter.includes(pel.userHeader(),
+                                 pel.primarySRC().value_or(nullptr)))
             {
-                jsonInsert(listStr, "SRC", "No SRC", 2);
+                return std::nullopt;
             }
 
-            // platformid
-            jsonInsert(listStr, "PLID",
-                       getNumberString("0x%X", pel.privateHeader().plid()), 2);
-
-            // creatorid
-            std::string creatorID =
-                getNumberString("%c", pel.privateHeader().creatorID());
-            val = pv::creatorIDs.count(creatorID) ? pv::creatorIDs.at(creatorID)
-                                                  : "Unknown Creator ID";
-            jsonInsert(listStr, "CreatorID", val, 2);
-
-            // subsystem
-            std::string subsystem = pv::getValue(pel.userHeader().subsystem(),
-                                                 pel_values::subsystemValues);
-            jsonInsert(listStr, "Subsystem", subsystem, 2);
-
-            // commit time
-            char tmpValStr[50];
-            sprintf(tmpValStr, "%02X/%02X/%02X%02X %02X:%02X:%02X",
-                    pel.privateHeader().commitTimestamp().month,
-                    pel.privateHeader().commitTimestamp().day,
-                    pel.privateHeader().commitTimestamp().yearMSB,
-                    pel.privateHeader().commitTimestamp().yearLSB,
-                    pel.privateHeader().commitTimestamp().hour,
-                    pel.privateHeader().commitTimestamp().minutes,
-                    pel.privateHeader().commitTimestamp().seconds);
-            jsonInsert(listStr, "Commit Time", tmpValStr, 2);
-
-            // severity
-            std::string severity = pv::getValue(pel.userHeader().severity(),
-                                                pel_values::severityValues);
-            jsonInsert(listStr, "Sev", severity, 2);
-
-            // compID
-            jsonInsert(
-                listStr, "CompID",
-                getComponentName(pel.privateHeader().header().componentID,
-                                 pel.privateHeader().creatorID()),
-                2);
-
-            auto found = listStr.rfind(",");
-            if (found != std::string::npos)
+            if (hexDump)
             {
-                listStr.replace(found, 1, "");
-                listStr += "    },\n";
+                return dumpHex(std::data(pel.data()), pel.size(), 0, false)
+                    .get();
             }
-            foundPEL = true;
-        }
-    }
-    catch (const std::exception& e)
-    {
-        log<level::ERR>("Hit exception while reading PEL File",
-                        entry("FILENAME=%s", fileName.c_str()),
-                        entry("ERROR=%s", e.what()));
-    }
-    return listStr;
-}
 
-/**
- * @brief Print a list of PELs or a JSON array of PELs
- * @param[in] order - Boolean to print in reverse orser
- * @param[in] hidden - Boolean to include hidden PELs
- * @param[in] includeInfo - Boolean to include informational PELs
- * @param[in] critSysTerm - Boolean to include critical error and system
- * termination PELs
- * @param[in] fullPEL - Boolean to print full PEL into a JSON array
- * @param[in] scrubRegex - SRC regex object
- * @param[in] hexDump - Boolean to print hexdump of PEL instead of JSON
- */
-void printPELs(bool order, bool hidden, bool includeInfo, bool critSysTerm,
-               bool fullPEL, const std::optional<std::regex>& scrubRegex,
-               bool hexDump, bool archive = false)
-{
-    std::string listStr;
-    std::vector<std::pair<uint32_t, uint64_t>> PELs;
-    std::vector<std::string> plugins;
-    listStr = "{\n";
-    for (auto it = (archive ? fs::directory_iterator(pelLogDir() + "/archive")
-                            : fs::directory_iterator(pelLogDir()));
-         it != fs::directory_iterator(); ++it)
-    {
-        if (!fs::is_regular_file((*it).path()))
-        {
-            continue;
+            return pel.toJSON(*registries[worker], plugins);
         }
-        else
+        catch (const std::exception& e)
         {
-            PELs.emplace_back(fileNameToPELId((*it).path().filename()),
-                              fileNameToTimestamp((*it).path().filename()));
+            log<level::ERR>("Hit exception while reading PEL File",
+                            entry("FILENAME=%s", fileName.c_str()),
+                            entry("ERROR=%s", e.what()));
         }
-    }
-
-    // Sort the pairs based on second time parameter
-    std::sort(PELs.begin(), PELs.end(),
-              [](const auto& left, const auto& right) {
-                  return left.second < right.second;
-              });
-
-    bool foundPEL = false;
-
-    if (fullPEL && !hexDump)
-    {
-        plugins = getPlugins();
-    }
-    auto buildJSON = [&listStr, &hidden, &includeInfo, &critSysTerm, &fullPEL,
-                      &foundPEL, &scrubRegex, &plugins, &hexDump,
-                      &archive](const auto& i) {
-        listStr += genPELJSON(i, hidden, includeInfo, critSysTerm, fullPEL,
-                              foundPEL, scrubRegex, plugins, hexDump, archive);
+        return std::nullopt;
     };
-    if (order)
-    {
-        std::for_each(PELs.rbegin(), PELs.rend(), buildJSON);
-    }
-    else
-    {
-        std::for_each(PELs.begin(), PELs.end(), buildJSON);
-    }
+
+    auto format = list::Writer::Format::object;
     if (hexDump)
     {
-        return;
+        format = list::Writer::Format::plain;
     }
-    if (foundPEL)
+    else if (fullPEL)
     {
-        if (fullPEL)
-        {
-            std::cout << "]" << std::endl;
-        }
-        else
-        {
-            std::size_t found;
-            found = listStr.rfind(",");
-            if (found != std::string::npos)
-            {
-                listStr.replace(found, 1, "");
-                listStr += "}\n";
-                printf("%s", listStr.c_str());
-            }
-        }
+        format = list::Writer::Format::array;
     }
-    else
+
+    list::Writer writer{std::cout, format};
+    list::renderInOrder(files.size(), workers, render,
+                        [&writer](const std::string& pel) {
+                            writer.write(pel);
+                        });
+    writer.finish();
+
+    if (pyState != nullptr)
     {
-        std::string emptyJSON = fullPEL ? "[]" : "{}";
-        std::cout << emptyJSON << std::endl;
+        PyEval_RestoreThread(pyState);
     }
 }
 
@@ -653,12 +427,43 @@ void deletePEL(const std::string& id)
 }
 
 /**
- * @brief Delete all PEL files.
+ * @brief Delete all PELs.
+ *
+ * The logging daemon is asked to do it with a DeleteAll, so it removes
+ * them all together instead of handling each file delete on its own.
+ * Only if the daemon isn't running or doesn't answer are the files
+ * deleted here.  Any other failure, such as the daemon refusing to
+ * delete them, is reported and nothing is deleted.
  */
 void deleteAllPELs()
 {
     log<level::INFO>("peltool deleting all event logs");
 
+    try
+    {
+        auto bus = sdbusplus::bus::new_default();
+        auto method =
+            bus.new_method_call(service::logging, object_path::logging,
+                                interface::deleteAll, "DeleteAll");
+        bus.call_noreply(method);
+        return;
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        std::string_view name{e.name()};
+        if ((name != "org.freedesktop.DBus.Error.ServiceUnknown") &&
+            (name != "org.freedesktop.DBus.Error.NoReply"))
+        {
+            std::cerr << "DeleteAll D-Bus call failed: " << e.what()
+                      << std::endl;
+            exit(1);
+        }
+
+        std::cerr << "The logging daemon could not be reached, deleting "
+                     "the files directly: "
+                  << e.what() << std::endl;
+    }
+
     for (const auto& entry : fs::directory_iterator(pelLogDir()))
     {
         if (!fs::is_regular_file(entry.path()))
@@ -688,7 +493,7 @@ void displayPEL(const PEL& pel, bool hexDump)
         else
         {
             auto plugins = getPlugins();
-            pel.toJSON(registry, plugins);
+            std::cout << pel.toJSON(registry, plugins) << std::endl;
         }
     }
     else
@@ -700,13 +505,9 @@ void displayPEL(const PEL& pel, bool hexDump)
 
 /**
  * @brief Print number of PELs
- * @param[in] hidden - Bool to include hidden logs
- * @param[in] includeInfo - Bool to include informational logs
- * @param[in] critSysTerm - Bool to include CritSysTerm
- * @param[in] scrubRegex - SRC regex object
+ * @param[in] filter - Which PELs to count
  */
-void printPELCount(bool hidden, bool includeInfo, bool critSysTerm,
-                   const std::optional<std::regex>& scrubRegex)
+void printPELCount(const list::Filter& filter)
 {
     std::size_t count = 0;
 
@@ -723,32 +524,12 @@ void printPELCount(bool hidden, bool includeInfo, bool critSysTerm,
             continue;
         }
         PEL pel{data};
-        if (!pel.valid())
-        {
-            continue;
-        }
-        if (!includeInfo && pel.userHeader().severity() == 0)
+        if (!pel.valid() ||
+            !filter.includes(pel.userHeader(),
+                             pel.primarySRC().value_or(nullptr)))
         {
             continue;
         }
-        if (critSysTerm && pel.userHeader().severity() != critSysTermSeverity)
-        {
-            continue;
-        }
-        std::bitset<16> actionFlags{pel.userHeader().actionFlags()};
-        if (!hidden && actionFlags.test(hiddenFlagBit))
-        {
-            continue;
-        }
-        if (pel.primarySRC() && scrubRegex)
-        {
-            std::string val = pel.primarySRC().value()->asciiString();
-            if (std::regex_search(trimEnd(val), scrubRegex.value(),
-                                  std::regex_constants::match_not_null))
-            {
-                continue;
-            }
-        }
         count++;
     }
     std::cout << "{\n"
@@ -846,7 +627,6 @@ int main(int argc, char** argv)
     std::string bmcId;
     std::string idToDelete;
     std::string scrubFile;
-    std::optional<std::regex> scrubRegex;
     bool listPEL = false;
     bool listPELDescOrd = false;
     bool hidden = false;
@@ -857,6 +637,7 @@ int main(int argc, char** argv)
     bool fullPEL = false;
     bool hexDump = false;
     bool archive = false;
+    bool noParserCache = false;
 
     app.set_help_flag("--help", "Print this help message and exit");
     app.add_option("--file", fileName, "Display a PEL using its Raw PEL file");
@@ -877,9 +658,15 @@ int main(int argc, char** argv)
                    "File containing SRC regular expressions to ignore");
     app.add_flag("-x", hexDump, "Display PEL(s) in hexdump instead of JSON");
     app.add_flag("--archive", archive, "List or display archived PELs");
+    app.add_flag("--no-parser-cache", noParserCache,
+                 "Don't use the parser results saved by earlier runs");
 
     CLI11_PARSE(app, argc, argv);
 
+    useParseCacheFile = !noParserCache;
+
+    list::Filter filter{hidden, includeInfo, critSysTerm, std::nullopt};
+
     if (!fileName.empty())
     {
         std::vector<uint8_t> data = getFileData(fileName);
@@ -895,7 +682,7 @@ int main(int argc, char** argv)
             else
             {
                 auto plugins = getPlugins();
-                pel.toJSON(registry, plugins);
+                std::cout << pel.toJSON(registry, plugins) << std::endl;
             }
         }
         else
@@ -916,18 +703,17 @@ int main(int argc, char** argv)
     {
         if (!scrubFile.empty())
         {
-            scrubRegex = genRegex(scrubFile);
+            filter.scrubRegex = genRegex(scrubFile);
         }
-        printPELs(listPELDescOrd, hidden, includeInfo, critSysTerm, fullPEL,
-                  scrubRegex, hexDump, archive);
+        printPELs(listPELDescOrd, filter, fullPEL, hexDump, archive);
     }
     else if (showPELCount)
     {
         if (!scrubFile.empty())
         {
-            scrubRegex = genRegex(scrubFile);
+            filter.scrubRegex = genRegex(scrubFile);
         }
-        printPELCount(hidden, includeInfo, critSysTerm, scrubRegex);
+        printPELCount(filter);
     }
     else if (!idToDelete.empty())
     {
@@ -941,6 +727,10 @@ int main(int argc, char** argv)
     {
         std::cout << app.help("", CLI::AppFormatMode::All) << std::endl;
     }
+    if (pluginStamp)
+    {
+        user_data::getParseCache().save(getPELParserCacheFile(), *pluginStamp);
+    }
     Py_Finalize();
     return 0;
 }
@@ -18,9 +18,7 @@
 #include "json_utils.hpp"
 #include "pel_types.hpp"
 #include "user_data_formats.hpp"
-#ifdef PELTOOL
 #include "user_data_json.hpp"
-#endif
 
 #include <phosphor-logging/lg2.hpp>
 
@@ -95,14 +93,10 @@ void UserData::validate()
 }
 
 std::optional<std::string> UserData::getJSON(
-    uint8_t creatorID [[maybe_unused]],
-    const std::vector<std::string>& plugins [[maybe_unused]]) const
+    uint8_t creatorID, const std::vector<std::string>& plugins) const
 {
-#ifdef PELTOOL
     return user_data::getJSON(_header.componentID, _header.subType,
                               _header.version, _data, creatorID, plugins);
-#endif
-    return std::nullopt;
 }
 
 bool UserData::shrink(size_t newSize)
@@ -22,7 +22,12 @@
 #include "stream.hpp"
 #include "user_data_formats.hpp"
 
+#ifdef PELTOOL
+#include "parse_cache.hpp"
+#include "plugin_host.hpp"
+
 #include <Python.h>
+#endif
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
@@ -35,11 +40,18 @@ namespace openpower::pels::user_data
 namespace pv = openpower::pels::pel_values;
 using orderedJSON = nlohmann::ordered_json;
 
+#ifdef PELTOOL
 void pyDecRef(PyObject* pyObj)
 {
     Py_XDECREF(pyObj);
 }
 
+void pyReleaseGIL(PyGILState_STATE* state)
+{
+    PyGILState_Release(*state);
+}
+#endif
+
 /**
  * @brief Returns a JSON string for use by PEL::printSectionInJSON().
  *
@@ -119,19 +131,19 @@ std::string getCBORJSON(uint16_t componentID, uint8_t subType, uint8_t version,
     // If the data vector is too short, an exception will get
     // thrown which will be handled up the call stack.
 
-    auto cborData = data;
     uint32_t pad{};
 
-    Stream stream{cborData};
-    stream.offset(cborData.size() - 4);
+    Stream stream{std::span{data}};
+    stream.offset(data.size() - 4);
     stream >> pad;
 
-    if (cborData.size() > (pad + sizeof(pad)))
+    auto cborEnd = data.end();
+    if (data.size() > (pad + sizeof(pad)))
     {
-        cborData.resize(data.size() - sizeof(pad) - pad);
+        cborEnd -= sizeof(pad) + pad;
     }
 
-    orderedJSON json = orderedJSON::from_cbor(cborData);
+    orderedJSON json = orderedJSON::from_cbor(data.begin(), cborEnd);
 
     return prettyJSON(componentID, subType, version, creatorID, json);
 }
@@ -229,6 +241,7 @@ std::optional<std::string> getBuiltinFormatJSON(
     return std::nullopt;
 }
 
+#ifdef PELTOOL
 /**
  * @brief Call Python modules to parse the data into a JSON string
  *
@@ -257,155 +270,115 @@ std::optional<std::string> getPythonJSON(
     uint16_t componentID, uint8_t subType, uint8_t version,
     const std::vector<uint8_t>& data, uint8_t creatorID)
 {
-    PyObject *pName, *pModule, *eType, *eValue, *eTraceback, *pKey;
-    std::string pErrStr;
+    // peltool can render PELs on several threads, so hold the GIL
+    // until the objects below have been released.
+    PyGILState_STATE gilState = PyGILState_Ensure();
+    std::unique_ptr<PyGILState_STATE, decltype(&pyReleaseGIL)> gilPtr(
+        &gilState, &pyReleaseGIL);
+
     std::string module = getNumberString("%c", tolower(creatorID)) +
                          getNumberString("%04x", componentID);
-    pName = PyUnicode_FromString(
-        std::string("udparsers." + module + "." + module).c_str());
-    std::unique_ptr<PyObject, decltype(&pyDecRef)> modNamePtr(pName, &pyDecRef);
-    pModule = PyImport_Import(pName);
-    if (pModule == NULL)
+    PyObject* pFunc = plugin_host::getFunction(
+        "udparsers." + module + "." + module, "parseUDToJson");
+    if (pFunc == nullptr)
     {
-        pErrStr = "No error string found";
-        PyErr_Fetch(&eType, &eValue, &eTraceback);
-        if (eType)
-        {
-            Py_XDECREF(eType);
-        }
-        if (eTraceback)
-        {
-            Py_XDECREF(eTraceback);
-        }
-        if (eValue)
-        {
-            PyObject* pStr = PyObject_Str(eValue);
-            Py_XDECREF(eValue);
-            if (pStr)
-            {
-                pErrStr = PyUnicode_AsUTF8(pStr);
-                Py_XDECREF(pStr);
-            }
-        }
+        return std::nullopt;
     }
-    else
+
+    auto ud = data.data();
+    PyObject* pArgs = PyTuple_New(3);
+    std::unique_ptr<PyObject, decltype(&pyDecRef)> argPtr(pArgs, &pyDecRef);
+    PyTuple_SetItem(pArgs, 0, PyLong_FromUnsignedLong((unsigned long)subType));
+    PyTuple_SetItem(pArgs, 1, PyLong_FromUnsignedLong((unsigned long)version));
+    PyObject* pData = PyMemoryView_FromMemory(
+        reinterpret_cast<char*>(const_cast<unsigned char*>(ud)), data.size(),
+        PyBUF_READ);
+    PyTuple_SetItem(pArgs, 2, pData);
+    PyObject* pResult = PyObject_CallObject(pFunc, pArgs);
+    if (pResult == nullptr)
     {
-        std::unique_ptr<PyObject, decltype(&pyDecRef)> modPtr(
-            pModule, &pyDecRef);
-        std::string funcToCall = "parseUDToJson";
-        pKey = PyUnicode_FromString(funcToCall.c_str());
-        std::unique_ptr<PyObject, decltype(&pyDecRef)> keyPtr(pKey, &pyDecRef);
-        PyObject* pDict = PyModule_GetDict(pModule);
-        Py_INCREF(pDict);
-        if (!PyDict_Contains(pDict, pKey))
-        {
-            Py_DECREF(pDict);
-            lg2::error("Python module error.  Function missing: {FUNC}, "
-                       "module = {MODULE}, subtype = {SUBTYPE}, "
-                       "version = {VERSION}, data length = {LEN}",
-                       "FUNC", funcToCall, "MODULE", module, "SUBTYPE", subType,
-                       "VERSION", version, "LEN", data.size());
-            return std::nullopt;
-        }
-        PyObject* pFunc = PyDict_GetItemString(pDict, funcToCall.c_str());
-        Py_DECREF(pDict);
-        Py_INCREF(pFunc);
-        if (PyCallable_Check(pFunc))
+        lg2::debug("Python exception thrown by parser.  Error = {ERROR}, "
+                   "module = {MODULE}, subtype = {SUBTYPE}, "
+                   "version = {VERSION}, data length = {LEN}",
+                   "ERROR", plugin_host::fetchError(), "MODULE", module,
+                   "SUBTYPE", subType, "VERSION", version, "LEN", data.size());
+        return std::nullopt;
+    }
+
+    std::unique_ptr<PyObject, decltype(&pyDecRef)> resPtr(pResult, &pyDecRef);
+
+    if (pResult == Py_None)
+    {
+        // Just return a nullopt so it will hexdump the section
+        return std::nullopt;
+    }
+
+    PyObject* pBytes = PyUnicode_AsEncodedString(pResult, "utf-8", "~E~");
+    std::unique_ptr<PyObject, decltype(&pyDecRef)> pyBytePtr(pBytes,
+                                                             &pyDecRef);
+    const char* output = PyBytes_AS_STRING(pBytes);
+    try
+    {
+        orderedJSON json = orderedJSON::parse(output);
+        if ((json.is_object() && !json.empty()) ||
+            (json.is_array() && json.size() > 0) ||
+            (json.is_string() && json != ""))
         {
-            auto ud = data.data();
-            PyObject* pArgs = PyTuple_New(3);
-            std::unique_ptr<PyObject, decltype(&pyDecRef)> argPtr(
-                pArgs, &pyDecRef);
-            PyTuple_SetItem(pArgs, 0,
-                            PyLong_FromUnsignedLong((unsigned long)subType));
-            PyTuple_SetItem(pArgs, 1,
-                            PyLong_FromUnsignedLong((unsigned long)version));
-            PyObject* pData = PyMemoryView_FromMemory(
-                reinterpret_cast<char*>(const_cast<unsigned char*>(ud)),
-                data.size(), PyBUF_READ);
-            PyTuple_SetItem(pArgs, 2, pData);
-            PyObject* pResult = PyObject_CallObject(pFunc, pArgs);
-            Py_DECREF(pFunc);
-            if (pResult)
-            {
-                std::unique_ptr<PyObject, decltype(&pyDecRef)> resPtr(
-                    pResult, &pyDecRef);
-
-                if (pResult == Py_None)
-                {
-                    // Just return a nullopt so it will hexdump the section
-                    return std::nullopt;
-                }
-
-                PyObject* pBytes =
-                    PyUnicode_AsEncodedString(pResult, "utf-8", "~E~");
-                std::unique_ptr<PyObject, decltype(&pyDecRef)> pyBytePtr(
-                    pBytes, &pyDecRef);
-                const char* output = PyBytes_AS_STRING(pBytes);
-                try
-                {
-                    orderedJSON json = orderedJSON::parse(output);
-                    if ((json.is_object() && !json.empty()) ||
-                        (json.is_array() && json.size() > 0) ||
-                        (json.is_string() && json != ""))
-                    {
-                        return prettyJSON(componentID, subType, version,
-                                          creatorID, json);
-                    }
-                }
-                catch (const std::exception& e)
-                {
-                    lg2::error("Bad JSON from parser.  Error = {ERROR}, "
-                               "module = {MODULE}, subtype = {SUBTYPE}, "
-                               "version = {VERSION}, data length = {LEN}",
-                               "ERROR", e, "MODULE", module, "SUBTYPE", subType,
-                               "VERSION", version, "LEN", data.size());
-                    return std::nullopt;
-                }
-            }
-            else
-            {
-                pErrStr = "No error string found";
-                PyErr_Fetch(&eType, &eValue, &eTraceback);
-                if (eType)
-                {
-                    Py_XDECREF(eType);
-                }
-                if (eTraceback)
-                {
-                    Py_XDECREF(eTraceback);
-                }
-                if (eValue)
-                {
-                    PyObject* pStr = PyObject_Str(eValue);
-                    Py_XDECREF(eValue);
-                    if (pStr)
-                    {
-                        pErrStr = PyUnicode_AsUTF8(pStr);
-                        Py_XDECREF(pStr);
-                    }
-                }
-            }
+            return prettyJSON(componentID, subType, version, creatorID, json);
         }
     }
-    if (!pErrStr.empty())
+    catch (const std::exception& e)
     {
-        lg2::debug("Python exception thrown by parser.  Error = {ERROR}, "
+        lg2::error("Bad JSON from parser.  Error = {ERROR}, "
                    "module = {MODULE}, subtype = {SUBTYPE}, "
                    "version = {VERSION}, data length = {LEN}",
-                   "ERROR", pErrStr, "MODULE", module, "SUBTYPE", subType,
+                   "ERROR", e, "MODULE", module, "SUBTYPE", subType,
                    "VERSION", version, "LEN", data.size());
     }
+
     return std::nullopt;
 }
 
+/**
+ * @brief Returns the JSON from the Python parser, using the parse
+ *        cache so that the same data isn't parsed again.
+ *
+ * @param[in] componentID - The comp ID from the UserData section header
+ * @param[in] subType - The subtype from the UserData section header
+ * @param[in] version - The version from the UserData section header
+ * @param[in] data - The data itself
+ * @param[in] creatorID - The creatorID from the PrivateHeader section
+ * @return std::optional<std::string> - The JSON string if it could be created,
+ *                                      else std::nullopt
+ */
+std::optional<std::string> getCachedPythonJSON(
+    uint16_t componentID, uint8_t subType, uint8_t version,
+    const std::vector<uint8_t>& data, uint8_t creatorID)
+{
+    auto& cache = getParseCache();
+    auto key =
+        ParseCache::makeKey(creatorID, componentID, subType, version, data);
+
+    std::optional<std::string> json;
+    if (!cache.find(key, data, json))
+    {
+        json = getPythonJSON(componentID, subType, version, data, creatorID);
+        cache.insert(key, data, json);
+    }
+
+    return json;
+}
+#endif
+
 std::optional<std::string> getJSON(
     uint16_t componentID, uint8_t subType, uint8_t version,
     const std::vector<uint8_t>& data, uint8_t creatorID,
-    const std::vector<std::string>& plugins)
+    const std::vector<std::string>& plugins [[maybe_unused]])
 {
+#ifdef PELTOOL
     std::string subsystem = getNumberString("%c", tolower(creatorID));
     std::string component = getNumberString("%04x", componentID);
+#endif
     try
     {
         if (pv::creatorIDs.at(getNumberString("%c", creatorID)) == "BMC" &&
@@ -414,12 +387,14 @@ std::optional<std::string> getJSON(
             return getBuiltinFormatJSON(componentID, subType, version, data,
                                         creatorID);
         }
+#ifdef PELTOOL
         else if (std::find(plugins.begin(), plugins.end(),
                            subsystem + component) != plugins.end())
         {
-            return getPythonJSON(componentID, subType, version, data,
-                                 creatorID);
+            return getCachedPythonJSON(componentID, subType, version, data,
+                                       creatorID);
         }
+#endif
     }
     catch (const std::exception& e)
     {
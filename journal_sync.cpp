@@ -0,0 +1,172 @@
+#include "config.h"
+
+#include "journal_sync.hpp"
+
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace phosphor
+{
+namespace logging
+{
+
+namespace
+{
+constexpr auto journalRunPath = "/run/systemd/journal";
+constexpr auto syncedPath = "/run/systemd/journal/synced";
+} // namespace
+
+JournalSync::JournalSync(sdbusplus::bus_t& bus) :
+    _bus(bus), _event(sdeventplus::Event::get_default()),
+    _timer(_event, [this](auto& /*timer*/) {
+        lg2::info("Timeout ({TIMEOUT}s), no new journal synced data",
+                  "TIMEOUT", timeout.count());
+        finish();
+    })
+{}
+
+JournalSync::~JournalSync()
+{
+    _ioSource.reset();
+    if (_fd != -1)
+    {
+        if (_wd != -1)
+        {
+            inotify_rm_watch(_fd, _wd);
+        }
+        close(_fd);
+    }
+}
+
+void JournalSync::start(Callback callback)
+{
+    _callback = std::move(callback);
+    _inProgress = true;
+    _start = std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+                 .count();
+
+    // Without a watch there is no way to know when it's done,
+    // so just go on without the sync.
+    if (!watch())
+    {
+        finish();
+        return;
+    }
+
+    try
+    {
+        constexpr auto journalUnit = "systemd-journald.service";
+        auto method = _bus.new_method_call(SYSTEMD_BUSNAME, SYSTEMD_PATH,
+                                           SYSTEMD_INTERFACE, "KillUnit");
+        method.append(journalUnit, "main", SIGRTMIN + 1);
+        _bus.call(method);
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to kill journal service: {ERROR}", "ERROR", e);
+        finish();
+        return;
+    }
+
+    _timer.restartOnce(timeout);
+}
+
+bool JournalSync::watch()
+{
+    if (_fd != -1)
+    {
+        return true;
+    }
+
+    _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_fd < 0)
+    {
+        lg2::error("Failed to create inotify watch: {ERROR}", "ERROR",
+                   strerror(errno));
+        return false;
+    }
+
+    _wd = inotify_add_watch(_fd, journalRunPath,
+                            IN_MOVED_TO | IN_DONT_FOLLOW | IN_ONLYDIR);
+    if (_wd < 0)
+    {
+        lg2::error("Failed to watch journal directory: {PATH}: {ERROR}",
+                   "PATH", journalRunPath, "ERROR", strerror(errno));
+        close(_fd);
+        _fd = -1;
+        return false;
+    }
+
+    _ioSource = std::make_unique<sdeventplus::source::IO>(
+        _event, _fd, EPOLLIN,
+        std::bind(std::mem_fn(&JournalSync::changed), this,
+                  std::placeholders::_1, std::placeholders::_2,
+                  std::placeholders::_3));
+
+    return true;
+}
+
+bool JournalSync::synced() const
+{
+    std::ifstream syncedFile(syncedPath);
+    std::string timestampStr;
+    if (!std::getline(syncedFile, timestampStr))
+    {
+        return false;
+    }
+
+    try
+    {
+        return std::stoll(timestampStr) >= _start;
+    }
+    catch (const std::exception& e)
+    {
+        return false;
+    }
+}
+
+void JournalSync::changed(sdeventplus::source::IO& /*io*/, int fd,
+                          uint32_t /*revents*/)
+{
+    // Throw away the events, the synced file says if the sync happened.
+    constexpr auto maxBytes = 64;
+    uint8_t buffer[maxBytes];
+    while (read(fd, buffer, maxBytes) > 0)
+        ;
+
+    if (_inProgress && !_doneSource && synced())
+    {
+        finish();
+    }
+}
+
+void JournalSync::finish()
+{
+    _timer.setEnabled(false);
+
+    _doneSource = std::make_unique<sdeventplus::source::Defer>(
+        _event, std::bind(std::mem_fn(&JournalSync::done), this,
+                          std::placeholders::_1));
+}
+
+void JournalSync::done(sdeventplus::source::EventBase& /*source*/)
+{
+    _doneSource.reset();
+    _inProgress = false;
+
+    // The callback may start the next sync.
+    auto callback = std::move(_callback);
+    callback();
+}
+
+} // namespace logging
+} // namespace phosphor
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace phosphor
+{
+namespace logging
+{
+
+/** @class JournalSyncBase
+ *  @brief The interface used to sync the journal before the metadata of
+ *         committed errors is read, so tests can replace journald.
+ */
+class JournalSyncBase
+{
+  public:
+    using Callback = std::function<void()>;
+
+    JournalSyncBase() = default;
+    JournalSyncBase(const JournalSyncBase&) = delete;
+    JournalSyncBase& operator=(const JournalSyncBase&) = delete;
+    JournalSyncBase(JournalSyncBase&&) = delete;
+    JournalSyncBase& operator=(JournalSyncBase&&) = delete;
+    virtual ~JournalSyncBase() = default;
+
+    /** @brief Requests a journal sync.  Must not be called while one
+     *         is already in progress.
+     *
+     *  @param[in] callback - Called from the event loop once the sync
+     *                        has completed, failed, or timed out
+     */
+    virtual void start(Callback callback) = 0;
+
+    /** @brief Returns if a sync is in progress */
+    virtual bool inProgress() const = 0;
+};
+
+/** @class JournalSync
+ *  @brief Asks journald to sync and calls back once it has, without
+ *         blocking the event loop while waiting.
+ *  @details This does the same as util::journalSync(), which is the
+ *           "journalctl --sync" implementation, but instead of polling
+ *           for the synced file to be updated it watches for it with an
+ *           IO event source.  The callback is run from a deferred event
+ *           once journald reports the sync is done, or after a timeout.
+ */
+class JournalSync : public JournalSyncBase
+{
+  public:
+    JournalSync() = delete;
+    ~JournalSync() override;
+
+    /** @brief Constructor
+     *
+     *  @param[in] bus - The D-Bus connection to request the sync on
+     */
+    explicit JournalSync(sdbusplus::bus_t& bus);
+
+    void start(Callback callback) override;
+
+    bool inProgress() const override
+    {
+        return _inProgress;
+    }
+
+    /** @brief How long to wait for journald before giving up */
+    static constexpr auto timeout = std::chrono::seconds(5);
+
+  private:
+    /** @brief Watches the journal run directory for the synced file
+     *         being updated.
+     *
+     *  @return bool - If the watch is in place
+     */
+    bool watch();
+
+    /** @brief Returns if the synced file was written after the sync
+     *         was requested.
+     */
+    bool synced() const;
+
+    /** @brief Called when the journal run directory changes
+     *
+     *  @param[in] io - The event source
+     *  @param[in] fd - The inotify descriptor
+     *  @param[in] revents - The events that occurred
+     */
+    void changed(sdeventplus::source::IO& io, int fd, uint32_t revents);
+
+    /** @brief Schedules the callback on a deferred event and ends the
+     *         current sync.
+     */
+    void finish();
+
+    /** @brief Ends the sync and runs the callback
+     *
+     *  @param[in] source - The deferred event source
+     */
+    void done(sdeventplus::source::EventBase& source);
+
+    /** @brief The D-Bus connection */
+    sdbusplus::bus_t& _bus;
+
+    /** @brief The callback of the sync in progress */
+    Callback _callback;
+
+    /** @brief The event loop */
+    sdeventplus::Event _event;
+
+    /** @brief The inotify descriptor, or -1 */
+    int _fd = -1;
+
+    /** @brief The inotify watch descriptor, or -1 */
+    int _wd = -1;
+
+    /** @brief The event source for _fd */
+    std::unique_ptr<sdeventplus::source::IO> _ioSource;
+
+    /** @brief Gives up on the sync after the timeout */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _timer;
+
+    /** @brief The event source that runs the callback */
+    std::unique_ptr<sdeventplus::source::Defer> _doneSource;
+
+    /** @brief The monotonic time in microseconds the sync was requested */
+    int64_t _start = 0;
+
+    /** @brief If a sync is in progress */
+    bool _inProgress = false;
+};
+
+} // namespace logging
+} // namespace phosphor
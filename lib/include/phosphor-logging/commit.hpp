@@ -3,6 +3,8 @@
 #include <sdbusplus/async.hpp>
 #include <sdbusplus/exception.hpp>
 
+#include <future>
+
 namespace lg2
 {
 /** Commit a generated event/error.
@@ -10,19 +12,34 @@ namespace lg2
  *  @param e - The event to commit.
  *  @return The object path of the resulting event.
  *
- *  Note: Similar to elog(), this will use the default dbus connection to
- *  perform the operation.
+ *  Note: This uses a dbus connection that is made on first use and shared
+ *  by the whole process.
  */
 auto commit(sdbusplus::exception::generated_event_base&& e)
     -> sdbusplus::message::object_path;
 
+/** Commit a generated event/error without waiting for it to be created.
+ *
+ *  @param e - The event to commit.
+ *  @return A future holding the object path of the resulting event, or the
+ *          exception if it could not be created.
+ *
+ *  Note: The events are created in order by a worker thread, using the
+ *  same dbus connection as commit().  Events still pending when the process
+ *  exits normally are created before it exits, for up to a couple of
+ *  seconds.  Those left after that, or after a failed call, are dropped and
+ *  their futures hold a std::future_error.  The future may be discarded if
+ *  the path isn't needed.
+ */
+auto commit_async(sdbusplus::exception::generated_event_base&& e)
+    -> std::future<sdbusplus::message::object_path>;
+
 /** Resolve an existing event/error.
  *
  *  @param logPath - The object path of the event to resolve.
  *  @return None.
  *
- *  Note: Similar to elog(), this will use the default dbus connection to
- *  perform the operation.
+ *  Note: This uses the same dbus connection as commit().
  */
 void resolve(const sdbusplus::message::object_path& logPath);
 
@@ -9,6 +9,7 @@
 #include <phosphor-logging/lg2/flags.hpp>
 #include <phosphor-logging/lg2/header.hpp>
 #include <phosphor-logging/lg2/level.hpp>
+#include <phosphor-logging/lg2/message.hpp>
 
 #include <source_location>
 
@@ -24,7 +25,8 @@ struct log
      *  @param[in] msg - The message to log.
      *  @param[in] ts - The rest of the arguments.
      */
-    explicit log(const std::source_location& s, const char* msg,
+    explicit log(const std::source_location& s,
+                 const details::message_str& msg,
                  details::header_str_conversion_t<Ts&&>... ts)
     {
         details::log_conversion::start(
@@ -39,7 +41,8 @@ struct log
      *  @param[in] s - The derived source_location.
      */
     explicit log(
-        const char* msg, details::header_str_conversion_t<Ts&&>... ts,
+        const details::message_str& msg,
+        details::header_str_conversion_t<Ts&&>... ts,
         const std::source_location& s = std::source_location::current()) :
         log(s, msg, std::forward<details::header_str_conversion_t<Ts&&>>(ts)...)
     {}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <phosphor-logging/lg2/level.hpp>
+#include <phosphor-logging/lg2/message.hpp>
 
 #include <cstddef>
 #include <source_location>
@@ -22,4 +23,16 @@ namespace lg2::details
  */
 void do_log(level, const std::source_location&, const char*, ...);
 
+/** do_log, but with a message which may have been parsed at compile time.
+ *
+ *  The message is passed by pointer since it must be the last parameter
+ *  before the variadic arguments.
+ *
+ *  @param[in] level - The logging level to use.
+ *  @param[in] source_location - The original source location of the upper-level
+ *                               log call.
+ *  @param[in] message_str* - The primary message to log.
+ */
+void do_log(level, const std::source_location&, const message_str*, ...);
+
 } // namespace lg2::details
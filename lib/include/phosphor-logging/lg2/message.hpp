@@ -0,0 +1,102 @@
+#pragma once
+
+#include <phosphor-logging/lg2/concepts.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace lg2::details
+{
+
+/** A type holding the message string along with where its {HEADER}
+ *  placeholders are.
+ *
+ *  A string literal is parsed at compile time, so at runtime the message
+ *  can be built by copying the literal text between the placeholders and
+ *  the values of the matching headers.  Any other string is left for
+ *  do_log to search as it builds the message.
+ */
+struct message_str
+{
+    /** The location of a possible {HEADER} in the message. */
+    struct placeholder
+    {
+        // Offset of the '{'.
+        uint32_t offset;
+        // Length of the text between the braces.
+        uint32_t size;
+    };
+
+    // The most placeholders held at once, enough for nearly every message.
+    static constexpr size_t max_placeholders = 8;
+
+    // Hold the message string value.
+    std::string_view value;
+
+    // How much of the message has been parsed for placeholders.
+    size_t parsed = 0;
+
+    // The placeholders found in the parsed part of the message.
+    size_t count = 0;
+    std::array<placeholder, max_placeholders> placeholders{};
+
+    /** Constructor for string literals, which parses at compile time.
+     *
+     *  A 'const char[]' which isn't a constant, such as a local array,
+     *  doesn't compile, the same as with header_str; pass a pointer to
+     *  it instead.
+     */
+    template <maybe_constexpr_string T>
+    consteval message_str(T&& s) : value(s)
+    {
+        parse();
+    }
+
+    /** Constructor for all other strings, which do_log searches. */
+    template <not_constexpr_string T>
+        requires std::convertible_to<T, const char*>
+    message_str(T&& s) : value(static_cast<const char*>(s))
+    {}
+
+    const char* data() const
+    {
+        return value.data();
+    }
+
+  private:
+    /** Find the placeholders in the message, until the end of the
+     *  message or max_placeholders have been found.
+     *
+     *  Every '{' with a '}' after it is recorded, the same as do_log
+     *  matches a header against the text up to the next '}', so a
+     *  placeholder may overlap the one before it.
+     */
+    constexpr void parse()
+    {
+        parsed = value.size();
+
+        for (auto open = value.find('{'); open != value.npos;
+             open = value.find('{', open + 1))
+        {
+            auto close = value.find('}', open + 1);
+            if (close == value.npos)
+            {
+                return;
+            }
+
+            if (count == max_placeholders)
+            {
+                parsed = open;
+                return;
+            }
+
+            placeholders[count++] = {static_cast<uint32_t>(open),
+                                     static_cast<uint32_t>(close - open - 1)};
+        }
+    }
+};
+
+} // namespace lg2::details
@@ -3,6 +3,7 @@
 #include "lg2_commit.hpp"
 
 #include <sys/syslog.h>
+#include <unistd.h>
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/commit.hpp>
@@ -12,6 +13,14 @@
 #include <xyz/openbmc_project/Logging/Create/client.hpp>
 #include <xyz/openbmc_project/Logging/Entry/client.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+
 namespace lg2
 {
 namespace details
@@ -54,13 +63,11 @@ static auto severity_from_syslog(int s) -> Entry::Level
 
 using AdditionalData_t = std::map<std::string, std::string>;
 
-/* Create AdditionalData from the sdbusplus event json. */
-static auto data_from_json(sdbusplus::exception::generated_event_base& t)
-    -> AdditionalData_t
+/* Create AdditionalData from the data of the sdbusplus event json. */
+static auto data_from_json(const nlohmann::json& j) -> AdditionalData_t
 {
     AdditionalData_t result{};
 
-    auto j = t.to_json()[t.name()];
     for (const auto& item : j.items())
     {
         // Special cases for the "_SOURCE" fields, which contain debug
@@ -109,50 +116,263 @@ static auto data_from_json(sdbusplus::exception::generated_event_base& t)
 auto extractEvent(sdbusplus::exception::generated_event_base&& t)
     -> std::tuple<std::string, Entry::Level, std::map<std::string, std::string>>
 {
-    return {t.name(), severity_from_syslog(t.severity()), data_from_json(t)};
+    auto j = t.to_json();
+    return {t.name(), severity_from_syslog(t.severity()),
+            data_from_json(j[t.name()])};
 }
 
-} // namespace details
+using Event_t = std::tuple<std::string, Entry::Level, AdditionalData_t>;
 
-auto commit(sdbusplus::exception::generated_event_base&& t)
-    -> sdbusplus::message::object_path
+/* Journal the event, if enabled, and extract what Create needs from it.
+ *
+ * The event is only converted to json once, as the conversion is a large
+ * part of the cost of a commit.
+ */
+static auto prepare_event(sdbusplus::exception::generated_event_base& t)
+    -> Event_t
 {
+    auto j = t.to_json();
+
     if constexpr (LG2_COMMIT_JOURNAL)
     {
-        lg2::error("OPENBMC_MESSAGE_ID={DATA}", "DATA", t.to_json().dump());
+        lg2::error("OPENBMC_MESSAGE_ID={DATA}", "DATA", j.dump());
     }
 
+    Event_t result{t.name(), severity_from_syslog(t.severity()), {}};
+
     if constexpr (LG2_COMMIT_DBUS)
     {
-        using details::Create;
+        std::get<AdditionalData_t>(result) = data_from_json(j[t.name()]);
+    }
+
+    return result;
+}
+
+/* The dbus connection of the synchronous functions.
+ *
+ * Setting up a connection costs more than the Create call itself, so one is
+ * kept for the life of the process rather than made for every call.  sd-bus
+ * connections aren't thread-safe, so calls on it are serialized.  It is made
+ * again after a failed call, in case the connection was lost, and in a child
+ * process, which can't use its parent's connection.
+ */
+class CommitBus
+{
+  public:
+    template <typename F>
+    auto call(F&& f)
+    {
+        std::lock_guard l{lock};
+
+        if (!bus || (pid != getpid()))
+        {
+            bus.emplace(sdbusplus::bus::new_bus());
+            pid = getpid();
+        }
+
+        try
+        {
+            return f(*bus);
+        }
+        catch (const sdbusplus::exception_t&)
+        {
+            bus.reset();
+            throw;
+        }
+    }
+
+  private:
+    std::mutex lock;
+    std::optional<sdbusplus::bus_t> bus;
+    pid_t pid = 0;
+};
+
+static auto commit_bus() -> CommitBus&
+{
+    static CommitBus bus;
+    return bus;
+}
 
-        auto b = sdbusplus::bus::new_default();
+/* Call Create on the commit connection.
+ *
+ * The timeout is in microseconds, with 0 for the sd-bus default.
+ */
+static auto create(const Event_t& event, uint64_t timeout = 0)
+    -> sdbusplus::message::object_path
+{
+    return commit_bus().call([&event, timeout](sdbusplus::bus_t& b) {
         auto m =
             b.new_method_call(Create::default_service, Create::instance_path,
                               Create::interface, "Create");
 
-        m.append(t.name(), details::severity_from_syslog(t.severity()),
-                 details::data_from_json(t));
+        std::apply([&m](const auto&... args) { m.append(args...); }, event);
 
-        auto reply = b.call(m);
+        auto reply = b.call(m, timeout);
 
         return reply.unpack<sdbusplus::message::object_path>();
+    });
+}
+
+/* The events committed by commit_async(), created in order by a worker.
+ *
+ * The worker is started on first use.  Events still pending when the
+ * process exits are created before the worker is stopped, but only for up
+ * to drainTimeout, as exit would hang on a daemon that doesn't answer.  The
+ * rest are dropped once that runs out or a Create call fails, which leaves
+ * their futures with a broken_promise error.
+ */
+class CommitQueue
+{
+  public:
+    static constexpr auto drainTimeout = std::chrono::seconds(2);
+
+    CommitQueue()
+    {
+        // Destroyed after the queue, which uses it until the worker stops.
+        commit_bus();
+    }
+
+    ~CommitQueue()
+    {
+        if (worker.joinable())
+        {
+            worker.request_stop();
+            worker.join();
+        }
+    }
+
+    CommitQueue(const CommitQueue&) = delete;
+    CommitQueue& operator=(const CommitQueue&) = delete;
+    CommitQueue(CommitQueue&&) = delete;
+    CommitQueue& operator=(CommitQueue&&) = delete;
+
+    auto push(Event_t&& event) -> std::future<sdbusplus::message::object_path>
+    {
+        std::lock_guard l{lock};
+
+        auto& request = pending.emplace_back(std::move(event));
+        auto result = request.path.get_future();
+
+        if (!worker.joinable())
+        {
+            worker = std::jthread([this](std::stop_token stop) { run(stop); });
+        }
+
+        wakeup.notify_one();
+
+        return result;
+    }
+
+  private:
+    struct Request
+    {
+        explicit Request(Event_t&& event) : event(std::move(event)) {}
+
+        Event_t event;
+        std::promise<sdbusplus::message::object_path> path;
+    };
+
+    void run(std::stop_token stop)
+    {
+        std::unique_lock l{lock};
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        bool failed = false;
+
+        // Once stopped, this still returns true until the queue is drained.
+        while (wakeup.wait(l, stop, [this]() { return !pending.empty(); }))
+        {
+            uint64_t timeout = 0;
+
+            if (stop.stop_requested())
+            {
+                auto now = std::chrono::steady_clock::now();
+                if (!deadline)
+                {
+                    deadline = now + drainTimeout;
+                }
+
+                if (failed || (now >= *deadline))
+                {
+                    lg2::error("Dropping {COUNT} events not committed at exit",
+                               "COUNT", pending.size());
+                    pending.clear();
+                    break;
+                }
+
+                timeout = std::chrono::ceil<std::chrono::microseconds>(
+                              *deadline - now)
+                              .count();
+            }
+
+            auto request = std::move(pending.front());
+            pending.pop_front();
+            l.unlock();
+
+            try
+            {
+                request.path.set_value(create(request.event, timeout));
+            }
+            catch (...)
+            {
+                request.path.set_exception(std::current_exception());
+                failed = stop.stop_requested();
+            }
+
+            l.lock();
+        }
+    }
+
+    std::mutex lock;
+    std::condition_variable_any wakeup;
+    std::deque<Request> pending;
+    std::jthread worker;
+};
+
+} // namespace details
+
+auto commit(sdbusplus::exception::generated_event_base&& t)
+    -> sdbusplus::message::object_path
+{
+    auto event = details::prepare_event(t);
+
+    if constexpr (LG2_COMMIT_DBUS)
+    {
+        return details::create(event);
     }
 
     return {};
 }
 
+auto commit_async(sdbusplus::exception::generated_event_base&& t)
+    -> std::future<sdbusplus::message::object_path>
+{
+    auto event = details::prepare_event(t);
+
+    if constexpr (LG2_COMMIT_DBUS)
+    {
+        static details::CommitQueue queue;
+        return queue.push(std::move(event));
+    }
+
+    std::promise<sdbusplus::message::object_path> path;
+    path.set_value({});
+    return path.get_future();
+}
+
 void resolve(const sdbusplus::message::object_path& logPath)
 {
     if constexpr (LG2_COMMIT_DBUS)
     {
         using details::Entry;
 
-        auto b = sdbusplus::bus::new_default();
-        auto m = b.new_method_call(Entry::default_service, logPath.str.c_str(),
-                                   "org.freedesktop.DBus.Properties", "Set");
-        m.append(Entry::interface, "Resolved", std::variant<bool>(true));
-        auto reply = b.call(m);
+        details::commit_bus().call([&logPath](sdbusplus::bus_t& b) {
+            auto m = b.new_method_call(Entry::default_service,
+                                       logPath.str.c_str(),
+                                       "org.freedesktop.DBus.Properties",
+                                       "Set");
+            m.append(Entry::interface, "Resolved", std::variant<bool>(true));
+            b.call(m);
+        });
     }
 }
 
@@ -162,18 +382,14 @@ auto commit(sdbusplus::async::context& ctx,
 {
     using details::Create;
 
-    if constexpr (LG2_COMMIT_JOURNAL)
-    {
-        lg2::error("OPENBMC_MESSAGE_ID={DATA}", "DATA", t.to_json().dump());
-    }
+    auto [message, level, data] = details::prepare_event(t);
 
     if constexpr (LG2_COMMIT_DBUS)
     {
         co_return co_await Create(ctx)
             .service(Create::default_service)
             .path(Create::instance_path)
-            .create(t.name(), details::severity_from_syslog(t.severity()),
-                    details::data_from_json(t));
+            .create(message, level, data);
     }
     co_return {};
 }
@@ -6,117 +6,249 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <algorithm>
-#include <bitset>
+#include <array>
+#include <charconv>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <source_location>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace lg2::details
 {
-/** Convert unsigned to string using format flags. */
-static std::string value_to_string(uint64_t f, uint64_t v)
+/** A stack buffer that the journal fields are formatted into.
+ *
+ *  Fields are built up one at a time with begin(), append() and end().
+ *  Once a field is ended it never moves, so the iovec for it stays valid,
+ *  and only a field that doesn't fit in the stack buffer causes a heap
+ *  allocation.
+ */
+class field_arena
 {
+  public:
+    field_arena() = default;
+    field_arena(const field_arena&) = delete;
+    field_arena& operator=(const field_arena&) = delete;
+
+    /** Start a new field. */
+    void begin()
+    {
+        field_start = used;
+    }
+
+    /** Append data to the current field. */
+    void append(const char* data, size_t size)
+    {
+        if (used + size > capacity)
+        {
+            grow(size);
+        }
+        std::memcpy(current + used, data, size);
+        used += size;
+    }
+
+    void append(std::string_view data)
+    {
+        append(data.data(), data.size());
+    }
+
+    void append(char c)
+    {
+        append(&c, 1);
+    }
+
+    /** Finish the current field, returning where it is. */
+    iovec end()
+    {
+        return iovec{current + field_start, used - field_start};
+    }
+
+  private:
+    /** Move the current field to a new heap chunk with room for 'size'
+     *  more bytes.  Fields that were already ended stay where they are.
+     */
+    void grow(size_t size)
+    {
+        auto field_size = used - field_start;
+        auto chunk_size = std::max(stack_size, 2 * (field_size + size));
+        auto& chunk =
+            overflow.emplace_back(std::make_unique<char[]>(chunk_size));
+
+        std::memcpy(chunk.get(), current + field_start, field_size);
+        current = chunk.get();
+        capacity = chunk_size;
+        field_start = 0;
+        used = field_size;
+    }
+
+    static constexpr size_t stack_size = 2048;
+
+    char buffer[stack_size];
+    char* current = buffer;
+    size_t capacity = stack_size;
+    size_t used = 0;
+    size_t field_start = 0;
+    std::vector<std::unique_ptr<char[]>> overflow;
+};
+
+/** A vector that holds its first N elements without allocating. */
+template <typename T, size_t N>
+class small_vector
+{
+  public:
+    void push_back(const T& t)
+    {
+        if (count < N)
+        {
+            inline_data[count] = t;
+        }
+        else
+        {
+            if (heap_data.empty())
+            {
+                heap_data.assign(inline_data.begin(), inline_data.end());
+            }
+            heap_data.push_back(t);
+        }
+        ++count;
+    }
+
+    T* data()
+    {
+        return count <= N ? inline_data.data() : heap_data.data();
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    T& operator[](size_t i)
+    {
+        return data()[i];
+    }
+
+  private:
+    std::array<T, N> inline_data;
+    std::vector<T> heap_data;
+    size_t count = 0;
+};
+
+/** Append an unsigned value to a field using the format flags. */
+static void append_value(field_arena& arena, uint64_t f, uint64_t v)
+{
+    char value[72];
+
     switch (f & (hex | bin | dec).value)
     {
-        // For binary, use bitset<>::to_string.
+        // For binary, print every bit of the field width.
         // Treat values without a field-length format flag as 64 bit.
         case bin.value:
         {
+            size_t bits = 64;
             switch (f & (field8 | field16 | field32 | field64).value)
             {
                 case field8.value:
-                {
-                    return "0b" + std::bitset<8>(v).to_string();
-                }
+                    bits = 8;
+                    break;
                 case field16.value:
-                {
-                    return "0b" + std::bitset<16>(v).to_string();
-                }
+                    bits = 16;
+                    break;
                 case field32.value:
-                {
-                    return "0b" + std::bitset<32>(v).to_string();
-                }
+                    bits = 32;
+                    break;
                 case field64.value:
                 default:
-                {
-                    return "0b" + std::bitset<64>(v).to_string();
-                }
+                    break;
+            }
+
+            value[0] = '0';
+            value[1] = 'b';
+            for (size_t i = 0; i < bits; i++)
+            {
+                value[2 + i] = (v & (1ULL << (bits - 1 - i))) ? '1' : '0';
             }
+            arena.append(value, 2 + bits);
+            return;
         }
 
-        // For hex, use the appropriate sprintf.
+        // For hex, zero pad to the field width.
         case hex.value:
         {
-            char value[19];
-            const char* format = nullptr;
-
+            size_t width = 0;
             switch (f & (field8 | field16 | field32 | field64).value)
             {
                 case field8.value:
-                {
-                    format = "0x%02" PRIx64;
+                    width = 2;
                     break;
-                }
-
                 case field16.value:
-                {
-                    format = "0x%04" PRIx64;
+                    width = 4;
                     break;
-                }
-
                 case field32.value:
-                {
-                    format = "0x%08" PRIx64;
+                    width = 8;
                     break;
-                }
-
                 case field64.value:
-                {
-                    format = "0x%016" PRIx64;
+                    width = 16;
                     break;
-                }
-
                 default:
-                {
-                    format = "0x%" PRIx64;
                     break;
-                }
             }
 
-            snprintf(value, sizeof(value), format, v);
-            return value;
+            char digits[16];
+            auto end =
+                std::to_chars(digits, digits + sizeof(digits), v, 16).ptr;
+            size_t size = end - digits;
+
+            arena.append("0x", 2);
+            for (; size < width; width--)
+            {
+                arena.append('0');
+            }
+            arena.append(digits, size);
+            return;
         }
 
-        // For dec, use the simple to_string.
         case dec.value:
         default:
         {
-            return std::to_string(v);
+            auto end = std::to_chars(value, value + sizeof(value), v).ptr;
+            arena.append(value, end - value);
+            return;
         }
     }
 }
 
-/** Convert signed to string using format flags. */
-static std::string value_to_string(uint64_t f, int64_t v)
+/** Append a signed value to a field using the format flags. */
+static void append_value(field_arena& arena, uint64_t f, int64_t v)
 {
     // If hex or bin was requested just use the unsigned formatting
     // rules. (What should a negative binary number look like otherwise?)
     if (f & (hex | bin).value)
     {
-        return value_to_string(f, static_cast<uint64_t>(v));
+        append_value(arena, f, static_cast<uint64_t>(v));
+        return;
     }
-    return std::to_string(v);
+
+    char value[24];
+    auto end = std::to_chars(value, value + sizeof(value), v).ptr;
+    arena.append(value, end - value);
 }
 
-/** Convert float to string using format flags. */
-static std::string value_to_string(uint64_t, double v)
+/** Append a float to a field using the format flags. */
+static void append_value(field_arena& arena, uint64_t, double v)
 {
-    // No format flags supported for floats.
-    return std::to_string(v);
+    // No format flags supported for floats.  Match std::to_string(), which
+    // is "%f".
+    char value[400];
+    auto end = std::to_chars(value, value + sizeof(value), v,
+                             std::chars_format::fixed, 6)
+                   .ptr;
+    arena.append(value, end - value);
 }
 
 // Positions of various strings in an iovec.
@@ -130,12 +262,12 @@ static constexpr size_t static_locs = pos_func + 1;
 
 /** No-op output of a message. */
 static void noop_extra_output(level, const std::source_location&,
-                              const std::string&)
+                              std::string_view)
 {}
 
 /** std::cerr output of a message. */
 static void cerr_extra_output(level l, const std::source_location& s,
-                              const std::string& m)
+                              std::string_view m)
 {
     static const char* const defaultFormat = []() {
         const char* f = getenv("LG2_FORMAT");
@@ -218,97 +350,237 @@ static auto extra_output_method =
 // per systemd.exec manpage.
 static auto send_debug_to_journal = nullptr != getenv("DEBUG_INVOCATION");
 
-// Do_log implementation.
-void do_log(level l, const std::source_location& s, const char* m, ...)
+/** A value passed to do_log, after it has been formatted into its field. */
+struct log_arg
 {
-    using namespace std::string_literals;
+    std::string_view header;
+    std::string_view value;
+    bool used;
+};
+
+/** Replace the header in the args which matches the name, if there is
+ *  one which isn't used yet.
+ *
+ *  @return true if the header was found
+ */
+template <size_t N>
+static bool append_header(field_arena& arena, std::string_view name,
+                          small_vector<log_arg, N>& args)
+{
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        if (!args[i].used && (args[i].header == name))
+        {
+            args[i].used = true;
+            arena.append(args[i].value);
+            return true;
+        }
+    }
+    return false;
+}
 
-    std::vector<std::string> strings{static_locs};
+/** Append the message, with each {HEADER} replaced by its value, in a
+ *  single pass over the message.
+ *
+ *  Only the first {HEADER} for each argument is replaced.  A {HEADER}
+ *  with no matching argument is left as is.
+ */
+template <size_t N>
+static void append_message(field_arena& arena, std::string_view m,
+                           small_vector<log_arg, N>& args)
+{
+    while (!m.empty())
+    {
+        auto open = m.find('{');
+        if (open == std::string_view::npos)
+        {
+            break;
+        }
+
+        arena.append(m.data(), open);
+        m.remove_prefix(open);
+
+        auto close = m.find('}', 1);
+        if (close == std::string_view::npos)
+        {
+            break;
+        }
 
-    std::string message{m};
+        if (append_header(arena, m.substr(1, close - 1), args))
+        {
+            m.remove_prefix(close + 1);
+        }
+        else
+        {
+            arena.append('{');
+            m.remove_prefix(1);
+        }
+    }
 
-    // Assign all the static fields.
-    strings[pos_fmtmsg] = "LOG2_FMTMSG="s + m;
-    strings[pos_prio] = "PRIORITY="s + std::to_string(static_cast<uint64_t>(l));
-    strings[pos_file] = "CODE_FILE="s + s.file_name();
-    strings[pos_line] = "CODE_LINE="s + std::to_string(s.line());
-    strings[pos_func] = "CODE_FUNC="s + s.function_name();
+    arena.append(m);
+}
+
+/** Append the message using the placeholders found at compile time,
+ *  and searching the rest of the message the same as a runtime string.
+ */
+template <size_t N>
+static void append_message(field_arena& arena, const message_str& m,
+                           small_vector<log_arg, N>& args)
+{
+    size_t pos = 0;
+    for (size_t i = 0; i < m.count; i++)
+    {
+        const auto& p = m.placeholders[i];
+        if (p.offset < pos)
+        {
+            continue;
+        }
+
+        arena.append(m.value.substr(pos, p.offset - pos));
+        if (append_header(arena, m.value.substr(p.offset + 1, p.size), args))
+        {
+            pos = p.offset + p.size + 2;
+        }
+        else
+        {
+            pos = p.offset;
+        }
+    }
+
+    auto rest = std::max(pos, m.parsed);
+    arena.append(m.value.substr(pos, rest - pos));
+    append_message(arena, m.value.substr(rest), args);
+}
+
+/** Log the message, with the arguments from the va_list. */
+static void vlog(level l, const std::source_location& s, const message_str& m,
+                 std::va_list& va)
+{
+    // Typical calls have a handful of arguments, which fit in here along
+    // with the fixed fields without touching the heap.
+    constexpr size_t inline_args = 16;
+
+    field_arena arena;
+    small_vector<iovec, static_locs + inline_args> iov;
+    small_vector<log_arg, inline_args> args;
+
+    // Assign all the static fields.  MESSAGE is filled in last.
+    iov.push_back({});
+
+    arena.begin();
+    arena.append("LOG2_FMTMSG=");
+    arena.append(m.value);
+    iov.push_back(arena.end());
+
+    arena.begin();
+    arena.append("PRIORITY=");
+    append_value(arena, dec.value, static_cast<uint64_t>(l));
+    iov.push_back(arena.end());
+
+    arena.begin();
+    arena.append("CODE_FILE=");
+    arena.append(s.file_name());
+    iov.push_back(arena.end());
+
+    arena.begin();
+    arena.append("CODE_LINE=");
+    append_value(arena, dec.value, static_cast<uint64_t>(s.line()));
+    iov.push_back(arena.end());
+
+    arena.begin();
+    arena.append("CODE_FUNC=");
+    arena.append(s.function_name());
+    iov.push_back(arena.end());
 
     // Handle all the va_list args.
-    std::va_list args;
-    va_start(args, m);
     while (true)
     {
         // Get the header out.
-        auto h_ptr = va_arg(args, const char*);
+        auto h_ptr = va_arg(va, const char*);
         if (h_ptr == nullptr)
         {
             break;
         }
-        std::string h{h_ptr};
+        std::string_view h{h_ptr};
 
         // Get the format flag.
-        auto f = va_arg(args, uint64_t);
+        auto f = va_arg(va, uint64_t);
+
+        // Create the field for this value.
+        arena.begin();
+        arena.append(h);
+        arena.append('=');
 
         // Handle the value depending on which type format flag it has.
-        std::string value = {};
         switch (f & (signed_val | unsigned_val | str | floating).value)
         {
             case signed_val.value:
             {
-                auto v = va_arg(args, int64_t);
-                value = value_to_string(f, v);
+                append_value(arena, f, va_arg(va, int64_t));
                 break;
             }
 
             case unsigned_val.value:
             {
-                auto v = va_arg(args, uint64_t);
-                value = value_to_string(f, v);
+                append_value(arena, f, va_arg(va, uint64_t));
                 break;
             }
 
             case str.value:
             {
-                value = va_arg(args, const char*);
+                arena.append(va_arg(va, const char*));
                 break;
             }
 
             case floating.value:
             {
-                auto v = va_arg(args, double);
-                value = value_to_string(f, v);
+                append_value(arena, f, va_arg(va, double));
                 break;
             }
         }
 
-        // Create the field for this value.
-        strings.emplace_back(h + '=' + value);
+        auto field = arena.end();
+        iov.push_back(field);
 
-        // Check for {HEADER} in the message and replace with value.
-        auto h_brace = '{' + h + '}';
-        if (auto start = message.find(h_brace); start != std::string::npos)
-        {
-            message.replace(start, h_brace.size(), value);
-        }
+        std::string_view value{static_cast<const char*>(field.iov_base),
+                               field.iov_len};
+        value.remove_prefix(h.size() + 1);
+        args.push_back({h, value, false});
     }
-    va_end(args);
 
-    // Add the final message into the strings array.
-    strings[pos_msg] = "MESSAGE="s + message.data();
+    // Add the final message, with the values filled in.
+    arena.begin();
+    arena.append("MESSAGE=");
+    append_message(arena, m, args);
+    iov[pos_msg] = arena.end();
 
-    // Trasform strings -> iovec.
-    std::vector<iovec> iov{};
-    std::ranges::transform(strings, std::back_inserter(iov), [](auto& s) {
-        return iovec{s.data(), s.length()};
-    });
+    std::string_view message{static_cast<const char*>(iov[pos_msg].iov_base),
+                             iov[pos_msg].iov_len};
+    message.remove_prefix(sizeof("MESSAGE=") - 1);
 
     // Output the iovec.
     if (send_debug_to_journal || l != level::debug)
     {
-        sd_journal_sendv(iov.data(), strings.size());
+        sd_journal_sendv(iov.data(), iov.size());
     }
     extra_output_method(l, s, message);
 }
 
+// Do_log implementation.
+void do_log(level l, const std::source_location& s, const char* m, ...)
+{
+    std::va_list va;
+    va_start(va, m);
+    vlog(l, s, message_str{m}, va);
+    va_end(va);
+}
+
+void do_log(level l, const std::source_location& s, const message_str* m, ...)
+{
+    std::va_list va;
+    va_start(va, m);
+    vlog(l, s, *m, va);
+    va_end(va);
+}
+
 } // namespace lg2::details
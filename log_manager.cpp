@@ -31,6 +31,7 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <vector>
 
 using namespace std::chrono;
@@ -49,15 +50,109 @@ inline auto getLevel(const std::string& errMsg)
 {
     auto reqLevel = Entry::Level::Error; // Default to Error
 
-    auto levelmap = g_errLevelMap.find(errMsg);
-    if (levelmap != g_errLevelMap.end())
+    if (const auto* errLevel = g_errLevelMap.find(errMsg))
     {
-        reqLevel = static_cast<Entry::Level>(levelmap->second);
+        reqLevel = static_cast<Entry::Level>(*errLevel);
     }
 
     return reqLevel;
 }
 
+/**
+ * @brief The most journal entries with a matching transaction ID to look
+ *        through for metadata.
+ */
+constexpr size_t maxTransactionEntries = 64;
+
+/**
+ * @brief Reads the metadata for a committed error from the journal.
+ *
+ * Only the journal entries with the transaction ID are looked at, newest
+ * first, stopping once all the metadata is found or after
+ * maxTransactionEntries entries.
+ *
+ * @param[in] j - The open journal
+ * @param[in] transactionId - The transaction ID of the commit
+ * @param[in] errMsg - The error message, used to find the metadata names
+ *
+ * @return The metadata names and values found
+ */
+std::map<std::string, std::string> readCommitMetadata(
+    sd_journal* j, uint64_t transactionId, const std::string& errMsg)
+{
+    std::map<std::string, std::string> additionalData{};
+
+    std::set<std::string> metalist;
+    if (const auto* errMeta = g_errMetaMap.find(errMsg))
+    {
+        for (auto name : *errMeta)
+        {
+            metalist.emplace(name);
+        }
+    }
+
+    // Add _PID field information in AdditionalData.
+    metalist.insert("_PID");
+
+    sd_journal_flush_matches(j);
+    auto match = "TRANSACTION_ID=" + std::to_string(transactionId);
+    int rc = sd_journal_add_match(j, match.c_str(), 0);
+    if (rc < 0)
+    {
+        lg2::error("Failed to add journal match {MATCH}: {ERROR}", "MATCH",
+                   match, "ERROR", strerror(-rc));
+        return additionalData;
+    }
+
+    // Read the journal from the end to get the most recent entry first.
+    // The result from the sd_journal_get_data() is of the form
+    // VARIABLE=value.
+    sd_journal_seek_tail(j);
+    for (size_t count = 0; (count < maxTransactionEntries) &&
+                           !metalist.empty() && (sd_journal_previous(j) > 0);
+         count++)
+    {
+        // Search for all metadata variables in the current journal entry.
+        for (auto i = metalist.cbegin(); i != metalist.cend();)
+        {
+            const char* data = nullptr;
+            size_t length = 0;
+
+            rc = sd_journal_get_data(j, (*i).c_str(), (const void**)&data,
+                                     &length);
+            if (rc < 0)
+            {
+                // Metadata variable not found, check next metadata
+                // variable.
+                i++;
+                continue;
+            }
+
+            // Metadata variable found, save it and remove it from the set.
+            std::string metadata(data, length);
+            if (auto pos = metadata.find('='); pos != std::string::npos)
+            {
+                auto key = metadata.substr(0, pos);
+                auto value = metadata.substr(pos + 1);
+                additionalData.emplace(std::move(key), std::move(value));
+            }
+            i = metalist.erase(i);
+        }
+    }
+
+    if (!metalist.empty())
+    {
+        // Not all the metadata variables were found in the journal.
+        for (auto& metaVarStr : metalist)
+        {
+            lg2::info("Failed to find metadata: {META_FIELD}", "META_FIELD",
+                      metaVarStr);
+        }
+    }
+
+    return additionalData;
+}
+
 int Manager::getRealErrSize()
 {
     return realErrors.size();
@@ -71,203 +166,293 @@ int Manager::getInfoErrSize()
 uint32_t Manager::commit(uint64_t transactionId, std::string errMsg)
 {
     auto level = getLevel(errMsg);
-    _commit(transactionId, std::move(errMsg), level);
-    return entryId;
+    return _commit(transactionId, std::move(errMsg), level);
 }
 
 uint32_t Manager::commitWithLvl(uint64_t transactionId, std::string errMsg,
                                 uint32_t errLvl)
 {
-    _commit(transactionId, std::move(errMsg),
-            static_cast<Entry::Level>(errLvl));
-    return entryId;
+    return _commit(transactionId, std::move(errMsg),
+                   static_cast<Entry::Level>(errLvl));
 }
 
-void Manager::_commit(uint64_t transactionId [[maybe_unused]],
-                      std::string&& errMsg, Entry::Level errLvl)
+uint32_t Manager::_commit(uint64_t transactionId, std::string&& errMsg,
+                          Entry::Level errLvl)
 {
-    std::map<std::string, std::string> additionalData{};
-
     // When running as a test-case, the system may have a LOT of journal
     // data and we may not have permissions to do some of the journal sync
-    // operations.  Just skip over them.
-    if (!IS_UNIT_TEST)
+    // operations.  Just skip over them, unless the test provided its own
+    // journal syncer.
+    if (IS_UNIT_TEST && !journalSyncer)
     {
-        static constexpr auto transactionIdVar =
-            std::string_view{"TRANSACTION_ID"};
-        // Length of 'TRANSACTION_ID' string.
-        static constexpr auto transactionIdVarSize = transactionIdVar.size();
-        // Length of 'TRANSACTION_ID=' string.
-        static constexpr auto transactionIdVarOffset = transactionIdVarSize + 1;
+        createEntry(std::move(errMsg), errLvl, {});
+        return entryId;
+    }
 
-        // Flush all the pending log messages into the journal
-        util::journalSync();
+    // The ID is returned to the caller now, but the entry can't be made
+    // until the journal is synced and its metadata can be read.
+    auto id = ++entryId;
+    PendingCommit commit{transactionId, std::move(errMsg), errLvl, id};
 
-        sd_journal* j = nullptr;
-        int rc = sd_journal_open(&j, SD_JOURNAL_LOCAL_ONLY);
-        if (rc < 0)
-        {
-            lg2::error("Failed to open journal: {ERROR}", "ERROR",
-                       strerror(-rc));
-            return;
-        }
+    if (!journalSyncer)
+    {
+        journalSyncer = std::make_unique<JournalSync>(busLog);
+    }
 
-        std::string transactionIdStr = std::to_string(transactionId);
-        std::set<std::string> metalist;
-        auto metamap = g_errMetaMap.find(errMsg);
-        if (metamap != g_errMetaMap.end())
-        {
-            metalist.insert(metamap->second.begin(), metamap->second.end());
-        }
+    // Anything logged after a sync was requested may not be part of it,
+    // so these wait for the next one.
+    if (journalSyncer->inProgress())
+    {
+        waitingCommits.push_back(std::move(commit));
+    }
+    else
+    {
+        syncingCommits.push_back(std::move(commit));
+        journalSyncer->start([this]() { finishCommits(); });
+    }
 
-        // Add _PID field information in AdditionalData.
-        metalist.insert("_PID");
+    return id;
+}
 
-        // Read the journal from the end to get the most recent entry first.
-        // The result from the sd_journal_get_data() is of the form
-        // VARIABLE=value.
-        SD_JOURNAL_FOREACH_BACKWARDS(j)
-        {
-            const char* data = nullptr;
-            size_t length = 0;
+void Manager::finishCommits()
+{
+    auto commits = std::move(syncingCommits);
+    syncingCommits = std::move(waitingCommits);
+    waitingCommits.clear();
 
-            // Look for the transaction id metadata variable
-            rc = sd_journal_get_data(j, transactionIdVar.data(),
-                                     (const void**)&data, &length);
-            if (rc < 0)
-            {
-                // This journal entry does not have the TRANSACTION_ID
-                // metadata variable.
-                continue;
-            }
+    if (!syncingCommits.empty())
+    {
+        journalSyncer->start([this]() { finishCommits(); });
+    }
 
-            // journald does not guarantee that sd_journal_get_data() returns
-            // NULL terminated strings, so need to specify the size to use to
-            // compare, use the returned length instead of anything that relies
-            // on NULL terminators like strlen(). The data variable is in the
-            // form of 'TRANSACTION_ID=1234'. Remove the TRANSACTION_ID
-            // characters plus the (=) sign to do the comparison. 'data +
-            // transactionIdVarOffset' will be in the form of '1234'. 'length -
-            // transactionIdVarOffset' will be the length of '1234'.
-            if ((length <= (transactionIdVarOffset)) ||
-                (transactionIdStr.compare(
-                     0, transactionIdStr.size(), data + transactionIdVarOffset,
-                     length - transactionIdVarOffset) != 0))
-            {
-                // The value of the TRANSACTION_ID metadata is not the requested
-                // transaction id number.
-                continue;
-            }
+    sd_journal* journalPtr = nullptr;
+    int rc = sd_journal_open(&journalPtr, SD_JOURNAL_LOCAL_ONLY);
+    if (rc < 0)
+    {
+        lg2::error("Failed to open journal: {ERROR}", "ERROR", strerror(-rc));
+        journalPtr = nullptr;
+    }
+    std::unique_ptr<sd_journal, decltype(&sd_journal_close)> j{
+        journalPtr, sd_journal_close};
 
-            // Search for all metadata variables in the current journal entry.
-            for (auto i = metalist.cbegin(); i != metalist.cend();)
-            {
-                rc = sd_journal_get_data(j, (*i).c_str(), (const void**)&data,
-                                         &length);
-                if (rc < 0)
-                {
-                    // Metadata variable not found, check next metadata
-                    // variable.
-                    i++;
-                    continue;
-                }
-
-                // Metadata variable found, save it and remove it from the set.
-                std::string metadata(data, length);
-                if (auto pos = metadata.find('='); pos != std::string::npos)
-                {
-                    auto key = metadata.substr(0, pos);
-                    auto value = metadata.substr(pos + 1);
-                    additionalData.emplace(std::move(key), std::move(value));
-                }
-                i = metalist.erase(i);
-            }
-            if (metalist.empty())
+    // One bad commit can't drop the ones after it.
+    for (auto& commit : commits)
+    {
+        try
+        {
+            std::map<std::string, std::string> additionalData{};
+            if (j)
             {
-                // All metadata variables found, break out of journal loop.
-                break;
+                additionalData = readCommitMetadata(
+                    j.get(), commit.transactionId, commit.errMsg);
             }
+
+            createEntry(std::move(commit.errMsg), commit.errLvl,
+                        std::move(additionalData), FFDCEntries{}, commit.id);
         }
-        if (!metalist.empty())
+        catch (const std::exception& e)
         {
-            // Not all the metadata variables were found in the journal.
-            for (auto& metaVarStr : metalist)
-            {
-                lg2::info("Failed to find metadata: {META_FIELD}", "META_FIELD",
-                          metaVarStr);
-            }
+            lg2::error("Failed to create event log {ID}: {ERROR}", "ID",
+                       commit.id, "ERROR", e);
         }
+    }
+}
+
+void Manager::makeRoom(const std::set<uint32_t>& ids, size_t cap,
+                       size_t count)
+{
+    if (ids.size() + count <= cap)
+    {
+        return;
+    }
+
+    // Erasing removes the ID from the set.
+    auto excess = std::min(ids.size(), ids.size() + count - cap);
+    for (size_t i = 0; i < excess; i++)
+    {
+        erase(*ids.begin());
+    }
+}
+
+auto Manager::makeEntry(std::string errMsg, Entry::Level errLvl,
+                        std::map<std::string, std::string> additionalData,
+                        uint32_t id) -> std::unique_ptr<Entry>
+{
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::system_clock::now().time_since_epoch())
+                  .count();
+    auto objPath = std::string(OBJ_ENTRY) + '/' + std::to_string(id);
+
+    AssociationList objects{};
+    auto additionalDataVec = util::additional_data::combine(additionalData);
+    processMetadata(errMsg, additionalDataVec, objects);
 
-        sd_journal_close(j);
+    // There is no file per entry for FilePath to point to in the journal.
+    std::string filePath;
+    if (!journal)
+    {
+        filePath = getEntrySerializePath(id);
     }
-    createEntry(errMsg, errLvl, additionalData);
+
+    return std::make_unique<Entry>(
+        busLog, objPath, id,
+        ms, // Milliseconds since 1970
+        errLvl, std::move(errMsg), std::move(additionalData),
+        std::move(objects), fwVersion, filePath, *this);
 }
 
 auto Manager::createEntry(std::string errMsg, Entry::Level errLvl,
                           std::map<std::string, std::string> additionalData,
-                          const FFDCEntries& ffdc)
+                          const FFDCEntries& ffdc,
+                          std::optional<uint32_t> reservedId)
     -> sdbusplus::message::object_path
 {
     if (!Extensions::disableDefaultLogCaps())
     {
         if (errLvl < Entry::sevLowerLimit)
         {
-            if (realErrors.size() >= ERROR_CAP)
-            {
-                erase(realErrors.front());
-            }
+            makeRoom(realErrors, ERROR_CAP, 1);
         }
         else
         {
-            if (infoErrors.size() >= ERROR_INFO_CAP)
-            {
-                erase(infoErrors.front());
-            }
+            makeRoom(infoErrors, ERROR_INFO_CAP, 1);
         }
     }
 
-    entryId++;
-    if (errLvl >= Entry::sevLowerLimit)
+    auto id = reservedId ? *reservedId : ++entryId;
+    auto e = makeEntry(std::move(errMsg), errLvl, std::move(additionalData),
+                       id);
+    auto objPath = std::string(OBJ_ENTRY) + '/' + std::to_string(id);
+
+    if (journal)
     {
-        infoErrors.push_back(entryId);
+        try
+        {
+            journal->add(*e);
+        }
+        catch (const std::system_error& ex)
+        {
+            lg2::error("Failed to store event log {ID} in the journal: "
+                       "{ERROR}",
+                       "ID", id, "ERROR", ex);
+        }
     }
     else
     {
-        realErrors.push_back(entryId);
+        serialize(*e);
     }
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                  std::chrono::system_clock::now().time_since_epoch())
-                  .count();
-    auto objPath = std::string(OBJ_ENTRY) + '/' + std::to_string(entryId);
-
-    AssociationList objects{};
-    auto additionalDataVec = util::additional_data::combine(additionalData);
-    processMetadata(errMsg, additionalDataVec, objects);
-
-    auto e = std::make_unique<Entry>(
-        busLog, objPath, entryId,
-        ms, // Milliseconds since 1970
-        errLvl, std::move(errMsg), std::move(additionalData),
-        std::move(objects), fwVersion, getEntrySerializePath(entryId), *this);
-
-    serialize(*e);
 
     if (isQuiesceOnErrorEnabled() && (errLvl < Entry::sevLowerLimit) &&
         isCalloutPresent(*e))
     {
-        quiesceOnError(entryId);
+        quiesceOnError(id);
     }
 
     // Add entry before calling the extensions so that they have access to it
-    entries.insert(std::make_pair(entryId, std::move(e)));
+    addEntry(id, std::move(e));
 
-    doExtensionLogCreate(*entries.find(entryId)->second, ffdc);
+    doExtensionLogCreate(*entries.find(id)->second, ffdc);
 
     // Note: No need to close the file descriptors in the FFDC.
 
     return objPath;
 }
 
+std::vector<sdbusplus::message::object_path>
+    Manager::createBatch(std::vector<BatchEvent> events)
+{
+    // The number of the oldest events of each severity to skip, as the
+    // cap would erase them before the batch is done.
+    size_t skipReal = 0;
+    size_t skipInfo = 0;
+
+    if (!Extensions::disableDefaultLogCaps())
+    {
+        size_t real = std::ranges::count_if(events, [](const auto& event) {
+            return std::get<Severity>(event) < Entry::sevLowerLimit;
+        });
+        size_t info = events.size() - real;
+
+        skipReal = real > ERROR_CAP ? real - ERROR_CAP : 0;
+        skipInfo = info > ERROR_INFO_CAP ? info - ERROR_INFO_CAP : 0;
+
+        makeRoom(realErrors, ERROR_CAP, real - skipReal);
+        makeRoom(infoErrors, ERROR_INFO_CAP, info - skipInfo);
+    }
+
+    std::vector<sdbusplus::message::object_path> paths;
+    paths.reserve(events.size());
+
+    std::vector<std::unique_ptr<Entry>> created;
+    std::vector<const FFDCEntries*> createdFFDC;
+
+    for (auto& [message, severity, additionalData, ffdc] : events)
+    {
+        auto& skip = severity < Entry::sevLowerLimit ? skipReal : skipInfo;
+        if (skip > 0)
+        {
+            skip--;
+            continue;
+        }
+
+        auto id = ++entryId;
+        paths.emplace_back(std::string(OBJ_ENTRY) + '/' + std::to_string(id));
+
+        created.push_back(makeEntry(std::move(message), severity,
+                                    std::move(additionalData), id));
+        createdFFDC.push_back(&ffdc);
+    }
+
+    if (journal)
+    {
+        try
+        {
+            journal->add(created);
+        }
+        catch (const std::system_error& e)
+        {
+            lg2::error("Failed to store {COUNT} event logs in the journal: "
+                       "{ERROR}",
+                       "COUNT", created.size(), "ERROR", e);
+        }
+    }
+    else
+    {
+        for (const auto& e : created)
+        {
+            serialize(*e);
+        }
+    }
+
+    std::optional<bool> quiesce;
+    for (size_t i = 0; i < created.size(); i++)
+    {
+        auto id = created[i]->id();
+
+        if ((created[i]->severity() < Entry::sevLowerLimit) &&
+            isCalloutPresent(*created[i]))
+        {
+            if (!quiesce)
+            {
+                quiesce = isQuiesceOnErrorEnabled();
+            }
+            if (*quiesce)
+            {
+                quiesceOnError(id);
+            }
+        }
+
+        // Add entry before calling the extensions so that they have access
+        // to it
+        addEntry(id, std::move(created[i]));
+        auto& e = *entries.at(id);
+
+        doExtensionLogCreate(e, *createdFFDC[i]);
+    }
+
+    return paths;
+}
+
 auto Manager::createFromEvent(
     sdbusplus::exception::generated_event_base&& event)
     -> sdbusplus::message::object_path
@@ -323,11 +508,13 @@ bool Manager::isCalloutPresent(const Entry& entry)
 
 void Manager::findAndRemoveResolvedBlocks()
 {
-    for (auto& entry : entries)
+    for (auto it = blockingErrors.begin(); it != blockingErrors.end();)
     {
-        if (entry.second->resolved())
+        auto entryId = (it++)->first;
+        auto entry = entries.find(entryId);
+        if ((entry != entries.end()) && entry->second->resolved())
         {
-            checkAndRemoveBlockingError(entry.first);
+            checkAndRemoveBlockingError(entryId);
         }
     }
 }
@@ -403,11 +590,7 @@ void Manager::checkAndQuiesceHost()
 void Manager::quiesceOnError(const uint32_t entryId)
 {
     // Verify we don't already have this entry blocking
-    auto it = find_if(this->blockingErrors.begin(), this->blockingErrors.end(),
-                      [&](const std::unique_ptr<Block>& obj) {
-                          return obj->entryId == entryId;
-                      });
-    if (it != this->blockingErrors.end())
+    if (this->blockingErrors.contains(entryId))
     {
         // Already recorded so just return
         lg2::debug(
@@ -420,7 +603,7 @@ void Manager::quiesceOnError(const uint32_t entryId)
     auto blockPath =
         std::string(OBJ_LOGGING) + "/block" + std::to_string(entryId);
     auto blockObj = std::make_unique<Block>(this->busLog, blockPath, entryId);
-    this->blockingErrors.push_back(std::move(blockObj));
+    this->blockingErrors.emplace(entryId, std::move(blockObj));
 
     // Register call back if log is resolved
     using namespace sdbusplus::bus::match::rules;
@@ -489,14 +672,7 @@ void Manager::processMetadata(const std::string& /*errorName*/,
 void Manager::checkAndRemoveBlockingError(uint32_t entryId)
 {
     // First look for blocking object and remove
-    auto it = find_if(blockingErrors.begin(), blockingErrors.end(),
-                      [&](const std::unique_ptr<Block>& obj) {
-                          return obj->entryId == entryId;
-                      });
-    if (it != blockingErrors.end())
-    {
-        blockingErrors.erase(it);
-    }
+    blockingErrors.erase(entryId);
 
     // Now remove the callback looking for the error to be resolved
     auto resolveFind = propChangedEntryCallback.find(entryId);
@@ -524,123 +700,200 @@ size_t Manager::eraseAll()
                        "ERROR", e);
         }
     }
-    size_t entriesSize = entries.size();
-    auto iter = entries.begin();
-    if (logIDWithHwIsolation.empty())
+    std::set<uint32_t> keep{logIDWithHwIsolation.begin(),
+                            logIDWithHwIsolation.end()};
+
+    std::set<uint32_t> ids;
+    for (const auto& [id, entry] : entries)
+    {
+        if (!keep.contains(id) && !isDeleteProhibited(id))
+        {
+            ids.insert(ids.end(), id);
+        }
+    }
+
+    eraseEntries(ids);
+
+    entryId = entries.empty() ? 0 : entries.rbegin()->first;
+
+    // Don't reuse the IDs already returned for commits still in progress.
+    for (const auto* commits : {&syncingCommits, &waitingCommits})
     {
-        while (iter != entries.end())
+        for (const auto& commit : *commits)
         {
-            auto e = iter->first;
-            ++iter;
-            erase(e);
+            entryId = std::max(entryId, commit.id);
+        }
+    }
+
+    return ids.size();
+}
+
+size_t Manager::erase(const std::set<uint32_t>& ids)
+{
+    std::set<uint32_t> erasable;
+    for (auto id : ids)
+    {
+        if (entries.contains(id) && !isDeleteProhibited(id))
+        {
+            erasable.insert(erasable.end(), id);
+        }
+    }
+
+    eraseEntries(erasable);
+
+    return erasable.size();
+}
+
+void Manager::eraseEntries(const std::set<uint32_t>& ids)
+{
+    if (ids.empty())
+    {
+        return;
+    }
+
+    // Delete the persistent representation of the errors.
+    if (journal)
+    {
+        try
+        {
+            journal->remove(ids);
+        }
+        catch (const std::system_error& e)
+        {
+            lg2::error("Failed to remove {COUNT} event logs from the "
+                       "journal: {ERROR}",
+                       "COUNT", ids.size(), "ERROR", e);
         }
-        entryId = 0;
     }
     else
     {
-        while (iter != entries.end())
+        for (auto id : ids)
         {
-            auto e = iter->first;
-            ++iter;
-            try
-            {
-                if (!std::ranges::contains(logIDWithHwIsolation, e))
-                {
-                    erase(e);
-                }
-                else
-                {
-                    entriesSize--;
-                }
-            }
-            catch (const sdbusplus::xyz::openbmc_project::Common::Error::
-                       Unavailable& e)
+            fs::remove(paths::error() / std::to_string(id));
+        }
+    }
+
+    for (auto id : ids)
+    {
+        realErrors.erase(id);
+        infoErrors.erase(id);
+        entries.erase(id);
+        checkAndRemoveBlockingError(id);
+    }
+
+    notifyDelete(ids);
+}
+
+bool Manager::isDeleteProhibited(uint32_t id) const
+{
+    for (auto& func : Extensions::getDeleteProhibitedFunctions())
+    {
+        try
+        {
+            bool prohibited = false;
+            func(id, prohibited);
+            if (prohibited)
             {
-                entriesSize--;
+                return true;
             }
         }
-        if (!entries.empty())
+        catch (const sdbusplus::xyz::openbmc_project::Common::Error::
+                   Unavailable& e)
         {
-            entryId = std::ranges::max_element(entries, [](const auto& a,
-                                                           const auto& b) {
-                          return a.first < b.first;
-                      })->first;
+            return true;
         }
-        else
+        catch (const std::exception& e)
         {
-            entryId = 0;
+            lg2::error("An extension's deleteProhibited function threw an "
+                       "exception: {ERROR}",
+                       "ERROR", e);
         }
     }
-    return entriesSize;
+
+    return false;
 }
 
-void Manager::erase(uint32_t entryId)
+void Manager::notifyDelete(const std::set<uint32_t>& ids)
 {
-    auto entryFound = entries.find(entryId);
-    if (entries.end() != entryFound)
+    for (auto& remove : Extensions::getDeleteFunctions())
     {
-        for (auto& func : Extensions::getDeleteProhibitedFunctions())
+        for (auto id : ids)
         {
             try
             {
-                bool prohibited = false;
-                func(entryId, prohibited);
-                if (prohibited)
-                {
-                    throw sdbusplus::xyz::openbmc_project::Common::Error::
-                        Unavailable();
-                }
-            }
-            catch (const sdbusplus::xyz::openbmc_project::Common::Error::
-                       Unavailable& e)
-            {
-                throw;
+                remove(id);
             }
             catch (const std::exception& e)
             {
-                lg2::error("An extension's deleteProhibited function threw an "
+                lg2::error("An extension's delete function threw an "
                            "exception: {ERROR}",
                            "ERROR", e);
             }
         }
+    }
 
-        // Delete the persistent representation of this error.
-        fs::path errorPath(paths::error());
-        errorPath /= std::to_string(entryId);
-        fs::remove(errorPath);
-
-        auto removeId = [](std::list<uint32_t>& ids, uint32_t id) {
-            auto it = std::find(ids.begin(), ids.end(), id);
-            if (it != ids.end())
+    // Extensions that handle logs deleted together are told once.
+    for (auto& functions : Extensions::getDeleteAllFunctions())
+    {
+        try
+        {
+            if (ids.size() == 1)
             {
-                ids.erase(it);
+                functions.remove(*ids.begin());
+            }
+            else
+            {
+                functions.removeAll(ids);
             }
-        };
-        if (entryFound->second->severity() >= Entry::sevLowerLimit)
-        {
-            removeId(infoErrors, entryId);
         }
-        else
+        catch (const std::exception& e)
         {
-            removeId(realErrors, entryId);
+            lg2::error("An extension's delete all function threw an "
+                       "exception: {ERROR}",
+                       "ERROR", e);
         }
-        entries.erase(entryFound);
+    }
+}
 
-        checkAndRemoveBlockingError(entryId);
+void Manager::erase(uint32_t entryId)
+{
+    auto entryFound = entries.find(entryId);
+    if (entries.end() != entryFound)
+    {
+        if (isDeleteProhibited(entryId))
+        {
+            throw sdbusplus::xyz::openbmc_project::Common::Error::
+                Unavailable();
+        }
 
-        for (auto& remove : Extensions::getDeleteFunctions())
+        // Delete the persistent representation of this error.
+        if (journal)
         {
             try
             {
-                remove(entryId);
+                journal->remove(entryId);
             }
-            catch (const std::exception& e)
+            catch (const std::system_error& e)
             {
-                lg2::error("An extension's delete function threw an exception: "
-                           "{ERROR}",
-                           "ERROR", e);
+                lg2::error("Failed to remove event log {ID} from the "
+                           "journal: {ERROR}",
+                           "ID", entryId, "ERROR", e);
             }
         }
+        else
+        {
+            fs::path errorPath(paths::error());
+            errorPath /= std::to_string(entryId);
+            fs::remove(errorPath);
+        }
+
+        realErrors.erase(entryId);
+        infoErrors.erase(entryId);
+        entries.erase(entryFound);
+
+        checkAndRemoveBlockingError(entryId);
+
+        notifyDelete({entryId});
     }
     else
     {
@@ -654,6 +907,12 @@ void Manager::restore()
         return id == restoredId;
     };
 
+    if (journal)
+    {
+        restoreFromJournal();
+        return;
+    }
+
     fs::path dir(paths::error());
     if (!fs::exists(dir) || fs::is_empty(dir))
     {
@@ -672,16 +931,7 @@ void Manager::restore()
             if (sanity(static_cast<uint32_t>(idNum), e->id()))
             {
                 e->path(file.path(), true);
-                if (e->severity() >= Entry::sevLowerLimit)
-                {
-                    infoErrors.push_back(idNum);
-                }
-                else
-                {
-                    realErrors.push_back(idNum);
-                }
-
-                entries.insert(std::make_pair(idNum, std::move(e)));
+                addEntry(idNum, std::move(e));
             }
             else
             {
@@ -699,6 +949,63 @@ void Manager::restore()
     }
 }
 
+void Manager::addEntry(uint32_t id, std::unique_ptr<Entry>&& e)
+{
+    if (e->severity() >= Entry::sevLowerLimit)
+    {
+        infoErrors.insert(id);
+    }
+    else
+    {
+        realErrors.insert(id);
+    }
+
+    entries.insert(std::make_pair(id, std::move(e)));
+}
+
+void Manager::restoreFromJournal()
+{
+    auto makeEntry = [this](uint32_t id) {
+        return std::make_unique<Entry>(
+            busLog, std::string(OBJ_ENTRY) + '/' + std::to_string(id), id,
+            *this);
+    };
+
+    auto restored = journal->restore(makeEntry);
+    journal->migrate(paths::error(), makeEntry, restored);
+
+    for (auto& [id, e] : restored)
+    {
+        addEntry(id, std::move(e));
+    }
+
+    if (!entries.empty())
+    {
+        entryId = entries.rbegin()->first;
+    }
+}
+
+void Manager::persistUpdate(const Entry& entry)
+{
+    if (journal)
+    {
+        try
+        {
+            journal->update(entry);
+        }
+        catch (const std::system_error& e)
+        {
+            lg2::error("Failed to update event log {ID} in the journal: "
+                       "{ERROR}",
+                       "ID", entry.id(), "ERROR", e);
+        }
+    }
+    else
+    {
+        serialize(entry);
+    }
+}
+
 std::string Manager::readFWVersion()
 {
     auto version = util::getOSReleaseValue("VERSION_ID");
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "config.h"
+
 #include "elog_block.hpp"
 #include "elog_entry.hpp"
+#include "elog_journal.hpp"
+#include "journal_sync.hpp"
+#include "paths.hpp"
+#include "perfect_hash.hpp"
 #include "xyz/openbmc_project/Logging/Internal/Manager/server.hpp"
 
 #include <phosphor-logging/log.hpp>
@@ -11,15 +17,26 @@
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 #include <xyz/openbmc_project/Logging/event.hpp>
 
-#include <list>
+#include <optional>
+#include <set>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 namespace phosphor
 {
 namespace logging
 {
 
-extern const std::map<std::string, std::vector<std::string>> g_errMetaMap;
-extern const std::map<std::string, level> g_errLevelMap;
+using ErrMetaMap = PerfectHashMap<std::span<const std::string_view>>;
+using ErrLevelMap = PerfectHashMap<level>;
+
+/** @brief The metadata names of each error, from elog-lookup.cpp */
+extern const ErrMetaMap g_errMetaMap;
+
+/** @brief The level of each error, from elog-lookup.cpp */
+extern const ErrLevelMap g_errLevelMap;
 
 using CreateIface = sdbusplus::server::xyz::openbmc_project::logging::Create;
 using DeleteAllIface =
@@ -48,6 +65,12 @@ using FFDCEntry = std::tuple<CreateIface::FFDCFormat, uint8_t, uint8_t,
 
 using FFDCEntries = std::vector<FFDCEntry>;
 
+/** @brief An event to create with createBatch(): the message, severity,
+ *         AdditionalData and FFDC, the same as for create().
+ */
+using BatchEvent = std::tuple<std::string, Severity,
+                              std::map<std::string, std::string>, FFDCEntries>;
+
 namespace internal
 {
 
@@ -69,16 +92,32 @@ class Manager : public details::ServerObject<details::ManagerIface>
     /** @brief Constructor to put object onto bus at a dbus path.
      *  @param[in] bus - Bus to attach to.
      *  @param[in] path - Path to attach at.
+     *  @param[in] journalSync - Syncs the journal for commits.  If null,
+     *                           a JournalSync is made on the first commit.
      */
-    Manager(sdbusplus::bus_t& bus, const char* objPath) :
+    Manager(sdbusplus::bus_t& bus, const char* objPath,
+            std::unique_ptr<JournalSyncBase> journalSync = nullptr) :
         details::ServerObject<details::ManagerIface>(bus, objPath), busLog(bus),
-        entryId(0), fwVersion(readFWVersion()) {};
+        entryId(0), fwVersion(readFWVersion()),
+        journalSyncer(std::move(journalSync))
+    {
+        if constexpr (ENTRY_STORE_JOURNAL)
+        {
+            journal = std::make_unique<EntryJournal>(paths::errorJournal());
+        }
+    };
 
     /*
      * @fn commit()
      * @brief sd_bus Commit method implementation callback.
      * @details Create an error/event log based on transaction id and
      *          error message.
+     *
+     *          The entry isn't created before this returns.  Its ID is
+     *          reserved and returned right away, and the entry is created
+     *          from the event loop once the journal has been synced and
+     *          its metadata read.  If the sync fails or times out, the
+     *          entry is still created with whatever metadata is found.
      * @param[in] transactionId - Unique identifier of the journal entries
      *                            to be committed.
      * @param[in] errMsg - The error exception message associated with the
@@ -90,7 +129,8 @@ class Manager : public details::ServerObject<details::ManagerIface>
      * @fn commit()
      * @brief sd_bus CommitWithLvl method implementation callback.
      * @details Create an error/event log based on transaction id and
-     *          error message.
+     *          error message.  The entry is created later, the same as
+     *          for commit().
      * @param[in] transactionId - Unique identifier of the journal entries
      *                            to be committed.
      * @param[in] errMsg - The error exception message associated with the
@@ -106,12 +146,34 @@ class Manager : public details::ServerObject<details::ManagerIface>
      */
     void erase(uint32_t entryId);
 
+    /** @brief Erase a set of entries together
+     *
+     *  Entries that an extension prohibits deleting are kept, and IDs
+     *  without an entry are skipped.  The rest are removed from storage
+     *  together, and the extensions are told about them with one call.
+     *
+     *  @param[in] ids - The entry IDs
+     *
+     *  @return size_t - count of erased entries
+     */
+    size_t erase(const std::set<uint32_t>& ids);
+
     /** @brief Construct error d-bus objects from their persisted
      *         representations.
      */
     void restore();
 
+    /** @brief Persist an entry after its properties were updated.
+     *
+     *  @param[in] entry - The entry that was updated
+     */
+    void persistUpdate(const Entry& entry);
+
     /** @brief  Erase all error log entries
+     *
+     *  Entries with hardware still isolated, or that an extension prohibits
+     *  deleting are kept.  The rest are removed from storage together,
+     *  and the extensions are told about them with one call.
      *
      *  @return size_t - count of erased entries
      */
@@ -186,6 +248,22 @@ class Manager : public details::ServerObject<details::ManagerIface>
                 const FFDCEntries& ffdc = FFDCEntries{})
         -> sdbusplus::message::object_path;
 
+    /** @brief sd_bus CreateBatch method implementation callback.
+     *
+     *  Creates an event log for each event, in order, the same as
+     *  calling create() for each.  Room is made under the caps once for
+     *  the whole batch, the entries are stored together, and the quiesce
+     *  setting is only read once.  Events that the cap would erase within
+     *  the same batch are not created, and get neither an ID nor a path.
+     *
+     * @param[in] events - The events to create
+     *
+     * @return The object paths of the entries created, in the order of
+     *         their events
+     */
+    std::vector<sdbusplus::message::object_path>
+        createBatch(std::vector<BatchEvent> events) override;
+
     /** @brief Create an internal event log from the sdbusplus generated event
      *
      *  @param[in] event - The event to create.
@@ -226,14 +304,35 @@ class Manager : public details::ServerObject<details::ManagerIface>
     /*
      * @fn _commit()
      * @brief commit() helper
+     * @details The entry ID is reserved right away, but the entry is only
+     *          created after the journal has been synced so its metadata
+     *          can be read.  Commits that arrive while a sync is already
+     *          in progress share the next sync.
      * @param[in] transactionId - Unique identifier of the journal entries
      *                            to be committed.
      * @param[in] errMsg - The error exception message associated with the
      *                     error log to be committed.
      * @param[in] errLvl - level of the error
+     * @return uint32_t - The ID of the entry
+     */
+    uint32_t _commit(uint64_t transactionId, std::string&& errMsg,
+                     Entry::Level errLvl);
+
+    /** @brief A commit waiting on the journal sync */
+    struct PendingCommit
+    {
+        uint64_t transactionId;
+        std::string errMsg;
+        Entry::Level errLvl;
+        uint32_t id;
+    };
+
+    /** @brief Called when a journal sync completes to read the metadata
+     *         of the commits it covers from the journal and create their
+     *         entries.  Starts another sync if more commits arrived in
+     *         the meantime.
      */
-    void _commit(uint64_t transactionId, std::string&& errMsg,
-                 Entry::Level errLvl);
+    void finishCommits();
 
     /** @brief Call metadata handler(s), if any. Handlers may create
      *         associations.
@@ -268,12 +367,55 @@ class Manager : public details::ServerObject<details::ManagerIface>
      * @param[in] additionalData - The AdditionalData property for the error
      * @param[in] ffdc - A vector of FFDC file info. Defaults to an empty
      * vector.
+     * @param[in] reservedId - The entry ID if one was already reserved,
+     *                         otherwise the next ID is used.
      */
     auto createEntry(std::string errMsg, Entry::Level errLvl,
                      std::map<std::string, std::string> additionalData,
-                     const FFDCEntries& ffdc = FFDCEntries{})
+                     const FFDCEntries& ffdc = FFDCEntries{},
+                     std::optional<uint32_t> reservedId = std::nullopt)
         -> sdbusplus::message::object_path;
 
+    /** @brief Creates the Entry object for a new entry
+     *
+     * @param[in] errMsg - The error exception message
+     * @param[in] errLvl - level of the error
+     * @param[in] additionalData - The AdditionalData property for the error
+     * @param[in] id - The entry ID
+     */
+    auto makeEntry(std::string errMsg, Entry::Level errLvl,
+                   std::map<std::string, std::string> additionalData,
+                   uint32_t id) -> std::unique_ptr<Entry>;
+
+    /** @brief Asks the extensions if deleting an entry is prohibited
+     *
+     * @param[in] id - The entry ID
+     *
+     * @return true if any extension prohibits it
+     */
+    bool isDeleteProhibited(uint32_t id) const;
+
+    /** @brief Calls the extensions' delete functions for erased entries
+     *
+     * @param[in] ids - The IDs of the entries that were erased
+     */
+    void notifyDelete(const std::set<uint32_t>& ids);
+
+    /** @brief Erases entries, and tells the extensions about them
+     *
+     * @param[in] ids - The IDs of the entries, which must all exist
+     */
+    void eraseEntries(const std::set<uint32_t>& ids);
+
+    /** @brief Erases the oldest entries of a severity so that more can be
+     *         created without going over its cap.
+     *
+     * @param[in] ids - The IDs of the entries of the severity
+     * @param[in] cap - The cap for the severity
+     * @param[in] count - The number of entries to make room for
+     */
+    void makeRoom(const std::set<uint32_t>& ids, size_t cap, size_t count);
+
     /** @brief Notified on entry property changes
      *
      * If an entry is blocking, this callback will be registered to monitor for
@@ -294,14 +436,27 @@ class Manager : public details::ServerObject<details::ManagerIface>
      */
     void checkAndQuiesceHost();
 
+    /** @brief Adds a stored entry to the entries map and the
+     *         severity lists.
+     *
+     *  @param[in] id - The entry ID
+     *  @param[in] e - The entry
+     */
+    void addEntry(uint32_t id, std::unique_ptr<Entry>&& e);
+
+    /** @brief Restores the entries from the entry journal, first
+     *         moving any entries stored one file per entry into it.
+     */
+    void restoreFromJournal();
+
     /** @brief Persistent sdbusplus DBus bus connection. */
     sdbusplus::bus_t& busLog;
 
-    /** @brief List of error ids for high severity errors */
-    std::list<uint32_t> realErrors;
+    /** @brief Error ids for high severity errors, oldest first */
+    std::set<uint32_t> realErrors;
 
-    /** @brief List of error ids for Info(and below) severity */
-    std::list<uint32_t> infoErrors;
+    /** @brief Error ids for Info(and below) severity, oldest first */
+    std::set<uint32_t> infoErrors;
 
     /** @brief Id of last error log entry */
     uint32_t entryId;
@@ -309,12 +464,26 @@ class Manager : public details::ServerObject<details::ManagerIface>
     /** @brief The BMC firmware version */
     const std::string fwVersion;
 
-    /** @brief Array of blocking errors */
-    std::vector<std::unique_ptr<Block>> blockingErrors;
+    /** @brief Map of entry id to its blocking error object */
+    std::map<uint32_t, std::unique_ptr<Block>> blockingErrors;
 
     /** @brief Map of entry id to call back object on properties changed */
     std::map<uint32_t, std::unique_ptr<sdbusplus::bus::match_t>>
         propChangedEntryCallback;
+
+    /** @brief The append-only entry store, used instead of one file
+     *         per entry when the journal entry store is configured.
+     */
+    std::unique_ptr<EntryJournal> journal;
+
+    /** @brief Requests journal syncs for commits */
+    std::unique_ptr<JournalSyncBase> journalSyncer;
+
+    /** @brief Commits covered by the journal sync in progress */
+    std::vector<PendingCommit> syncingCommits;
+
+    /** @brief Commits that arrived after the sync in progress started */
+    std::vector<PendingCommit> waitingCommits;
 };
 
 } // namespace internal
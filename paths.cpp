@@ -8,6 +8,10 @@ auto error() -> std::filesystem::path
 {
     return std::filesystem::path(PERSIST_PATH_ROOT) / "errors";
 }
+auto errorJournal() -> std::filesystem::path
+{
+    return std::filesystem::path(PERSIST_PATH_ROOT) / "error_journal";
+}
 auto extension() -> std::filesystem::path
 {
     return std::filesystem::path(PERSIST_PATH_ROOT) / "extensions";
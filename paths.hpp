@@ -9,6 +9,7 @@ namespace phosphor::logging::paths
 {
 
 auto error() -> std::filesystem::path;
+auto errorJournal() -> std::filesystem::path;
 auto extension() -> std::filesystem::path;
 
 } // namespace phosphor::logging::paths
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace phosphor::logging
+{
+
+namespace details
+{
+
+/**
+ * @brief Reads up to 8 bytes of a key as a little endian word, padded
+ *        with zeros.
+ *
+ * @param[in] key - The key
+ * @param[in] pos - The position of the first byte
+ *
+ * @return uint64_t - The word
+ */
+constexpr uint64_t readWord(std::string_view key, size_t pos)
+{
+    auto length = std::min<size_t>(8, key.size() - pos);
+    uint64_t word = 0;
+
+    if !consteval
+    {
+        if (length == 8)
+        {
+            std::memcpy(&word, key.data() + pos, sizeof(word));
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                word = std::byteswap(word);
+            }
+            return word;
+        }
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        word |= static_cast<uint64_t>(static_cast<uint8_t>(key[pos + i]))
+                << (8 * i);
+    }
+
+    return word;
+}
+
+} // namespace details
+
+/**
+ * @brief Hashes a key of a PerfectHashMap, 8 bytes at a time.
+ *
+ * This must match hash_key() in tools/perfect_hash.py, which builds
+ * the tables.
+ *
+ * @param[in] key - The key
+ *
+ * @return uint64_t - The hash
+ */
+constexpr uint64_t hashKey(std::string_view key)
+{
+    uint64_t h = key.size();
+    for (size_t pos = 0; pos < key.size(); pos += 8)
+    {
+        h = (h ^ details::readWord(key, pos)) * 0x9E3779B97F4A7C15;
+    }
+
+    return h ^ (h >> 32);
+}
+
+/**
+ * @brief Mixes a key's hash with a seed to get its slot.
+ *
+ * This must match get_slot() in tools/perfect_hash.py.
+ *
+ * @param[in] hash - The key's hash
+ * @param[in] seed - The seed
+ * @param[in] size - The number of slots
+ *
+ * @return size_t - The slot
+ */
+constexpr size_t getSlot(uint64_t hash, uint32_t seed, size_t size)
+{
+    uint64_t h = hash ^ (seed * 0x9E3779B97F4A7C15);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCD;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53;
+    h ^= h >> 33;
+
+    // Scales the top 32 bits to the size, instead of dividing
+    return ((h >> 32) * size) >> 32;
+}
+
+/**
+ * @class PerfectHashMap
+ *
+ * A read only map with string keys, whose tables are built by the code
+ * generators with tools/perfect_hash.py.  Each key has its own slot, so
+ * finding one takes one pass over the key and a single string compare.
+ *
+ * The tables are constexpr arrays, so nothing is built or allocated
+ * at startup.
+ */
+template <typename T>
+struct PerfectHashMap
+{
+    using Entry = std::pair<std::string_view, T>;
+
+    /**
+     * @brief The seed of each bucket, or if negative, -1 - the slot
+     *        of the bucket's only key.
+     */
+    std::span<const int32_t> seeds;
+
+    /**
+     * @brief The entry in each slot
+     */
+    std::span<const Entry> entries;
+
+    /**
+     * @brief Finds the value of a key.
+     *
+     * @param[in] key - The key
+     *
+     * @return const T* - The value, or nullptr if the key isn't there
+     */
+    constexpr const T* find(std::string_view key) const
+    {
+        if (entries.empty())
+        {
+            return nullptr;
+        }
+
+        auto hash = hashKey(key);
+        auto seed = seeds[getSlot(hash, 0, seeds.size())];
+        auto slot = (seed < 0)
+                        ? static_cast<size_t>(-(seed + 1))
+                        : getSlot(hash, static_cast<uint32_t>(seed),
+                                  entries.size());
+
+        const auto& entry = entries[slot];
+        return (entry.first == key) ? &entry.second : nullptr;
+    }
+
+    /**
+     * @brief Returns the number of entries.
+     */
+    constexpr size_t size() const
+    {
+        return entries.size();
+    }
+};
+
+} // namespace phosphor::logging
@@ -0,0 +1,371 @@
+#include "alog_export.hpp"
+
+#include "alog_index.hpp"
+#include "alog_parser.hpp"
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <xyz/openbmc_project/Common/File/error.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <ranges>
+#include <string>
+
+namespace phosphor::auditlog
+{
+
+namespace
+{
+
+/* Amount of a log parsed at a time */
+constexpr size_t blockSize = 64 * 1024;
+
+} // namespace
+
+ALExport::~ALExport()
+{
+    for (const auto& stream : streams)
+    {
+        close(stream.fd);
+    }
+}
+
+uint64_t ALExport::parseBlock(int fd, uint64_t begin, uint64_t end,
+                              std::string& parsed)
+{
+    auto size = blockSize;
+
+    while (begin < end)
+    {
+        auto lines = ALIndex::readAt(fd, begin, std::min(size, end - begin));
+
+        /* A partial line at the end is parsed next time, once it is
+         * complete
+         */
+        auto newline = lines.rfind('\n');
+        if (newline == std::string::npos)
+        {
+            if ((lines.size() == size) && (begin + size < end))
+            {
+                // A line longer than the block, try again with more
+                size *= 2;
+                continue;
+            }
+            break;
+        }
+        lines.resize(newline + 1);
+
+        ALParseRange auditParser(lines, parsed);
+        auditParser.doParse();
+
+        return begin + lines.size();
+    }
+
+    return begin;
+}
+
+void ALExport::parseAppended(int fd, uint64_t size, LogFile& log,
+                             size_t space)
+{
+    while (log.offset < size)
+    {
+        std::string parsed;
+        auto offset = parseBlock(fd, log.offset, size, parsed);
+        if (offset == log.offset)
+        {
+            break;
+        }
+        log.offset = offset;
+        log.size += parsed.size();
+
+        if (log.size > space)
+        {
+            // Parsed as each export is written from now on
+            log.cached = false;
+            log.size = 0;
+            log.chunks.clear();
+            return;
+        }
+
+        // Extend the last chunk in place unless a stream is still writing it
+        if (!log.chunks.empty() && (log.chunks.back().use_count() == 1))
+        {
+            log.chunks.back()->append(parsed);
+        }
+        else
+        {
+            log.chunks.push_back(
+                std::make_shared<std::string>(std::move(parsed)));
+        }
+    }
+}
+
+std::vector<ALExport::Part> ALExport::update()
+{
+    std::vector<Part> parts;
+    decltype(files) current;
+    size_t cached = 0;
+
+    /* Newest log first, so it is the one kept when they don't all fit */
+    for (unsigned int logFileIdx = 0;; logFileIdx++)
+    {
+        auto path = ALIndex::logPath(logDir, logFileIdx);
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+        {
+            // No more files
+            break;
+        }
+        auto logFd = std::make_shared<const LogFd>(fd);
+
+        struct stat st{};
+        if (fstat(fd, &st) == -1)
+        {
+            break;
+        }
+
+        std::pair key{st.st_dev, st.st_ino};
+        auto node = files.extract(key);
+        auto [entry, added] = current.try_emplace(key);
+        if (!added)
+        {
+            // The same file linked twice
+            continue;
+        }
+
+        auto& log = entry->second;
+        uint64_t size = st.st_size;
+
+        if (!node.empty() && (size >= node.mapped().offset))
+        {
+            log = std::move(node.mapped());
+        }
+
+        if (log.cached && (cached + log.size > cacheSize))
+        {
+            log.cached = false;
+            log.size = 0;
+            log.chunks.clear();
+        }
+
+        if (log.cached && (size > log.offset))
+        {
+            parseAppended(fd, size, log, cacheSize - cached);
+        }
+
+        if (log.cached)
+        {
+            cached += log.size;
+            for (const auto& chunk : log.chunks | std::views::reverse)
+            {
+                parts.emplace_back(chunk);
+            }
+        }
+        else
+        {
+            log.offset = size;
+            parts.emplace_back(nullptr, std::move(logFd), 0, size);
+        }
+    }
+
+    files.swap(current);
+
+    /* Oldest log first */
+    std::ranges::reverse(parts);
+
+    return parts;
+}
+
+ALExport::Chunk ALExport::next(const std::vector<Part>& parts,
+                               Cursor& cursor)
+{
+    while (cursor.part < parts.size())
+    {
+        const auto& part = parts[cursor.part];
+
+        if (part.chunk)
+        {
+            cursor.part++;
+            if (!part.chunk->empty())
+            {
+                return part.chunk;
+            }
+            continue;
+        }
+
+        auto begin = part.begin + cursor.offset;
+        auto parsed = std::make_shared<std::string>();
+        auto offset = parseBlock(part.log->fd, begin, part.end, *parsed);
+        if (offset == begin)
+        {
+            cursor.part++;
+            cursor.offset = 0;
+            continue;
+        }
+        cursor.offset = offset - part.begin;
+
+        if (!parsed->empty())
+        {
+            return parsed;
+        }
+    }
+
+    return nullptr;
+}
+
+int ALExport::toMemfd(const std::vector<Part>& parts)
+{
+    int fd = memfd_create("auditLog.json", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd == -1)
+    {
+        auto e = errno;
+        lg2::error("Failed to create memfd: {ERRNO}", "ERRNO", e);
+        throw sdbusplus::xyz::openbmc_project::Common::File::Error::Open();
+    }
+
+    Cursor cursor;
+    Chunk chunk;
+
+    try
+    {
+        while ((chunk = next(parts, cursor)))
+        {
+            size_t done = 0;
+            while (done < chunk->size())
+            {
+                auto rc =
+                    write(fd, chunk->data() + done, chunk->size() - done);
+                if (rc < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    auto e = errno;
+                    lg2::error("Failed to write memfd: {ERRNO}", "ERRNO", e);
+                    throw sdbusplus::xyz::openbmc_project::Common::File::
+                        Error::Write();
+                }
+                done += rc;
+            }
+        }
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+
+    /* The caller gets a read-only view of the export */
+    if ((fcntl(fd, F_ADD_SEALS,
+               F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) ==
+         -1) ||
+        (lseek(fd, 0, SEEK_SET) == -1))
+    {
+        auto e = errno;
+        lg2::error("Failed to seal memfd: {ERRNO}", "ERRNO", e);
+        close(fd);
+        throw sdbusplus::xyz::openbmc_project::Common::File::Error::Seek();
+    }
+
+    return fd;
+}
+
+int ALExport::toPipe(std::vector<Part> parts,
+                     const sdeventplus::Event& event)
+{
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) == -1)
+    {
+        auto e = errno;
+        lg2::error("Failed to create pipe: {ERRNO}", "ERRNO", e);
+        throw sdbusplus::xyz::openbmc_project::Common::File::Error::Open();
+    }
+
+    // Only the write end is non-blocking, the reader gets a normal pipe
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+    auto stream = streams.emplace(streams.end());
+    stream->parts = std::move(parts);
+    stream->fd = fds[1];
+
+    try
+    {
+        stream->source = std::make_unique<sdeventplus::source::IO>(
+            event, fds[1], EPOLLOUT,
+            [this, stream](sdeventplus::source::IO&, int, uint32_t revents) {
+                writeStream(stream, revents);
+            });
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to add pipe to event loop: {ERROR}", "ERROR", e);
+        close(fds[0]);
+        close(fds[1]);
+        streams.erase(stream);
+        throw sdbusplus::xyz::openbmc_project::Common::File::Error::Open();
+    }
+
+    return fds[0];
+}
+
+void ALExport::writeStream(std::list<Stream>::iterator stream,
+                           uint32_t revents)
+{
+    /* Nothing more is written once the reader went away */
+    while ((revents & (EPOLLERR | EPOLLHUP)) == 0)
+    {
+        if (!stream->chunk || (stream->chunkOffset == stream->chunk->size()))
+        {
+            try
+            {
+                stream->chunk = next(stream->parts, stream->cursor);
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("Failed to parse audit log: {ERROR}", "ERROR", e);
+                break;
+            }
+
+            stream->chunkOffset = 0;
+            if (!stream->chunk)
+            {
+                break;
+            }
+        }
+
+        const auto& chunk = *stream->chunk;
+        auto rc = write(stream->fd, chunk.data() + stream->chunkOffset,
+                        chunk.size() - stream->chunkOffset);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN)
+            {
+                // Wait for the reader to make room
+                return;
+            }
+            auto e = errno;
+            lg2::debug("Audit log stream ended early: {ERRNO}", "ERRNO", e);
+            break;
+        }
+
+        stream->chunkOffset += rc;
+    }
+
+    // Closing the write end gives the reader end of file
+    close(stream->fd);
+    streams.erase(stream);
+}
+
+} // namespace phosphor::auditlog
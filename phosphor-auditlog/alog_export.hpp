@@ -0,0 +1,190 @@
+#pragma once
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phosphor::auditlog
+{
+
+/** @class ALExport
+ *  @brief Cache of the audit logs parsed into general JSON
+ *  @details The parsed entries of each log are kept by inode along with the
+ *  offset parsed up to, so each export only parses the events logged since
+ *  the previous one. Rotated logs don't change and are never parsed again.
+ *  Only as many logs, newest first, as fit in the cache size are kept. The
+ *  others are parsed a block at a time as each export is written.
+ */
+class ALExport
+{
+  public:
+    /** @brief Parsed entries, shared with exports still being written */
+    using Chunk = std::shared_ptr<const std::string>;
+
+    /** @brief A log opened by update(), kept open for the exports
+     *         still reading it
+     */
+    struct LogFd
+    {
+        explicit LogFd(int fd) : fd(fd) {}
+        LogFd(const LogFd&) = delete;
+        LogFd& operator=(const LogFd&) = delete;
+        LogFd(LogFd&&) = delete;
+        LogFd& operator=(LogFd&&) = delete;
+
+        ~LogFd()
+        {
+            close(fd);
+        }
+
+        int fd;
+    };
+
+    /** @brief Part of an export, either entries already parsed or the
+     *         range of a log to parse as the export is written
+     */
+    struct Part
+    {
+        Chunk chunk;
+        std::shared_ptr<const LogFd> log;
+        uint64_t begin = 0;
+        uint64_t end = 0;
+    };
+
+    /** @brief How far an export has been written */
+    struct Cursor
+    {
+        size_t part = 0;
+        // Offset into the range of a part that isn't parsed yet
+        uint64_t offset = 0;
+    };
+
+    /** @brief Default size of the parsed entries kept between exports */
+    static constexpr size_t defaultCacheSize = 1024 * 1024;
+
+    ALExport(const ALExport&) = delete;
+    ALExport& operator=(const ALExport&) = delete;
+    ALExport(ALExport&&) = delete;
+    ALExport& operator=(ALExport&&) = delete;
+    ~ALExport();
+
+    /** @brief Constructor
+     *  @param[in] logDir Directory holding audit.log and its rotated files
+     *  @param[in] cacheSize Most bytes of parsed entries to keep
+     */
+    explicit ALExport(std::filesystem::path logDir = "/var/log/audit",
+                      size_t cacheSize = defaultCacheSize) :
+        logDir(std::move(logDir)), cacheSize(cacheSize)
+    {}
+
+    /**
+     * @brief Parses the events logged since the last update
+     * @details Logs that no longer exist are dropped from the cache, and
+     *          logs that shrank are parsed again from the start.
+     * @return The parts of the export of all the logs, oldest to newest
+     */
+    std::vector<Part> update();
+
+    /**
+     * @brief Gets the next entries of an export, parsing them if needed
+     * @param[in] parts The parts of the export
+     * @param[in,out] cursor How far the export has been written
+     * @return Chunk The entries, or nullptr at the end of the export
+     */
+    static Chunk next(const std::vector<Part>& parts, Cursor& cursor);
+
+    /**
+     * @brief Writes an export to a sealed memfd
+     * @param[in] parts The parts of the export
+     * @return int A file descriptor to the memfd, at offset 0
+     */
+    static int toMemfd(const std::vector<Part>& parts);
+
+    /**
+     * @brief Streams an export through a pipe
+     * @details The entries are written from the event loop as the reader
+     *          makes room in the pipe, and the write end is closed once they
+     *          have all been written or the reader goes away.
+     * @param[in] parts The parts of the export
+     * @param[in] event The event loop to write from
+     * @return int A file descriptor to the read end of the pipe
+     */
+    int toPipe(std::vector<Part> parts, const sdeventplus::Event& event);
+
+  private:
+    /** @brief The parsed entries of a log */
+    struct LogFile
+    {
+        // Offset just past the last complete line parsed
+        uint64_t offset = 0;
+        // False once the entries didn't fit in the cache
+        bool cached = true;
+        // Total size of the chunks
+        size_t size = 0;
+        std::vector<std::shared_ptr<std::string>> chunks;
+    };
+
+    /** @brief An export being written to a pipe */
+    struct Stream
+    {
+        std::vector<Part> parts;
+        Cursor cursor;
+        Chunk chunk;
+        size_t chunkOffset = 0;
+        int fd = -1;
+        std::unique_ptr<sdeventplus::source::IO> source;
+    };
+
+    /**
+     * @brief Parses the complete lines in a block of a log
+     * @details The block is made larger for a line longer than it.
+     * @param[in] fd The log
+     * @param[in] begin Where to start, at the start of a line
+     * @param[in] end Where to stop
+     * @param[in,out] parsed String the parsed entries are appended to
+     * @return uint64_t Offset just past the last line parsed, which is begin
+     *         if there are no complete lines left
+     */
+    static uint64_t parseBlock(int fd, uint64_t begin, uint64_t end,
+                               std::string& parsed);
+
+    /**
+     * @brief Parses the complete lines appended to a log into its chunks
+     * @details Stops once the entries no longer fit in the space left.
+     * @param[in] fd The log
+     * @param[in] size Current size of the log
+     * @param[in,out] log The log's parsed entries
+     * @param[in] space Space left in the cache
+     */
+    static void parseAppended(int fd, uint64_t size, LogFile& log,
+                              size_t space);
+
+    /**
+     * @brief Writes as much of a stream as the pipe has room for
+     * @details The stream is removed once it is done.
+     * @param[in] stream The stream
+     * @param[in] revents The events from the event loop
+     */
+    void writeStream(std::list<Stream>::iterator stream, uint32_t revents);
+
+    std::filesystem::path logDir;
+    size_t cacheSize;
+
+    // Keyed by device and inode
+    std::map<std::pair<dev_t, ino_t>, LogFile> files;
+
+    std::list<Stream> streams;
+};
+
+} // namespace phosphor::auditlog
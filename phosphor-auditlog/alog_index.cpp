@@ -0,0 +1,323 @@
+#include "alog_index.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <xyz/openbmc_project/Common/File/error.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace phosphor::auditlog
+{
+
+namespace
+{
+
+/* Amount of a log read at a time when searching backwards */
+constexpr size_t blockSize = 64 * 1024;
+
+} // namespace
+
+std::string ALIndex::readAt(int fd, uint64_t offset, size_t size)
+{
+    std::string data(size, '\0');
+    size_t done = 0;
+
+    while (done < size)
+    {
+        auto rc = pread(fd, data.data() + done, size - done, offset + done);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            auto e = errno;
+            lg2::error("Failed to read audit log: {ERRNO}", "ERRNO", e);
+            throw sdbusplus::xyz::openbmc_project::Common::File::Error::Read();
+        }
+        if (rc == 0)
+        {
+            break;
+        }
+        done += rc;
+    }
+
+    data.resize(done);
+    return data;
+}
+
+uint64_t ALIndex::lineStart(int fd, uint64_t offset)
+{
+    while (offset > 0)
+    {
+        auto start = offset > blockSize ? offset - blockSize : 0;
+        auto block = readAt(fd, start, offset - start);
+
+        auto newline = block.rfind('\n');
+        if (newline != std::string::npos)
+        {
+            return start + newline + 1;
+        }
+        offset = start;
+    }
+
+    return 0;
+}
+
+size_t ALIndex::scanLines(std::string_view lines, uint64_t offset,
+                          std::vector<Record>& found) const
+{
+    constexpr std::string_view typeTag{"type="};
+    constexpr std::string_view msgTag{"msg=audit("};
+    size_t pos = 0;
+
+    while (pos < lines.size())
+    {
+        auto newline = lines.find('\n', pos);
+        if (newline == std::string_view::npos)
+        {
+            break;
+        }
+
+        /* Lines look like:
+         *   [node=<name> ]type=<TYPE> msg=audit(<sec>.<msec>:<serial>): ...
+         */
+        auto begin = pos;
+        auto line = lines.substr(begin, newline - begin);
+        pos = newline + 1;
+
+        if (line.starts_with("node="))
+        {
+            auto space = line.find(' ');
+            if (space == std::string_view::npos)
+            {
+                continue;
+            }
+            line.remove_prefix(space + 1);
+        }
+
+        if (!line.starts_with(typeTag))
+        {
+            continue;
+        }
+        line.remove_prefix(typeTag.size());
+
+        auto space = line.find(' ');
+        if ((space == std::string_view::npos) ||
+            (std::ranges::find(types, line.substr(0, space)) == types.end()))
+        {
+            continue;
+        }
+        line.remove_prefix(space + 1);
+
+        if (!line.starts_with(msgTag))
+        {
+            continue;
+        }
+        line.remove_prefix(msgTag.size());
+
+        uint64_t timestamp = 0;
+        auto [ptr, ec] = std::from_chars(line.data(),
+                                         line.data() + line.size(), timestamp);
+        if (ec != std::errc{})
+        {
+            continue;
+        }
+
+        found.emplace_back(offset + begin,
+                           static_cast<uint32_t>(newline - begin), timestamp);
+    }
+
+    return pos;
+}
+
+bool ALIndex::extendBack(OpenLog& open)
+{
+    auto& log = open.log;
+    auto size = blockSize;
+
+    while (log.begin > 0)
+    {
+        auto start = log.begin > size ? log.begin - size : 0;
+        auto block = readAt(open.fd, start, log.begin - start);
+        size_t first = 0;
+
+        if (start > 0)
+        {
+            // Skip the partial line at the start of the block. The block
+            // always ends with a newline, as log.begin starts a line.
+            auto newline = block.find('\n');
+            if (newline + 1 >= block.size())
+            {
+                // A line longer than the block, try again with more
+                size *= 2;
+                continue;
+            }
+            first = newline + 1;
+        }
+
+        std::vector<Record> found;
+        scanLines(std::string_view{block}.substr(first), start + first, found);
+
+        log.records.insert(log.records.begin(), found.begin(), found.end());
+        log.begin = start + first;
+        return true;
+    }
+
+    return false;
+}
+
+void ALIndex::extendForward(OpenLog& open, uint64_t size)
+{
+    auto& log = open.log;
+    auto appended = readAt(open.fd, log.end, size - log.end);
+
+    std::vector<Record> found;
+    log.end += scanLines(appended, log.end, found);
+
+    log.records.insert(log.records.end(), found.begin(), found.end());
+}
+
+std::filesystem::path ALIndex::logPath(const std::filesystem::path& logDir,
+                                       unsigned int logFileIdx)
+{
+    /* Newest file has no extension, the next oldest is .1, and so on */
+    auto path = logDir / "audit.log";
+    if (logFileIdx)
+    {
+        path += std::format(".{}", logFileIdx);
+    }
+    return path;
+}
+
+std::vector<ALIndex::OpenLog> ALIndex::openLogs()
+{
+    std::vector<OpenLog> logs;
+    decltype(files) current;
+
+    for (unsigned int logFileIdx = 0;; logFileIdx++)
+    {
+        auto path = logPath(logDir, logFileIdx);
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+        {
+            // No more files
+            break;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) == -1)
+        {
+            close(fd);
+            break;
+        }
+
+        std::pair key{st.st_dev, st.st_ino};
+        auto node = files.extract(key);
+        auto [entry, added] = current.try_emplace(key);
+        if (!added)
+        {
+            // The same file linked twice
+            close(fd);
+            continue;
+        }
+
+        auto& log = logs.emplace_back(entry->second, fd);
+        uint64_t size = st.st_size;
+
+        if (!node.empty() && (size >= node.mapped().end))
+        {
+            entry->second = std::move(node.mapped());
+            if (size > entry->second.end)
+            {
+                extendForward(log, size);
+            }
+        }
+        else
+        {
+            // New, or truncated, so start from the tail
+            lg2::debug("Indexing {FILE}", "FILE", path);
+            entry->second.begin = entry->second.end = lineStart(fd, size);
+        }
+    }
+
+    // Swapping keeps the references in logs valid
+    files.swap(current);
+
+    return logs;
+}
+
+std::vector<std::string> ALIndex::getLatest(size_t count, size_t skip)
+{
+    std::vector<std::string> entries;
+    auto logs = openLogs();
+
+    for (auto& open : logs)
+    {
+        const auto& records = open.log.records;
+
+        while ((records.size() < count + skip) && extendBack(open))
+        {}
+
+        auto available = std::min(records.size(), count + skip);
+        for (size_t i = skip; i < available; i++)
+        {
+            const auto& record = records[records.size() - 1 - i];
+            entries.push_back(readAt(open.fd, record.offset, record.length));
+        }
+
+        count -= available - std::min(skip, available);
+        skip -= std::min(skip, available);
+
+        if (count == 0)
+        {
+            break;
+        }
+    }
+
+    return entries;
+}
+
+std::vector<std::string> ALIndex::getRange(uint64_t start, uint64_t end)
+{
+    std::vector<std::string> entries;
+    auto logs = openLogs();
+
+    for (auto& open : logs)
+    {
+        const auto& records = open.log.records;
+
+        while ((records.empty() || (records.front().timestamp >= start)) &&
+               extendBack(open))
+        {}
+
+        auto last = std::ranges::upper_bound(records, end, {},
+                                             &Record::timestamp);
+        auto first = std::ranges::lower_bound(records.begin(), last, start,
+                                              {}, &Record::timestamp);
+
+        while (last != first)
+        {
+            --last;
+            entries.push_back(readAt(open.fd, last->offset, last->length));
+        }
+
+        // Rotated logs only hold older records
+        if (!records.empty() && (records.front().timestamp < start))
+        {
+            break;
+        }
+    }
+
+    return entries;
+}
+
+} // namespace phosphor::auditlog
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace phosphor::auditlog
+{
+
+/** @class ALIndex
+ *  @brief Index of the audit log records of a set of types
+ *  @details The audit logs are read backwards from their tails, only as far
+ *  as a query needs, and the offset and timestamp of each record of interest
+ *  is remembered. Logs are tracked by inode so the index of audit.log is
+ *  kept when it is rotated, and later queries only read what was appended to
+ *  the active log along with the records they return.
+ */
+class ALIndex
+{
+  public:
+    ALIndex() = delete;
+    ALIndex(const ALIndex&) = delete;
+    ALIndex& operator=(const ALIndex&) = delete;
+    ALIndex(ALIndex&&) = delete;
+    ALIndex& operator=(ALIndex&&) = delete;
+    ~ALIndex() = default;
+
+    /** @brief Constructor
+     *  @param[in] types Names of the record types to index, e.g. USER_LOGIN
+     *  @param[in] logDir Directory holding audit.log and its rotated files
+     */
+    explicit ALIndex(std::vector<std::string> types,
+                     std::filesystem::path logDir = "/var/log/audit") :
+        types(std::move(types)), logDir(std::move(logDir))
+    {}
+
+    /**
+     * @brief Returns the text of the newest records
+     * @param[in] count Maximum number of records to return
+     * @param[in] skip Number of the newest records to pass over first
+     * @return Records, newest to oldest, without line terminators
+     */
+    std::vector<std::string> getLatest(size_t count, size_t skip = 0);
+
+    /**
+     * @brief Returns the text of the records within a time range
+     * @param[in] start Oldest timestamp to return, in seconds since epoch
+     * @param[in] end Newest timestamp to return, in seconds since epoch
+     * @return Records, newest to oldest, without line terminators
+     */
+    std::vector<std::string> getRange(uint64_t start, uint64_t end);
+
+    /**
+     * @brief Returns the path of an audit log
+     * @param[in] logDir Directory holding audit.log and its rotated files
+     * @param[in] logFileIdx 0 for audit.log, 1 for the newest rotated log,
+     *            and so on
+     */
+    static std::filesystem::path logPath(const std::filesystem::path& logDir,
+                                         unsigned int logFileIdx);
+
+    /**
+     * @brief Reads bytes from a log
+     * @param[in] fd The log
+     * @param[in] offset Where to start
+     * @param[in] size Number of bytes to read
+     * @return The bytes, which are fewer than asked for at end of file
+     */
+    static std::string readAt(int fd, uint64_t offset, size_t size);
+
+  private:
+    /** @brief Location of a record in its log */
+    struct Record
+    {
+        uint64_t offset;
+        uint32_t length;
+        uint64_t timestamp;
+    };
+
+    /** @brief The records found so far in a log */
+    struct LogFile
+    {
+        // The bytes from begin to end have been indexed. Both are at the
+        // start of a line.
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        std::deque<Record> records;
+    };
+
+    /** @brief A log opened for the duration of a query */
+    struct OpenLog
+    {
+        OpenLog(LogFile& log, int fd) : log(log), fd(fd) {}
+        OpenLog(const OpenLog&) = delete;
+        OpenLog& operator=(const OpenLog&) = delete;
+        OpenLog(OpenLog&& other) noexcept :
+            log(other.log), fd(std::exchange(other.fd, -1))
+        {}
+        OpenLog& operator=(OpenLog&&) = delete;
+
+        ~OpenLog()
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+
+        LogFile& log;
+        int fd;
+    };
+
+    /**
+     * @brief Opens the logs, newest first, and brings their indexes up to
+     *        date
+     * @details Indexes of logs that no longer exist are dropped, and those
+     *          of logs that shrank are started over.
+     * @return The opened logs
+     */
+    std::vector<OpenLog> openLogs();
+
+    /**
+     * @brief Indexes the block of the log just before what is indexed
+     * @param[in] open The log
+     * @return bool False if the whole log was already indexed
+     */
+    bool extendBack(OpenLog& open);
+
+    /**
+     * @brief Indexes the complete lines appended to the log
+     * @param[in] open The log
+     * @param[in] size Current size of the log
+     */
+    void extendForward(OpenLog& open, uint64_t size);
+
+    /**
+     * @brief Finds the start of the line containing an offset
+     * @param[in] fd The log
+     * @param[in] offset The offset
+     * @return uint64_t Offset just after the newline before offset, or 0
+     */
+    static uint64_t lineStart(int fd, uint64_t offset);
+
+    /**
+     * @brief Indexes the newline terminated lines in a buffer
+     * @param[in] lines The lines. A partial line at the end is skipped.
+     * @param[in] offset Offset of the buffer in its log
+     * @param[out] found The records of interest
+     * @return size_t Number of bytes that were complete lines
+     */
+    size_t scanLines(std::string_view lines, uint64_t offset,
+                     std::vector<Record>& found) const;
+
+    std::vector<std::string> types;
+    std::filesystem::path logDir;
+
+    // Keyed by device and inode
+    std::map<std::pair<dev_t, ino_t>, LogFile> files;
+};
+
+} // namespace phosphor::auditlog
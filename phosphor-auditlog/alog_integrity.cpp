@@ -0,0 +1,117 @@
+#include "alog_integrity.hpp"
+
+#include <libaudit.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/exception.hpp>
+#include <xyz/openbmc_project/Logging/Create/server.hpp>
+
+#include <map>
+
+namespace phosphor::auditlog
+{
+
+void IntegrityLogger::handleRecord(auparse_state_t* au)
+{
+    auto type = auparse_get_type(au);
+
+    // Handle events of type INTEGRITY
+    if ((type < AUDIT_INTEGRITY_FIRST_MSG) || (type > AUDIT_INTEGRITY_LAST_MSG))
+    {
+        return;
+    }
+
+    handleRecord(type, auparse_get_record_text(au));
+}
+
+void IntegrityLogger::handleRecord(int type, std::string record)
+{
+    if ((type < AUDIT_INTEGRITY_FIRST_MSG) || (type > AUDIT_INTEGRITY_LAST_MSG))
+    {
+        return;
+    }
+
+    auto current = now();
+
+    if (current - windowStart >= window)
+    {
+        // Any report of the old window counts against the new one
+        windowStart = current;
+        windowLogs = 0;
+        flush(true);
+    }
+
+    if (windowLogs < maxLogs)
+    {
+        windowLogs++;
+        createLog(record, 0);
+    }
+    else
+    {
+        suppressed++;
+        lastSuppressed = std::move(record);
+    }
+}
+
+int IntegrityLogger::flush(bool final)
+{
+    if (suppressed == 0)
+    {
+        return -1;
+    }
+
+    auto current = now();
+    auto windowEnd = windowStart + window;
+
+    if (!final && (current < windowEnd))
+    {
+        return std::chrono::ceil<std::chrono::milliseconds>(windowEnd -
+                                                             current)
+            .count();
+    }
+
+    createLog(lastSuppressed, suppressed);
+    suppressed = 0;
+    windowStart = current;
+    windowLogs = 1;
+
+    return -1;
+}
+
+void IntegrityLogger::createLog(const std::string& record, size_t suppressed)
+{
+    // Create informational log
+    using Create = sdbusplus::server::xyz::openbmc_project::logging::Create;
+    constexpr auto logSeverity =
+        "xyz.openbmc_project.Logging.Entry.Level.Informational";
+    constexpr auto logMessage =
+        "xyz.openbmc_project.Software.Version.Info.IntegrityEvent";
+    try
+    {
+        if (!bus)
+        {
+            bus = sdbusplus::bus::new_default();
+        }
+
+        auto method = bus->new_method_call(Create::default_service,
+                                           Create::instance_path,
+                                           Create::interface, "Create");
+        std::map<std::string, std::string> additionalData;
+        additionalData["RECORD"] = record;
+        if (suppressed)
+        {
+            additionalData["SUPPRESSED_RECORDS"] = std::to_string(suppressed);
+        }
+        method.append(logMessage, logSeverity, additionalData);
+        bus->call_noreply(method);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        lg2::error("Error creating log: {ERROR}", "ERROR", e);
+
+        // Connect again next time, in case the connection was lost
+        bus.reset();
+    }
+}
+
+} // namespace phosphor::auditlog
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <auparse.h>
+
+#include <sdbusplus/bus.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace phosphor::auditlog
+{
+
+/** @class IntegrityLogger
+ *  @brief Creates informational logs for INTEGRITY records
+ *  @details Uses one D-Bus connection for the life of the plugin, and limits
+ *  the number of logs created during an audit storm. At most maxLogs logs are
+ *  created per window. The rest are counted and reported in one log once the
+ *  window ends, which counts as one of the logs of the next window.
+ */
+class IntegrityLogger
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t maxLogs = 10;
+    static constexpr auto window = std::chrono::seconds(60);
+
+    IntegrityLogger() = default;
+    IntegrityLogger(const IntegrityLogger&) = delete;
+    IntegrityLogger& operator=(const IntegrityLogger&) = delete;
+    IntegrityLogger(IntegrityLogger&&) = delete;
+    IntegrityLogger& operator=(IntegrityLogger&&) = delete;
+    virtual ~IntegrityLogger() = default;
+
+    /**
+     * @brief Creates a log if the record is an INTEGRITY one
+     * @param[in] au Parser pointing at the record
+     */
+    void handleRecord(auparse_state_t* au);
+
+    /**
+     * @brief Creates a log if the record is an INTEGRITY one
+     * @param[in] type The record type
+     * @param[in] record Text of the record
+     */
+    void handleRecord(int type, std::string record);
+
+    /**
+     * @brief Reports the suppressed records once their window has ended
+     * @param[in] final True to report them now, as the plugin is exiting
+     * @return int Milliseconds until this should be called again, or -1 if
+     *         nothing is pending. For use as a poll() timeout.
+     */
+    int flush(bool final = false);
+
+  protected:
+    /**
+     * @brief Returns the current time
+     */
+    virtual Clock::time_point now() const
+    {
+        return Clock::now();
+    }
+
+    /**
+     * @brief Creates an informational log
+     * @param[in] record Text of the record, the last one if suppressed
+     * @param[in] suppressed Number of records suppressed, if any
+     */
+    virtual void createLog(const std::string& record, size_t suppressed);
+
+  private:
+    std::optional<sdbusplus::bus_t> bus;
+    Clock::time_point windowStart;
+    size_t windowLogs = 0;
+    size_t suppressed = 0;
+    std::string lastSuppressed;
+};
+
+} // namespace phosphor::auditlog
@@ -12,6 +12,7 @@
 #include <xyz/openbmc_project/Common/File/error.hpp>
 
 #include <cstring>
+#include <fstream>
 #include <string>
 
 namespace phosphor::auditlog
@@ -19,30 +20,41 @@ namespace phosphor::auditlog
 
 sdbusplus::message::unix_fd ALManager::getAuditLog()
 {
-#ifdef AUDITLOG_KEEP_JSONFILE
-    ALParseFile parsedFile("/tmp/auditLog.json");
-#else
-    ALParseFile parsedFile;
-#endif
+    lg2::debug("Method GetAuditLog");
 
-    // Initialize to parse full audit log
-    ALParseAll auditParser(parsedFile);
+    // Parse the events logged since the last call
+    auto parts = auditExport.update();
 
-    lg2::debug("Method GetAuditLog: {FILEPATH}", "FILEPATH",
-               parsedFile.getPath());
+#ifdef AUDITLOG_KEEP_JSONFILE
+    {
+        ALParseFile parsedFile("/tmp/auditLog.json");
+        std::ofstream parsedStream(parsedFile.getPath());
+        ALExport::Cursor cursor;
+        while (auto chunk = ALExport::next(parts, cursor))
+        {
+            parsedStream << *chunk;
+        }
+    }
+#endif
 
-    // Parse all the events
-    auditParser.doParse();
+    sdeventplus::Event event = sdeventplus::Event::get_default();
 
     /* Get file descriptor to return.
-     * openParseFD() throws an error if it fails to open the file.
+     * Both of these throw an error if they fail.
      */
-    auto fd = openParseFD(parsedFile);
+    int fd = -1;
+    if constexpr (AUDITLOG_EXPORT_PIPE)
+    {
+        fd = auditExport.toPipe(std::move(parts), event);
+    }
+    else
+    {
+        fd = ALExport::toMemfd(parts);
+    }
 
     /* Schedule the fd to be closed by sdbusplus when it sends it back over
      * D-Bus.
      */
-    sdeventplus::Event event = sdeventplus::Event::get_default();
     fdCloseEventSource = std::make_unique<sdeventplus::source::Defer>(
         event, std::bind(&ALManager::closeFD, this, fd, std::placeholders::_1));
 
@@ -60,7 +72,12 @@ sdbusplus::message::unix_fd ALManager::getLatestEntries(uint32_t maxEvents)
     lg2::debug("Method GetLatestEntries: {FILE} maxEvents: {MAXCOUNT}", "FILE",
                parsedFile.getPath(), "MAXCOUNT", maxEvents);
 
-    ALParseLatest auditParser(maxEvents, parsedFile);
+    if (!ring)
+    {
+        ring = ALRing::open();
+    }
+
+    ALParseLatest auditParser(maxEvents, parsedFile, latestIndex, ring.get());
 
     // Parse events up to maxEvents specified
     auditParser.doParse();
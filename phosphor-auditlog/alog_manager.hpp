@@ -1,5 +1,11 @@
 #pragma once
 
+#include "config.h"
+
+#include "alog_export.hpp"
+#include "alog_index.hpp"
+#include "alog_parser.hpp"
+#include "alog_ring.hpp"
 #include "alog_utils.hpp"
 
 #include <libaudit.h>
@@ -45,8 +51,11 @@ class ALManager : public ALObject
 
     /**
      * @brief Parses all audit log events into JSON format.
-     * @details Entries are sorted oldest to newest.
-     * @return unix_fd A read-only file descriptor to the parsed file.
+     * @details Entries are sorted oldest to newest. Only the events logged
+     * since the previous call are parsed.
+     * @return unix_fd A read-only file descriptor to a sealed memfd, or the
+     * read end of a pipe when built with the auditlog_export option set to
+     * pipe.
      */
     sdbusplus::message::unix_fd getAuditLog() override;
 
@@ -77,6 +86,24 @@ class ALManager : public ALObject
      */
     std::unique_ptr<sdeventplus::source::Defer> fdCloseEventSource;
 
+    /**
+     * @brief The audit logs parsed by getAuditLog
+     */
+    ALExport auditExport{"/var/log/audit", AUDITLOG_EXPORT_CACHE};
+
+    /**
+     * @brief Index of the audit log records returned by getLatestEntries
+     * @details Kept between calls so that each one only reads what was
+     * logged since the last, and the records it returns.
+     */
+    ALIndex latestIndex{ALParseLatest::recordTypes()};
+
+    /**
+     * @brief Entries parsed by the audisp plugin as they were logged
+     * @details Opened on first use, as the plugin creates it.
+     */
+    std::unique_ptr<ALRing> ring;
+
     /**
      * @brief Closes the file descriptor passed in.
      * @details This is called from the event loop to close FDs returned from
@@ -1,7 +1,5 @@
 #include "alog_parser.hpp"
 
-#include "alog_manager.hpp"
-
 #include <auparse.h>
 #include <libaudit.h>
 
@@ -15,6 +13,7 @@
 #include <format>
 #include <list>
 #include <map>
+#include <ranges>
 #include <string>
 #include <string_view>
 
@@ -338,6 +337,17 @@ void ALParser::doParse()
     processEvents();
 }
 
+void ALParseRange::parseRecord()
+{
+    nlohmann::json parsedEntry;
+
+    if (formatEntry(parsedEntry))
+    {
+        parsed.append(parsedEntry.dump());
+        parsed.push_back('\n');
+    }
+}
+
 void ALParseLatest::parseRecord()
 {
     nlohmann::json parsedEntry;
@@ -376,62 +386,145 @@ size_t ALParseLatest::writeParsedEntries()
 void ALParseLatest::doParse()
 {
     lg2::debug("Parsing maxCount: {MAXCOUNT}", "MAXCOUNT", maxCount);
-    if (maxCount > 0)
-    {
-        processEvents();
 
-        auto parsedCount = writeParsedEntries();
+    /* Stop looking in the ring after this many records in a row aren't
+     * there, as the rest are likely older than anything it holds.
+     */
+    constexpr size_t maxRingMisses = 16;
+
+    size_t skip = 0;
+    size_t ringMisses = 0;
+    uint64_t ringPosition = 0;
 
-        // Process next file if needed to reach desired # entries
-        while (parsedCount < maxLeftCount)
+    // Records can be skipped as corrupt, so get more until there are enough
+    while (maxLeftCount > 0)
+    {
+        /* Only the records that are needed are read from the logs */
+        auto latest = logIndex.getLatest(maxLeftCount, skip);
+        if (latest.empty())
         {
-            maxLeftCount -= parsedCount;
+            // No more records to parse
+            break;
+        }
+        skip += latest.size();
 
-            if (!initNextLog())
+        /* Use the entries the plugin already parsed, and parse the rest */
+        std::vector<std::string> unparsed;
+        for (auto& record : latest)
+        {
+            std::string entry;
+            if ((ring != nullptr) && (ringMisses < maxRingMisses) &&
+                ring->find(ALRing::recordKey(record), entry, ringPosition))
             {
-                // No more files to parse
-                break;
+                parseRecords(unparsed);
+                parsedStream << entry << '\n';
+                maxLeftCount--;
+                ringMisses = 0;
+            }
+            else
+            {
+                unparsed.push_back(std::move(record));
+                ringMisses++;
             }
-
-            processEvents();
-
-            /* Add newest events to the file */
-            parsedCount = writeParsedEntries();
         }
+        parseRecords(unparsed);
     }
 }
 
-bool ALParseLatest::initNextLog()
+void ALParseLatest::parseRecords(std::vector<std::string>& unparsed)
 {
+    if (unparsed.empty())
+    {
+        return;
+    }
+
     if (au != nullptr)
     {
-        lg2::debug("initNextLog: destroying existing au");
         auparse_destroy(au);
         au = nullptr;
     }
 
-    /* Determine path of next log file to process.
-     * Newest file has no extension and matches 0 index value.
-     */
-    std::string logFilePath = "/var/log/audit/audit.log";
+    /* auparse wants them oldest first */
+    records.clear();
+    for (const auto& record : unparsed | std::views::reverse)
+    {
+        records.append(record);
+        records.push_back('\n');
+    }
 
-    if (logFileIdx)
+    lg2::debug("parseRecords: Initialize for {COUNT} records", "COUNT",
+               unparsed.size());
+    au = auparse_init(AUSOURCE_BUFFER, records.c_str());
+    if (au == nullptr)
     {
-        logFilePath = std::format("/var/log/audit/audit.log.{}",
-                                  std::to_string(logFileIdx));
+        lg2::error("Failed to init auparse");
+        throw sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure();
     }
 
-    lg2::debug("initNextLog: Initialize for {FILE}", "FILE", logFilePath);
-    au = auparse_init(AUSOURCE_FILE, logFilePath.c_str());
+    processEvents();
 
-    if (au != nullptr)
+    /* Add newest events to the file */
+    maxLeftCount -= writeParsedEntries();
+    unparsed.clear();
+}
+
+void ALParseFeed::feed(const char* data, size_t size)
+{
+    auparse_feed(au, data, size);
+}
+
+void ALParseFeed::flush()
+{
+    auparse_flush_feed(au);
+}
+
+void ALParseFeed::handleEvent(auparse_state_t* au,
+                              auparse_cb_event_t eventType, void* data)
+{
+    if (eventType != AUPARSE_CB_EVENT_READY)
     {
-        logFileIdx++;
-        return true;
+        return;
     }
 
-    // No more files to process
-    return false;
+    auto* parser = static_cast<ALParseFeed*>(data);
+
+    try
+    {
+        auparse_first_record(au);
+        parser->parseEvent();
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to parse event: {ERROR}", "ERROR", e);
+    }
+}
+
+void ALParseFeed::parseRecord()
+{
+    if (handler)
+    {
+        handler(au);
+    }
+
+    if (ring == nullptr)
+    {
+        return;
+    }
+
+    nlohmann::json parsedEntry;
+
+    if (formatEntry(parsedEntry))
+    {
+        auto type = auparse_get_type_name(au);
+        auto fullTimestamp = auparse_get_timestamp(au);
+
+        ring->push(ALRing::recordKey(
+                       type ? type : "",
+                       std::format("{}.{:03}:{}", fullTimestamp->sec,
+                                   fullTimestamp->milli,
+                                   fullTimestamp->serial)),
+                   parsedEntry.dump());
+    }
 }
 
 } // namespace phosphor::auditlog
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "alog_index.hpp"
+#include "alog_ring.hpp"
 #include "alog_utils.hpp"
 
 #include <auparse.h>
@@ -14,8 +16,10 @@
 #include <xyz/openbmc_project/Logging/AuditLog/server.hpp>
 
 #include <fstream>
+#include <functional>
 #include <list>
 #include <string>
+#include <vector>
 
 namespace phosphor::auditlog
 {
@@ -60,6 +64,10 @@ class ALParser
     void processEvents();
 
   protected:
+    /** @brief Constructor for parsers that don't write to a file
+     */
+    ALParser() = default;
+
     /**
      * @brief Format audit entries into raw JSON
      * @param[in,out] parsedEntry Filled in with parsed audit entry.
@@ -91,6 +99,12 @@ class ALParser
      */
     bool formatRaw(nlohmann::json& parsedEntry);
 
+    /**
+     * @brief Parses next event and each of its records into JSON format
+     * @details Writes the audit log events to parsedStream.
+     */
+    void parseEvent();
+
     auparse_state_t* au = nullptr;
     std::ofstream parsedStream;
 
@@ -102,12 +116,6 @@ class ALParser
      */
     bool getNextEvent();
 
-    /**
-     * @brief Parses next event and each of its records into JSON format
-     * @details Writes the audit log events to parsedStream.
-     */
-    void parseEvent();
-
     /**
      * @brief Parses and writes next record into JSON format
      */
@@ -151,23 +159,28 @@ class ALParseLatest : public ALParser
     /** @brief Constructor to initialize parsing of audit log files
      *  @param[in] maxEvents Maximum number of events to return.
      *  @param[in] parsedFile Initialized file for holding parsed log events
+     *  @param[in] logIndex Index of the audit log records to parse
+     *  @param[in] ring Entries already parsed by the audisp plugin, if any
      */
-    ALParseLatest(uint32_t maxEvents, ALParseFile& parsedFile) :
-        ALParser(parsedFile)
+    ALParseLatest(uint32_t maxEvents, ALParseFile& parsedFile,
+                  ALIndex& logIndex, const ALRing* ring = nullptr) :
+        ALParser(parsedFile), logIndex(logIndex), ring(ring)
     {
         lg2::debug("Constructing ALParseLatest: {MAXCOUNT}", "MAXCOUNT",
                    maxEvents);
 
-        initNextLog();
         maxCount = maxEvents;
         maxLeftCount = maxEvents;
+    }
 
-        if (au == nullptr)
-        {
-            lg2::error("Failed to init auparse");
-            throw sdbusplus::xyz::openbmc_project::Common::Error::
-                InternalFailure();
-        }
+    /**
+     * @brief Names of the record types formatEntry() accepts
+     * @return Types to pass to the ALIndex used
+     */
+    static std::vector<std::string> recordTypes()
+    {
+        return {audit_msg_type_to_name(AUDIT_USYS_CONFIG),
+                audit_msg_type_to_name(AUDIT_USER_LOGIN)};
     }
 
     /**
@@ -190,7 +203,9 @@ class ALParseLatest : public ALParser
   private:
     size_t maxCount = 0;
     size_t maxLeftCount = 0;
-    unsigned int logFileIdx = 0;
+    ALIndex& logIndex;
+    const ALRing* ring;
+    std::string records;
     std::list<std::string> parsedEntries;
 
     /**
@@ -199,13 +214,11 @@ class ALParseLatest : public ALParser
     void parseRecord() override;
 
     /**
-     * @brief Initializes parser to next audit log available
-     * @details Initializes with the latest audit log first. Each subsequent
-     *         call will initialize with the next oldest audit log file until
-     *         a file cannot be found.
-     * @return bool True if initialization succeeded, false otherwise.
+     * @brief Parses records and writes the entries to parsedStream
+     * @param[in,out] unparsed Records, newest to oldest. Cleared once
+     *                parsed.
      */
-    bool initNextLog();
+    void parseRecords(std::vector<std::string>& unparsed);
 
     /**
      * @brief Writes parsedEntries to parsedStream
@@ -215,26 +228,27 @@ class ALParseLatest : public ALParser
     size_t writeParsedEntries();
 };
 
-/** @class ALParseAll
+/** @class ALParseRange
  *  @brief Parsing audit log using auparse library services
- *  @details Provides means to parse all entries
+ *  @details Provides means to parse a range of a log into general JSON. The
+ *  parsed entries are appended to a string rather than written to a file.
  */
-class ALParseAll : public ALParser
+class ALParseRange : public ALParser
 {
   public:
-    ALParseAll(const ALParseAll&) = delete;
-    ALParseAll& operator=(const ALParseAll&) = delete;
-    ALParseAll(ALParseAll&&) = delete;
-    ALParseAll& operator=(ALParseAll&&) = delete;
-
-    /** @brief Constructor to initialize parsing of audit log files
-     *  @details Initializes au to parse all audit logs.
-     *  @param[in] parsedFile Initialized file for holding parsed log events
+    ALParseRange(const ALParseRange&) = delete;
+    ALParseRange& operator=(const ALParseRange&) = delete;
+    ALParseRange(ALParseRange&&) = delete;
+    ALParseRange& operator=(ALParseRange&&) = delete;
+
+    /** @brief Constructor to initialize parsing of audit log records
+     *  @param[in] records Complete lines of raw audit log records
+     *  @param[in,out] parsed String the parsed entries are appended to
      */
-    explicit ALParseAll(ALParseFile& parsedFile) : ALParser(parsedFile)
+    ALParseRange(const std::string& records, std::string& parsed) :
+        parsed(parsed)
     {
-        lg2::debug("Constructing ALParseAll");
-        au = auparse_init(AUSOURCE_LOGS, nullptr);
+        au = auparse_init(AUSOURCE_BUFFER, records.c_str());
         if (au == nullptr)
         {
             lg2::error("Failed to init auparse");
@@ -253,6 +267,87 @@ class ALParseAll : public ALParser
     {
         return formatGeneral(parsedEntry);
     };
+
+  private:
+    std::string& parsed;
+
+    /**
+     * @brief Parses next record into JSON format and appends to parsed
+     */
+    void parseRecord() override;
+};
+
+/** @class ALParseFeed
+ *  @brief Parsing audit log using auparse library services
+ *  @details Provides means to parse events as they are dispatched by auditd,
+ *  so the audisp plugin can add them to an ALRing in message registry form.
+ */
+class ALParseFeed : public ALParser
+{
+  public:
+    using RecordHandler = std::function<void(auparse_state_t*)>;
+
+    ALParseFeed(const ALParseFeed&) = delete;
+    ALParseFeed& operator=(const ALParseFeed&) = delete;
+    ALParseFeed(ALParseFeed&&) = delete;
+    ALParseFeed& operator=(ALParseFeed&&) = delete;
+
+    /** @brief Constructor to initialize parsing of dispatched events
+     *  @param[in] ring Ring to add the parsed entries to, if any
+     *  @param[in] handler Called with each record before it is parsed
+     */
+    ALParseFeed(ALRing* ring, RecordHandler handler) :
+        ring(ring), handler(std::move(handler))
+    {
+        au = auparse_init(AUSOURCE_FEED, nullptr);
+        if (au == nullptr)
+        {
+            lg2::error("Failed to init auparse feed");
+            throw sdbusplus::xyz::openbmc_project::Common::Error::
+                InternalFailure();
+        }
+
+        auparse_add_callback(au, handleEvent, this, nullptr);
+    }
+
+    /**
+     * @brief Parses dispatched data
+     * @details Events are parsed as they are completed.
+     * @param[in] data The data
+     * @param[in] size Size of the data
+     */
+    void feed(const char* data, size_t size);
+
+    /**
+     * @brief Parses any events still queued
+     */
+    void flush();
+
+  protected:
+    /**
+     * @brief Format audit entries into JSON using message registry form
+     * @param[in,out] parsedEntry Filled in with parsed audit entry.
+     * @return bool True if parsing succeeded, false otherwise.
+     */
+    bool formatEntry(nlohmann::json& parsedEntry) override
+    {
+        return formatMsgReg(parsedEntry);
+    };
+
+  private:
+    ALRing* ring;
+    RecordHandler handler;
+
+    /**
+     * @brief Passes the record to handler and adds its entry to ring
+     */
+    void parseRecord() override;
+
+    /**
+     * @brief Callback from auparse for each completed event
+     */
+    static void handleEvent(auparse_state_t* au, auparse_cb_event_t eventType,
+                            void* data);
 };
 
 } // namespace phosphor::auditlog
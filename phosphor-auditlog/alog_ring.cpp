@@ -0,0 +1,234 @@
+#include "alog_ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+namespace phosphor::auditlog
+{
+
+ALRing::~ALRing()
+{
+    munmap(header, mapSize);
+}
+
+void* ALRing::map(const std::string& name, bool create)
+{
+    int fd = shm_open(name.c_str(),
+                      create ? (O_RDWR | O_CREAT | O_CLOEXEC)
+                             : (O_RDWR | O_CLOEXEC),
+                      S_IRUSR | S_IWUSR);
+    if (fd == -1)
+    {
+        if (create || (errno != ENOENT))
+        {
+            auto e = errno;
+            lg2::error("Failed to open {NAME}: {ERRNO}", "NAME", name, "ERRNO",
+                       e);
+        }
+        return nullptr;
+    }
+
+    struct stat st{};
+    if ((fstat(fd, &st) == -1) ||
+        ((static_cast<size_t>(st.st_size) != mapSize) &&
+         (!create || (ftruncate(fd, mapSize) == -1))))
+    {
+        lg2::error("Unexpected size of {NAME}", "NAME", name);
+        close(fd);
+        return nullptr;
+    }
+
+    auto* map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                     0);
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        auto e = errno;
+        lg2::error("Failed to map {NAME}: {ERRNO}", "NAME", name, "ERRNO", e);
+        return nullptr;
+    }
+
+    return map;
+}
+
+std::unique_ptr<ALRing> ALRing::create(const std::string& name)
+{
+    auto* map = ALRing::map(name, true);
+    if (map == nullptr)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<ALRing> ring{new ALRing(map)};
+    auto* header = ring->header;
+
+    if ((header->magic != ringMagic) || (header->version != ringVersion) ||
+        (header->slotCount != slotCount) || (header->slotSize != slotSize))
+    {
+        lg2::info("Initializing {NAME}", "NAME", name);
+
+        // The magic is set last, once the rest is valid
+        std::memset(map, 0, mapSize);
+        header->version = ringVersion;
+        header->slotCount = slotCount;
+        header->slotSize = slotSize;
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = ringMagic;
+    }
+
+    return ring;
+}
+
+std::unique_ptr<ALRing> ALRing::open(const std::string& name)
+{
+    auto* map = ALRing::map(name, false);
+    if (map == nullptr)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<ALRing> ring{new ALRing(map)};
+    auto* header = ring->header;
+
+    if ((header->magic != ringMagic) || (header->version != ringVersion) ||
+        (header->slotCount != slotCount) || (header->slotSize != slotSize))
+    {
+        lg2::debug("{NAME} isn't initialized", "NAME", name);
+        return nullptr;
+    }
+
+    return ring;
+}
+
+ALRing::Slot* ALRing::slot(uint64_t number) const
+{
+    auto* slots = reinterpret_cast<std::byte*>(header + 1);
+    return reinterpret_cast<Slot*>(slots + (number % slotCount) * slotSize);
+}
+
+void ALRing::push(std::string_view key, std::string_view entry)
+{
+    if (sizeof(Slot) + key.size() + entry.size() > slotSize)
+    {
+        lg2::debug("Entry too large for ring: {KEY}", "KEY", key);
+        return;
+    }
+
+    // Entries are numbered from 1, so 0 can mean the newest in find()
+    auto number = header->written.load(std::memory_order_relaxed) + 1;
+    auto* s = slot(number);
+    auto* data = reinterpret_cast<char*>(s + 1);
+    auto sequence = s->sequence.load(std::memory_order_relaxed);
+
+    s->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s->number = number;
+    s->keyLength = key.size();
+    s->entryLength = entry.size();
+    std::memcpy(data, key.data(), key.size());
+    std::memcpy(data + key.size(), entry.data(), entry.size());
+
+    s->sequence.store(sequence + 2, std::memory_order_release);
+    header->written.store(number, std::memory_order_release);
+}
+
+bool ALRing::find(std::string_view key, std::string& entry,
+                  uint64_t& position) const
+{
+    auto written = header->written.load(std::memory_order_acquire);
+    auto oldest = written > slotCount ? written - slotCount + 1 : 1;
+    auto number = position == 0 ? written : std::min(position - 1, written);
+    char data[slotSize];
+
+    for (; number >= oldest; number--)
+    {
+        const auto* s = slot(number);
+
+        auto before = s->sequence.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            // Being overwritten with a newer entry
+            continue;
+        }
+
+        auto entryNumber = s->number;
+        size_t keyLength = s->keyLength;
+        size_t entryLength = s->entryLength;
+        if ((entryNumber != number) ||
+            (sizeof(Slot) + keyLength + entryLength > slotSize))
+        {
+            continue;
+        }
+        std::memcpy(data, s + 1, keyLength + entryLength);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s->sequence.load(std::memory_order_relaxed) != before)
+        {
+            continue;
+        }
+
+        if (std::string_view{data, keyLength} == key)
+        {
+            entry.assign(data + keyLength, entryLength);
+            position = number;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string ALRing::recordKey(std::string_view type, std::string_view stamp)
+{
+    return std::format("{} {}", type, stamp);
+}
+
+std::string ALRing::recordKey(std::string_view line)
+{
+    constexpr std::string_view typeTag{"type="};
+    constexpr std::string_view msgTag{" msg=audit("};
+
+    /* Lines look like:
+     *   [node=<name> ]type=<TYPE> msg=audit(<sec>.<msec>:<serial>): ...
+     */
+    if (line.starts_with("node="))
+    {
+        auto space = line.find(' ');
+        if (space == std::string_view::npos)
+        {
+            return {};
+        }
+        line.remove_prefix(space + 1);
+    }
+
+    if (!line.starts_with(typeTag))
+    {
+        return {};
+    }
+    line.remove_prefix(typeTag.size());
+
+    auto typeEnd = line.find(msgTag);
+    auto stampEnd = line.find(')');
+    if ((typeEnd == std::string_view::npos) ||
+        (stampEnd == std::string_view::npos) || (stampEnd < typeEnd))
+    {
+        return {};
+    }
+
+    auto stampStart = typeEnd + msgTag.size();
+    return recordKey(line.substr(0, typeEnd),
+                     line.substr(stampStart, stampEnd - stampStart));
+}
+
+} // namespace phosphor::auditlog
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace phosphor::auditlog
+{
+
+/** @class ALRing
+ *  @brief Ring buffer of parsed audit log entries in shared memory
+ *  @details The audisp plugin parses each event as auditd dispatches it and
+ *  adds the entries to the ring, keyed by record type and event stamp. The
+ *  daemon looks entries up by the key of the log records it returns, so it
+ *  only parses the records the ring doesn't have. There is one writer, and
+ *  readers never block it: each slot has a sequence number that is odd while
+ *  the slot is being written.
+ */
+class ALRing
+{
+  public:
+    ALRing() = delete;
+    ALRing(const ALRing&) = delete;
+    ALRing& operator=(const ALRing&) = delete;
+    ALRing(ALRing&&) = delete;
+    ALRing& operator=(ALRing&&) = delete;
+    ~ALRing();
+
+    static constexpr auto defaultName = "/phosphor-auditlog-ring";
+    static constexpr uint32_t slotCount = 1024;
+    static constexpr uint32_t slotSize = 1024;
+
+    /**
+     * @brief Creates the ring for writing
+     * @details An existing ring with the same layout is kept, otherwise it
+     *          is cleared.
+     * @param[in] name Name of the shared memory object
+     * @return The ring, or nullptr on failure
+     */
+    static std::unique_ptr<ALRing>
+        create(const std::string& name = defaultName);
+
+    /**
+     * @brief Opens an existing ring for reading
+     * @param[in] name Name of the shared memory object
+     * @return The ring, or nullptr if there isn't a usable one
+     */
+    static std::unique_ptr<ALRing> open(const std::string& name = defaultName);
+
+    /**
+     * @brief Adds an entry, replacing the oldest one when full
+     * @details Entries that don't fit in a slot are dropped.
+     * @param[in] key The key of the record parsed
+     * @param[in] entry The parsed entry
+     */
+    void push(std::string_view key, std::string_view entry);
+
+    /**
+     * @brief Looks up the entry parsed from a record
+     * @param[in] key The key of the record
+     * @param[out] entry The parsed entry
+     * @param[in,out] position Where to look back from, 0 for the newest
+     *                entry. Set to where the entry was found, so that
+     *                looking up older records continues from there.
+     * @return bool True if the entry was found
+     */
+    bool find(std::string_view key, std::string& entry,
+              uint64_t& position) const;
+
+    /**
+     * @brief Returns the key of a record
+     * @param[in] type The record type name, e.g. USER_LOGIN
+     * @param[in] stamp The event stamp, as <sec>.<msec>:<serial>
+     * @return The key
+     */
+    static std::string recordKey(std::string_view type, std::string_view stamp);
+
+    /**
+     * @brief Returns the key of a record in the audit log
+     * @param[in] line The record
+     * @return The key, or an empty string if the record isn't valid
+     */
+    static std::string recordKey(std::string_view line);
+
+  private:
+    /** @brief Start of the shared memory */
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t slotSize;
+        std::atomic<uint64_t> written;
+    };
+
+    /** @brief Start of each slot, followed by the key and then the entry */
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence;
+        uint64_t number;
+        uint16_t keyLength;
+        uint16_t entryLength;
+    };
+
+    static constexpr uint32_t ringMagic = 0x414c5247; // ALRG
+    static constexpr uint32_t ringVersion = 1;
+    static constexpr size_t mapSize =
+        sizeof(Header) + static_cast<size_t>(slotCount) * slotSize;
+
+    /** @brief Constructor
+     *  @param[in] map The mapped shared memory
+     */
+    explicit ALRing(void* map) : header(static_cast<Header*>(map)) {}
+
+    /**
+     * @brief Returns the slot that holds an entry
+     * @param[in] number The entry number
+     */
+    Slot* slot(uint64_t number) const;
+
+    /**
+     * @brief Maps the shared memory
+     * @param[in] name Name of the shared memory object
+     * @param[in] create True if the object should be created when missing
+     * @return The mapping, or nullptr on failure
+     */
+    static void* map(const std::string& name, bool create);
+
+    Header* header;
+};
+
+} // namespace phosphor::auditlog
@@ -7,6 +7,8 @@
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server/manager.hpp>
 
+#include <csignal>
+
 // AUDITLOG_PATH
 constexpr auto auditLogMgrRoot = "/xyz/openbmc_project/logging/auditlog";
 // AUDITLOG_INTERFACE
@@ -14,6 +16,9 @@ constexpr auto auditLogBusName = "xyz.openbmc_project.Logging.AuditLog";
 
 int main(int /*argc*/, char* /*argv*/[])
 {
+    // A GetAuditLog caller closing its pipe early shouldn't kill the daemon
+    std::signal(SIGPIPE, SIG_IGN);
+
     auto bus = sdbusplus::bus::new_default();
     auto event = sdeventplus::Event::get_default();
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
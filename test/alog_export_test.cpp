@@ -0,0 +1,315 @@
+#include "phosphor-auditlog/alog_export.hpp"
+#include "phosphor-auditlog/alog_parser.hpp"
+
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::auditlog;
+namespace fs = std::filesystem;
+
+class ALExportTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        // A pipe reader going away is an EPIPE, as in the daemon
+        std::signal(SIGPIPE, SIG_IGN);
+
+        char templ[] = "/tmp/alog_export_testXXXXXX";
+        dir = mkdtemp(templ);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    /** @brief Appends record lines to a log
+     *  @return The lines
+     */
+    std::string append(size_t count, const std::string& name = "audit.log")
+    {
+        std::string lines;
+        for (size_t i = 0; i < count; i++)
+        {
+            serial++;
+            lines += std::format(
+                "type=USER_LOGIN msg=audit({}.000:{}): pid={} uid=0 "
+                "msg='op=login acct=\"root\" res=success'\n",
+                1700000000 + serial, serial, serial);
+        }
+
+        appendText(lines, name);
+        return lines;
+    }
+
+    /** @brief Appends text to a log */
+    void appendText(const std::string& text,
+                    const std::string& name = "audit.log")
+    {
+        std::ofstream log{dir / name, std::ios::app};
+        log << text;
+    }
+
+    /** @brief Returns complete lines parsed as ALExport does */
+    static std::string parse(const std::string& lines)
+    {
+        std::string parsed;
+        ALParseRange parser(lines, parsed);
+        parser.doParse();
+        return parsed;
+    }
+
+    /** @brief Reads the rest of a file descriptor and closes it */
+    static std::string readAll(int fd)
+    {
+        std::string data;
+        char buffer[4096];
+        ssize_t rc;
+        while ((rc = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            data.append(buffer, rc);
+        }
+        close(fd);
+        return data;
+    }
+
+    /** @brief Returns the export written to a memfd */
+    static std::string exported(ALExport& alExport)
+    {
+        return readAll(ALExport::toMemfd(alExport.update()));
+    }
+
+    /** @brief Returns the text of a log */
+    std::string text(const std::string& name)
+    {
+        std::ifstream log{dir / name};
+        return {std::istreambuf_iterator<char>{log}, {}};
+    }
+
+    /** @brief Changes a log in place, without changing its inode or size */
+    void changeInPlace(const std::string& name, const std::string& from,
+                       const std::string& to)
+    {
+        auto pos = text(name).find(from);
+        ASSERT_NE(pos, std::string::npos);
+        ASSERT_EQ(from.size(), to.size());
+
+        std::fstream log{dir / name, std::ios::in | std::ios::out};
+        log.seekp(pos);
+        log << to;
+    }
+
+    /** @brief Returns the number of open file descriptors */
+    static size_t openFds()
+    {
+        return std::distance(fs::directory_iterator{"/proc/self/fd"},
+                             fs::directory_iterator{});
+    }
+
+    fs::path dir;
+    size_t serial = 0;
+};
+
+TEST_F(ALExportTest, Export)
+{
+    auto older = append(100, "audit.log.1");
+    auto newer = append(50);
+
+    ALExport alExport{dir};
+    auto expected = parse(older + newer);
+    ASSERT_FALSE(expected.empty());
+
+    int fd = ALExport::toMemfd(alExport.update());
+
+    // The export is read-only
+    EXPECT_EQ(write(fd, "x", 1), -1);
+    EXPECT_EQ(readAll(fd), expected);
+
+    EXPECT_EQ(exported(alExport), expected);
+}
+
+TEST_F(ALExportTest, NoLogs)
+{
+    ALExport alExport{dir};
+
+    EXPECT_TRUE(exported(alExport).empty());
+}
+
+TEST_F(ALExportTest, Appended)
+{
+    auto lines = append(10);
+
+    ALExport alExport{dir};
+    EXPECT_EQ(exported(alExport), parse(lines));
+
+    lines += append(5);
+    EXPECT_EQ(exported(alExport), parse(lines));
+}
+
+TEST_F(ALExportTest, PartialLine)
+{
+    auto lines = append(10);
+
+    ALExport alExport{dir};
+
+    // A partial line isn't exported until it is finished
+    auto partial = std::format(
+        "type=USER_LOGIN msg=audit(1800000000.000:{}): pid=1 uid=0 "
+        "msg='op=login acct=\"root\" res=success'\n",
+        1000);
+    appendText(partial.substr(0, 40));
+    EXPECT_EQ(exported(alExport), parse(lines));
+
+    appendText(partial.substr(40));
+    lines += partial;
+    EXPECT_EQ(exported(alExport), parse(lines));
+}
+
+TEST_F(ALExportTest, Rotated)
+{
+    auto older = append(20);
+
+    ALExport alExport{dir};
+    EXPECT_EQ(exported(alExport), parse(older));
+
+    // Rotate as auditd does, renaming audit.log to audit.log.1
+    fs::rename(dir / "audit.log", dir / "audit.log.1");
+    auto newer = append(5);
+    EXPECT_EQ(exported(alExport), parse(older + newer));
+
+    // The entries of audit.log.1 were kept, so it isn't parsed again
+    changeInPlace("audit.log.1", "uid=0", "uid=1");
+    EXPECT_EQ(exported(alExport), parse(older + newer));
+
+    // Until the oldest is removed in the next rotation
+    fs::rename(dir / "audit.log.1", dir / "audit.log.2");
+    fs::rename(dir / "audit.log", dir / "audit.log.1");
+    fs::remove(dir / "audit.log.2");
+    auto newest = append(3);
+    EXPECT_EQ(exported(alExport), parse(newer + newest));
+}
+
+TEST_F(ALExportTest, Truncated)
+{
+    append(20);
+
+    ALExport alExport{dir};
+    exported(alExport);
+
+    // Smaller than what was parsed, so it is parsed again
+    fs::resize_file(dir / "audit.log", 0);
+    auto lines = append(3);
+    EXPECT_EQ(exported(alExport), parse(lines));
+}
+
+TEST_F(ALExportTest, CacheSize)
+{
+    auto oldest = append(200, "audit.log.2");
+    auto older = append(200, "audit.log.1");
+    auto newer = append(10);
+
+    // Only the newest log fits, the others are parsed on each export
+    ALExport alExport{dir, parse(newer).size() + parse(older).size() / 2};
+    EXPECT_EQ(exported(alExport), parse(oldest + older + newer));
+
+    changeInPlace("audit.log.1", "uid=0", "uid=1");
+    changeInPlace("audit.log", "uid=0", "uid=1");
+    auto changed = older;
+    changed.replace(changed.find("uid=0"), 5, "uid=1");
+    EXPECT_EQ(exported(alExport), parse(oldest + changed + newer));
+
+    // Nothing kept at all, so the logs are parsed as they are now
+    ALExport uncached{dir, 0};
+    auto all = [this]() {
+        return parse(text("audit.log.2") + text("audit.log.1") +
+                     text("audit.log"));
+    };
+    EXPECT_EQ(exported(uncached), all());
+
+    append(10);
+    EXPECT_EQ(exported(uncached), all());
+}
+
+TEST_F(ALExportTest, LongLine)
+{
+    auto lines = append(5);
+    auto longLine = std::format(
+        "type=USER_LOGIN msg=audit(1800000000.000:1000): pid=1 uid=0 "
+        "msg='op={} acct=\"root\" res=success'\n",
+        std::string(200 * 1024, 'a'));
+    appendText(longLine);
+    lines += longLine + append(5);
+
+    ALExport uncached{dir, 0};
+    EXPECT_EQ(exported(uncached), parse(lines));
+}
+
+TEST_F(ALExportTest, Pipe)
+{
+    // More than the pipe holds at once
+    auto lines = append(2000, "audit.log.1") + append(2000);
+
+    auto event = sdeventplus::Event::get_default();
+    ALExport alExport{dir, 64 * 1024};
+
+    auto parts = alExport.update();
+    int fd = alExport.toPipe(parts, event);
+
+    std::string data;
+    char buffer[4096];
+    while (true)
+    {
+        event.run(std::chrono::milliseconds(10));
+
+        auto rc = read(fd, buffer, sizeof(buffer));
+        ASSERT_GE(rc, 0);
+        if (rc == 0)
+        {
+            break;
+        }
+        data.append(buffer, rc);
+    }
+    close(fd);
+
+    EXPECT_EQ(data, parse(lines));
+}
+
+TEST_F(ALExportTest, PipeClosedEarly)
+{
+    append(2000, "audit.log.1");
+    append(2000);
+
+    auto event = sdeventplus::Event::get_default();
+    ALExport alExport{dir, 64 * 1024};
+    auto fds = openFds();
+
+    int fd = alExport.toPipe(alExport.update(), event);
+    event.run(std::chrono::milliseconds(10));
+
+    char buffer[4096];
+    ASSERT_GT(read(fd, buffer, sizeof(buffer)), 0);
+    close(fd);
+
+    // The stream is dropped, closing the write end and the logs
+    for (int i = 0; (i < 10) && (openFds() != fds); i++)
+    {
+        event.run(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(openFds(), fds);
+
+    // And the next export still works
+    EXPECT_FALSE(exported(alExport).empty());
+}
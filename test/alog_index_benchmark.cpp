@@ -0,0 +1,212 @@
+#include "phosphor-auditlog/alog_index.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace phosphor::auditlog;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+const std::vector<std::string> types{"USYS_CONFIG", "USER_LOGIN"};
+
+constexpr size_t numLogs = 5;
+constexpr size_t linesPerLog = 40000;
+constexpr uint64_t firstTimestamp = 1700000000;
+
+/**
+ * @brief Returns a log line, mostly syscall records with a login or config
+ *        change now and then, like a BMC's audit log.
+ */
+std::string makeLine(uint64_t serial)
+{
+    auto stamp = std::format("msg=audit({}.{:03}:{})", firstTimestamp + serial,
+                             serial % 1000, serial);
+
+    if (serial % 25 == 0)
+    {
+        return std::format(
+            "type=USER_LOGIN {}: pid={} uid=0 auid=4294967295 ses=4294967295 "
+            "msg='op=login acct=\"root\" exe=\"/usr/sbin/dropbear\" "
+            "hostname=? addr=10.0.0.{} terminal=ssh res=success'\n",
+            stamp, 1000 + serial % 30000, serial % 250);
+    }
+
+    if (serial % 60 == 0)
+    {
+        return std::format(
+            "type=USYS_CONFIG {}: pid={} uid=0 auid=0 ses=1 "
+            "msg='op=set-hostname acct=\"root\" exe=\"/usr/bin/bmcweb\" "
+            "hostname=? addr=? terminal=? res=success'\n",
+            stamp, 1000 + serial % 30000);
+    }
+
+    return std::format(
+        "type=SYSCALL {}: arch=c00000b7 syscall=221 success=yes exit=0 "
+        "a0=7fd8 a1=7fd9 a2=7fda a3=0 items=2 ppid=1 pid={} auid=4294967295 "
+        "uid=0 gid=0 comm=\"sh\" exe=\"/bin/sh\" key=(null)\n",
+        stamp, 1000 + serial % 30000);
+}
+
+/**
+ * @brief Writes audit.log and its rotated files to a directory, with
+ *        audit.log.<numLogs - 1> the oldest.
+ * @return The directory
+ */
+fs::path makeLogs()
+{
+    static const auto dir = []() {
+        auto dir = fs::temp_directory_path() / "alog_index_benchmark";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+
+        uint64_t serial = 0;
+        for (size_t idx = numLogs; idx-- > 0;)
+        {
+            auto path = dir / "audit.log";
+            if (idx)
+            {
+                path += std::format(".{}", idx);
+            }
+
+            std::ofstream log{path};
+            for (size_t i = 0; i < linesPerLog; i++)
+            {
+                log << makeLine(serial++);
+            }
+        }
+        return dir;
+    }();
+
+    return dir;
+}
+
+/**
+ * @brief Appends a new login record to audit.log, as happens between
+ *        GetLatestEntries calls.
+ */
+void appendLogin(const fs::path& dir, uint64_t& serial)
+{
+    std::ofstream log{dir / "audit.log", std::ios::app};
+    serial += 25 - (serial % 25);
+    log << makeLine(serial);
+}
+
+} // namespace
+
+/**
+ * @brief What reading the latest entries used to require before any of
+ *        them were parsed: every line of every log.
+ */
+static void latestFullRead(benchmark::State& state)
+{
+    auto dir = makeLogs();
+    size_t count = state.range(0);
+
+    for (auto _ : state)
+    {
+        std::vector<std::string> latest;
+
+        for (size_t idx = 0; (idx < numLogs) && (latest.size() < count);
+             idx++)
+        {
+            auto path = dir / "audit.log";
+            if (idx)
+            {
+                path += std::format(".{}", idx);
+            }
+
+            std::ifstream log{path};
+            std::vector<std::string> matches;
+            std::string line;
+            while (std::getline(log, line))
+            {
+                if (line.starts_with("type=USER_LOGIN ") ||
+                    line.starts_with("type=USYS_CONFIG "))
+                {
+                    matches.push_back(line);
+                }
+            }
+
+            for (auto it = matches.rbegin();
+                 (it != matches.rend()) && (latest.size() < count); ++it)
+            {
+                latest.push_back(*it);
+            }
+        }
+
+        benchmark::DoNotOptimize(latest);
+    }
+}
+
+/**
+ * @brief The first GetLatestEntries call, which starts with no index.
+ */
+static void latestColdIndex(benchmark::State& state)
+{
+    auto dir = makeLogs();
+
+    for (auto _ : state)
+    {
+        ALIndex index{types, dir};
+        auto latest = index.getLatest(state.range(0));
+        benchmark::DoNotOptimize(latest);
+    }
+}
+
+/**
+ * @brief Later GetLatestEntries calls, with new records in between.
+ */
+static void latestWarmIndex(benchmark::State& state)
+{
+    // Appending goes to a copy of the logs
+    auto dir = fs::temp_directory_path() / "alog_index_benchmark_append";
+    fs::remove_all(dir);
+    fs::copy(makeLogs(), dir);
+
+    uint64_t serial = numLogs * linesPerLog;
+    ALIndex index{types, dir};
+    index.getLatest(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        appendLogin(dir, serial);
+        state.ResumeTiming();
+
+        auto latest = index.getLatest(state.range(0));
+        benchmark::DoNotOptimize(latest);
+    }
+
+    fs::remove_all(dir);
+}
+
+/**
+ * @brief The records from the last hour of the oldest log, which needs
+ *        the index to reach back through every log.
+ */
+static void rangeWarmIndex(benchmark::State& state)
+{
+    auto dir = makeLogs();
+    ALIndex index{types, dir};
+    uint64_t end = firstTimestamp + linesPerLog;
+
+    for (auto _ : state)
+    {
+        auto range = index.getRange(end - 3600, end);
+        benchmark::DoNotOptimize(range);
+    }
+}
+
+BENCHMARK(latestFullRead)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(latestColdIndex)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(rangeWarmIndex)->Unit(benchmark::kMicrosecond);
+BENCHMARK(latestWarmIndex)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,231 @@
+#include "phosphor-auditlog/alog_index.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::auditlog;
+namespace fs = std::filesystem;
+
+class ALIndexTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char templ[] = "/tmp/alog_index_testXXXXXX";
+        dir = mkdtemp(templ);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    /** @brief Returns a record line, without the newline */
+    static std::string record(const std::string& type, uint64_t timestamp,
+                              const std::string& text = "")
+    {
+        return std::format("type={} msg=audit({}.000:{}): {}", type,
+                           timestamp, timestamp, text);
+    }
+
+    /** @brief Appends text to a log */
+    void append(const std::string& text, const std::string& name = "audit.log")
+    {
+        std::ofstream log{dir / name, std::ios::app};
+        log << text;
+    }
+
+    /** @brief Appends record lines to a log */
+    void appendLines(const std::vector<std::string>& lines,
+                     const std::string& name = "audit.log")
+    {
+        for (const auto& line : lines)
+        {
+            append(line + '\n', name);
+        }
+    }
+
+    fs::path dir;
+    std::vector<std::string> types{"USER_LOGIN", "USYS_CONFIG"};
+};
+
+TEST_F(ALIndexTest, GetLatest)
+{
+    auto login1 = record("USER_LOGIN", 100, "first");
+    auto config = record("USYS_CONFIG", 101);
+    auto login2 = record("USER_LOGIN", 103, "second");
+    appendLines({login1, record("SYSCALL", 100), config, record("CWD", 102),
+                 login2, "not a record"});
+
+    ALIndex index{types, dir};
+
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{login2, config, login1}));
+    EXPECT_EQ(index.getLatest(2), (std::vector<std::string>{login2, config}));
+    EXPECT_EQ(index.getLatest(2, 1),
+              (std::vector<std::string>{config, login1}));
+    EXPECT_TRUE(index.getLatest(2, 3).empty());
+    EXPECT_TRUE(index.getLatest(0).empty());
+}
+
+TEST_F(ALIndexTest, NoLogs)
+{
+    ALIndex index{types, dir};
+
+    EXPECT_TRUE(index.getLatest(10).empty());
+    EXPECT_TRUE(index.getRange(0, UINT64_MAX).empty());
+}
+
+TEST_F(ALIndexTest, NodePrefix)
+{
+    auto login = "node=bmc0 " + record("USER_LOGIN", 100);
+    auto config = "node=bmc1 " + record("USYS_CONFIG", 101);
+    appendLines({login, "node=bmc0 " + record("SYSCALL", 102), config,
+                 "node=bmc0"});
+
+    ALIndex index{types, dir};
+
+    EXPECT_EQ(index.getLatest(10), (std::vector<std::string>{config, login}));
+}
+
+TEST_F(ALIndexTest, LongLines)
+{
+    // Longer than the blocks the log is read backwards in
+    auto login = record("USER_LOGIN", 100, std::string(200 * 1024, 'a'));
+    auto config = record("USYS_CONFIG", 101, std::string(100 * 1024, 'b'));
+    auto syscall = record("SYSCALL", 102, std::string(150 * 1024, 'c'));
+    appendLines({login, config, syscall});
+
+    ALIndex index{types, dir};
+
+    EXPECT_EQ(index.getLatest(10), (std::vector<std::string>{config, login}));
+}
+
+TEST_F(ALIndexTest, Appended)
+{
+    auto login1 = record("USER_LOGIN", 100);
+    appendLines({login1});
+
+    ALIndex index{types, dir};
+    EXPECT_EQ(index.getLatest(10), std::vector<std::string>{login1});
+
+    auto login2 = record("USER_LOGIN", 101);
+    appendLines({record("SYSCALL", 101), login2});
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{login2, login1}));
+
+    // A partial line isn't a record until it is finished
+    auto login3 = record("USER_LOGIN", 102);
+    append(login3.substr(0, 20));
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{login2, login1}));
+
+    append(login3.substr(20) + '\n');
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{login3, login2, login1}));
+}
+
+TEST_F(ALIndexTest, Rotated)
+{
+    auto login1 = record("USER_LOGIN", 100);
+    auto login2 = record("USER_LOGIN", 101);
+    appendLines({login1, login2});
+
+    ALIndex index{types, dir};
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{login2, login1}));
+
+    // Rotate as auditd does, renaming audit.log to audit.log.1
+    fs::rename(dir / "audit.log", dir / "audit.log.1");
+    auto config = record("USYS_CONFIG", 102);
+    appendLines({config});
+
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{config, login2, login1}));
+    EXPECT_EQ(index.getLatest(1, 1), std::vector<std::string>{login2});
+
+    // The index of audit.log.1 was kept, so a record changed in place
+    // without changing the size is still returned from where it was.
+    auto changed = login2;
+    changed.replace(changed.find("USER_LOGIN"), 10, "USER_LOGIX");
+    {
+        std::fstream log{dir / "audit.log.1",
+                         std::ios::in | std::ios::out | std::ios::binary};
+        log.seekp(login1.size() + 1);
+        log << changed;
+    }
+
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{config, changed, login1}));
+
+    // While a new index of that file wouldn't find it
+    ALIndex newIndex{types, dir};
+    EXPECT_EQ(newIndex.getLatest(10),
+              (std::vector<std::string>{config, login1}));
+}
+
+TEST_F(ALIndexTest, RotatedAway)
+{
+    auto login1 = record("USER_LOGIN", 100);
+    appendLines({login1});
+
+    ALIndex index{types, dir};
+    EXPECT_EQ(index.getLatest(10), std::vector<std::string>{login1});
+
+    fs::remove(dir / "audit.log");
+    EXPECT_TRUE(index.getLatest(10).empty());
+
+    auto login2 = record("USER_LOGIN", 101);
+    appendLines({login2});
+    EXPECT_EQ(index.getLatest(10), std::vector<std::string>{login2});
+}
+
+TEST_F(ALIndexTest, Truncated)
+{
+    auto login1 = record("USER_LOGIN", 100, "before the truncation");
+    auto login2 = record("USER_LOGIN", 101);
+    appendLines({login1, login2});
+
+    ALIndex index{types, dir};
+    EXPECT_EQ(index.getLatest(10),
+              (std::vector<std::string>{login2, login1}));
+
+    // Smaller than what was indexed, so it is indexed again
+    fs::resize_file(dir / "audit.log", 0);
+    auto login3 = record("USER_LOGIN", 102);
+    appendLines({login3});
+
+    EXPECT_EQ(index.getLatest(10), std::vector<std::string>{login3});
+}
+
+TEST_F(ALIndexTest, GetRange)
+{
+    auto login1 = record("USER_LOGIN", 100);
+    auto login2 = record("USER_LOGIN", 110);
+    auto config1 = record("USYS_CONFIG", 110);
+    auto login3 = record("USER_LOGIN", 120);
+    auto config2 = record("USYS_CONFIG", 130);
+    appendLines({login1, login2}, "audit.log.2");
+    appendLines({config1, login3}, "audit.log.1");
+    appendLines({config2});
+
+    ALIndex index{types, dir};
+
+    // Both ends are included
+    EXPECT_EQ(index.getRange(110, 120),
+              (std::vector<std::string>{login3, config1, login2}));
+    EXPECT_EQ(index.getRange(0, UINT64_MAX),
+              (std::vector<std::string>{config2, login3, config1, login2,
+                                        login1}));
+    EXPECT_EQ(index.getRange(101, 109), std::vector<std::string>{});
+    EXPECT_EQ(index.getRange(130, 130), std::vector<std::string>{config2});
+    EXPECT_EQ(index.getRange(131, 200), std::vector<std::string>{});
+    EXPECT_EQ(index.getRange(0, 99), std::vector<std::string>{});
+    EXPECT_EQ(index.getRange(0, 100), std::vector<std::string>{login1});
+    EXPECT_TRUE(index.getRange(120, 110).empty());
+}
@@ -0,0 +1,150 @@
+#include "phosphor-auditlog/alog_integrity.hpp"
+
+#include <libaudit.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::auditlog;
+using namespace std::chrono_literals;
+
+/** @class TestLogger
+ *  @brief An IntegrityLogger with a clock the test sets, which keeps the
+ *         logs instead of creating them.
+ */
+class TestLogger : public IntegrityLogger
+{
+  public:
+    Clock::time_point now() const override
+    {
+        return time;
+    }
+
+    void createLog(const std::string& record, size_t suppressed) override
+    {
+        logs.emplace_back(record, suppressed);
+    }
+
+    Clock::time_point time = Clock::time_point{} + 24h;
+    std::vector<std::pair<std::string, size_t>> logs;
+};
+
+class IntegrityLoggerTest : public ::testing::Test
+{
+  protected:
+    static std::string record(size_t i)
+    {
+        return "type=INTEGRITY_DATA msg=audit(1700000000.000:" +
+               std::to_string(i) + "): file=/usr/bin/x";
+    }
+
+    /** @brief Handles count records, starting from serial first */
+    void handle(size_t first, size_t count)
+    {
+        for (auto i = first; i < first + count; i++)
+        {
+            logger.handleRecord(AUDIT_INTEGRITY_DATA, record(i));
+        }
+    }
+
+    TestLogger logger;
+};
+
+TEST_F(IntegrityLoggerTest, OtherRecords)
+{
+    logger.handleRecord(AUDIT_USER_LOGIN, record(1));
+    logger.handleRecord(AUDIT_INTEGRITY_FIRST_MSG - 1, record(2));
+    logger.handleRecord(AUDIT_INTEGRITY_LAST_MSG + 1, record(3));
+
+    EXPECT_TRUE(logger.logs.empty());
+    EXPECT_EQ(logger.flush(), -1);
+
+    logger.handleRecord(AUDIT_INTEGRITY_FIRST_MSG, record(4));
+    logger.handleRecord(AUDIT_INTEGRITY_LAST_MSG, record(5));
+    EXPECT_EQ(logger.logs.size(), 2);
+}
+
+TEST_F(IntegrityLoggerTest, Limit)
+{
+    handle(1, IntegrityLogger::maxLogs);
+    ASSERT_EQ(logger.logs.size(), IntegrityLogger::maxLogs);
+    EXPECT_EQ(logger.logs.back(),
+              std::make_pair(record(IntegrityLogger::maxLogs), size_t{0}));
+    EXPECT_EQ(logger.flush(), -1);
+
+    // The rest of the window is only counted
+    logger.time += 10s;
+    handle(100, 5);
+    EXPECT_EQ(logger.logs.size(), IntegrityLogger::maxLogs);
+
+    // Until the window ends
+    EXPECT_EQ(logger.flush(), 50000);
+    logger.time += 49999ms + 500us;
+    EXPECT_EQ(logger.flush(), 1);
+    EXPECT_EQ(logger.logs.size(), IntegrityLogger::maxLogs);
+
+    logger.time += 500us;
+    EXPECT_EQ(logger.flush(), -1);
+    ASSERT_EQ(logger.logs.size(), IntegrityLogger::maxLogs + 1);
+    EXPECT_EQ(logger.logs.back(), std::make_pair(record(104), size_t{5}));
+
+    // Nothing left to report
+    EXPECT_EQ(logger.flush(true), -1);
+    EXPECT_EQ(logger.logs.size(), IntegrityLogger::maxLogs + 1);
+}
+
+TEST_F(IntegrityLoggerTest, ReportCountsInNextWindow)
+{
+    handle(1, IntegrityLogger::maxLogs + 3);
+
+    // A record after the window ends reports the suppressed ones first,
+    // without waiting on flush()
+    logger.time += IntegrityLogger::window;
+    handle(100, IntegrityLogger::maxLogs);
+
+    ASSERT_EQ(logger.logs.size(), IntegrityLogger::maxLogs * 2);
+    EXPECT_EQ(logger.logs[IntegrityLogger::maxLogs],
+              std::make_pair(record(IntegrityLogger::maxLogs + 3), size_t{3}));
+
+    // The report was one of the logs of the new window
+    EXPECT_EQ(logger.logs.back(),
+              std::make_pair(record(100 + IntegrityLogger::maxLogs - 2),
+                             size_t{0}));
+    EXPECT_EQ(logger.flush(), IntegrityLogger::window / 1ms);
+
+    logger.time += IntegrityLogger::window;
+    EXPECT_EQ(logger.flush(), -1);
+    EXPECT_EQ(logger.logs.back(),
+              std::make_pair(record(100 + IntegrityLogger::maxLogs - 1),
+                             size_t{1}));
+}
+
+TEST_F(IntegrityLoggerTest, FlushStartsWindow)
+{
+    handle(1, IntegrityLogger::maxLogs + 1);
+    logger.time += IntegrityLogger::window;
+    EXPECT_EQ(logger.flush(), -1);
+    ASSERT_EQ(logger.logs.size(), IntegrityLogger::maxLogs + 1);
+
+    // The report counts against the window flush() started
+    logger.time += 1s;
+    handle(100, IntegrityLogger::maxLogs);
+    EXPECT_EQ(logger.logs.size(), IntegrityLogger::maxLogs * 2);
+    EXPECT_EQ(logger.flush(), 59000);
+}
+
+TEST_F(IntegrityLoggerTest, FinalFlush)
+{
+    handle(1, IntegrityLogger::maxLogs + 2);
+
+    // Reported before the window ends, as the plugin is exiting
+    logger.time += 1s;
+    EXPECT_EQ(logger.flush(true), -1);
+    ASSERT_EQ(logger.logs.size(), IntegrityLogger::maxLogs + 1);
+    EXPECT_EQ(logger.logs.back(),
+              std::make_pair(record(IntegrityLogger::maxLogs + 2), size_t{2}));
+}
@@ -0,0 +1,190 @@
+#include "phosphor-auditlog/alog_ring.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <format>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::auditlog;
+
+class ALRingTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        name = std::format("/alog_ring_test-{}", getpid());
+        shm_unlink(name.c_str());
+    }
+
+    void TearDown() override
+    {
+        shm_unlink(name.c_str());
+    }
+
+    static std::string key(size_t i)
+    {
+        return ALRing::recordKey("USER_LOGIN",
+                                 std::format("1700000000.000:{}", i));
+    }
+
+    static std::string entry(size_t i)
+    {
+        return std::format("{{\"ID\":{}}}", i);
+    }
+
+    std::string name;
+};
+
+TEST_F(ALRingTest, PushFind)
+{
+    // Nothing to open until the writer creates it
+    EXPECT_EQ(ALRing::open(name), nullptr);
+
+    auto writer = ALRing::create(name);
+    ASSERT_NE(writer, nullptr);
+    auto reader = ALRing::open(name);
+    ASSERT_NE(reader, nullptr);
+
+    std::string found;
+    uint64_t position = 0;
+    EXPECT_FALSE(reader->find(key(1), found, position));
+
+    for (size_t i = 1; i <= 10; i++)
+    {
+        writer->push(key(i), entry(i));
+    }
+
+    for (size_t i = 1; i <= 10; i++)
+    {
+        position = 0;
+        ASSERT_TRUE(reader->find(key(i), found, position));
+        EXPECT_EQ(found, entry(i));
+        EXPECT_EQ(position, i);
+    }
+
+    position = 0;
+    EXPECT_FALSE(reader->find(key(11), found, position));
+
+    // Creating it again keeps the entries
+    writer = ALRing::create(name);
+    ASSERT_NE(writer, nullptr);
+    position = 0;
+    EXPECT_TRUE(writer->find(key(5), found, position));
+}
+
+TEST_F(ALRingTest, Wraparound)
+{
+    auto ring = ALRing::create(name);
+    ASSERT_NE(ring, nullptr);
+
+    size_t total = ALRing::slotCount * 2 + 10;
+    for (size_t i = 1; i <= total; i++)
+    {
+        ring->push(key(i), entry(i));
+    }
+
+    std::string found;
+    uint64_t position = 0;
+
+    // Only the newest slotCount entries are left
+    for (auto i : {total, total - ALRing::slotCount + 1})
+    {
+        position = 0;
+        ASSERT_TRUE(ring->find(key(i), found, position)) << i;
+        EXPECT_EQ(found, entry(i));
+        EXPECT_EQ(position, i);
+    }
+
+    for (auto i : {size_t{1}, size_t{10}, total - ALRing::slotCount})
+    {
+        position = 0;
+        EXPECT_FALSE(ring->find(key(i), found, position)) << i;
+    }
+}
+
+TEST_F(ALRingTest, Oversized)
+{
+    auto ring = ALRing::create(name);
+    ASSERT_NE(ring, nullptr);
+
+    ring->push(key(1), entry(1));
+    ring->push(key(2), std::string(ALRing::slotSize, 'x'));
+    ring->push(key(3), entry(3));
+
+    // Dropped without taking a slot
+    std::string found;
+    uint64_t position = 0;
+    EXPECT_FALSE(ring->find(key(2), found, position));
+
+    position = 0;
+    ASSERT_TRUE(ring->find(key(3), found, position));
+    EXPECT_EQ(position, 2);
+
+    // Just small enough still fits
+    auto fits = ALRing::slotSize - key(4).size() - 64;
+    ring->push(key(4), std::string(fits, 'y'));
+    position = 0;
+    ASSERT_TRUE(ring->find(key(4), found, position));
+    EXPECT_EQ(found, std::string(fits, 'y'));
+}
+
+TEST_F(ALRingTest, FindFromPosition)
+{
+    auto ring = ALRing::create(name);
+    ASSERT_NE(ring, nullptr);
+
+    // The same key twice, as after the audit log serials start over
+    ring->push(key(1), entry(1));
+    ring->push(key(2), entry(2));
+    ring->push(key(1), "again");
+    ring->push(key(3), entry(3));
+
+    std::string found;
+    uint64_t position = 0;
+    ASSERT_TRUE(ring->find(key(1), found, position));
+    EXPECT_EQ(found, "again");
+    EXPECT_EQ(position, 3);
+
+    // Continues with the older entries
+    ASSERT_TRUE(ring->find(key(1), found, position));
+    EXPECT_EQ(found, entry(1));
+    EXPECT_EQ(position, 1);
+
+    EXPECT_FALSE(ring->find(key(1), found, position));
+
+    // A newer key than the position isn't found
+    position = 2;
+    EXPECT_FALSE(ring->find(key(3), found, position));
+
+    // A position past the newest starts from the newest
+    position = 100;
+    ASSERT_TRUE(ring->find(key(3), found, position));
+    EXPECT_EQ(position, 4);
+}
+
+TEST_F(ALRingTest, RecordKey)
+{
+    EXPECT_EQ(ALRing::recordKey("USER_LOGIN", "1700000000.123:42"),
+              "USER_LOGIN 1700000000.123:42");
+
+    EXPECT_EQ(ALRing::recordKey(
+                  "type=USER_LOGIN msg=audit(1700000000.123:42): pid=1 uid=0"),
+              "USER_LOGIN 1700000000.123:42");
+
+    EXPECT_EQ(ALRing::recordKey("node=bmc type=INTEGRITY_DATA "
+                                "msg=audit(1700000000.123:42): pid=1"),
+              "INTEGRITY_DATA 1700000000.123:42");
+
+    // Not valid
+    EXPECT_EQ(ALRing::recordKey(""), "");
+    EXPECT_EQ(ALRing::recordKey("node=bmc"), "");
+    EXPECT_EQ(ALRing::recordKey("msg=audit(1700000000.123:42): pid=1"), "");
+    EXPECT_EQ(ALRing::recordKey("type=USER_LOGIN pid=1"), "");
+    EXPECT_EQ(ALRing::recordKey("type=USER_LOGIN msg=audit(1700000000.123:42"),
+              "");
+    EXPECT_EQ(ALRing::recordKey("type=USER) msg=audit(1700000000.123:42)"),
+              "");
+}
@@ -0,0 +1,263 @@
+#include "config.h"
+
+#include "elog_serialize.hpp"
+#include "journal_sync.hpp"
+#include "log_manager.hpp"
+#include "paths.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+namespace phosphor
+{
+namespace logging
+{
+namespace internal
+{
+
+namespace fs = std::filesystem;
+
+/** @class FakeJournalSync
+ *  @brief A journal syncer the test completes, which calls back from the
+ *         event loop the same as JournalSync.
+ */
+class FakeJournalSync : public JournalSyncBase
+{
+  public:
+    FakeJournalSync() : event(sdeventplus::Event::get_default()) {}
+
+    void start(Callback callback) override
+    {
+        ASSERT_FALSE(_inProgress);
+        _callback = std::move(callback);
+        _inProgress = true;
+        starts++;
+    }
+
+    bool inProgress() const override
+    {
+        return _inProgress;
+    }
+
+    /** @brief Completes the sync in progress from a deferred event */
+    void complete()
+    {
+        ASSERT_TRUE(_inProgress);
+        done = std::make_unique<sdeventplus::source::Defer>(
+            event, [this](auto& /*source*/) { finish(); });
+    }
+
+    /** @brief Completes the sync in progress after the delay, as
+     *         JournalSync does when journald doesn't answer.
+     */
+    void timeOut(std::chrono::milliseconds delay)
+    {
+        ASSERT_TRUE(_inProgress);
+        timer = std::make_unique<
+            sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+            event, [this](auto& /*timer*/) { finish(); });
+        timer->restartOnce(delay);
+    }
+
+    size_t starts = 0;
+
+  private:
+    void finish()
+    {
+        done.reset();
+        _inProgress = false;
+        auto callback = std::move(_callback);
+        callback();
+    }
+
+    sdeventplus::Event event;
+    Callback _callback;
+    bool _inProgress = false;
+    std::unique_ptr<sdeventplus::source::Defer> done;
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        timer;
+};
+
+class TestCommit : public testing::Test
+{
+  public:
+    TestCommit() :
+        bus(sdbusplus::bus::new_default()),
+        event(sdeventplus::Event::get_default()), sync(new FakeJournalSync),
+        manager(bus, "/xyz/openbmc_test/commit",
+                std::unique_ptr<JournalSyncBase>(sync))
+    {
+        fs::create_directories(paths::error());
+    }
+
+    /** @brief Runs the event loop until the predicate is true, or until
+     *         the timeout.
+     */
+    template <typename Pred>
+    bool runUntil(Pred pred,
+                  std::chrono::milliseconds timeout = std::chrono::seconds(10))
+    {
+        auto end = std::chrono::steady_clock::now() + timeout;
+        while (!pred() && (std::chrono::steady_clock::now() < end))
+        {
+            event.run(std::chrono::milliseconds(10));
+        }
+        return pred();
+    }
+
+    /** @brief Runs whatever is ready in the event loop */
+    void runPending()
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            event.run(std::chrono::milliseconds(1));
+        }
+    }
+
+    sdbusplus::bus_t bus;
+    sdeventplus::Event event;
+    FakeJournalSync* sync;
+    Manager manager;
+};
+
+TEST_F(TestCommit, CreatedAfterSync)
+{
+    auto id = manager.commitWithLvl(1, "test.Error", 3);
+
+    // The ID is handed out, but the entry waits on the sync
+    EXPECT_EQ(id, manager.lastEntryID());
+    EXPECT_EQ(sync->starts, 1);
+    EXPECT_FALSE(manager.entries.contains(id));
+
+    runPending();
+    EXPECT_FALSE(manager.entries.contains(id));
+
+    sync->complete();
+    ASSERT_TRUE(runUntil([&]() { return manager.entries.contains(id); }));
+    EXPECT_EQ(manager.entries.at(id)->message(), "test.Error");
+    EXPECT_EQ(manager.entries.at(id)->severity(), Entry::Level::Error);
+    EXPECT_FALSE(sync->inProgress());
+}
+
+TEST_F(TestCommit, CommitDuringSync)
+{
+    auto first = manager.commitWithLvl(1, "test.First", 3);
+    auto second = manager.commitWithLvl(2, "test.Second", 3);
+    auto third = manager.commitWithLvl(3, "test.Third", 3);
+
+    EXPECT_EQ(second, first + 1);
+    EXPECT_EQ(third, first + 2);
+
+    // The later commits wait for a sync of their own
+    EXPECT_EQ(sync->starts, 1);
+
+    sync->complete();
+    ASSERT_TRUE(runUntil([&]() { return manager.entries.contains(first); }));
+    EXPECT_FALSE(manager.entries.contains(second));
+    EXPECT_FALSE(manager.entries.contains(third));
+
+    // Which was started as soon as the first finished
+    EXPECT_EQ(sync->starts, 2);
+    EXPECT_TRUE(sync->inProgress());
+
+    sync->complete();
+    ASSERT_TRUE(runUntil([&]() {
+        return manager.entries.contains(second) &&
+               manager.entries.contains(third);
+    }));
+    EXPECT_EQ(manager.entries.at(third)->message(), "test.Third");
+    EXPECT_EQ(sync->starts, 2);
+    EXPECT_FALSE(sync->inProgress());
+}
+
+TEST_F(TestCommit, TimedOutSync)
+{
+    auto id = manager.commitWithLvl(1, "test.Error", 3);
+
+    sync->timeOut(std::chrono::milliseconds(50));
+    runPending();
+    EXPECT_FALSE(manager.entries.contains(id));
+
+    // The entry is still created with the ID it was given
+    ASSERT_TRUE(runUntil([&]() { return manager.entries.contains(id); }));
+    EXPECT_EQ(manager.entries.at(id)->message(), "test.Error");
+}
+
+TEST_F(TestCommit, FailedSync)
+{
+    // Without journald to answer, the real syncer gives up and calls back.
+    Manager realManager{bus, "/xyz/openbmc_test/commit/real",
+                        std::make_unique<JournalSync>(bus)};
+    auto id = realManager.commitWithLvl(1, "test.Error", 3);
+
+    ASSERT_TRUE(runUntil([&]() { return realManager.entries.contains(id); },
+                         JournalSync::timeout + std::chrono::seconds(5)));
+    EXPECT_EQ(realManager.entries.at(id)->message(), "test.Error");
+}
+
+TEST_F(TestCommit, EraseAllWithPendingCommits)
+{
+    auto existing = manager.create("test.Existing", Severity::Error, {});
+    auto existingId = std::stoul(existing.filename());
+
+    auto syncing = manager.commitWithLvl(1, "test.Syncing", 3);
+    auto waiting = manager.commitWithLvl(2, "test.Waiting", 3);
+    ASSERT_EQ(waiting, syncing + 1);
+
+    EXPECT_EQ(manager.eraseAll(), 1);
+    EXPECT_FALSE(manager.entries.contains(existingId));
+
+    // The IDs already handed out aren't reused
+    EXPECT_EQ(manager.lastEntryID(), waiting);
+    auto next = manager.create("test.Next", Severity::Error, {});
+    EXPECT_EQ(std::stoul(next.filename()), waiting + 1);
+
+    sync->complete();
+    ASSERT_TRUE(runUntil([&]() { return manager.entries.contains(syncing); }));
+    sync->complete();
+    ASSERT_TRUE(runUntil([&]() { return manager.entries.contains(waiting); }));
+
+    EXPECT_EQ(manager.entries.at(syncing)->message(), "test.Syncing");
+    EXPECT_EQ(manager.entries.at(waiting)->message(), "test.Waiting");
+    EXPECT_EQ(manager.entries.at(waiting + 1)->message(), "test.Next");
+}
+
+TEST_F(TestCommit, FailedCommitKeepsOthers)
+{
+    if (ENTRY_STORE_JOURNAL)
+    {
+        GTEST_SKIP() << "Entries aren't written to their own files";
+    }
+
+    auto first = manager.commitWithLvl(1, "test.First", 3);
+    auto bad = manager.commitWithLvl(2, "test.Bad", 3);
+    auto good = manager.commitWithLvl(3, "test.Good", 3);
+
+    // A directory in the way makes storing the bad entry throw.
+    auto badPath = getEntrySerializePath(bad);
+    fs::remove_all(badPath);
+    fs::create_directories(badPath / "blocker");
+
+    sync->complete();
+    ASSERT_TRUE(runUntil([&]() { return manager.entries.contains(first); }));
+
+    // The bad and good commits are finished together.
+    sync->complete();
+    EXPECT_TRUE(runUntil([&]() { return manager.entries.contains(good); }));
+    EXPECT_FALSE(manager.entries.contains(bad));
+    EXPECT_EQ(manager.entries.at(good)->message(), "test.Good");
+
+    fs::remove_all(badPath);
+}
+
+} // namespace internal
+} // namespace logging
+} // namespace phosphor
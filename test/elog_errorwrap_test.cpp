@@ -1,5 +1,9 @@
 #include "elog_errorwrap_test.hpp"
 
+#include <sys/resource.h>
+
+#include <csignal>
+
 namespace phosphor
 {
 namespace logging
@@ -26,6 +30,124 @@ TEST_F(TestLogManager, logCap)
     EXPECT_EQ(ERROR_CAP, manager.getRealErrSize());
 }
 
+TEST_F(TestLogManager, batchCap)
+{
+    std::vector<BatchEvent> events;
+    for (size_t i = 0; i < ERROR_INFO_CAP + 5; i++)
+    {
+        events.emplace_back("FOO", Severity::Informational,
+                            std::map<std::string, std::string>{
+                                {"INDEX", std::to_string(i)}},
+                            FFDCEntries{});
+    }
+    events.emplace_back("BAR", Severity::Error,
+                        std::map<std::string, std::string>{}, FFDCEntries{});
+
+    auto before = manager.lastEntryID();
+    auto paths = manager.createBatch(std::move(events));
+
+    // Only the newest ones fit under the cap, and only they get a path
+    ASSERT_EQ(paths.size(), ERROR_INFO_CAP + 1);
+    EXPECT_EQ(ERROR_INFO_CAP, manager.getInfoErrSize());
+    EXPECT_EQ(1, manager.getRealErrSize());
+    EXPECT_EQ(manager.lastEntryID(), before + ERROR_INFO_CAP + 1);
+
+    for (const auto& path : paths)
+    {
+        EXPECT_TRUE(manager.entries.contains(std::stoul(path.filename())));
+    }
+
+    auto& first = manager.entries.at(before + 1);
+    EXPECT_EQ(paths.front().str,
+              std::string(OBJ_ENTRY) + '/' + std::to_string(before + 1));
+    EXPECT_EQ(first->additionalData().at("INDEX"), "5");
+
+    auto& last = manager.entries.at(manager.lastEntryID());
+    EXPECT_EQ(last->message(), "BAR");
+
+    auto& lastInfo = manager.entries.at(manager.lastEntryID() - 1);
+    EXPECT_EQ(lastInfo->additionalData().at("INDEX"),
+              std::to_string(ERROR_INFO_CAP + 4));
+}
+
+TEST_F(TestLogManager, failedStoreNotCounted)
+{
+    if (ENTRY_STORE_JOURNAL)
+    {
+        GTEST_SKIP() << "Entries aren't written to their own files";
+    }
+
+    auto realErrs = manager.getRealErrSize();
+    auto id = manager.lastEntryID() + 1;
+
+    // A directory in the way makes storing the entry throw.
+    auto path = getEntrySerializePath(id);
+    fs::remove_all(path);
+    fs::create_directories(path / "blocker");
+
+    EXPECT_ANY_THROW(manager.create("FOO", Severity::Error, {}));
+    EXPECT_FALSE(manager.entries.contains(id));
+    EXPECT_EQ(manager.getRealErrSize(), realErrs);
+
+    fs::remove_all(path);
+}
+
+TEST_F(TestLogManager, entryFilePath)
+{
+    auto path = manager.create("FOO", Severity::Error, {});
+    auto id = std::stoul(path.filename());
+
+    // Only a file per entry has a path to show
+    if constexpr (ENTRY_STORE_JOURNAL)
+    {
+        EXPECT_TRUE(manager.entries.at(id)->path().empty());
+    }
+    else
+    {
+        EXPECT_EQ(manager.entries.at(id)->path(),
+                  getEntrySerializePath(id).string());
+    }
+}
+
+TEST_F(TestLogManager, journalWriteFailure)
+{
+    if constexpr (!ENTRY_STORE_JOURNAL)
+    {
+        GTEST_SKIP() << "Entries aren't stored in the journal";
+    }
+
+    manager.create("FOO", Severity::Error, {});
+
+    // Make every write to the journal fail
+    auto handler = signal(SIGXFSZ, SIG_IGN);
+    rlimit oldLimit{};
+    getrlimit(RLIMIT_FSIZE, &oldLimit);
+    rlimit limit{1, oldLimit.rlim_max};
+    setrlimit(RLIMIT_FSIZE, &limit);
+
+    // The entries are still created, changed, and erased on D-Bus
+    sdbusplus::message::object_path path;
+    EXPECT_NO_THROW(path = manager.create("BAR", Severity::Error, {}));
+    auto id = std::stoul(path.filename());
+    ASSERT_TRUE(manager.entries.contains(id));
+
+    EXPECT_NO_THROW(manager.entries.at(id)->resolved(true));
+
+    std::vector<BatchEvent> events;
+    events.emplace_back("BATCH", Severity::Error,
+                        std::map<std::string, std::string>{}, FFDCEntries{});
+    EXPECT_NO_THROW(manager.createBatch(std::move(events)));
+    EXPECT_TRUE(manager.entries.contains(manager.lastEntryID()));
+
+    EXPECT_NO_THROW(manager.erase(id));
+    EXPECT_FALSE(manager.entries.contains(id));
+
+    EXPECT_NO_THROW(manager.eraseAll());
+
+    setrlimit(RLIMIT_FSIZE, &oldLimit);
+    signal(SIGXFSZ, handler);
+}
+
 } // namespace internal
 } // namespace logging
 } // namespace phosphor
@@ -0,0 +1,227 @@
+#include "elog_entry.hpp"
+#include "elog_journal.hpp"
+#include "elog_serialize.hpp"
+#include "log_manager.hpp"
+
+#include <sdbusplus/test/sdbus_mock.hpp>
+
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+using namespace phosphor::logging;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+sdbusplus::SdBusMock sdbusMock;
+sdbusplus::bus_t bus = sdbusplus::get_mocked_new(&sdbusMock);
+internal::Manager manager(bus, OBJ_INTERNAL);
+
+const fs::path benchDir{"/tmp/elog_journal_benchmark"};
+
+/**
+ * @brief Creates the number of entries passed in.
+ */
+std::vector<std::unique_ptr<Entry>> makeEntries(size_t count)
+{
+    std::vector<std::unique_ptr<Entry>> entries;
+
+    for (uint32_t id = 1; id <= count; id++)
+    {
+        std::map<std::string, std::string> data{
+            {"CALLOUT_INVENTORY_PATH",
+             "/xyz/openbmc_project/inventory/system/chassis/motherboard"},
+            {"_PID", "1234"},
+            {"ID", std::to_string(id)}};
+
+        entries.push_back(std::make_unique<Entry>(
+            bus, std::string(OBJ_ENTRY) + '/' + std::to_string(id), id,
+            1000 + id, Entry::Level::Error,
+            "xyz.openbmc_project.Common.Error.InternalFailure", std::move(data),
+            AssociationList{}, "fw-1.0", getEntrySerializePath(id, benchDir),
+            manager));
+    }
+
+    return entries;
+}
+
+EntryJournal::EntryFactory factory()
+{
+    return [](uint32_t id) {
+        return std::make_unique<Entry>(
+            bus, std::string(OBJ_ENTRY) + '/' + std::to_string(id), id,
+            manager);
+    };
+}
+
+void resetDir()
+{
+    fs::remove_all(benchDir);
+    fs::create_directories(benchDir);
+}
+
+} // namespace
+
+/**
+ * @brief Persists new entries, one file each.
+ */
+static void createFiles(benchmark::State& state)
+{
+    auto entries = makeEntries(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        resetDir();
+        state.ResumeTiming();
+
+        for (const auto& e : entries)
+        {
+            serialize(*e, benchDir);
+        }
+    }
+
+    fs::remove_all(benchDir);
+}
+
+/**
+ * @brief Persists new entries to the journal.
+ */
+static void createJournal(benchmark::State& state)
+{
+    auto entries = makeEntries(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        resetDir();
+        state.ResumeTiming();
+
+        EntryJournal journal{benchDir};
+        for (const auto& e : entries)
+        {
+            journal.add(*e);
+        }
+    }
+
+    fs::remove_all(benchDir);
+}
+
+/**
+ * @brief Persists resolving every entry, one file each.
+ */
+static void resolveFiles(benchmark::State& state)
+{
+    auto entries = makeEntries(state.range(0));
+    resetDir();
+
+    for (const auto& e : entries)
+    {
+        serialize(*e, benchDir);
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& e : entries)
+        {
+            e->resolution("Replace the part", true);
+            serialize(*e, benchDir);
+        }
+    }
+
+    fs::remove_all(benchDir);
+}
+
+/**
+ * @brief Persists resolving every entry to the journal.
+ */
+static void resolveJournal(benchmark::State& state)
+{
+    auto entries = makeEntries(state.range(0));
+    resetDir();
+
+    EntryJournal journal{benchDir};
+    for (const auto& e : entries)
+    {
+        journal.add(*e);
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& e : entries)
+        {
+            e->resolution("Replace the part", true);
+            journal.update(*e);
+        }
+    }
+
+    state.counters["compactions"] = journal.getStats().compactions;
+    fs::remove_all(benchDir);
+}
+
+/**
+ * @brief Restores entries stored one file each, the way
+ *        Manager::restore() does.
+ */
+static void restoreFiles(benchmark::State& state)
+{
+    resetDir();
+    for (const auto& e : makeEntries(state.range(0)))
+    {
+        serialize(*e, benchDir);
+    }
+
+    for (auto _ : state)
+    {
+        std::map<uint32_t, std::unique_ptr<Entry>> restored;
+        for (const auto& file : fs::directory_iterator(benchDir))
+        {
+            auto id = std::stol(file.path().filename().c_str());
+            auto e = factory()(id);
+            if (deserialize(file.path(), *e))
+            {
+                restored.emplace(id, std::move(e));
+            }
+        }
+        benchmark::DoNotOptimize(restored.size());
+    }
+
+    fs::remove_all(benchDir);
+}
+
+/**
+ * @brief Restores entries from the journal, after one update per entry.
+ */
+static void restoreJournal(benchmark::State& state)
+{
+    resetDir();
+    {
+        EntryJournal journal{benchDir};
+        for (const auto& e : makeEntries(state.range(0)))
+        {
+            journal.add(*e);
+            e->resolution("Replace the part", true);
+            journal.update(*e);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        EntryJournal journal{benchDir};
+        auto restored = journal.restore(factory());
+        benchmark::DoNotOptimize(restored.size());
+    }
+
+    fs::remove_all(benchDir);
+}
+
+BENCHMARK(createFiles)->Arg(ERROR_CAP)->Unit(benchmark::kMillisecond);
+BENCHMARK(createJournal)->Arg(ERROR_CAP)->Unit(benchmark::kMillisecond);
+BENCHMARK(resolveFiles)->Arg(ERROR_CAP)->Unit(benchmark::kMillisecond);
+BENCHMARK(resolveJournal)->Arg(ERROR_CAP)->Unit(benchmark::kMillisecond);
+BENCHMARK(restoreFiles)->Arg(ERROR_CAP)->Unit(benchmark::kMillisecond);
+BENCHMARK(restoreJournal)->Arg(ERROR_CAP)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,307 @@
+#include "elog_entry.hpp"
+#include "elog_journal.hpp"
+#include "elog_serialize.hpp"
+#include "serialization_tests.hpp"
+
+#include <sys/resource.h>
+
+#include <csignal>
+#include <fstream>
+
+namespace phosphor
+{
+namespace logging
+{
+namespace test
+{
+
+namespace
+{
+
+std::unique_ptr<Entry> makeEntry(uint32_t id, const fs::path& dir)
+{
+    std::map<std::string, std::string> data{{"ID", std::to_string(id)},
+                                            {"KEY", "VALUE"}};
+    return std::make_unique<Entry>(
+        bus, std::string(OBJ_ENTRY) + '/' + std::to_string(id), id, 100 + id,
+        Entry::Level::Error, "test.Error", std::move(data),
+        AssociationList{}, "level42", getEntrySerializePath(id, dir),
+        manager);
+}
+
+EntryJournal::EntryFactory factory()
+{
+    return [](uint32_t id) {
+        return std::make_unique<Entry>(
+            bus, std::string(OBJ_ENTRY) + '/' + std::to_string(id), id,
+            manager);
+    };
+}
+
+} // namespace
+
+class TestJournal : public testing::Test
+{
+  public:
+    TestJournal()
+    {
+        char path[] = "/tmp/elog_journal_test.XXXXXX";
+        dir = mkdtemp(path);
+    }
+
+    ~TestJournal()
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+};
+
+TEST_F(TestJournal, AddUpdateRemove)
+{
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir};
+
+        auto e1 = makeEntry(1, dir);
+        auto e2 = makeEntry(2, dir);
+        auto e3 = makeEntry(3, dir);
+        journal.add(*e1);
+        journal.add(*e2);
+        journal.add(*e3);
+
+        e2->resolution("replace part", true);
+        e2->updateTimestamp(500, true);
+        e2->severity(Entry::Level::Warning, true);
+        journal.update(*e2);
+
+        journal.remove(3);
+
+        auto stats = journal.getStats();
+        EXPECT_EQ(stats.liveEntries, 2);
+        EXPECT_EQ(stats.records, 5);
+    }
+
+    EntryJournal journal{journalDir};
+    auto entries = journal.restore(factory());
+    ASSERT_EQ(entries.size(), 2);
+
+    const auto& e1 = entries.at(1);
+    EXPECT_EQ(e1->id(), 1);
+    EXPECT_EQ(e1->timestamp(), 101);
+    EXPECT_EQ(e1->message(), "test.Error");
+    EXPECT_EQ(e1->additionalData().at("ID"), "1");
+    EXPECT_EQ(e1->version(), "level42");
+    EXPECT_EQ(e1->severity(), Entry::Level::Error);
+
+    const auto& e2 = entries.at(2);
+    EXPECT_EQ(e2->resolution(), "replace part");
+    EXPECT_EQ(e2->updateTimestamp(), 500);
+    EXPECT_EQ(e2->severity(), Entry::Level::Warning);
+
+    EXPECT_FALSE(entries.contains(3));
+}
+
+TEST_F(TestJournal, AddBatch)
+{
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir};
+
+        auto e1 = makeEntry(1, dir);
+        journal.add(*e1);
+
+        std::vector<std::unique_ptr<Entry>> batch;
+        for (uint32_t id = 2; id <= 6; id++)
+        {
+            batch.push_back(makeEntry(id, dir));
+        }
+        journal.add(batch);
+
+        // An empty batch doesn't add anything
+        journal.add(std::vector<std::unique_ptr<Entry>>{});
+
+        journal.remove(3);
+
+        auto stats = journal.getStats();
+        EXPECT_EQ(stats.liveEntries, 5);
+        EXPECT_EQ(stats.records, 7);
+    }
+
+    EntryJournal journal{journalDir};
+    auto entries = journal.restore(factory());
+    ASSERT_EQ(entries.size(), 5);
+
+    EXPECT_EQ(entries.at(6)->timestamp(), 106);
+    EXPECT_EQ(entries.at(6)->additionalData().at("ID"), "6");
+    EXPECT_FALSE(entries.contains(3));
+}
+
+TEST_F(TestJournal, RemoveSet)
+{
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir};
+        for (uint32_t id = 1; id <= 5; id++)
+        {
+            journal.add(*makeEntry(id, dir));
+        }
+
+        journal.remove(std::set<uint32_t>{1, 3, 4});
+
+        // An empty set doesn't add anything
+        journal.remove(std::set<uint32_t>{});
+
+        auto stats = journal.getStats();
+        EXPECT_EQ(stats.liveEntries, 2);
+        EXPECT_EQ(stats.records, 8);
+    }
+
+    EntryJournal journal{journalDir};
+    auto entries = journal.restore(factory());
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_TRUE(entries.contains(2));
+    EXPECT_TRUE(entries.contains(5));
+}
+
+TEST_F(TestJournal, Compaction)
+{
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir};
+        auto e = makeEntry(7, dir);
+        journal.add(*e);
+
+        for (uint64_t i = 0; i < 500; i++)
+        {
+            e->updateTimestamp(i, true);
+            journal.update(*e);
+        }
+
+        auto stats = journal.getStats();
+        EXPECT_GE(stats.compactions, 1);
+        EXPECT_EQ(stats.segments, 1);
+        EXPECT_LT(stats.records, 200);
+    }
+
+    EntryJournal journal{journalDir};
+    auto entries = journal.restore(factory());
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries.at(7)->updateTimestamp(), 499);
+}
+
+TEST_F(TestJournal, Segments)
+{
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir, 512};
+        for (uint32_t id = 1; id <= 20; id++)
+        {
+            journal.add(*makeEntry(id, dir));
+        }
+        EXPECT_GT(journal.getStats().segments, 1);
+    }
+
+    EntryJournal journal{journalDir, 512};
+    auto entries = journal.restore(factory());
+    EXPECT_EQ(entries.size(), 20);
+    EXPECT_GT(journal.getStats().segments, 1);
+}
+
+TEST_F(TestJournal, TornRecord)
+{
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir};
+        journal.add(*makeEntry(1, dir));
+        journal.add(*makeEntry(2, dir));
+    }
+
+    // Simulate a partial write of a third record
+    auto segment = *fs::directory_iterator(journalDir);
+    auto size = fs::file_size(segment.path());
+    {
+        std::ofstream file{segment.path(), std::ios::binary | std::ios::app};
+        file.write("\x4E\x52\x4A\x45\x01\x00", 6);
+    }
+
+    {
+        EntryJournal journal{journalDir};
+        auto entries = journal.restore(factory());
+        EXPECT_EQ(entries.size(), 2);
+
+        // The partial record was dropped
+        EXPECT_EQ(fs::file_size(segment.path()), size);
+
+        journal.add(*makeEntry(3, dir));
+    }
+
+    EntryJournal journal{journalDir};
+    auto entries = journal.restore(factory());
+    EXPECT_EQ(entries.size(), 3);
+}
+
+TEST_F(TestJournal, FailedWrite)
+{
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir};
+        journal.add(*makeEntry(1, dir));
+
+        auto segment = *fs::directory_iterator(journalDir);
+        auto size = fs::file_size(segment.path());
+
+        // Limit the file size so only part of the next record is written
+        auto handler = signal(SIGXFSZ, SIG_IGN);
+        rlimit oldLimit{};
+        getrlimit(RLIMIT_FSIZE, &oldLimit);
+        rlimit limit{size + 8, oldLimit.rlim_max};
+        setrlimit(RLIMIT_FSIZE, &limit);
+
+        EXPECT_THROW(journal.add(*makeEntry(2, dir)), std::system_error);
+
+        setrlimit(RLIMIT_FSIZE, &oldLimit);
+        signal(SIGXFSZ, handler);
+
+        // The partial record was cut off
+        EXPECT_EQ(fs::file_size(segment.path()), size);
+
+        journal.add(*makeEntry(3, dir));
+    }
+
+    EntryJournal journal{journalDir};
+    auto entries = journal.restore(factory());
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_TRUE(entries.contains(1));
+    EXPECT_TRUE(entries.contains(3));
+}
+
+TEST_F(TestJournal, Migrate)
+{
+    auto fileDir = dir / "errors";
+    fs::create_directories(fileDir);
+
+    serialize(*makeEntry(4, fileDir), fileDir);
+    serialize(*makeEntry(5, fileDir), fileDir);
+
+    auto journalDir = dir / "journal";
+    {
+        EntryJournal journal{journalDir};
+        auto entries = journal.restore(factory());
+        EXPECT_TRUE(entries.empty());
+
+        EXPECT_EQ(journal.migrate(fileDir, factory(), entries), 2);
+        EXPECT_EQ(entries.size(), 2);
+        EXPECT_TRUE(fs::is_empty(fileDir));
+    }
+
+    EntryJournal journal{journalDir};
+    auto entries = journal.restore(factory());
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries.at(4)->additionalData().at("ID"), "4");
+    EXPECT_EQ(entries.at(5)->timestamp(), 105);
+}
+
+} // namespace test
+} // namespace logging
+} // namespace phosphor
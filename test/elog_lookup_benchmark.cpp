@@ -0,0 +1,118 @@
+#include "config.h"
+
+#include "log_manager.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace phosphor::logging;
+
+namespace
+{
+
+using MetaMap = std::map<std::string, std::vector<std::string>>;
+using LevelMap = std::map<std::string, level>;
+
+/**
+ * @brief Builds the std::maps that elog-lookup.cpp used to define, which
+ *        were built by static initialization on every startup.
+ */
+std::pair<MetaMap, LevelMap> buildMaps()
+{
+    MetaMap metaMap;
+    LevelMap levelMap;
+
+    for (const auto& [name, meta] : g_errMetaMap.entries)
+    {
+        std::vector<std::string> metaNames(meta.begin(), meta.end());
+        metaMap.emplace(name, std::move(metaNames));
+    }
+
+    for (const auto& [name, errLevel] : g_errLevelMap.entries)
+    {
+        levelMap.emplace(name, errLevel);
+    }
+
+    return {std::move(metaMap), std::move(levelMap)};
+}
+
+/**
+ * @brief The names looked up, as _commit() gets them: every error,
+ *        plus one that isn't there.
+ */
+std::vector<std::string> getNames()
+{
+    std::vector<std::string> names;
+    for (const auto& entry : g_errMetaMap.entries)
+    {
+        names.emplace_back(entry.first);
+    }
+    names.emplace_back("xyz.openbmc_project.Unknown.Error.NotThere");
+
+    return names;
+}
+
+} // namespace
+
+/**
+ * @brief The startup cost of the std::maps.  The generated tables have
+ *        none, as they are constant initialized.
+ */
+static void startupStdMap(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(buildMaps());
+    }
+
+    state.SetItemsProcessed(state.iterations() * g_errMetaMap.size());
+}
+
+/**
+ * @brief Looks up the level and metadata of each name in the std::maps.
+ */
+static void lookupStdMap(benchmark::State& state)
+{
+    auto [metaMap, levelMap] = buildMaps();
+    auto names = getNames();
+
+    for (auto _ : state)
+    {
+        for (const auto& name : names)
+        {
+            benchmark::DoNotOptimize(levelMap.find(name));
+            benchmark::DoNotOptimize(metaMap.find(name));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+/**
+ * @brief Looks up the level and metadata of each name in the generated
+ *        perfect hash tables.
+ */
+static void lookupPerfectHash(benchmark::State& state)
+{
+    auto names = getNames();
+
+    for (auto _ : state)
+    {
+        for (const auto& name : names)
+        {
+            benchmark::DoNotOptimize(g_errLevelMap.find(name));
+            benchmark::DoNotOptimize(g_errMetaMap.find(name));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK(startupStdMap)->Unit(benchmark::kMicrosecond);
+BENCHMARK(lookupStdMap);
+BENCHMARK(lookupPerfectHash);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,66 @@
+#include "callouts-gen.hpp"
+#include "log_manager.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::logging;
+
+TEST(ElogLookup, FindsEveryError)
+{
+    ASSERT_EQ(g_errMetaMap.size(), g_errLevelMap.size());
+
+    for (const auto& [name, meta] : g_errMetaMap.entries)
+    {
+        const auto* found = g_errMetaMap.find(name);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found, &meta);
+
+        EXPECT_NE(g_errLevelMap.find(name), nullptr);
+    }
+}
+
+TEST(ElogLookup, Values)
+{
+    const auto* meta = g_errMetaMap.find(
+        "example.xyz.openbmc_project.Example.Elog.TestErrorTwo");
+    ASSERT_NE(meta, nullptr);
+    ASSERT_EQ(meta->size(), 3);
+    EXPECT_EQ((*meta)[0], "DEV_ADDR");
+    EXPECT_EQ((*meta)[2], "DEV_NAME");
+
+    // The parents' metadata comes after the error's own
+    meta = g_errMetaMap.find("example.xyz.openbmc_project.Example.Bar.Bar");
+    ASSERT_NE(meta, nullptr);
+    EXPECT_EQ(meta->front(), "BAR_DATA");
+    EXPECT_EQ((*meta)[1], "FOO_DATA");
+
+    const auto* errLevel = g_errLevelMap.find(
+        "example.xyz.openbmc_project.Example.Elog.TestErrorOne");
+    ASSERT_NE(errLevel, nullptr);
+    EXPECT_EQ(*errLevel, level::INFO);
+}
+
+TEST(ElogLookup, Missing)
+{
+    EXPECT_EQ(g_errMetaMap.find(""), nullptr);
+    EXPECT_EQ(g_errMetaMap.find("xyz.openbmc_project.Not.Error.There"),
+              nullptr);
+    EXPECT_EQ(g_errLevelMap.find("example.xyz.openbmc_project.Example.Foo"),
+              nullptr);
+}
+
+TEST(ElogLookup, Callouts)
+{
+    // Lookups work at compile time too
+    static_assert(callouts.find("/sys/devices/not/there") == nullptr);
+    static_assert(callouts.entries.empty() ||
+                  (callouts.find(callouts.entries.front().first) ==
+                   &callouts.entries.front().second));
+
+    for (const auto& [device, path] : callouts.entries)
+    {
+        const auto* found = callouts.find(device);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, path);
+    }
+}
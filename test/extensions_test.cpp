@@ -1,12 +1,29 @@
 #include "elog_entry.hpp"
 #include "extensions.hpp"
+#include "paths.hpp"
+#include "xyz/openbmc_project/Common/error.hpp"
 
 #include <sdbusplus/test/sdbus_mock.hpp>
 
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace phosphor::logging;
 
+namespace
+{
+
+// What the delete functions were called with.
+std::vector<uint32_t> deleted1;
+std::vector<uint32_t> deleted3;
+std::vector<std::set<uint32_t>> deletedAll;
+
+} // namespace
+
 void startup1(internal::Manager& /*manager*/) {}
 
 void startup2(internal::Manager& /*manager*/) {}
@@ -23,18 +40,31 @@ void create2(const std::string& /*message*/, uint32_t /*id*/,
              const AssociationEndpointsArg& /*assocs*/, const FFDCArg& /*ffdc*/)
 {}
 
-void deleteLog1(uint32_t /*id*/) {}
+void deleteLog1(uint32_t id)
+{
+    deleted1.push_back(id);
+}
 
 void deleteLog2(uint32_t /*id*/) {}
 
-void deleteProhibited1(uint32_t /*id*/, bool& prohibited)
+void deleteLog3(uint32_t id)
 {
-    prohibited = true;
+    deleted3.push_back(id);
 }
 
-void deleteProhibited2(uint32_t /*id*/, bool& prohibited)
+void deleteAll3(const std::set<uint32_t>& ids)
 {
-    prohibited = true;
+    deletedAll.push_back(ids);
+}
+
+void deleteProhibited1(uint32_t id, bool& prohibited)
+{
+    prohibited = (id == 5);
+}
+
+void deleteProhibited2(uint32_t id, bool& prohibited)
+{
+    prohibited = (id == 5);
 }
 
 void logIDWithHwIsolation1(std::vector<uint32_t>& logIDs)
@@ -58,6 +88,7 @@ REGISTER_EXTENSION_FUNCTION(logIDWithHwIsolation1)
 REGISTER_EXTENSION_FUNCTION(logIDWithHwIsolation2)
 REGISTER_EXTENSION_FUNCTION(deleteLog1)
 REGISTER_EXTENSION_FUNCTION(deleteLog2)
+REGISTER_EXTENSION_DELETE_FUNCTIONS(deleteLog3, deleteAll3)
 
 TEST(ExtensionsTest, FunctionCallTest)
 {
@@ -86,6 +117,13 @@ TEST(ExtensionsTest, FunctionCallTest)
         d(5);
     }
 
+    EXPECT_EQ(Extensions::getDeleteAllFunctions().size(), 1);
+    for (auto& d : Extensions::getDeleteAllFunctions())
+    {
+        d.remove(5);
+        d.removeAll({5, 6});
+    }
+
     EXPECT_EQ(Extensions::getDeleteProhibitedFunctions().size(), 2);
     for (auto& p : Extensions::getDeleteProhibitedFunctions())
     {
@@ -115,3 +153,111 @@ TEST(ExtensionsTest, FunctionCallTest)
 
     EXPECT_TRUE(Extensions::disableDefaultLogCaps());
 }
+
+class ExtensionsEraseTest : public ::testing::Test
+{
+  public:
+    ExtensionsEraseTest() :
+        bus(sdbusplus::get_mocked_new(&sdbusMock)), manager(bus, "testpath")
+    {
+        std::filesystem::create_directories(paths::error());
+
+        deleted1.clear();
+        deleted3.clear();
+        deletedAll.clear();
+
+        for (uint32_t id = 1; id <= 8; id++)
+        {
+            auto path = manager.create("test.Error", Severity::Error, {});
+            EXPECT_EQ(path.filename(), std::to_string(id));
+        }
+    }
+
+    ~ExtensionsEraseTest()
+    {
+        // Don't leave the entries kept for the restore of other tests.
+        for (uint32_t id = 1; id <= 8; id++)
+        {
+            std::filesystem::remove(paths::error() / std::to_string(id));
+        }
+    }
+
+    /** @brief Returns the IDs of the entries left */
+    static std::set<uint32_t> ids(const internal::Manager& manager)
+    {
+        std::set<uint32_t> result;
+        for (const auto& [id, entry] : manager.entries)
+        {
+            result.insert(id);
+        }
+        return result;
+    }
+
+    testing::NiceMock<sdbusplus::SdBusMock> sdbusMock;
+    sdbusplus::bus_t bus;
+    internal::Manager manager;
+};
+
+TEST_F(ExtensionsEraseTest, EraseAll)
+{
+    // 5 is prohibited from being deleted and 1 and 2 have hardware
+    // isolated, so they are kept instead of failing the DeleteAll.
+    EXPECT_EQ(manager.eraseAll(), 5);
+    EXPECT_EQ(ids(manager), (std::set<uint32_t>{1, 2, 5}));
+
+    // The extension with a delete all function is told once, and the
+    // others for each entry.
+    std::set<uint32_t> erased{3, 4, 6, 7, 8};
+    EXPECT_EQ(deletedAll, std::vector<std::set<uint32_t>>{erased});
+    EXPECT_TRUE(deleted3.empty());
+    EXPECT_EQ(deleted1, (std::vector<uint32_t>{3, 4, 6, 7, 8}));
+
+    // Nothing left that can be erased
+    deleted1.clear();
+    deletedAll.clear();
+    EXPECT_EQ(manager.eraseAll(), 0);
+    EXPECT_TRUE(deleted1.empty());
+    EXPECT_TRUE(deletedAll.empty());
+}
+
+TEST_F(ExtensionsEraseTest, EraseAllRemovesStored)
+{
+    manager.eraseAll();
+
+    // Only the entries kept are restored, whether they are stored in
+    // files or in the entry journal.
+    internal::Manager restored(bus, "testpath2");
+    restored.restore();
+
+    auto left = ids(restored);
+    for (uint32_t id : {1, 2, 5})
+    {
+        EXPECT_TRUE(left.contains(id)) << id;
+    }
+    for (uint32_t id : {3, 4, 6, 7, 8})
+    {
+        EXPECT_FALSE(left.contains(id)) << id;
+    }
+}
+
+TEST_F(ExtensionsEraseTest, Erase)
+{
+    // One entry goes to every delete function
+    manager.erase(3);
+    EXPECT_EQ(deleted1, std::vector<uint32_t>{3});
+    EXPECT_EQ(deleted3, std::vector<uint32_t>{3});
+    EXPECT_TRUE(deletedAll.empty());
+
+    EXPECT_THROW(
+        manager.erase(5),
+        sdbusplus::xyz::openbmc_project::Common::Error::Unavailable);
+    EXPECT_TRUE(manager.entries.contains(5));
+
+    // Several go to the delete all function
+    deleted1.clear();
+    deleted3.clear();
+    EXPECT_EQ(manager.erase(std::set<uint32_t>{4, 5, 6, 9}), 2);
+    EXPECT_EQ(deleted1, (std::vector<uint32_t>{4, 6}));
+    EXPECT_TRUE(deleted3.empty());
+    EXPECT_EQ(deletedAll, (std::vector<std::set<uint32_t>>{{4, 6}}));
+}
@@ -0,0 +1,127 @@
+#include "config.h"
+
+#include "log_manager.hpp"
+#include "paths.hpp"
+
+#include <sys/uio.h>
+
+#include <phosphor-logging/commit.hpp>
+#include <sdbusplus/async.hpp>
+#include <sdbusplus/server/manager.hpp>
+#include <xyz/openbmc_project/Logging/event.hpp>
+
+#include <filesystem>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace phosphor::logging;
+using LoggingCleared = sdbusplus::event::xyz::openbmc_project::Logging::Cleared;
+
+// Replace the journal send so the journal isn't flooded when the commit
+// strategy includes it.
+extern "C" int sd_journal_sendv(const struct iovec* /*iov*/, int /*n*/)
+{
+    return 0;
+}
+
+namespace
+{
+
+/**
+ * @brief Runs the log-manager on its own connection and thread, to stand
+ *        in for the daemon that commits are sent to.
+ */
+class LogManagerThread
+{
+  public:
+    LogManagerThread() :
+        objManager(ctx, OBJ_LOGGING), iMgr(ctx, OBJ_INTERNAL),
+        mgr(ctx, OBJ_LOGGING, iMgr)
+    {
+        // Own the name before the first commit is sent to it.
+        ctx.request_name(BUSNAME_LOGGING);
+
+        task = std::thread([this]() { ctx.run(); });
+    }
+
+    ~LogManagerThread()
+    {
+        ctx.spawn(stdexec::just() | stdexec::then([this]() {
+                      ctx.request_stop();
+                  }));
+        task.join();
+    }
+
+    LogManagerThread(const LogManagerThread&) = delete;
+    LogManagerThread& operator=(const LogManagerThread&) = delete;
+    LogManagerThread(LogManagerThread&&) = delete;
+    LogManagerThread& operator=(LogManagerThread&&) = delete;
+
+  private:
+    sdbusplus::async::context ctx;
+    sdbusplus::server::manager_t objManager;
+    internal::Manager iMgr;
+    Manager mgr;
+    std::thread task;
+};
+
+} // namespace
+
+/**
+ * @brief Commits the number of events passed in one at a time, waiting
+ *        for each to be created.
+ */
+static void commitSync(benchmark::State& state)
+{
+    // The daemon requires its directories to be created first.
+    std::filesystem::create_directories(paths::error());
+    LogManagerThread daemon;
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            auto path = lg2::commit(LoggingCleared("NUMBER_OF_LOGS", i));
+            benchmark::DoNotOptimize(path);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Commits the number of events passed in without waiting, then
+ *        waits for them all to be created.
+ */
+static void commitAsync(benchmark::State& state)
+{
+    // The daemon requires its directories to be created first.
+    std::filesystem::create_directories(paths::error());
+    LogManagerThread daemon;
+    std::vector<std::future<sdbusplus::message::object_path>> results;
+
+    for (auto _ : state)
+    {
+        results.clear();
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            results.push_back(
+                lg2::commit_async(LoggingCleared("NUMBER_OF_LOGS", i)));
+        }
+
+        for (auto& result : results)
+        {
+            benchmark::DoNotOptimize(result.get());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(commitSync)->Arg(1)->Arg(64)->UseRealTime();
+BENCHMARK(commitAsync)->Arg(1)->Arg(64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,101 @@
+#include <sys/uio.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+std::atomic<size_t> allocations = 0;
+size_t journalFields = 0;
+
+const std::string path{"/xyz/openbmc_project/inventory/system/chassis"};
+const std::string src{"BD8D1234"};
+} // namespace
+
+// Count every heap allocation made while logging.
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+// Replace the journal send so only the formatting is measured and the
+// journal isn't flooded.
+extern "C" int sd_journal_sendv(const struct iovec* /*iov*/, int n)
+{
+    journalFields += n;
+    return 0;
+}
+
+/**
+ * @brief Logs a message with the number of fields passed in, using
+ *        the common value types.
+ */
+static void logFields(int64_t count)
+{
+    switch (count)
+    {
+        case 0:
+            lg2::info("Starting the service");
+            break;
+        case 1:
+            lg2::info("Opened {PATH}", "PATH", path);
+            break;
+        case 2:
+            lg2::error("Failed opening {PATH}: {ERRNO}", "PATH", path,
+                       "ERRNO", 2);
+            break;
+        case 4:
+            lg2::error("Read {SIZE} bytes from {PATH} at {OFFSET}: {RC}",
+                       "SIZE", 4096U, "PATH", path, "OFFSET",
+                       lg2::hex | lg2::field32, 0x1000U, "RC", -5);
+            break;
+        case 8:
+        default:
+            lg2::error("PEL {ID} for {OBMC_ID} severity {SEV} from {SRC}",
+                       "ID", lg2::hex, 0x50001234U, "OBMC_ID", 42U, "SEV",
+                       lg2::hex | lg2::field8, 0x40U, "SRC", src,
+                       "PATH", path, "SIZE", 2048U, "TEMP", 45.5, "ACKED",
+                       false);
+            break;
+    }
+}
+
+static void doLog(benchmark::State& state)
+{
+    auto count = state.range(0);
+    auto start = allocations.load();
+
+    for (auto _ : state)
+    {
+        logFields(count);
+    }
+
+    state.counters["allocs_per_call"] = benchmark::Counter(
+        allocations.load() - start, benchmark::Counter::kAvgIterations);
+    benchmark::DoNotOptimize(journalFields);
+}
+
+BENCHMARK(doLog)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,122 @@
+#include <sys/uio.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::string message;
+} // namespace
+
+// Capture the MESSAGE field instead of sending to the journal.
+extern "C" int sd_journal_sendv(const struct iovec* iov, int n)
+{
+    constexpr std::string_view field{"MESSAGE="};
+
+    for (int i = 0; i < n; i++)
+    {
+        std::string_view value{static_cast<const char*>(iov[i].iov_base),
+                               iov[i].iov_len};
+        if (value.starts_with(field))
+        {
+            message = value.substr(field.size());
+        }
+    }
+    return 0;
+}
+
+namespace phosphor
+{
+namespace logging
+{
+namespace test
+{
+
+class TestLg2Message : public testing::Test
+{
+  public:
+    TestLg2Message()
+    {
+        message.clear();
+    }
+};
+
+// A message_str made from a literal in a constant expression is parsed
+// at compile time.
+constexpr lg2::details::message_str parsed{"Value {A} and {B}"};
+static_assert(parsed.count == 2);
+static_assert(parsed.parsed == parsed.value.size());
+
+TEST_F(TestLg2Message, Literal)
+{
+    lg2::info("Value {A} and {B}", "A", 1, "B", std::string{"two"});
+    EXPECT_EQ(message, "Value 1 and two");
+
+    lg2::info("No placeholders");
+    EXPECT_EQ(message, "No placeholders");
+
+    lg2::info("Unknown {C} is kept", "A", 1);
+    EXPECT_EQ(message, "Unknown {C} is kept");
+
+    lg2::info("Nested {{A}} braces", "A", 1);
+    EXPECT_EQ(message, "Nested {1} braces");
+}
+
+TEST_F(TestLg2Message, NonLiteralArray)
+{
+    // An array that isn't a constant is passed as a pointer.
+    const char msg[] = "Array {A} value";
+    lg2::info(static_cast<const char*>(msg), "A", 5);
+    EXPECT_EQ(message, "Array 5 value");
+
+    char buffer[32];
+    std::strcpy(buffer, "Buffer {A}");
+    lg2::info(buffer, "A", std::string{"x"});
+    EXPECT_EQ(message, "Buffer x");
+}
+
+TEST_F(TestLg2Message, CString)
+{
+    std::string msg{"String {A} value"};
+    lg2::info(msg.c_str(), "A", 7);
+    EXPECT_EQ(message, "String 7 value");
+}
+
+TEST_F(TestLg2Message, RuntimeHeader)
+{
+    // Headers passed to do_log at runtime aren't checked as header_str
+    // names, but are replaced in the message all the same.
+    auto str = static_cast<uint64_t>(lg2::str.value);
+    lg2::details::do_log(lg2::level::info, std::source_location::current(),
+                         "Runtime {lower} and {A-B}", "lower", str, "x",
+                         "A-B", str, "y", nullptr);
+    EXPECT_EQ(message, "Runtime x and y");
+
+    lg2::details::do_log(lg2::level::info, std::source_location::current(),
+                         "Nested {{A}} braces", "A", str, "1", nullptr);
+    EXPECT_EQ(message, "Nested {1} braces");
+}
+
+TEST_F(TestLg2Message, ManyPlaceholders)
+{
+    static_assert(lg2::details::message_str::max_placeholders < 10);
+
+    lg2::info("{H0} {H1} {H2} {H3} {H4} {H5} {H6} {H7} {H8} {H9}", "H0", 0,
+              "H1", 1, "H2", 2, "H3", 3, "H4", 4, "H5", 5, "H6", 6, "H7", 7,
+              "H8", 8, "H9", 9);
+    EXPECT_EQ(message, "0 1 2 3 4 5 6 7 8 9");
+
+    std::string msg{"{H0} {H1} {H2} {H3} {H4} {H5} {H6} {H7} {H8} {H9}"};
+    lg2::info(msg.c_str(), "H0", 0, "H1", 1, "H2", 2, "H3", 3, "H4", 4, "H5",
+              5, "H6", 6, "H7", 7, "H8", 8, "H9", 9);
+    EXPECT_EQ(message, "0 1 2 3 4 5 6 7 8 9");
+}
+
+} // namespace test
+} // namespace logging
+} // namespace phosphor
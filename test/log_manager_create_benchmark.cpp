@@ -0,0 +1,99 @@
+#include "config.h"
+
+#include "log_manager.hpp"
+#include "paths.hpp"
+
+#include <sdbusplus/test/sdbus_mock.hpp>
+
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+using namespace phosphor::logging;
+
+namespace
+{
+
+sdbusplus::SdBusMock sdbusMock;
+sdbusplus::bus_t bus = sdbusplus::get_mocked_new(&sdbusMock);
+
+/**
+ * @brief Makes the events passed to create() or createBatch().
+ */
+std::vector<BatchEvent> makeEvents(size_t count)
+{
+    std::vector<BatchEvent> events;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        std::map<std::string, std::string> data{
+            {"CALLOUT_INVENTORY_PATH",
+             "/xyz/openbmc_project/inventory/system/chassis/motherboard"},
+            {"_PID", "1234"},
+            {"INDEX", std::to_string(i)}};
+
+        events.emplace_back("xyz.openbmc_project.Common.Error.InternalFailure",
+                            Severity::Error, std::move(data), FFDCEntries{});
+    }
+
+    return events;
+}
+
+} // namespace
+
+/**
+ * @brief Creates the events with one create() call each.
+ */
+static void createSingle(benchmark::State& state)
+{
+    std::filesystem::create_directories(paths::error());
+    internal::Manager manager(bus, OBJ_INTERNAL);
+    auto events = makeEvents(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (const auto& [message, severity, data, ffdc] : events)
+        {
+            benchmark::DoNotOptimize(
+                manager.create(message, severity, data, ffdc));
+        }
+
+        state.PauseTiming();
+        manager.eraseAll();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Creates the events with one createBatch() call.
+ */
+static void createBatch(benchmark::State& state)
+{
+    std::filesystem::create_directories(paths::error());
+    internal::Manager manager(bus, OBJ_INTERNAL);
+    auto events = makeEvents(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto batch = events;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(manager.createBatch(std::move(batch)));
+
+        state.PauseTiming();
+        manager.eraseAll();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// With more events than ERROR_CAP, the batch skips the events the cap would
+// erase before it is done, which single creates make and then erase.
+BENCHMARK(createSingle)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(createBatch)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -9,7 +9,9 @@
 #include <xyz/openbmc_project/Logging/Entry/client.hpp>
 #include <xyz/openbmc_project/Logging/event.hpp>
 
+#include <future>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -233,4 +235,72 @@ TEST_F(TestLogManagerDbus, CallCommitAsync)
     }
 }
 
+// Commit several events without waiting and verify that they are created in
+// the order they were committed.
+TEST_F(TestLogManagerDbus, CallCommitAsyncInOrder)
+{
+    std::vector<std::future<sdbusplus::message::object_path>> results;
+    for (int i = 0; i < 10; i++)
+    {
+        results.push_back(
+            lg2::commit_async(LoggingCleared("NUMBER_OF_LOGS", 100 + i)));
+    }
+
+    // The journal entries are made before commit_async() returns.
+    if constexpr (LG2_COMMIT_JOURNAL)
+    {
+        auto entry = last_journal_entry();
+        if (entry != journal_unavailable)
+        {
+            EXPECT_THAT(entry, ::testing::HasSubstr("\"NUMBER_OF_LOGS\":109"));
+        }
+    }
+
+    uint32_t last = 0;
+    for (auto& result : results)
+    {
+        auto path = result.get();
+
+        if constexpr (LG2_COMMIT_DBUS)
+        {
+            ASSERT_FALSE(path.str.empty());
+
+            auto id = std::stoul(path.filename());
+            EXPECT_GT(id, last);
+            last = id;
+        }
+        else
+        {
+            EXPECT_TRUE(path.str.empty());
+        }
+    }
+}
+
+// Commit an event without the daemon running and verify that the error is
+// passed back in the future.
+TEST_F(TestLogManagerDbus, CallCommitAsyncFailure)
+{
+    data.reset();
+
+    auto result = lg2::commit_async(LoggingCleared("NUMBER_OF_LOGS", 1));
+
+    if constexpr (LG2_COMMIT_DBUS)
+    {
+        EXPECT_THROW(result.get(), sdbusplus::exception_t);
+    }
+    else
+    {
+        EXPECT_TRUE(result.get().str.empty());
+    }
+
+    // The next commit makes a new connection and isn't affected.
+    data = std::make_unique<fixture_data>();
+    auto path = lg2::commit(LoggingCleared("NUMBER_OF_LOGS", 2));
+
+    if constexpr (LG2_COMMIT_DBUS)
+    {
+        EXPECT_FALSE(path.str.empty());
+    }
+}
+
 } // namespace phosphor::logging::test
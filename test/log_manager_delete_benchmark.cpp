@@ -0,0 +1,103 @@
+#include "config.h"
+
+#include "extensions.hpp"
+#include "log_manager.hpp"
+#include "paths.hpp"
+
+#include <sdbusplus/test/sdbus_mock.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace phosphor::logging;
+
+namespace
+{
+
+sdbusplus::SdBusMock sdbusMock;
+sdbusplus::bus_t bus = sdbusplus::get_mocked_new(&sdbusMock);
+
+/**
+ * @brief Creates the number of entries passed in.
+ * @return The IDs of the entries created
+ */
+std::vector<uint32_t> createEntries(internal::Manager& manager, size_t count)
+{
+    std::vector<BatchEvent> events;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        std::map<std::string, std::string> data{
+            {"CALLOUT_INVENTORY_PATH",
+             "/xyz/openbmc_project/inventory/system/chassis/motherboard"},
+            {"_PID", "1234"},
+            {"INDEX", std::to_string(i)}};
+
+        events.emplace_back("xyz.openbmc_project.Common.Error.InternalFailure",
+                            Severity::Error, std::move(data), FFDCEntries{});
+    }
+
+    std::vector<uint32_t> ids;
+    for (const auto& path : manager.createBatch(std::move(events)))
+    {
+        ids.push_back(std::stoul(path.filename()));
+    }
+
+    return ids;
+}
+
+} // namespace
+
+// Keep all of the entries created instead of capping them.
+DISABLE_LOG_ENTRY_CAPS()
+
+/**
+ * @brief Deletes the entries with one erase() call each.
+ */
+static void eraseEach(benchmark::State& state)
+{
+    std::filesystem::create_directories(paths::error());
+    internal::Manager manager(bus, OBJ_INTERNAL);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto ids = createEntries(manager, state.range(0));
+        state.ResumeTiming();
+
+        for (auto id : ids)
+        {
+            manager.erase(id);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Deletes the entries with one eraseAll() call.
+ */
+static void eraseAll(benchmark::State& state)
+{
+    std::filesystem::create_directories(paths::error());
+    internal::Manager manager(bus, OBJ_INTERNAL);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        createEntries(manager, state.range(0));
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(manager.eraseAll());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(eraseEach)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(eraseAll)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
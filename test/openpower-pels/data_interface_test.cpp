@@ -1,8 +1,13 @@
 #include "extensions/openpower-pels/data_interface.hpp"
+#include "mocks.hpp"
+
+#include <stdexcept>
 
 #include <gtest/gtest.h>
 
 using namespace openpower::pels;
+using ::testing::Return;
+using ::testing::Throw;
 
 TEST(DataInterfaceTest, ExtractConnectorLocCode)
 {
@@ -34,3 +39,65 @@ TEST(DataInterfaceTest, ExtractUptime)
 
     EXPECT_EQ(uptime, retUptime);
 }
+
+TEST(DataInterfaceTest, HwIsolationLogIDsCached)
+{
+    MockDataInterface dataIface;
+
+    EXPECT_CALL(dataIface, readLogIDsWithHwIsolation())
+        .Times(1)
+        .WillOnce(Return(std::vector<uint32_t>{1, 2, 3}));
+
+    EXPECT_EQ(dataIface.getLogIDWithHwIsolation(),
+              (std::vector<uint32_t>{1, 2, 3}));
+    EXPECT_EQ(dataIface.getLogIDWithHwIsolation(),
+              (std::vector<uint32_t>{1, 2, 3}));
+}
+
+TEST(DataInterfaceTest, HwIsolationLogIDsInvalidated)
+{
+    MockDataInterface dataIface;
+
+    EXPECT_CALL(dataIface, readLogIDsWithHwIsolation())
+        .Times(2)
+        .WillOnce(Return(std::vector<uint32_t>{1, 2}))
+        .WillOnce(Return(std::vector<uint32_t>{2}));
+
+    EXPECT_EQ(dataIface.getLogIDWithHwIsolation(),
+              (std::vector<uint32_t>{1, 2}));
+
+    dataIface.isolationChanged();
+
+    EXPECT_EQ(dataIface.getLogIDWithHwIsolation(), std::vector<uint32_t>{2});
+    EXPECT_EQ(dataIface.getLogIDWithHwIsolation(), std::vector<uint32_t>{2});
+}
+
+TEST(DataInterfaceTest, HwIsolationReadFailureNotCached)
+{
+    MockDataInterface dataIface;
+
+    EXPECT_CALL(dataIface, readLogIDsWithHwIsolation())
+        .Times(2)
+        .WillOnce(Throw(std::runtime_error{"D-Bus failure"}))
+        .WillOnce(Return(std::vector<uint32_t>{4}));
+
+    EXPECT_THROW(dataIface.getLogIDWithHwIsolation(), std::runtime_error);
+    EXPECT_EQ(dataIface.getLogIDWithHwIsolation(), std::vector<uint32_t>{4});
+}
+
+TEST(DataInterfaceTest, AffectsHwIsolation)
+{
+    EXPECT_TRUE(DataInterface::affectsHwIsolation(
+        "/xyz/openbmc_project/hardware_isolation/entry/1"));
+    EXPECT_TRUE(DataInterface::affectsHwIsolation(
+        "/xyz/openbmc_project/hardware_isolation/entry/1/"
+        "isolated_hw_errorlog"));
+    EXPECT_TRUE(DataInterface::affectsHwIsolation(
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard/"
+        "error_log"));
+
+    EXPECT_FALSE(DataInterface::affectsHwIsolation(
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard"));
+    EXPECT_FALSE(DataInterface::affectsHwIsolation(
+        "/xyz/openbmc_project/logging/entry/1/callout"));
+}
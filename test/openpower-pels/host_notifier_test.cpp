@@ -34,6 +34,7 @@ using ::testing::Return;
 namespace fs = std::filesystem;
 using namespace std::chrono;
 
+const size_t severityOffset = 58;
 const size_t actionFlags0Offset = 66;
 const size_t actionFlags1Offset = 67;
 
@@ -78,14 +79,17 @@ class HostNotifierTest : public CleanPELFiles
  * @brief Create PEL with the specified action flags
  *
  * @param[in] actionFlagsMask - Optional action flags to use
+ * @param[in] severity - Optional severity to use
  *
  * @return std::unique_ptr<PEL>
  */
-std::unique_ptr<PEL> makePEL(uint16_t actionFlagsMask = 0)
+std::unique_ptr<PEL> makePEL(uint16_t actionFlagsMask = 0,
+                             uint8_t severity = 0x20)
 {
     static uint32_t obmcID = 1;
     auto data = pelDataFactory(TestPELType::pelSimple);
 
+    data[severityOffset] = severity;
     data[actionFlags0Offset] |= actionFlagsMask >> 8;
     data[actionFlags1Offset] |= actionFlagsMask & 0xFF;
 
@@ -361,6 +365,72 @@ TEST_F(HostNotifierTest, TestStartAfterHostUp)
     EXPECT_EQ(notifier.queueSize(), 0);
 }
 
+// Test that the most severe PELs are sent first, and then the oldest
+TEST_F(HostNotifierTest, TestSendOrder)
+{
+    sdeventplus::Event sdEvent{event};
+
+    HostNotifier notifier{repo, dataIface, std::move(hostIface)};
+
+    std::vector<uint32_t> sent;
+    ON_CALL(*mockHostIface, sendNewLogCmd(_, _))
+        .WillByDefault(Invoke([this, &sent](uint32_t id, uint32_t) {
+            sent.push_back(id);
+            return mockHostIface->send(0);
+        }));
+
+    // Add them with the host off
+    std::vector<uint32_t> ids;
+    for (auto severity : {0x00, 0x40, 0x20, 0x50, 0x40, 0x00})
+    {
+        auto pel = makePEL(0, severity);
+        repo.add(pel);
+        ids.push_back(pel->id());
+    }
+
+    EXPECT_EQ(notifier.queueSize(), 6);
+
+    dataIface.changeHostState(true);
+
+    runEvents(sdEvent, 7);
+
+    EXPECT_EQ(mockHostIface->numCmdsProcessed(), 6);
+    EXPECT_EQ(notifier.queueSize(), 0);
+
+    // Critical, unrecoverable, predictive, and then informational
+    std::vector<uint32_t> expected{ids[3], ids[1], ids[4],
+                                   ids[2], ids[0], ids[5]};
+    EXPECT_EQ(sent, expected);
+}
+
+// Test that a PEL deleted from the queue won't be sent
+TEST_F(HostNotifierTest, TestDeleteFromQueue)
+{
+    sdeventplus::Event sdEvent{event};
+
+    HostNotifier notifier{repo, dataIface, std::move(hostIface)};
+
+    std::vector<uint32_t> ids;
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto pel = makePEL();
+        repo.add(pel);
+        ids.push_back(pel->id());
+    }
+
+    EXPECT_EQ(notifier.queueSize(), 3);
+
+    repo.remove(Repository::LogID{Repository::LogID::Pel{ids[1]}});
+    EXPECT_EQ(notifier.queueSize(), 2);
+
+    dataIface.changeHostState(true);
+
+    runEvents(sdEvent, 3);
+
+    EXPECT_EQ(mockHostIface->numCmdsProcessed(), 2);
+    EXPECT_EQ(notifier.queueSize(), 0);
+}
+
 // Test that a single failure will cause a retry
 TEST_F(HostNotifierTest, TestHostRetry)
 {
@@ -0,0 +1,147 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/inventory_cache.hpp"
+
+#include <format>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+
+namespace
+{
+
+/**
+ * @brief Stands in for the D-Bus lookups that DataInterface makes for a
+ *        hardware callout, counting how many were made.
+ */
+struct FakeInventory
+{
+    uint64_t calls = 0;
+
+    std::string locationCode(const std::string& path)
+    {
+        calls++;
+        return "P0-" + path.substr(path.rfind('/') + 1);
+    }
+
+    InventoryCache::HWCalloutFields fields(const std::string& path)
+    {
+        calls++;
+        return {"PN" + path, "CCIN", "SN"};
+    }
+
+    std::string expand(const std::string& locCode)
+    {
+        calls++;
+        return "U1234.567.ABCDEFG-" + locCode;
+    }
+
+    std::vector<std::string> paths(const std::string& locCode)
+    {
+        calls++;
+        return {"/xyz/openbmc_project/inventory/system/chassis/" + locCode};
+    }
+};
+
+/**
+ * @brief Resolves the callouts a PEL would have: one by inventory path
+ *        and one by location code.  This is what createPEL() does through
+ *        DataInterface for each hardware callout.
+ */
+void resolveCallouts(InventoryCache* cache, FakeInventory& inv,
+                     const std::string& path, const std::string& locCode)
+{
+    if (cache)
+    {
+        auto loc = cache->getLocationCode(
+            path, [&]() { return inv.locationCode(path); });
+        auto fields = cache->getHWCalloutFields(
+            path, [&]() { return inv.fields(path); });
+        auto expanded = cache->getExpandedLocationCode(
+            locCode, [&]() { return inv.expand(locCode); });
+        auto paths = cache->getInventoryFromLocCode(
+            locCode, 0, false, [&]() { return inv.paths(locCode); });
+        benchmark::DoNotOptimize(loc);
+        benchmark::DoNotOptimize(fields);
+        benchmark::DoNotOptimize(expanded);
+        benchmark::DoNotOptimize(paths);
+    }
+    else
+    {
+        auto loc = inv.locationCode(path);
+        auto fields = inv.fields(path);
+        auto expanded = inv.expand(locCode);
+        auto paths = inv.paths(locCode);
+        benchmark::DoNotOptimize(loc);
+        benchmark::DoNotOptimize(fields);
+        benchmark::DoNotOptimize(expanded);
+        benchmark::DoNotOptimize(paths);
+    }
+}
+
+/**
+ * @brief Creates PELs that call out a small set of FRUs, like during an
+ *        error storm, and reports the D-Bus lookups needed per PEL.
+ */
+void storm(benchmark::State& state, bool useCache)
+{
+    auto frus = state.range(0);
+    InventoryCache cache;
+    FakeInventory inv;
+    int64_t i = 0;
+
+    std::vector<std::pair<std::string, std::string>> callouts;
+    for (int64_t f = 0; f < frus; f++)
+    {
+        callouts.emplace_back(
+            std::format("/xyz/openbmc_project/inventory/system/fan{}", f),
+            std::format("A{}", f));
+    }
+
+    for (auto _ : state)
+    {
+        const auto& [path, locCode] = callouts[i++ % frus];
+        resolveCallouts(useCache ? &cache : nullptr, inv, path, locCode);
+    }
+
+    state.counters["dbus_calls_per_pel"] =
+        static_cast<double>(inv.calls) / state.iterations();
+
+    const auto& stats = cache.getStats();
+    if (stats.hits + stats.misses)
+    {
+        state.counters["hit_rate"] = static_cast<double>(stats.hits) /
+                                     (stats.hits + stats.misses);
+    }
+}
+
+} // namespace
+
+static void calloutsUncached(benchmark::State& state)
+{
+    storm(state, false);
+}
+
+static void calloutsCached(benchmark::State& state)
+{
+    storm(state, true);
+}
+
+BENCHMARK(calloutsUncached)->Arg(8);
+BENCHMARK(calloutsCached)->Arg(8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,182 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/inventory_cache.hpp"
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace openpower::pels;
+
+const std::string fan0{"/xyz/openbmc_project/inventory/system/chassis/fan0"};
+const std::string fan1{"/xyz/openbmc_project/inventory/system/chassis/fan1"};
+
+TEST(InventoryCacheTest, HitsAndMisses)
+{
+    InventoryCache cache;
+    size_t fetches = 0;
+
+    auto fetchLoc = [&fetches]() {
+        fetches++;
+        return std::string{"P0-A0"};
+    };
+
+    EXPECT_EQ(cache.getLocationCode(fan0, fetchLoc), "P0-A0");
+    EXPECT_EQ(cache.getLocationCode(fan0, fetchLoc), "P0-A0");
+    EXPECT_EQ(cache.getLocationCode(fan1, fetchLoc), "P0-A0");
+    EXPECT_EQ(fetches, 2);
+
+    auto fetchFields = [&fetches]() {
+        fetches++;
+        return InventoryCache::HWCalloutFields{"PN", "CCIN", "SN"};
+    };
+
+    auto fields = cache.getHWCalloutFields(fan0, fetchFields);
+    fields = cache.getHWCalloutFields(fan0, fetchFields);
+    EXPECT_EQ(fields.fruPartNumber, "PN");
+    EXPECT_EQ(fields.ccin, "CCIN");
+    EXPECT_EQ(fields.serialNumber, "SN");
+    EXPECT_EQ(fetches, 3);
+
+    auto fetchPaths = [&fetches]() {
+        fetches++;
+        return std::vector<std::string>{fan0};
+    };
+
+    // The node and expanded flag are part of the key
+    EXPECT_EQ(cache.getInventoryFromLocCode("P0-A0", 0, false, fetchPaths),
+              std::vector<std::string>{fan0});
+    cache.getInventoryFromLocCode("P0-A0", 0, false, fetchPaths);
+    cache.getInventoryFromLocCode("P0-A0", 1, false, fetchPaths);
+    cache.getInventoryFromLocCode("P0-A0", 0, true, fetchPaths);
+    EXPECT_EQ(fetches, 6);
+
+    const auto& stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 3);
+    EXPECT_EQ(stats.misses, 6);
+}
+
+TEST(InventoryCacheTest, FailuresNotCached)
+{
+    InventoryCache cache;
+    size_t fetches = 0;
+
+    auto fetch = [&fetches]() -> std::string {
+        fetches++;
+        throw std::runtime_error{"D-Bus failure"};
+    };
+
+    EXPECT_THROW(cache.getExpandedLocationCode("P0-A0", fetch),
+                 std::runtime_error);
+    EXPECT_THROW(cache.getExpandedLocationCode("P0-A0", fetch),
+                 std::runtime_error);
+    EXPECT_EQ(fetches, 2);
+
+    EXPECT_EQ(cache.getExpandedLocationCode(
+                  "P0-A0", []() { return std::string{"U1-P0-A0"}; }),
+              "U1-P0-A0");
+    EXPECT_EQ(cache.getExpandedLocationCode("P0-A0", fetch), "U1-P0-A0");
+}
+
+TEST(InventoryCacheTest, Invalidate)
+{
+    InventoryCache cache;
+    size_t fetches = 0;
+
+    auto fetchLoc = [&fetches]() {
+        fetches++;
+        return std::string{"P0-A0"};
+    };
+    auto fetchFields = [&fetches]() {
+        fetches++;
+        return InventoryCache::HWCalloutFields{"PN", "CCIN", "SN"};
+    };
+    auto fetchExpanded = [&fetches]() {
+        fetches++;
+        return std::string{"U1-P0-A0"};
+    };
+
+    auto fill = [&]() {
+        fetches = 0;
+        cache.getLocationCode(fan0, fetchLoc);
+        cache.getLocationCode(fan1, fetchLoc);
+        cache.getHWCalloutFields(fan0, fetchFields);
+        cache.getHWCalloutFields(fan1, fetchFields);
+        cache.getExpandedLocationCode("P0-A0", fetchExpanded);
+    };
+
+    fill();
+    EXPECT_EQ(fetches, 5);
+
+    // Only fan0's VPD is fetched again
+    cache.invalidateVPD(fan0);
+    fill();
+    EXPECT_EQ(fetches, 1);
+
+    // Location codes changing invalidates the expanded ones too
+    cache.invalidateLocationCode(fan1);
+    fill();
+    EXPECT_EQ(fetches, 2);
+
+    // An object added or removed invalidates all of its data
+    cache.invalidate(fan0);
+    fill();
+    EXPECT_EQ(fetches, 3);
+
+    // The system VPD changing only invalidates the expanded ones
+    cache.invalidateSystemVPD();
+    fill();
+    EXPECT_EQ(fetches, 1);
+
+    cache.clear();
+    fill();
+    EXPECT_EQ(fetches, 5);
+
+    EXPECT_EQ(cache.getStats().invalidations, 5);
+}
+
+TEST(InventoryCacheTest, MaxEntries)
+{
+    InventoryCache cache;
+    size_t fetches = 0;
+
+    auto fetch = [&fetches]() {
+        fetches++;
+        return std::string{"P0"};
+    };
+
+    for (size_t i = 0; i < InventoryCache::maxEntries; i++)
+    {
+        cache.getLocationCode(std::to_string(i), fetch);
+    }
+    EXPECT_EQ(fetches, InventoryCache::maxEntries);
+
+    // Using "0" makes "1" the least recently used
+    cache.getLocationCode("0", fetch);
+    EXPECT_EQ(fetches, InventoryCache::maxEntries);
+
+    // So "1" is the one replaced when the table is full
+    cache.getLocationCode(std::to_string(InventoryCache::maxEntries), fetch);
+    EXPECT_EQ(fetches, InventoryCache::maxEntries + 1);
+
+    cache.getLocationCode("0", fetch);
+    cache.getLocationCode("2", fetch);
+    cache.getLocationCode(std::to_string(InventoryCache::maxEntries), fetch);
+    EXPECT_EQ(fetches, InventoryCache::maxEntries + 1);
+
+    cache.getLocationCode("1", fetch);
+    EXPECT_EQ(fetches, InventoryCache::maxEntries + 2);
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/journal.hpp"
+#include "extensions/openpower-pels/paths.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+const std::vector<std::string> syslogIDs{"app1", "app2", "app3", "app4",
+                                         "phosphor-log-manager"};
+
+/**
+ * @brief Writes a journal file with the number of entries passed in,
+ *        spread across a few syslog IDs, by converting the journal
+ *        export format with systemd-journal-remote.
+ *
+ * @param[in] count - The number of entries
+ *
+ * @return std::optional<fs::path> - The journal file, if it could be made
+ */
+std::optional<fs::path> makeJournal(size_t count)
+{
+    auto dir = getPELReadOnlyDataPath();
+    auto journal = dir / std::format("bench{}.journal", count);
+
+    if (fs::exists(journal))
+    {
+        return journal;
+    }
+
+    auto exportFile = dir / "bench.export";
+    {
+        std::ofstream file{exportFile};
+        uint64_t usec = 1700000000000000;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            usec += 150000;
+            file << std::format(
+                "__REALTIME_TIMESTAMP={}\n__MONOTONIC_TIMESTAMP={}\n"
+                "_BOOT_ID=0123456789abcdef0123456789abcdef\n"
+                "SYSLOG_IDENTIFIER={}\n_PID={}\n"
+                "MESSAGE=Message {} from the benchmark journal\n\n",
+                usec, usec - 1700000000000000, syslogIDs[i % syslogIDs.size()],
+                1000 + (i % syslogIDs.size()), i);
+        }
+    }
+
+    for (const auto* remote : {"/usr/lib/systemd/systemd-journal-remote",
+                               "/lib/systemd/systemd-journal-remote"})
+    {
+        if (fs::exists(remote))
+        {
+            auto cmd = std::format("{} -o {} {} >/dev/null 2>&1", remote,
+                                   journal.string(), exportFile.string());
+            if ((std::system(cmd.c_str()) == 0) && fs::exists(journal))
+            {
+                return journal;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+} // namespace
+
+/**
+ * @brief Captures the newest entries of the whole journal, which is what
+ *        a JournalCapture with NumLines does.
+ */
+static void captureLines(benchmark::State& state)
+{
+    auto file = makeJournal(50000);
+    if (!file)
+    {
+        state.SkipWithError("Could not make a journal file");
+        return;
+    }
+
+    Journal journal{{file->string()}};
+
+    for (auto _ : state)
+    {
+        auto messages = journal.getMessages("", state.range(0));
+        benchmark::DoNotOptimize(messages);
+    }
+}
+
+/**
+ * @brief Captures the newest entries of 4 syslog IDs, which is what a
+ *        JournalCapture with an AppCaptureList does.
+ */
+static void captureApps(benchmark::State& state, bool onePass)
+{
+    auto file = makeJournal(50000);
+    if (!file)
+    {
+        state.SkipWithError("Could not make a journal file");
+        return;
+    }
+
+    Journal journal{{file->string()}};
+    std::vector<std::pair<std::string, size_t>> captures;
+    for (size_t i = 0; i < 4; i++)
+    {
+        captures.emplace_back(syslogIDs[i], state.range(0));
+    }
+
+    for (auto _ : state)
+    {
+        // The base class does a pass per ID
+        auto messages =
+            onePass ? journal.getMessagesByID(captures)
+                    : journal.JournalBase::getMessagesByID(captures);
+        benchmark::DoNotOptimize(messages);
+    }
+}
+
+static void captureAppsPerID(benchmark::State& state)
+{
+    captureApps(state, false);
+}
+
+static void captureAppsOnePass(benchmark::State& state)
+{
+    captureApps(state, true);
+}
+
+BENCHMARK(captureLines)->Arg(10)->Arg(100)->Arg(1000)->Arg(5000)->Unit(
+    benchmark::kMicrosecond);
+BENCHMARK(captureAppsPerID)->Arg(50)->Arg(500)->Unit(benchmark::kMicrosecond);
+BENCHMARK(captureAppsOnePass)->Arg(50)->Arg(500)->Unit(
+    benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
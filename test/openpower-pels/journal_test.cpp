@@ -0,0 +1,266 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/journal.hpp"
+
+#include <cerrno>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace openpower::pels;
+
+namespace
+{
+
+struct FakeEntry
+{
+    uint64_t usec;
+    std::string syslogID;
+    std::string pid;
+    std::string message;
+};
+
+// The entries of the fake journal, oldest first.
+std::vector<FakeEntry> fakeEntries;
+
+// Makes opening the journal fail.
+bool failOpen = false;
+
+// Makes adding a match for this syslog ID fail.
+std::string failMatch;
+
+} // namespace
+
+// An in-memory journal in place of the sd_journal functions Journal uses,
+// so it can be tested without journal files.
+struct sd_journal
+{
+    std::set<std::string> matches;
+    long pos = 0;
+    std::string data;
+};
+
+extern "C"
+{
+
+int sd_journal_open(sd_journal** journal, int /*flags*/)
+{
+    if (failOpen)
+    {
+        return -EACCES;
+    }
+    *journal = new sd_journal;
+    return 0;
+}
+
+int sd_journal_open_files(sd_journal** journal, const char* const* /*paths*/,
+                          int flags)
+{
+    return sd_journal_open(journal, flags);
+}
+
+void sd_journal_close(sd_journal* journal)
+{
+    delete journal;
+}
+
+int sd_journal_add_match(sd_journal* journal, const void* data, size_t size)
+{
+    std::string match{static_cast<const char*>(data)};
+    if (size != 0)
+    {
+        match.assign(static_cast<const char*>(data), size);
+    }
+
+    if (!failMatch.empty() && (match == "SYSLOG_IDENTIFIER=" + failMatch))
+    {
+        return -ENOMEM;
+    }
+
+    journal->matches.insert(match);
+    return 0;
+}
+
+int sd_journal_seek_tail(sd_journal* journal)
+{
+    journal->pos = fakeEntries.size();
+    return 0;
+}
+
+int sd_journal_previous(sd_journal* journal)
+{
+    while (--journal->pos >= 0)
+    {
+        const auto& entry = fakeEntries[journal->pos];
+        if (journal->matches.empty() ||
+            journal->matches.contains("SYSLOG_IDENTIFIER=" + entry.syslogID))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int sd_journal_get_data(sd_journal* journal, const char* field,
+                        const void** data, size_t* length)
+{
+    const auto& entry = fakeEntries[journal->pos];
+    std::string name{field};
+    const std::string* value = nullptr;
+
+    if (name == "SYSLOG_IDENTIFIER")
+    {
+        value = &entry.syslogID;
+    }
+    else if (name == "_PID")
+    {
+        value = &entry.pid;
+    }
+    else if (name == "MESSAGE")
+    {
+        value = &entry.message;
+    }
+
+    if ((value == nullptr) || value->empty())
+    {
+        return -ENOENT;
+    }
+
+    journal->data = name + '=' + *value;
+    *data = journal->data.data();
+    *length = journal->data.size();
+    return 0;
+}
+
+int sd_journal_get_realtime_usec(sd_journal* journal, uint64_t* usec)
+{
+    *usec = fakeEntries[journal->pos].usec;
+    return 0;
+}
+}
+
+class JournalTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        failOpen = false;
+        failMatch.clear();
+        fakeEntries.clear();
+
+        // Jan 01 00:00:00, one second apart, with the IDs interleaved.
+        const std::vector<std::string> ids{"app1", "app2", "app1", "app3",
+                                           "app2", "app1", "app2", "app1"};
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+            fakeEntries.emplace_back(i * 1000000, ids[i], "10",
+                                     "msg" + std::to_string(i));
+        }
+    }
+
+    static std::string line(size_t i)
+    {
+        const auto& entry = fakeEntries[i];
+        return "Jan 01 00:00:0" + std::to_string(i) + ' ' + entry.syslogID +
+               '[' + entry.pid + "]: " + entry.message;
+    }
+};
+
+TEST_F(JournalTest, GetMessages)
+{
+    Journal journal;
+
+    EXPECT_EQ(journal.getMessages("app1", 2),
+              (std::vector<std::string>{line(5), line(7)}));
+
+    // Fewer messages than asked for
+    EXPECT_EQ(journal.getMessages("app3", 5),
+              std::vector<std::string>{line(3)});
+
+    // An empty ID gets every entry
+    EXPECT_EQ(journal.getMessages("", 3),
+              (std::vector<std::string>{line(5), line(6), line(7)}));
+
+    EXPECT_TRUE(journal.getMessages("app4", 5).empty());
+    EXPECT_TRUE(journal.getMessages("app1", 0).empty());
+}
+
+TEST_F(JournalTest, GetMessagesByID)
+{
+    Journal journal;
+
+    auto messages = journal.getMessagesByID(
+        {{"app1", 3}, {"app2", 10}, {"app4", 1}, {"app1", 1}, {"app3", 0}});
+
+    ASSERT_EQ(messages.size(), 5);
+    EXPECT_EQ(messages[0],
+              (std::vector<std::string>{line(2), line(5), line(7)}));
+    EXPECT_EQ(messages[1],
+              (std::vector<std::string>{line(1), line(4), line(6)}));
+    EXPECT_TRUE(messages[2].empty());
+
+    // The same ID again, wanting fewer messages
+    EXPECT_EQ(messages[3], std::vector<std::string>{line(7)});
+
+    EXPECT_TRUE(messages[4].empty());
+
+    // The same as getting them one at a time
+    std::vector<std::pair<std::string, size_t>> captures{
+        {"app3", 2}, {"app2", 1}, {"app1", 8}};
+    EXPECT_EQ(journal.getMessagesByID(captures),
+              journal.JournalBase::getMessagesByID(captures));
+}
+
+TEST_F(JournalTest, GetMessagesByIDWithEmptyID)
+{
+    Journal journal;
+
+    auto messages = journal.getMessagesByID({{"app3", 1}, {"", 2}});
+
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0], std::vector<std::string>{line(3)});
+    EXPECT_EQ(messages[1], (std::vector<std::string>{line(6), line(7)}));
+}
+
+TEST_F(JournalTest, OpenFailure)
+{
+    Journal journal;
+    failOpen = true;
+
+    EXPECT_THROW(journal.getMessages("app1", 1), std::runtime_error);
+
+    auto messages = journal.getMessagesByID({{"app1", 1}, {"app2", 1}});
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_TRUE(messages[0].empty());
+    EXPECT_TRUE(messages[1].empty());
+}
+
+TEST_F(JournalTest, MatchFailure)
+{
+    Journal journal;
+    failMatch = "app2";
+
+    // Only the ID that failed is left empty
+    auto messages =
+        journal.getMessagesByID({{"app1", 1}, {"app2", 1}, {"app3", 1}});
+
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(messages[0], std::vector<std::string>{line(7)});
+    EXPECT_TRUE(messages[1].empty());
+    EXPECT_EQ(messages[2], std::vector<std::string>{line(3)});
+}
@@ -63,7 +63,7 @@ class MockDataInterface : public DataInterfaceBase
     MOCK_METHOD(void, createProgressSRC,
                 (const std::vector<uint8_t>&, const std::vector<uint8_t>&),
                 (const override));
-    MOCK_METHOD(std::vector<uint32_t>, getLogIDWithHwIsolation, (),
+    MOCK_METHOD(std::vector<uint32_t>, readLogIDsWithHwIsolation, (),
                 (const override));
     MOCK_METHOD(std::vector<uint8_t>, getRawProgressSRC, (), (const override));
     MOCK_METHOD(std::optional<std::vector<uint8_t>>, getDIProperty,
@@ -87,6 +87,11 @@ class MockDataInterface : public DataInterfaceBase
     {
         setFruPresent(locationCode);
     }
+
+    void isolationChanged()
+    {
+        hwIsolationChanged();
+    }
 };
 
 /**
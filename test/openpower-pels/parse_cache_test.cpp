@@ -0,0 +1,259 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/parse_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <gtest/gtest.h>
+
+using namespace openpower::pels::user_data;
+namespace fs = std::filesystem;
+
+class ParseCacheTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char templ[] = "/tmp/parsecachetestXXXXXX";
+        dir = mkdtemp(templ);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+};
+
+TEST_F(ParseCacheTest, FindAndInsert)
+{
+    ParseCache cache;
+    std::vector<uint8_t> data{1, 2, 3, 4};
+    auto key = ParseCache::makeKey('O', 0x1234, 1, 2, data);
+    std::optional<std::string> json;
+
+    EXPECT_FALSE(cache.find(key, data, json));
+
+    cache.insert(key, data, "\"Data\": 1");
+    ASSERT_TRUE(cache.find(key, data, json));
+    EXPECT_EQ(json, "\"Data\": 1");
+
+    // A parser returning nothing is cached too
+    auto noneKey = ParseCache::makeKey('O', 0x1234, 9, 2, data);
+    cache.insert(noneKey, data, std::nullopt);
+    json = "something";
+    ASSERT_TRUE(cache.find(noneKey, data, json));
+    EXPECT_FALSE(json);
+
+    // Different data, creator, or version are different keys
+    std::vector<uint8_t> other{1, 2, 3, 5};
+    EXPECT_FALSE(cache.find(ParseCache::makeKey('O', 0x1234, 1, 2, other),
+                            other, json));
+    EXPECT_FALSE(
+        cache.find(ParseCache::makeKey('B', 0x1234, 1, 2, data), data, json));
+    EXPECT_FALSE(
+        cache.find(ParseCache::makeKey('O', 0x1234, 1, 3, data), data, json));
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.getStats().hits, 2);
+    EXPECT_EQ(cache.getStats().misses, 4);
+}
+
+TEST_F(ParseCacheTest, MaxSize)
+{
+    ParseCache cache{10};
+    std::vector<uint8_t> data{1};
+    std::optional<std::string> json;
+
+    auto key1 = ParseCache::makeKey('O', 1, 1, 1, data);
+    auto key2 = ParseCache::makeKey('O', 2, 1, 1, data);
+    cache.insert(key1, data, "12345678");
+    cache.insert(key2, data, "12345678");
+
+    EXPECT_TRUE(cache.find(key1, data, json));
+    EXPECT_FALSE(cache.find(key2, data, json));
+
+    // The data counts too
+    ParseCache dataCache{10};
+    std::vector<uint8_t> large(8);
+    dataCache.insert(key1, large, "12");
+    dataCache.insert(key2, large, "12");
+
+    EXPECT_TRUE(dataCache.find(key1, large, json));
+    EXPECT_FALSE(dataCache.find(key2, large, json));
+}
+
+TEST_F(ParseCacheTest, SameHash)
+{
+    ParseCache cache;
+    std::vector<uint8_t> data{1, 2, 3, 4};
+    std::vector<uint8_t> other{4, 3, 2, 1};
+    std::optional<std::string> json;
+
+    // A key with a hash that matches another section's data
+    auto key = ParseCache::makeKey('O', 0x1234, 1, 2, data);
+    cache.insert(key, data, "\"Data\": 1");
+
+    EXPECT_FALSE(cache.find(key, other, json));
+
+    // And it doesn't replace the section already there
+    cache.insert(key, other, "\"Data\": 2");
+    ASSERT_TRUE(cache.find(key, data, json));
+    EXPECT_EQ(json, "\"Data\": 1");
+    EXPECT_FALSE(cache.find(key, other, json));
+}
+
+TEST_F(ParseCacheTest, SaveAndLoad)
+{
+    auto file = dir / "cache";
+    std::vector<uint8_t> data{1, 2, 3, 4};
+    auto key1 = ParseCache::makeKey('O', 0x1234, 1, 2, data);
+    auto key2 = ParseCache::makeKey('O', 0x1234, 9, 2, data);
+
+    {
+        ParseCache cache;
+        cache.insert(key1, data, "\"Data\": 1");
+        cache.insert(key2, data, std::nullopt);
+        cache.save(file, 42);
+    }
+
+    ASSERT_TRUE(fs::exists(file));
+
+    {
+        ParseCache cache;
+        ASSERT_TRUE(cache.load(file, 42));
+        EXPECT_EQ(cache.size(), 2);
+
+        std::optional<std::string> json;
+        ASSERT_TRUE(cache.find(key1, data, json));
+        EXPECT_EQ(json, "\"Data\": 1");
+        ASSERT_TRUE(cache.find(key2, data, json));
+        EXPECT_FALSE(json);
+
+        // Nothing was added, so it isn't written again
+        fs::remove(file);
+        cache.save(file, 42);
+        EXPECT_FALSE(fs::exists(file));
+
+        cache.insert(ParseCache::makeKey('O', 1, 1, 1, data), data, "1");
+        cache.save(file, 42);
+        EXPECT_TRUE(fs::exists(file));
+    }
+
+    // The plugins changed
+    {
+        ParseCache cache;
+        EXPECT_FALSE(cache.load(file, 43));
+        EXPECT_EQ(cache.size(), 0);
+    }
+
+    // Truncated
+    fs::resize_file(file, fs::file_size(file) - 2);
+    {
+        ParseCache cache;
+        EXPECT_FALSE(cache.load(file, 42));
+        EXPECT_EQ(cache.size(), 0);
+    }
+
+    // Missing
+    ParseCache cache;
+    EXPECT_FALSE(cache.load(dir / "missing", 42));
+}
+
+TEST_F(ParseCacheTest, LoadDamaged)
+{
+    auto file = dir / "cache";
+    std::vector<uint8_t> data{1, 2, 3, 4};
+
+    // Sets 4 bytes of the file to 0xFF
+    auto damage = [&file](size_t offset) {
+        std::fstream output{file,
+                            std::ios::in | std::ios::out | std::ios::binary};
+        output.seekp(offset);
+        output.write("\xFF\xFF\xFF\xFF", 4);
+    };
+
+    auto save = [&file, &data]() {
+        ParseCache cache;
+        cache.insert(ParseCache::makeKey('O', 0x1234, 1, 2, data), data,
+                     "\"Data\": 1");
+        cache.save(file, 42);
+    };
+
+    // The header is 17 bytes, and the data size follows the creator,
+    // component ID, subtype, and version.
+    constexpr size_t dataSizeOffset = 17 + 5;
+    constexpr size_t jsonSizeOffset = dataSizeOffset + 4 + 4 + 1;
+
+    save();
+    {
+        ParseCache cache;
+        ASSERT_TRUE(cache.load(file, 42));
+        EXPECT_EQ(cache.size(), 1);
+    }
+
+    for (auto offset : {dataSizeOffset, jsonSizeOffset})
+    {
+        save();
+        damage(offset);
+
+        ParseCache cache;
+        EXPECT_FALSE(cache.load(file, 42));
+        EXPECT_EQ(cache.size(), 0);
+    }
+
+    // Changed data isn't found with the key of the original data
+    save();
+    {
+        std::fstream output{file,
+                            std::ios::in | std::ios::out | std::ios::binary};
+        output.seekp(dataSizeOffset + 4);
+        output.put(9);
+    }
+    {
+        ParseCache cache;
+        ASSERT_TRUE(cache.load(file, 42));
+
+        std::optional<std::string> json;
+        EXPECT_FALSE(cache.find(ParseCache::makeKey('O', 0x1234, 1, 2, data),
+                                data, json));
+    }
+}
+
+TEST_F(ParseCacheTest, SaveTempFile)
+{
+    auto file = dir / "cache";
+    std::vector<uint8_t> data{1, 2, 3, 4};
+
+    // Something else is in the way of a fixed temporary file name
+    fs::create_directory(dir / "cache.tmp");
+
+    ParseCache cache;
+    cache.insert(ParseCache::makeKey('O', 1, 1, 1, data), data, "1");
+    cache.save(file, 42);
+
+    EXPECT_TRUE(fs::is_regular_file(file));
+    EXPECT_EQ(fs::status(file).permissions() & fs::perms::others_read,
+              fs::perms::others_read);
+
+    // Nothing else was left behind
+    EXPECT_EQ(std::distance(fs::directory_iterator{dir},
+                            fs::directory_iterator{}),
+              2);
+}
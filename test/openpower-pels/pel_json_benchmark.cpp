@@ -0,0 +1,167 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/pel_json_cache.hpp"
+#include "extensions/openpower-pels/registry.hpp"
+#include "extensions/openpower-pels/repository.hpp"
+#include "pel_utils.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/**
+ * @brief The number of GetPELJSON requests made in each iteration.
+ */
+constexpr size_t requests = 1000;
+
+/**
+ * @brief Creates a repository with the number of PELs passed in, with
+ *        IDs 1 through count.
+ *
+ * @param[in] count - The number of PELs to create
+ *
+ * @return fs::path - The repository base path
+ */
+fs::path makeRepo(size_t count)
+{
+    auto basePath = getPELRepoPath() / ("json" + std::to_string(count));
+    fs::remove_all(basePath);
+
+    Repository repo{basePath};
+    for (uint32_t id = 1; id <= count; id++)
+    {
+        auto data = pelFactory(id, 'O', 0x40, 0x8800, 2000);
+        auto pel = std::make_unique<PEL>(data);
+        repo.add(pel);
+    }
+
+    return basePath;
+}
+
+/**
+ * @brief Returns a registry without any entries, so the time spent is
+ *        just what it takes to render the PELs.
+ */
+message::Registry makeRegistry()
+{
+    auto path = getPELReadOnlyDataPath() / message::registryFileName;
+    std::ofstream{path} << R"({"PELs": []})";
+    return message::Registry{path};
+}
+
+/**
+ * @brief Renders a PEL in JSON the way the PEL manager does on a
+ *        cache miss.
+ */
+std::string render(Repository& repo, message::Registry& registry,
+                   uint32_t pelID)
+{
+    using ID = Repository::LogID;
+    auto data = repo.getPELData(ID{ID::Pel{pelID}});
+    PEL pel{*data};
+    return pel.toJSON(registry, {}) + '\n';
+}
+
+} // namespace
+
+/**
+ * @brief The previous way of running a process for each request, with
+ *        a process that does nothing.  This is the floor of what it cost,
+ *        as peltool also started Python, searched the PEL directory, and
+ *        loaded the message registry on top of this.
+ */
+static void runProcess(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < requests; i++)
+        {
+            FILE* pipe = popen("/bin/true", "r");
+            benchmark::DoNotOptimize(pclose(pipe));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * requests);
+}
+
+/**
+ * @brief Renders the JSON for each request, cycling through the number
+ *        of PELs passed in.
+ */
+static void renderEach(benchmark::State& state)
+{
+    auto basePath = makeRepo(state.range(0));
+    Repository repo{basePath};
+    auto registry = makeRegistry();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < requests; i++)
+        {
+            uint32_t pelID = 1 + (i % state.range(0));
+            benchmark::DoNotOptimize(render(repo, registry, pelID));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * requests);
+    fs::remove_all(basePath);
+}
+
+/**
+ * @brief Renders the JSON through the cache, cycling through the number
+ *        of PELs passed in.
+ */
+static void renderCached(benchmark::State& state)
+{
+    auto basePath = makeRepo(state.range(0));
+    Repository repo{basePath};
+    auto registry = makeRegistry();
+    PELJSONCache cache;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < requests; i++)
+        {
+            uint32_t pelID = 1 + (i % state.range(0));
+            benchmark::DoNotOptimize(cache.get(pelID, [&]() {
+                return render(repo, registry, pelID);
+            }));
+        }
+    }
+
+    const auto& stats = cache.getStats();
+    state.counters["hit_ratio"] =
+        static_cast<double>(stats.hits) / (stats.hits + stats.misses);
+    state.SetItemsProcessed(state.iterations() * requests);
+    fs::remove_all(basePath);
+}
+
+// Polling more PELs than the cache holds in a cycle makes every request
+// a miss, which the 100 PEL case shows.
+BENCHMARK(runProcess)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(renderEach)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(renderCached)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/pel_json_cache.hpp"
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace openpower::pels;
+
+TEST(PELJSONCacheTest, HitsAndMisses)
+{
+    PELJSONCache cache;
+    size_t renders = 0;
+
+    auto render = [&renders]() {
+        renders++;
+        return std::string{"{}"};
+    };
+
+    EXPECT_EQ(cache.get(0x50000001, render), "{}");
+    EXPECT_EQ(cache.get(0x50000001, render), "{}");
+    EXPECT_EQ(cache.get(0x50000002, render), "{}");
+    EXPECT_EQ(renders, 2);
+    EXPECT_EQ(cache.size(), 2);
+
+    const auto& stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+
+    // Nothing is saved if rendering fails
+    EXPECT_THROW(cache.get(0x50000003,
+                           []() -> std::string {
+                               throw std::runtime_error{"failed"};
+                           }),
+                 std::runtime_error);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(PELJSONCacheTest, Invalidate)
+{
+    PELJSONCache cache;
+    std::string json{"{\"v\": 1}"};
+
+    auto render = [&json]() { return json; };
+
+    EXPECT_EQ(cache.get(0x50000001, render), json);
+
+    // Still the old JSON until it's invalidated
+    json = "{\"v\": 2}";
+    EXPECT_EQ(cache.get(0x50000001, render), "{\"v\": 1}");
+
+    cache.invalidate(0x50000001);
+    EXPECT_EQ(cache.get(0x50000001, render), "{\"v\": 2}");
+    EXPECT_EQ(cache.getStats().invalidations, 1);
+
+    // Invalidating what isn't there does nothing
+    cache.invalidate(0x50000005);
+    EXPECT_EQ(cache.getStats().invalidations, 1);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(PELJSONCacheTest, LeastRecentlyUsed)
+{
+    PELJSONCache cache;
+    size_t renders = 0;
+
+    auto render = [&renders]() {
+        renders++;
+        return std::to_string(renders);
+    };
+
+    for (uint32_t id = 0; id < PELJSONCache::maxEntries; id++)
+    {
+        cache.get(id, render);
+    }
+    EXPECT_EQ(cache.size(), PELJSONCache::maxEntries);
+
+    // Use the oldest one, so that the second oldest is replaced instead
+    EXPECT_EQ(cache.get(0, render), "1");
+    cache.get(PELJSONCache::maxEntries, render);
+    EXPECT_EQ(cache.size(), PELJSONCache::maxEntries);
+
+    renders = 0;
+    cache.get(0, render);
+    EXPECT_EQ(renders, 0);
+
+    cache.get(1, render);
+    EXPECT_EQ(renders, 1);
+}
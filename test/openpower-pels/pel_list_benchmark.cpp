@@ -0,0 +1,158 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/pel.hpp"
+#include "extensions/openpower-pels/pel_list.hpp"
+#include "extensions/openpower-pels/read_file.hpp"
+#include "pel_utils.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/**
+ * @brief Writes PEL files named like the repository names them
+ *        into a directory, to list.
+ *
+ * @param[in] count - The number of PELs
+ *
+ * @return fs::path - The directory
+ */
+fs::path makeRepo(size_t count)
+{
+    auto dir = getPELRepoPath() / "list";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    for (uint32_t id = 1; id <= count; id++)
+    {
+        auto data = pelFactory(0x50000000 + id, 'O', 0x40, 0x8800, 2000);
+        auto name = std::format("20261018{:08}_{:08X}", id, 0x50000000 + id);
+
+        std::ofstream file{dir / name, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    return dir;
+}
+
+std::unique_ptr<message::Registry> makeRegistry()
+{
+    auto path = getPELReadOnlyDataPath() / message::registryFileName;
+    std::ofstream{path} << R"({"PELs": []})";
+    return std::make_unique<message::Registry>(path, false);
+}
+
+} // namespace
+
+/**
+ * @brief The previous way of listing, on one thread, with every
+ *        section of every PEL parsed and the whole list built
+ *        up in a string before it is printed.
+ */
+static void listFullPELs(benchmark::State& state)
+{
+    auto dir = makeRepo(state.range(0));
+    auto registry = makeRegistry();
+    list::Filter filter;
+
+    for (auto _ : state)
+    {
+        std::string listStr = "{\n";
+
+        for (const auto& file : list::getFiles(dir, false))
+        {
+            auto data = util::readFile(file);
+            PEL pel{data};
+            if (pel.valid() &&
+                filter.includes(pel.userHeader(),
+                                pel.primarySRC().value_or(nullptr)))
+            {
+                listStr += list::summarize(pel.privateHeader(),
+                                           pel.userHeader(),
+                                           pel.primarySRC().value(),
+                                           *registry) +
+                           ",\n";
+            }
+        }
+
+        listStr.replace(listStr.rfind(","), 1, "");
+        listStr += "}\n";
+        benchmark::DoNotOptimize(listStr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    fs::remove_all(dir);
+}
+
+/**
+ * @brief Lists the PELs like peltool -l now does, with only the
+ *        headers and primary SRC parsed, on the number of worker
+ *        threads passed in, streaming the output.
+ */
+static void listHeaders(benchmark::State& state)
+{
+    auto dir = makeRepo(state.range(0));
+    size_t workers = state.range(1);
+    list::Filter filter;
+
+    std::vector<std::unique_ptr<message::Registry>> registries;
+    for (size_t i = 0; i < workers; i++)
+    {
+        registries.push_back(makeRegistry());
+    }
+
+    for (auto _ : state)
+    {
+        std::ostringstream out;
+        list::Writer writer{out, list::Writer::Format::object};
+        auto files = list::getFiles(dir, false);
+
+        list::renderInOrder(
+            files.size(), workers,
+            [&files, &filter, &registries](size_t index, size_t worker) {
+                auto data = util::readFile(files[index]);
+                return list::summarize(data, filter, *registries[worker]);
+            },
+            [&writer](const std::string& pel) { writer.write(pel); });
+
+        writer.finish();
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    fs::remove_all(dir);
+}
+
+BENCHMARK(listFullPELs)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(listHeaders)
+    ->Args({1000, 1})
+    ->Args({1000, 2})
+    ->Args({1000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,234 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/pel.hpp"
+#include "extensions/openpower-pels/pel_list.hpp"
+#include "pel_utils.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+message::Registry makeRegistry()
+{
+    return message::Registry{
+        getPELReadOnlyDataPath() / message::registryFileName, false};
+}
+
+} // namespace
+
+TEST(PELListTest, RenderInOrder)
+{
+    for (size_t workers : {1, 4})
+    {
+        std::vector<size_t> written;
+
+        // Every 7th item is skipped, and the first items take the
+        // longest so that the ones after them finish first.
+        auto render = [](size_t index,
+                         size_t /*worker*/) -> std::optional<std::string> {
+            if (index < 4)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            if (index % 7 == 0)
+            {
+                return std::nullopt;
+            }
+            return std::to_string(index);
+        };
+
+        list::renderInOrder(100, workers, render,
+                            [&written](const std::string& item) {
+                                written.push_back(std::stoul(item));
+                            });
+
+        std::vector<size_t> expected;
+        for (size_t index = 0; index < 100; index++)
+        {
+            if (index % 7 != 0)
+            {
+                expected.push_back(index);
+            }
+        }
+
+        EXPECT_EQ(written, expected);
+    }
+}
+
+TEST(PELListTest, RenderInOrderThrows)
+{
+    std::vector<std::string> written;
+
+    auto render = [](size_t index,
+                     size_t /*worker*/) -> std::optional<std::string> {
+        if (index == 50)
+        {
+            throw std::runtime_error{"render failed"};
+        }
+        return std::to_string(index);
+    };
+
+    EXPECT_THROW(list::renderInOrder(100, 4, render,
+                                     [&written](const std::string& item) {
+                                         written.push_back(item);
+                                     }),
+                 std::runtime_error);
+
+    // Everything before the failure was still written
+    ASSERT_EQ(written.size(), 50);
+    EXPECT_EQ(written.back(), "49");
+}
+
+TEST(PELListTest, Summarize)
+{
+    auto registry = makeRegistry();
+    list::Filter filter;
+
+    auto data = pelFactory(0x50000001, 'O', 0x40, 0x8800, 500);
+    PEL pel{data};
+
+    auto entry = list::summarize(data, filter, registry);
+    ASSERT_TRUE(entry);
+
+    // The same as when the whole PEL is parsed
+    EXPECT_EQ(*entry, list::summarize(pel.privateHeader(), pel.userHeader(),
+                                      pel.primarySRC().value(), registry));
+
+    EXPECT_TRUE(entry->starts_with("    \"0x50000001\": {\n"));
+    EXPECT_TRUE(entry->ends_with("\n    }"));
+    EXPECT_NE(entry->find("\"SRC\""), std::string::npos);
+    EXPECT_NE(entry->find("\"PLID\""), std::string::npos);
+    EXPECT_NE(entry->find("\"CompID\""), std::string::npos);
+
+    // Truncated
+    data.resize(data.size() - 100);
+    EXPECT_FALSE(list::summarize(data, filter, registry));
+}
+
+TEST(PELListTest, Filter)
+{
+    auto registry = makeRegistry();
+    list::Filter filter;
+
+    // Informational
+    auto info = pelFactory(1, 'O', 0x00, 0x8800, 500);
+    EXPECT_FALSE(list::summarize(info, filter, registry));
+
+    // Hidden
+    auto hidden = pelFactory(2, 'O', 0x40, 0x4000, 500);
+    EXPECT_FALSE(list::summarize(hidden, filter, registry));
+
+    filter.includeInfo = true;
+    filter.hidden = true;
+    EXPECT_TRUE(list::summarize(info, filter, registry));
+    EXPECT_TRUE(list::summarize(hidden, filter, registry));
+
+    // Not a critical system terminating PEL
+    filter.critSysTerm = true;
+    EXPECT_FALSE(list::summarize(hidden, filter, registry));
+
+    // Scrubbed by SRC
+    auto data = pelFactory(3, 'O', 0x40, 0x8800, 500);
+    PEL pel{data};
+    filter = list::Filter{};
+    filter.scrubRegex =
+        std::regex{pel.primarySRC().value()->asciiString().substr(0, 8)};
+    EXPECT_FALSE(list::summarize(data, filter, registry));
+}
+
+TEST(PELListTest, GetFiles)
+{
+    auto dir = getPELRepoPath() / "list";
+    fs::create_directories(dir);
+    fs::create_directories(dir / "archive");
+
+    std::vector<std::string> names{"2026101812000000_50000003",
+                                   "2025010100000000_50000002",
+                                   "2026101812000000_50000001"};
+    for (const auto& name : names)
+    {
+        std::ofstream{dir / name};
+    }
+
+    auto files = list::getFiles(dir, false);
+    ASSERT_EQ(files.size(), 3);
+    EXPECT_EQ(files[0].filename(), "2025010100000000_50000002");
+    EXPECT_EQ(files[1].filename(), "2026101812000000_50000001");
+    EXPECT_EQ(files[2].filename(), "2026101812000000_50000003");
+
+    files = list::getFiles(dir, true);
+    ASSERT_EQ(files.size(), 3);
+    EXPECT_EQ(files[0].filename(), "2026101812000000_50000003");
+    EXPECT_EQ(files[2].filename(), "2025010100000000_50000002");
+
+    fs::remove_all(dir);
+}
+
+TEST(PELListTest, Writer)
+{
+    {
+        std::ostringstream out;
+        list::Writer writer{out, list::Writer::Format::object};
+        writer.finish();
+        EXPECT_EQ(out.str(), "{}\n");
+    }
+
+    {
+        std::ostringstream out;
+        list::Writer writer{out, list::Writer::Format::object};
+        writer.write("    \"0x1\": {\n    }");
+        writer.write("    \"0x2\": {\n    }");
+        writer.finish();
+        EXPECT_EQ(out.str(),
+                  "{\n    \"0x1\": {\n    },\n    \"0x2\": {\n    }\n}\n");
+    }
+
+    {
+        std::ostringstream out;
+        list::Writer writer{out, list::Writer::Format::array};
+        writer.finish();
+        EXPECT_EQ(out.str(), "[]\n");
+    }
+
+    {
+        std::ostringstream out;
+        list::Writer writer{out, list::Writer::Format::array};
+        writer.write("{\n}");
+        writer.write("{\n}");
+        writer.finish();
+        EXPECT_EQ(out.str(), "[\n{\n}\n,\n\n{\n}\n]\n");
+    }
+
+    {
+        std::ostringstream out;
+        list::Writer writer{out, list::Writer::Format::plain};
+        writer.write("00000000:  01 02");
+        writer.finish();
+        EXPECT_EQ(out.str(), "00000000:  01 02\n");
+    }
+}
@@ -31,6 +31,7 @@ namespace fs = std::filesystem;
 
 using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::Throw;
 using json = nlohmann::json;
 
 class TestLogger
@@ -491,6 +492,14 @@ TEST_F(ManagerTest, TestDBusMethods)
     EXPECT_THROW(
         manager.getBMCLogIdFromPELId(pel.id() + 1),
         sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument);
+
+    // GetPELJSON, which is the same the second time from the cache
+    auto pelJSON = manager.getPELJSON(42);
+    EXPECT_TRUE(json::parse(pelJSON).contains("Private Header"));
+    EXPECT_EQ(manager.getPELJSON(42), pelJSON);
+    EXPECT_THROW(
+        manager.getPELJSON(43),
+        sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument);
 }
 
 // An ESEL from the wild
@@ -610,6 +619,23 @@ TEST_F(ManagerTest, TestESELToRawData)
     EXPECT_TRUE(pel.valid());
 }
 
+TEST_F(ManagerTest, TestNeedsParserPlugins)
+{
+    // The BMC's sections only need a plugin that is installed
+    PEL bmcPEL{pelFactory(1, 'O', 0x20, 0x8800, 500)};
+    EXPECT_FALSE(Manager::needsParserPlugins(bmcPEL, {}));
+    EXPECT_FALSE(Manager::needsParserPlugins(bmcPEL, {"bsrc"}));
+    EXPECT_TRUE(Manager::needsParserPlugins(bmcPEL, {"osrc"}));
+
+    // The plugins for other creators can be anywhere on the python3 path,
+    // so their SRC and UserData sections always need peltool.
+    PEL hostPEL{pelFactory(2, 'B', 0x20, 0x8800, 500)};
+    EXPECT_TRUE(Manager::needsParserPlugins(hostPEL, {}));
+
+    PEL eselPEL{Manager::eselToRawData(esel)};
+    EXPECT_TRUE(Manager::needsParserPlugins(eselPEL, {}));
+}
+
 TEST_F(ManagerTest, TestCreateWithESEL)
 {
     std::unique_ptr<DataInterfaceBase> dataIface =
@@ -738,6 +764,62 @@ TEST_F(ManagerTest, TestPruning)
     }
 }
 
+// Test that PELs aren't pruned when the hardware isolated log IDs can't
+// be read, such as when the isolation tree isn't on D-Bus.
+TEST_F(ManagerTest, TestPruningIsolationReadFailure)
+{
+    sdeventplus::Event e{sdEvent};
+
+    auto mockIface = std::make_unique<MockDataInterface>();
+    EXPECT_CALL(*mockIface, readLogIDsWithHwIsolation())
+        .WillOnce(Throw(sdbusplus::xyz::openbmc_project::Common::Error::
+                            ResourceNotFound{}))
+        .WillRepeatedly(Return(std::vector<uint32_t>{}));
+
+    std::unique_ptr<DataInterfaceBase> dataIface = std::move(mockIface);
+
+    std::unique_ptr<JournalBase> journal = std::make_unique<MockJournal>();
+
+    openpower::pels::Manager manager{
+        logManager, std::move(dataIface),
+        std::bind(std::mem_fn(&TestLogger::log), &logger, std::placeholders::_1,
+                  std::placeholders::_2, std::placeholders::_3),
+        std::move(journal)};
+
+    // The same PELs as TestPruning, where the 24th one would trigger a
+    // prune.  That one fails to read the IDs and keeps every PEL, and
+    // the 25th one tries again.
+    auto dir = makeTempDir();
+    for (int i = 1; i <= 25; i++)
+    {
+        auto data = pelFactory(42, 'O', 0x40, 0x8800, 1000);
+
+        fs::path pelFilename = dir / "rawpel";
+        std::ofstream pelFile{pelFilename};
+        pelFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+        pelFile.close();
+
+        std::map<std::string, std::string> additionalData{
+            {"RAWPEL", pelFilename.string()}};
+        std::vector<std::string> associations;
+
+        manager.create("error message", 42, 0,
+                       phosphor::logging::Entry::Level::Error, additionalData,
+                       associations);
+
+        EXPECT_NO_THROW(e.run(std::chrono::milliseconds(1)));
+
+        if (i < 25)
+        {
+            EXPECT_EQ(countPELsInRepo(), i);
+        }
+        else
+        {
+            EXPECT_EQ(countPELsInRepo(), 7);
+        }
+    }
+}
+
 // Test that manually deleting a PEL file will be recognized by the code.
 TEST_F(ManagerTest, TestPELManualDelete)
 {
@@ -872,11 +954,8 @@ TEST_F(ManagerTest, TestPELManualDeleteAll)
 
     EXPECT_EQ(countPELsInRepo(), 0);
 
-    // It will take 5 event loop passes to process them all
-    for (int i = 0; i < 5; i++)
-    {
-        e.run(std::chrono::milliseconds(1));
-    }
+    // They are all handled in one event loop pass
+    e.run(std::chrono::milliseconds(1));
 
     for (int i = 1; i <= 200; i++)
     {
@@ -886,6 +965,50 @@ TEST_F(ManagerTest, TestPELManualDeleteAll)
     }
 }
 
+// Test erasing the PELs of many event logs at once.
+TEST_F(ManagerTest, TestEraseMany)
+{
+    std::unique_ptr<DataInterfaceBase> dataIface =
+        std::make_unique<MockDataInterface>();
+
+    std::unique_ptr<JournalBase> journal = std::make_unique<MockJournal>();
+
+    openpower::pels::Manager manager{
+        logManager, std::move(dataIface),
+        std::bind(std::mem_fn(&TestLogger::log), &logger, std::placeholders::_1,
+                  std::placeholders::_2, std::placeholders::_3),
+        std::move(journal)};
+
+    auto data = pelDataFactory(TestPELType::pelSimple);
+    fs::path pelFilename = makeTempDir() / "rawpel";
+
+    std::map<std::string, std::string> additionalData{
+        {"RAWPEL", pelFilename.string()}};
+    std::vector<std::string> associations;
+
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        std::ofstream pelFile{pelFilename};
+        pelFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+        pelFile.close();
+
+        manager.create("error message", i, 0,
+                       phosphor::logging::Entry::Level::Error, additionalData,
+                       associations);
+    }
+
+    // An ID without a PEL is skipped
+    manager.erase(std::set<uint32_t>{1, 3, 4});
+
+    EXPECT_THROW(
+        manager.getPEL(0x50000001),
+        sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument);
+    EXPECT_NO_THROW(manager.getPEL(0x50000002));
+    EXPECT_THROW(
+        manager.getPEL(0x50000003),
+        sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument);
+}
+
 // Test that fault LEDs are turned on when PELs are created
 TEST_F(ManagerTest, TestServiceIndicators)
 {
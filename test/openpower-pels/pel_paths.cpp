@@ -63,6 +63,19 @@ std::filesystem::path getPELReadOnlyDataPath()
     return dataPath;
 }
 
+std::filesystem::path getPELParserSitePath()
+{
+    static std::string sitePath;
+
+    if (sitePath.empty())
+    {
+        char templ[] = "/tmp/pelparsertestXXXXXX";
+        sitePath = mkdtemp(templ);
+    }
+
+    return sitePath;
+}
+
 size_t getPELRepoSize()
 {
     // 100KB
@@ -74,5 +87,11 @@ size_t getMaxNumPELs()
     return 100;
 }
 
+std::chrono::milliseconds getPELSyncLatency()
+{
+    // Flush every write, as there isn't an event loop running
+    return std::chrono::milliseconds::zero();
+}
+
 } // namespace pels
 } // namespace openpower
@@ -0,0 +1,103 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/pel.hpp"
+#include "extensions/openpower-pels/read_file.hpp"
+#include "pel_utils.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/**
+ * @brief Writes a PEL file with a UserData section of the size
+ *        passed in, to get PELs of different sizes.
+ *
+ * @param[in] udSize - The UserData section size
+ *
+ * @return fs::path - The PEL file
+ */
+fs::path makePELFile(size_t udSize)
+{
+    auto path = getPELRepoPath() / ("pel_read_" + std::to_string(udSize));
+    auto data = pelFactory(1, 'O', 0x40, 0x8800, udSize);
+
+    std::ofstream file{path, std::ios::binary};
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    return path;
+}
+
+} // namespace
+
+/**
+ * @brief The previous way of reading a PEL file into a vector with
+ *        istreambuf_iterators, and then parsing it.  The bytes_copied
+ *        counter is what is copied out of the ifstream's buffer on top
+ *        of what the kernel copies.
+ */
+static void readIntoVector(benchmark::State& state)
+{
+    auto path = makePELFile(state.range(0));
+    size_t bytesCopied = 0;
+
+    for (auto _ : state)
+    {
+        std::ifstream file{path};
+        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                                  std::istreambuf_iterator<char>()};
+        bytesCopied += data.size();
+
+        PEL pel{data};
+        benchmark::DoNotOptimize(pel.valid());
+    }
+
+    state.counters["bytes_copied"] = benchmark::Counter(
+        bytesCopied, benchmark::Counter::kAvgIterations);
+    fs::remove(path);
+}
+
+/**
+ * @brief Reading the PEL file straight into the vector with a single
+ *        read() call using util::readFile(), and then parsing it.
+ *        The only copy is the kernel's, into the vector.
+ */
+static void readFile(benchmark::State& state)
+{
+    auto path = makePELFile(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto data = util::readFile(path);
+        PEL pel{data};
+        benchmark::DoNotOptimize(pel.valid());
+    }
+
+    state.counters["bytes_copied"] = 0;
+    fs::remove(path);
+}
+
+BENCHMARK(readIntoVector)->Arg(500)->Arg(4000)->Arg(15000);
+BENCHMARK(readFile)->Arg(500)->Arg(4000)->Arg(15000);
+
+BENCHMARK_MAIN();
@@ -75,6 +75,22 @@ TEST_F(PELTest, FlattenTest)
     EXPECT_EQ(flattenedData.size(), pel->size());
 }
 
+// Test building a PEL from read only data
+TEST_F(PELTest, ReadOnlyDataTest)
+{
+    const auto data = pelDataFactory(TestPELType::pelSimple);
+    PEL pel{std::span{data}, 42};
+
+    EXPECT_TRUE(pel.valid());
+    EXPECT_EQ(pel.id(), 0x80818283);
+    EXPECT_EQ(pel.obmcLogID(), 42);
+
+    // The only difference is the OBMC log ID
+    auto copy = data;
+    PEL pel2{copy, 42};
+    EXPECT_EQ(pel.data(), pel2.data());
+}
+
 TEST_F(PELTest, CommitTimeTest)
 {
     auto data = pelDataFactory(TestPELType::pelSimple);
@@ -0,0 +1,76 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/pel.hpp"
+#include "extensions/openpower-pels/read_file.hpp"
+#include "pel_utils.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+class ReadFileTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        dir = fs::temp_directory_path() / "read_file_test";
+        fs::create_directories(dir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+};
+
+TEST_F(ReadFileTest, ReadTest)
+{
+    auto data = pelDataFactory(TestPELType::pelSimple);
+    auto path = dir / "pel";
+    {
+        std::ofstream file{path, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    auto fileData = util::readFile(path);
+    EXPECT_EQ(fileData, data);
+
+    // Parse it as read only data
+    const auto& constData = fileData;
+    PEL pel{std::span{constData}};
+    EXPECT_TRUE(pel.valid());
+    EXPECT_EQ(pel.data(), data);
+}
+
+TEST_F(ReadFileTest, EmptyFileTest)
+{
+    auto path = dir / "empty";
+    std::ofstream{path};
+
+    EXPECT_TRUE(util::readFile(path).empty());
+}
+
+TEST_F(ReadFileTest, MissingFileTest)
+{
+    EXPECT_THROW(util::readFile(dir / "missing"), std::system_error);
+}
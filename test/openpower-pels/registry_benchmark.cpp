@@ -0,0 +1,150 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/registry.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+using namespace openpower::pels::message;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/**
+ * @brief Writes a registry with the number of entries passed in, each
+ *        with callouts and documentation like the real registry has.
+ *
+ * @param[in] count - The number of entries
+ *
+ * @return fs::path - The registry file
+ */
+fs::path makeRegistry(size_t count)
+{
+    auto path = getPELReadOnlyDataPath() /
+                ("registry" + std::to_string(count) + ".json");
+    nlohmann::json pels = nlohmann::json::array();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        nlohmann::json callouts = nlohmann::json::array();
+        for (const auto& system : {"systemA", "systemB"})
+        {
+            callouts.push_back(
+                {{"System", system},
+                 {"CalloutList",
+                  {{{"Priority", "high"}, {"LocCode", "P0"}},
+                   {{"Priority", "medium"}, {"Procedure", "BMC0001"}},
+                   {{"Priority", "low"}, {"SymbolicFRU", "service_docs"}}}}});
+        }
+
+        pels.push_back(
+            {{"Name", std::format("xyz.openbmc_project.Error.Fault{}", i)},
+             {"Subsystem", "bmc_firmware"},
+             {"ComponentID", "0x2000"},
+             {"Severity", "unrecoverable"},
+             {"ActionFlags", {"service_action", "report", "call_home"}},
+             {"SRC",
+              {{"ReasonCode", std::format("0x{:04X}", 0x2000 + i)},
+               {"Words6To9",
+                {{"6", {{"Description", "Failing unit"},
+                        {"AdditionalDataPropSource", "UNIT"}}},
+                 {"7", {{"Description", "Return code"},
+                        {"AdditionalDataPropSource", "RC"}}}}}}},
+             {"Callouts", callouts},
+             {"Documentation",
+              {{"Description", "A fault was detected in a unit"},
+               {"Message", "Unit %1 failed with return code %2"},
+               {"MessageArgSources", {"SRCWord6", "SRCWord7"}}}}});
+    }
+
+    std::ofstream file{path};
+    file << nlohmann::json{{"PELs", pels}}.dump(4);
+
+    return path;
+}
+
+} // namespace
+
+/**
+ * @brief Looks up entries by name in the same Registry object, which is
+ *        what the PEL manager does each time it creates a PEL.
+ */
+static void lookupByName(benchmark::State& state)
+{
+    auto count = state.range(0);
+    Registry registry{makeRegistry(count)};
+    int64_t i = 0;
+
+    for (auto _ : state)
+    {
+        auto entry = registry.lookup(
+            std::format("xyz.openbmc_project.Error.Fault{}", i++ % count),
+            LookupType::name);
+        benchmark::DoNotOptimize(entry);
+    }
+}
+
+/**
+ * @brief Looks up entries by reason code, which is what
+ *        SRC::getErrorDetails() does.
+ */
+static void lookupByReasonCode(benchmark::State& state)
+{
+    auto count = state.range(0);
+    Registry registry{makeRegistry(count)};
+    int64_t i = 0;
+
+    for (auto _ : state)
+    {
+        auto entry = registry.lookup(
+            std::format("0x{:04X}", 0x2000 + (i++ % count)),
+            LookupType::reasonCode);
+        benchmark::DoNotOptimize(entry);
+    }
+}
+
+/**
+ * @brief Looks up entries by reason code with the registry cached in
+ *        memory, which is what peltool does.
+ */
+static void lookupCached(benchmark::State& state)
+{
+    auto count = state.range(0);
+    Registry registry{makeRegistry(count), false};
+    int64_t i = 0;
+
+    for (auto _ : state)
+    {
+        auto entry = registry.lookup(
+            std::format("0x{:04X}", 0x2000 + (i++ % count)),
+            LookupType::reasonCode, true);
+        benchmark::DoNotOptimize(entry);
+    }
+}
+
+BENCHMARK(lookupByName)->Arg(250)->Unit(benchmark::kMicrosecond);
+BENCHMARK(lookupByReasonCode)->Arg(250)->Unit(benchmark::kMicrosecond);
+BENCHMARK(lookupCached)->Arg(250)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
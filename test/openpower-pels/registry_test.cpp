@@ -17,6 +17,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 
@@ -1201,3 +1202,70 @@ TEST_F(RegistryTest, TestJournalSectionCapture)
     EXPECT_EQ(acl[1].syslogID, "test2");
     EXPECT_EQ(acl[1].numLines, 6);
 }
+
+TEST_F(RegistryTest, TestRegistryChanged)
+{
+    auto path = RegistryTest::writeData(registryData);
+    Registry registry{path};
+    Registry cached{path};
+
+    EXPECT_TRUE(registry.lookup("xyz.openbmc_project.Power.Fault",
+                                LookupType::name));
+    EXPECT_TRUE(cached.lookup("xyz.openbmc_project.Power.Fault",
+                              LookupType::name, true));
+
+    const auto newData = R"(
+    {
+        "PELs":
+        [
+            {
+                "Name": "xyz.openbmc_project.Power.NewFault",
+                "Subsystem": "power_supply",
+                "SRC":
+                {
+                    "ReasonCode": "0x2040"
+                },
+                "Callouts":
+                [
+                    {
+                        "CalloutList":
+                        [
+                            {"Priority": "high", "LocCode": "P1"}
+                        ]
+                    }
+                ],
+                "Documentation":
+                {
+                    "Description": "A new fault",
+                    "Message": "A new fault"
+                }
+            }
+        ]
+    }
+    )";
+
+    RegistryTest::writeData(newData);
+    fs::last_write_time(path,
+                        fs::last_write_time(path) + std::chrono::seconds(1));
+
+    // The file is parsed again since it changed
+    EXPECT_FALSE(registry.lookup("xyz.openbmc_project.Power.Fault",
+                                 LookupType::name));
+
+    auto entry = registry.lookup("0x2040", LookupType::reasonCode);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->name, "xyz.openbmc_project.Power.NewFault");
+    ASSERT_TRUE(entry->callouts);
+    EXPECT_EQ((*entry->callouts)[0]["CalloutList"][0]["LocCode"], "P1");
+
+    // Unless the registry was cached
+    EXPECT_TRUE(cached.lookup("xyz.openbmc_project.Power.Fault",
+                              LookupType::name, true));
+    EXPECT_FALSE(cached.lookup("0x2040", LookupType::reasonCode, true));
+
+    // Callouts aren't kept if they aren't wanted
+    Registry noCallouts{path, false};
+    entry = noCallouts.lookup("0x2040", LookupType::reasonCode);
+    ASSERT_TRUE(entry);
+    EXPECT_FALSE(entry->callouts);
+}
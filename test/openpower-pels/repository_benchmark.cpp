@@ -0,0 +1,141 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/repository.hpp"
+#include "pel_utils.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+/**
+ * @brief Creates a repository directory with the number of PELs
+ *        passed in, alternating between BMC and hostboot PELs.
+ *
+ * @param[in] count - The number of PELs to create
+ *
+ * @return fs::path - The repository base path
+ */
+fs::path makeRepo(size_t count)
+{
+    auto basePath = getPELRepoPath() / std::to_string(count);
+    auto logPath = basePath / "logs";
+
+    fs::remove_all(basePath);
+    fs::create_directories(logPath / "archive");
+
+    for (uint32_t id = 1; id <= count; id++)
+    {
+        auto data = pelFactory(id, (id % 2) ? 'O' : 'B', 0x40, 0x8800, 1000);
+        PEL pel{data};
+
+        std::ofstream file{logPath / Repository::getPELFilename(
+                                         pel.id(), pel.commitTime()),
+                           std::ios::binary};
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    return basePath;
+}
+
+/**
+ * @brief Restore with no attributes index, so every PEL file is read.
+ */
+static void restoreNoIndex(benchmark::State& state)
+{
+    auto basePath = makeRepo(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        fs::remove(basePath / "attributes_index");
+        state.ResumeTiming();
+
+        Repository repo{basePath, 100 * 1024 * 1024, 20000};
+        benchmark::DoNotOptimize(repo.getSizeStats());
+    }
+
+    fs::remove_all(basePath);
+}
+
+/**
+ * @brief Restore with a current attributes index, so no PEL files are read.
+ */
+static void restoreWithIndex(benchmark::State& state)
+{
+    auto basePath = makeRepo(state.range(0));
+
+    // Writes the index
+    Repository{basePath, 100 * 1024 * 1024, 20000};
+
+    for (auto _ : state)
+    {
+        Repository repo{basePath, 100 * 1024 * 1024, 20000};
+        benchmark::DoNotOptimize(repo.getSizeStats());
+    }
+
+    fs::remove_all(basePath);
+}
+
+/**
+ * @brief The previous restore method of reading and fully
+ *        parsing every PEL file serially, for comparison.
+ */
+static void restoreFullParse(benchmark::State& state)
+{
+    auto basePath = makeRepo(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (const auto& dirEntry : fs::directory_iterator(basePath / "logs"))
+        {
+            if (!fs::is_regular_file(dirEntry.path()))
+            {
+                continue;
+            }
+
+            std::ifstream file{dirEntry.path()};
+            std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                                      std::istreambuf_iterator<char>()};
+            PEL pel{data};
+            benchmark::DoNotOptimize(pel.valid());
+        }
+    }
+
+    fs::remove_all(basePath);
+}
+
+BENCHMARK(restoreNoIndex)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(restoreWithIndex)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(restoreFullParse)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+/**
+ * Copyright © 2026 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/repository.hpp"
+#include "pel_utils.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+using namespace openpower::pels;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/**
+ * @brief Creates a repository with the number of PELs passed in,
+ *        where PEL i has OBMC log ID i.
+ */
+class LookupFixture : public benchmark::Fixture
+{
+  public:
+    void SetUp(const benchmark::State& state) override
+    {
+        auto count = state.range(0);
+        basePath = getPELRepoPath() / ("lookup" + std::to_string(count));
+        fs::remove_all(basePath);
+
+        repo = std::make_unique<Repository>(basePath, 100 * 1024 * 1024,
+                                            count + 1);
+
+        for (uint32_t id = 1; id <= count; id++)
+        {
+            auto data = pelFactory(id, 'O', 0x40, 0x8800, 1000);
+            auto pel = std::make_unique<PEL>(data, id);
+            repo->add(pel);
+        }
+    }
+
+    void TearDown(const benchmark::State&) override
+    {
+        repo.reset();
+        fs::remove_all(basePath);
+    }
+
+    fs::path basePath;
+    std::unique_ptr<Repository> repo;
+};
+
+} // namespace
+
+/**
+ * @brief Looks up every PEL by its OBMC log ID, which previously
+ *        required a search through the whole attributes map.
+ */
+BENCHMARK_DEFINE_F(LookupFixture, getLogIDByObmcID)(benchmark::State& state)
+{
+    uint32_t count = state.range(0);
+    uint32_t id = 0;
+
+    for (auto _ : state)
+    {
+        id = (id % count) + 1;
+        auto logID =
+            repo->getLogID(Repository::LogID{Repository::LogID::Obmc{id}});
+        benchmark::DoNotOptimize(logID);
+    }
+}
+
+/**
+ * @brief Looks up every PEL by its PEL ID.
+ */
+BENCHMARK_DEFINE_F(LookupFixture, getLogIDByPelID)(benchmark::State& state)
+{
+    uint32_t count = state.range(0);
+    uint32_t id = 0;
+
+    for (auto _ : state)
+    {
+        id = (id % count) + 1;
+        auto logID =
+            repo->getLogID(Repository::LogID{Repository::LogID::Pel{id}});
+        benchmark::DoNotOptimize(logID);
+    }
+}
+
+/**
+ * @brief The previous method of searching the attributes map
+ *        with LogID::operator==, for comparison.
+ */
+BENCHMARK_DEFINE_F(LookupFixture, linearSearchByObmcID)
+(benchmark::State& state)
+{
+    uint32_t count = state.range(0);
+    uint32_t id = 0;
+    const auto& attributes = repo->getAttributesMap();
+
+    for (auto _ : state)
+    {
+        id = (id % count) + 1;
+        Repository::LogID logID{Repository::LogID::Obmc{id}};
+        auto it = std::find_if(
+            attributes.begin(), attributes.end(),
+            [&logID](const auto& a) { return a.first == logID; });
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+BENCHMARK_REGISTER_F(LookupFixture, getLogIDByObmcID)->Arg(1000)->Arg(10000);
+BENCHMARK_REGISTER_F(LookupFixture, getLogIDByPelID)->Arg(1000)->Arg(10000);
+BENCHMARK_REGISTER_F(LookupFixture, linearSearchByObmcID)
+    ->Arg(1000)
+    ->Arg(10000);
+
+BENCHMARK_MAIN();
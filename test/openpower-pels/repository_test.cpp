@@ -14,12 +14,14 @@
  * limitations under the License.
  */
 #include "extensions/openpower-pels/paths.hpp"
+#include "extensions/openpower-pels/read_file.hpp"
 #include "extensions/openpower-pels/repository.hpp"
 #include "pel_utils.hpp"
 
 #include <ext/stdio_filebuf.h>
 
 #include <filesystem>
+#include <fstream>
 
 #include <gtest/gtest.h>
 
@@ -89,6 +91,76 @@ TEST_F(RepositoryTest, AddTest)
     EXPECT_EQ(repo.lastPelID(), pel->id());
 }
 
+// Test the write counters, flushing each write
+TEST_F(RepositoryTest, WriteStatsTest)
+{
+    Repository repo{repoPath};
+    size_t bytes = 0;
+
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        auto data = pelDataFactory(TestPELType::pelSimple);
+        auto pel = std::make_unique<PEL>(data, i);
+        pel->assignID();
+        repo.add(pel);
+        bytes += pel->size();
+    }
+
+    const auto& stats = repo.getWriteStats();
+    EXPECT_EQ(stats.files, 3);
+    EXPECT_EQ(stats.bytes, bytes);
+    EXPECT_EQ(stats.flushes, 3);
+
+    // Nothing is left in the temporary directory
+    EXPECT_TRUE(fs::is_empty(repoPath / "logs" / ".tmp"));
+
+    // Nothing to sync
+    repo.sync();
+    EXPECT_EQ(stats.flushes, 3);
+}
+
+// Test that with a sync latency, writes share a flush
+TEST_F(RepositoryTest, GroupSyncTest)
+{
+    using pelID = Repository::LogID::Pel;
+
+    // Leave a partial write behind, which should get cleaned up
+    fs::create_directories(repoPath / "logs" / ".tmp");
+    std::ofstream{repoPath / "logs" / ".tmp" / "2030010100000000_50000001"};
+
+    Repository repo{repoPath, 100 * 1024, 100, std::chrono::seconds{60}};
+    EXPECT_TRUE(fs::is_empty(repoPath / "logs" / ".tmp"));
+
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 1; i <= 5; i++)
+    {
+        auto data = pelDataFactory(TestPELType::pelSimple);
+        auto pel = std::make_unique<PEL>(data, i);
+        pel->assignID();
+        repo.add(pel);
+        ids.push_back(pel->id());
+    }
+
+    const auto& stats = repo.getWriteStats();
+    EXPECT_EQ(stats.files, 5);
+    EXPECT_EQ(stats.flushes, 0);
+
+    // The PELs can still be read before the flush
+    for (auto id : ids)
+    {
+        EXPECT_TRUE(repo.getPELData(Repository::LogID{pelID{id}}));
+    }
+
+    repo.setPELHostTransState(ids[0], TransmissionState::acked);
+    EXPECT_EQ(stats.files, 6);
+
+    repo.sync();
+    EXPECT_EQ(stats.flushes, 1);
+
+    repo.sync();
+    EXPECT_EQ(stats.flushes, 1);
+}
+
 TEST_F(RepositoryTest, RemoveTest)
 {
     using pelID = Repository::LogID::Pel;
@@ -116,6 +188,100 @@ TEST_F(RepositoryTest, RemoveTest)
     EXPECT_FALSE(repo.remove(id));
 }
 
+// Test removing many PELs together
+TEST_F(RepositoryTest, RemoveManyTest)
+{
+    using pelID = Repository::LogID::Pel;
+    using obmcID = Repository::LogID::Obmc;
+
+    Repository repo{repoPath};
+    std::vector<Repository::LogID> ids;
+    std::vector<fs::path> paths;
+
+    for (uint32_t i = 1; i <= 5; i++)
+    {
+        auto data = pelDataFactory(TestPELType::pelSimple);
+        auto pel = std::make_unique<PEL>(data, i);
+        pel->assignID();
+        ids.emplace_back(pelID{pel->id()}, obmcID{i});
+        paths.push_back(
+            Repository::getPELFilename(pel->id(), pel->commitTime()));
+        repo.add(pel);
+    }
+
+    // The callbacks are only called once all of them are removed.
+    std::vector<uint32_t> removed;
+    repo.subscribeToDeletes("test", [&](uint32_t id) {
+        removed.push_back(id);
+        EXPECT_FALSE(repo.hasPEL(ids[0]));
+        EXPECT_FALSE(repo.hasPEL(ids[3]));
+    });
+
+    // A PEL whose file was already deleted is still removed.
+    fs::remove(repoPath / "logs" / paths[3]);
+
+    auto removedIDs = repo.remove(
+        {Repository::LogID{obmcID{1}}, Repository::LogID{ids[1].pelID},
+         Repository::LogID{obmcID{4}}, Repository::LogID{obmcID{99}}});
+
+    ASSERT_EQ(removedIDs.size(), 3);
+    EXPECT_EQ(removedIDs[0], ids[0]);
+    EXPECT_EQ(removedIDs[1], ids[1]);
+    EXPECT_EQ(removedIDs[2], ids[3]);
+
+    EXPECT_EQ(removed, (std::vector<uint32_t>{ids[0].pelID.id, ids[1].pelID.id,
+                                              ids[3].pelID.id}));
+
+    auto archivePath = repoPath / "logs" / "archive";
+    EXPECT_TRUE(fs::exists(archivePath / paths[0]));
+    EXPECT_TRUE(fs::exists(archivePath / paths[1]));
+    EXPECT_FALSE(fs::exists(archivePath / paths[3]));
+
+    EXPECT_TRUE(repo.hasPEL(ids[2]));
+    EXPECT_TRUE(repo.hasPEL(ids[4]));
+    EXPECT_FALSE(repo.hasPEL(ids[1]));
+}
+
+// Test finding PELs by an OBMC ID that more than one has
+TEST_F(RepositoryTest, DuplicateOBMCIDTest)
+{
+    using pelID = Repository::LogID::Pel;
+    using obmcID = Repository::LogID::Obmc;
+
+    Repository repo{repoPath};
+    std::vector<Repository::LogID> ids;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        auto data = pelDataFactory(TestPELType::pelSimple);
+        auto pel = std::make_unique<PEL>(data, 7);
+        pel->assignID();
+        ids.emplace_back(pelID{pel->id()}, obmcID{7});
+        repo.add(pel);
+    }
+
+    // The earliest one is found
+    Repository::LogID id{obmcID{7}};
+    auto found = repo.getLogID(id);
+    ASSERT_TRUE(found);
+    EXPECT_EQ(found->pelID.id, ids[0].pelID.id);
+
+    // The others are still found as each is removed
+    repo.remove(ids[0]);
+    found = repo.getLogID(id);
+    ASSERT_TRUE(found);
+    EXPECT_EQ(found->pelID.id, ids[1].pelID.id);
+
+    repo.remove(ids[2]);
+    found = repo.getLogID(id);
+    ASSERT_TRUE(found);
+    EXPECT_EQ(found->pelID.id, ids[1].pelID.id);
+
+    repo.remove(id);
+    EXPECT_FALSE(repo.getLogID(id));
+    EXPECT_TRUE(repo.getAttributesMap().empty());
+}
+
 TEST_F(RepositoryTest, RestoreTest)
 {
     using pelID = Repository::LogID::Pel;
@@ -186,6 +352,168 @@ TEST_F(RepositoryTest, RestoreTest)
     }
 }
 
+TEST_F(RepositoryTest, RestoreFromIndexTest)
+{
+    using ID = Repository::LogID;
+
+    auto compare = [](const Repository::PELAttributes& a,
+                      const Repository::PELAttributes& b) {
+        EXPECT_EQ(a.path, b.path);
+        EXPECT_EQ(a.sizeOnDisk, b.sizeOnDisk);
+        EXPECT_EQ(a.creator, b.creator);
+        EXPECT_EQ(a.subsystem, b.subsystem);
+        EXPECT_EQ(a.severity, b.severity);
+        EXPECT_EQ(a.actionFlags, b.actionFlags);
+        EXPECT_EQ(a.hostState, b.hostState);
+        EXPECT_EQ(a.hmcState, b.hmcState);
+        EXPECT_EQ(a.plid, b.plid);
+        EXPECT_EQ(a.deconfig, b.deconfig);
+        EXPECT_EQ(a.guard, b.guard);
+        EXPECT_EQ(a.creationTime, b.creationTime);
+    };
+
+    std::map<uint32_t, Repository::PELAttributes> expected;
+
+    {
+        Repository repo{repoPath};
+
+        // PELs from a few different creators
+        uint32_t pelID = 1;
+        for (char creator : {'O', 'B', 'H'})
+        {
+            auto data = pelFactory(pelID++, creator, 0x40, 0x8800, 500);
+            auto pel = std::make_unique<PEL>(data);
+            repo.add(pel);
+        }
+
+        for (const auto& [id, attributes] : repo.getAttributesMap())
+        {
+            expected.emplace(id.pelID.id, attributes);
+        }
+    }
+
+    // The first restore reads the PEL files, and the second one
+    // uses the index it wrote.
+    for (int i = 0; i < 2; i++)
+    {
+        Repository repo{repoPath};
+        EXPECT_TRUE(fs::exists(repoPath / "attributes_index"));
+        ASSERT_EQ(repo.getAttributesMap().size(), expected.size());
+
+        for (const auto& [id, attributes] : expected)
+        {
+            auto a = repo.getPELAttributes(ID{ID::Pel(id)});
+            ASSERT_TRUE(a);
+            compare(a->get(), attributes);
+        }
+    }
+
+    // Change a PEL behind the index's back, which makes its record stale.
+    {
+        Repository repo{repoPath};
+        repo.setPELHMCTransState(2, TransmissionState::acked);
+    }
+
+    {
+        Repository repo{repoPath};
+        auto a = repo.getPELAttributes(ID{ID::Pel(2)});
+        ASSERT_TRUE(a);
+        EXPECT_EQ(a->get().hmcState, TransmissionState::acked);
+    }
+
+    // A corrupt index is ignored
+    {
+        std::ofstream index{repoPath / "attributes_index", std::ios::trunc};
+        index << "garbage";
+    }
+
+    {
+        Repository repo{repoPath};
+        EXPECT_EQ(repo.getAttributesMap().size(), expected.size());
+    }
+}
+
+TEST_F(RepositoryTest, RestoreIndexTimestampTest)
+{
+    using ID = Repository::LogID;
+    fs::path path;
+    auto index = repoPath / "attributes_index";
+    auto fileTime =
+        fs::file_time_type::clock::now() - std::chrono::seconds(10);
+
+    {
+        Repository repo{repoPath};
+        auto data = pelFactory(1, 'O', 0x40, 0x8800, 500);
+        auto pel = std::make_unique<PEL>(data);
+        repo.add(pel);
+
+        path = repo.getPELAttributes(ID{ID::Pel(1)})->get().path;
+        fs::last_write_time(path, fileTime);
+    }
+
+    // The index was written for the added PEL without a restore
+    ASSERT_TRUE(fs::exists(index));
+
+    // Change the PEL in place, keeping its size and modification time
+    auto changeFile = [&path, &fileTime]() {
+        auto data = util::readFile(path);
+        PEL pel{data};
+        pel.setHMCTransmissionState(TransmissionState::acked);
+        auto changed = pel.data();
+        ASSERT_EQ(changed.size(), data.size());
+
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char*>(changed.data()),
+                   changed.size());
+        file.close();
+        fs::last_write_time(path, fileTime);
+    };
+    changeFile();
+
+    // The file is older than the index, so its record is used
+    {
+        Repository repo{repoPath};
+        auto a = repo.getPELAttributes(ID{ID::Pel(1)});
+        ASSERT_TRUE(a);
+        EXPECT_EQ(a->get().hmcState, TransmissionState::newPEL);
+    }
+
+    // But if the index was written in the same clock tick as the file
+    // was last modified, like on a filesystem with one second
+    // timestamps, the file could have changed since, so it is read.
+    fs::last_write_time(index, fileTime);
+    {
+        Repository repo{repoPath};
+        auto a = repo.getPELAttributes(ID{ID::Pel(1)});
+        ASSERT_TRUE(a);
+        EXPECT_EQ(a->get().hmcState, TransmissionState::acked);
+    }
+}
+
+TEST_F(RepositoryTest, RestoreInvalidPELTest)
+{
+    fs::path path;
+
+    {
+        Repository repo{repoPath};
+        auto data = pelFactory(1, 'O', 0x40, 0x8800, 500);
+        auto pel = std::make_unique<PEL>(data);
+        repo.add(pel);
+
+        using ID = Repository::LogID;
+        path = repo.getPELAttributes(ID{ID::Pel(1)})->get().path;
+    }
+
+    // Chop off the end of the file, like after a power loss.
+    fs::resize_file(path, 300);
+
+    {
+        Repository repo{repoPath};
+        EXPECT_TRUE(repo.getAttributesMap().empty());
+        EXPECT_FALSE(fs::exists(path));
+    }
+}
+
 TEST_F(RepositoryTest, TestGetPELData)
 {
     using ID = Repository::LogID;
@@ -288,6 +616,36 @@ TEST_F(RepositoryTest, TestSubscriptions)
     EXPECT_EQ(removed.size(), 0);
 }
 
+TEST_F(RepositoryTest, TestUpdateSubscriptions)
+{
+    std::vector<uint32_t> updated;
+
+    Repository::UpdateCallback uc = [&updated](uint32_t id) {
+        updated.push_back(id);
+    };
+
+    Repository repo{repoPath};
+    repo.subscribeToUpdates("test", uc);
+
+    auto data = pelDataFactory(TestPELType::pelSimple);
+    auto pel = std::make_unique<PEL>(data);
+    auto pelID = pel->id();
+    repo.add(pel);
+    EXPECT_TRUE(updated.empty());
+
+    repo.setPELHostTransState(pelID, TransmissionState::acked);
+    ASSERT_EQ(updated.size(), 1);
+    EXPECT_EQ(updated[0], pelID);
+
+    // Already acked, so it isn't rewritten
+    repo.setPELHostTransState(pelID, TransmissionState::acked);
+    EXPECT_EQ(updated.size(), 1);
+
+    repo.unsubscribeFromUpdates("test");
+    repo.setPELHMCTransState(pelID, TransmissionState::acked);
+    EXPECT_EQ(updated.size(), 1);
+}
+
 TEST_F(RepositoryTest, TestGetAttributes)
 {
     uint32_t pelID = 0;
@@ -783,6 +1141,60 @@ TEST_F(RepositoryTest, TestPruneWithAcks)
 }
 
 // Test that the total number of PELs limit is enforced.
+// Test that pruning uses the transmission states of PELs
+// that were restored and then had their states changed.
+TEST_F(RepositoryTest, TestPruneAfterRestore)
+{
+    std::vector<uint32_t> hmcAckedIDs;
+    std::vector<uint32_t> hostAckedIDs;
+
+    {
+        Repository repo{repoPath, 4096 * 20, 100};
+
+        // 6 BMC predictive PELs, right at the 30% limit
+        for (uint32_t i = 1; i <= 6; i++)
+        {
+            auto data = pelFactory(i, 'O', 0x20, 0x8800, 500);
+            auto pel = std::make_unique<PEL>(data);
+            repo.add(pel);
+
+            if (i == 4)
+            {
+                repo.setPELHMCTransState(pel->id(), TransmissionState::acked);
+                hmcAckedIDs.push_back(pel->obmcLogID());
+            }
+            else if (i == 5)
+            {
+                repo.setPELHostTransState(pel->id(),
+                                          TransmissionState::acked);
+                hostAckedIDs.push_back(pel->obmcLogID());
+            }
+        }
+    }
+
+    Repository repo{repoPath, 4096 * 20, 100};
+
+    // Push it over the limit by 2 PELs
+    for (uint32_t i = 7; i <= 8; i++)
+    {
+        auto data = pelFactory(i, 'O', 0x20, 0x8800, 500);
+        auto pel = std::make_unique<PEL>(data);
+        repo.add(pel);
+
+        // An ack that is then taken back
+        repo.setPELHMCTransState(pel->id(), TransmissionState::acked);
+        repo.setPELHMCTransState(pel->id(), TransmissionState::newPEL);
+    }
+
+    auto IDs = repo.prune(std::vector<uint32_t>{});
+    ASSERT_EQ(IDs.size(), 2);
+
+    // The HMC acked one goes first, and then the host acked one.
+    EXPECT_EQ(IDs[0], hmcAckedIDs[0]);
+    EXPECT_EQ(IDs[1], hostAckedIDs[0]);
+    EXPECT_EQ(repo.getSizeStats().total, 4096 * 6);
+}
+
 TEST_F(RepositoryTest, TestPruneTooManyPELs)
 {
     std::vector<uint32_t> id;
@@ -1016,6 +1428,70 @@ TEST_F(RepositoryTest, GetLogIDNotFoundTC)
     ASSERT_TRUE(!logID.has_value());
 }
 
+// Test finding PELs by their OpenBMC log ID after adds, removes,
+// and a restore.
+TEST_F(RepositoryTest, FindByObmcIDTest)
+{
+    using pelID = Repository::LogID::Pel;
+    using obmcID = Repository::LogID::Obmc;
+
+    std::vector<Repository::LogID> ids;
+
+    {
+        Repository repo{repoPath};
+
+        for (uint32_t i = 1; i <= 10; i++)
+        {
+            auto data = pelDataFactory(TestPELType::pelSimple);
+            auto pel = std::make_unique<PEL>(data, i * 100);
+            pel->assignID();
+            repo.add(pel);
+            ids.emplace_back(pelID(pel->id()), obmcID(i * 100));
+        }
+
+        for (const auto& id : ids)
+        {
+            auto logID = repo.getLogID(Repository::LogID{id.obmcID});
+            ASSERT_TRUE(logID);
+            EXPECT_EQ(logID->pelID.id, id.pelID.id);
+        }
+
+        // Remove one using only its OBMC ID
+        auto removedID = repo.remove(Repository::LogID{ids[3].obmcID});
+        ASSERT_TRUE(removedID);
+        EXPECT_EQ(removedID->pelID.id, ids[3].pelID.id);
+        EXPECT_FALSE(repo.hasPEL(Repository::LogID{ids[3].obmcID}));
+        EXPECT_FALSE(repo.hasPEL(Repository::LogID{ids[3].pelID}));
+
+        // Remove one using only its PEL ID
+        EXPECT_TRUE(repo.remove(Repository::LogID{ids[6].pelID}));
+        EXPECT_FALSE(repo.hasPEL(Repository::LogID{ids[6].obmcID}));
+
+        // A zero OBMC ID doesn't match anything
+        EXPECT_FALSE(repo.hasPEL(Repository::LogID{obmcID(0)}));
+
+        // A PEL ID takes precedence over the OBMC ID like with operator==
+        Repository::LogID mixed{ids[0].pelID, ids[1].obmcID};
+        auto logID = repo.getLogID(mixed);
+        ASSERT_TRUE(logID);
+        EXPECT_EQ(logID->obmcID.id, ids[0].obmcID.id);
+    }
+
+    {
+        Repository repo{repoPath};
+
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+            bool expected = (i != 3) && (i != 6);
+            EXPECT_EQ(repo.hasPEL(Repository::LogID{ids[i].obmcID}),
+                      expected);
+            EXPECT_EQ(repo.getPELData(Repository::LogID{ids[i].obmcID})
+                          .has_value(),
+                      expected);
+        }
+    }
+}
+
 // Test that OpenBMC log Id with hardware isolation entry is not removed.
 TEST_F(RepositoryTest, TestPruneWithIdHwIsoEntry)
 {
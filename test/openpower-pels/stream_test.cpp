@@ -197,3 +197,36 @@ TEST(StreamTest, TestVectorInsertExtract)
     // Go off the end
     EXPECT_THROW(stream >> toExtract, std::out_of_range);
 }
+
+TEST(StreamTest, TestReadOnly)
+{
+    const std::vector<uint8_t> data{0x11, 0x22, 0x33, 0x44, 0x55,
+                                    0x66, 0x77, 0x88, 0x99};
+    Stream stream{std::span{data}};
+
+    uint8_t v8;
+    uint32_t v32;
+    stream >> v8 >> v32;
+    EXPECT_EQ(v8, 0x11);
+    EXPECT_EQ(v32, 0x22334455);
+    EXPECT_EQ(stream.remaining(), 4);
+
+    // Can't write to it
+    EXPECT_THROW(stream << v8, std::logic_error);
+
+    stream.offset(7);
+    uint16_t v16;
+    stream >> v16;
+    EXPECT_EQ(v16, 0x8899);
+
+    // Go off the end
+    EXPECT_THROW(stream >> v16, std::out_of_range);
+    EXPECT_THROW(stream.offset(9), std::out_of_range);
+
+    // Start at an offset
+    Stream offsetStream{std::span{data}, 8};
+    offsetStream >> v8;
+    EXPECT_EQ(v8, 0x99);
+
+    EXPECT_THROW((Stream{std::span{data}, 9}), std::out_of_range);
+}
@@ -0,0 +1,98 @@
+r"""
+Builds the perfect hash tables that the generated code looks strings up in
+with phosphor::logging::PerfectHashMap, from perfect_hash.hpp.
+
+Each key is hashed once.  The hash is mixed with seed 0 to pick a bucket,
+and each bucket then gets the seed that mixes all of its keys into free
+slots, or for a bucket with a single key, a negative value that names its
+slot directly.  A lookup is then one pass over the key and a single string
+compare.
+"""
+
+MASK = 0xFFFFFFFFFFFFFFFF
+MULTIPLIER = 0x9E3779B97F4A7C15
+
+
+def hash_key(key):
+    r"""
+    Hash a key, 8 bytes at a time.  This must match hashKey() in
+    perfect_hash.hpp.
+    """
+    data = key.encode()
+    h = len(data)
+    for pos in range(0, len(data), 8):
+        end = pos + 8
+        word = int.from_bytes(data[pos:end], "little")
+        h = ((h ^ word) * MULTIPLIER) & MASK
+
+    return h ^ (h >> 32)
+
+
+def get_slot(h, seed, size):
+    r"""
+    Mix a key's hash with a seed to get its slot.  This must match
+    getSlot() in perfect_hash.hpp.
+    """
+    h = (h ^ ((seed * MULTIPLIER) & MASK)) & MASK
+    h ^= h >> 33
+    h = (h * 0xFF51AFD7ED558CCD) & MASK
+    h ^= h >> 33
+    h = (h * 0xC4CEB9FE1A85EC53) & MASK
+    h ^= h >> 33
+
+    # Scale the top 32 bits to the size, instead of dividing.
+    return ((h >> 32) * size) >> 32
+
+
+def build(keys):
+    r"""
+    Build the tables for the keys, which must be unique.
+
+    Returns a tuple of the seed of each bucket, and the key in each slot.
+    Both have one element per key.
+    """
+    hashes = {key: hash_key(key) for key in keys}
+    if len(set(hashes.values())) != len(keys):
+        raise ValueError("perfect hash keys must have unique hashes")
+
+    size = len(keys)
+    if size == 0:
+        return [], []
+
+    buckets = [[] for _ in range(size)]
+    for key in keys:
+        buckets[get_slot(hashes[key], 0, size)].append(key)
+
+    seeds = [0] * size
+    slots = [None] * size
+
+    # Place the largest buckets first, while there are the most free slots.
+    order = sorted(range(size), key=lambda b: len(buckets[b]), reverse=True)
+    for bucket in order:
+        if len(buckets[bucket]) <= 1:
+            break
+
+        seed = 1
+        while True:
+            positions = [
+                get_slot(hashes[key], seed, size) for key in buckets[bucket]
+            ]
+            if len(set(positions)) == len(positions) and all(
+                slots[p] is None for p in positions
+            ):
+                break
+            seed += 1
+
+        for key, position in zip(buckets[bucket], positions):
+            slots[position] = key
+        seeds[bucket] = seed
+
+    # Single keys go straight into the slots that are left.
+    free = [p for p in range(size) if slots[p] is None]
+    for bucket in order:
+        if len(buckets[bucket]) == 1:
+            position = free.pop()
+            slots[position] = buckets[bucket][0]
+            seeds[bucket] = -position - 1
+
+    return seeds, slots
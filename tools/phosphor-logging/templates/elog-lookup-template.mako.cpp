@@ -1,59 +1,80 @@
 ## Note that this file is not auto generated, it is what generates the
 ## elog-lookup.cpp file
+<%!
+    import perfect_hash
+%>\
+<%
+    # The full name, metadata, and level of each error, keeping the
+    # first if a name is repeated.
+    lookup = {}
+    for error in errors:
+        meta_list = list(meta[error]) if (error in meta and meta[error]) else []
+        parent = parents[error]
+        while parent:
+            if (parent in meta and meta[parent]):
+                meta_list += meta[parent]
+            parent = parents[parent]
+
+        name = error
+        if ("example.xyz.openbmc_project" not in name):
+            index = name.rfind('.')
+            name = name[:index] + ".Error" + name[index:]
+
+        if name not in lookup:
+            lookup[name] = (meta_list, error_lvl[error])
+
+    seeds, slots = perfect_hash.build(list(lookup))
+%>\
 // This file was autogenerated.  Do not edit!
 // See elog-gen.py for more details
-#include <map>
-#include <vector>
 #include <log_manager.hpp>
+#include <perfect_hash.hpp>
 #include <phosphor-logging/log.hpp>
 
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
 namespace phosphor
 {
 
 namespace logging
 {
 
-const std::map<std::string,std::vector<std::string>> g_errMetaMap = {
-    % for name in errors:
-<%
-    meta_string = ""
-    meta_list = []
-    if(name in meta and meta[name]):
-        meta_list = meta[name]
-        meta_string = '\",\"'.join(meta_list)
-
-    parent = parents[name]
-    while parent:
-        if (parent in meta and meta[parent]):
-            parent_meta_short = '\",\"'.join(meta[parent])
-            if (meta_string):
-                meta_string = meta_string + "\",\"" + parent_meta_short
-            else:
-                meta_string = parent_meta_short
-        parent = parents[parent]
-    if ("example.xyz.openbmc_project" not in name):
-        index = name.rfind('.')
-        name = name[:index] + ".Error" + name[index:]
-%>\
-    %if (meta_string):
-    {"${name}",{"${meta_string}"}},
-    %else:
-    {"${name}",{}},
-    %endif
-    % endfor
-};
-
-const std::map<std::string,level> g_errLevelMap = {
-    % for a in errors:
-<%
-    name = a
-    if ("example.xyz.openbmc_project" not in name):
-        index = name.rfind('.')
-        name = name[:index] + ".Error" + name[index:]
-%>\
-    {"${name}",level::${error_lvl[a]}},
-    % endfor
-};
+namespace
+{
+
+% for slot, name in enumerate(slots):
+    % if lookup[name][0]:
+constexpr std::array<std::string_view, ${len(lookup[name][0])}> errMeta${slot}{
+    "${'", "'.join(lookup[name][0])}"};
+    % endif
+% endfor
+
+constexpr std::array<int32_t, ${len(seeds)}> errSeeds{${", ".join(str(s) for s in seeds)}};
+
+constexpr std::array<ErrMetaMap::Entry, ${len(slots)}> errMetaEntries{{
+% for slot, name in enumerate(slots):
+    % if lookup[name][0]:
+    {"${name}", errMeta${slot}},
+    % else:
+    {"${name}", {}},
+    % endif
+% endfor
+}};
+
+constexpr std::array<ErrLevelMap::Entry, ${len(slots)}> errLevelEntries{{
+% for name in slots:
+    {"${name}", level::${lookup[name][1]}},
+% endfor
+}};
+
+} // namespace
+
+constexpr ErrMetaMap g_errMetaMap{errSeeds, errMetaEntries};
+
+constexpr ErrLevelMap g_errLevelMap{errSeeds, errLevelEntries};
 
 } // namespace logging
 